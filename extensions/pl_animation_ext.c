@@ -5,6 +5,7 @@
 /*
 Index of this file:
 // [SECTION] includes
+// [SECTION] defines
 // [SECTION] structs
 // [SECTION] global data
 // [SECTION] internal api
@@ -27,6 +28,7 @@ Index of this file:
 // extensions
 #include "pl_profile_ext.h"
 #include "pl_log_ext.h"
+#include "pl_job_ext.h"
 
 #ifdef PL_UNITY_BUILD
     #include "pl_unity_ext.inc"
@@ -47,10 +49,25 @@ Index of this file:
     static const plProfileI*           gptProfile           = NULL;
     static const plLogI*               gptLog               = NULL;
     static const plEcsI*               gptECS               = NULL;
+    static const plJobI*               gptJob               = NULL;
 #endif
 
 #include "pl_ds.h"
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#ifndef PL_ANIMATION_PARALLEL_THRESHOLD
+    #define PL_ANIMATION_PARALLEL_THRESHOLD 16 // animation components
+#endif
+
+#define PL_ANIMATION_CURSOR_MAX_STEPS 4 // keyframes walked before falling back to binary search
+
+// smallest three quaternion components lie in [-1/sqrt(2), 1/sqrt(2)] (15 bits each)
+#define PL_ANIMATION_QUAT_RANGE 0.70710678f
+#define PL_ANIMATION_QUAT_SCALE (2.0f * PL_ANIMATION_QUAT_RANGE / 32767.0f)
+
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
@@ -70,6 +87,13 @@ typedef struct _plAnimationContext
     plEcsTypeKey tHierarchyComponentType;
 } plAnimationContext;
 
+typedef struct _plAnimationJobData
+{
+    plComponentLibrary*   ptLibrary;
+    plAnimationComponent* ptComponents;
+    float                 fDeltaTime;
+} plAnimationJobData;
+
 //-----------------------------------------------------------------------------
 // [SECTION] global data
 //-----------------------------------------------------------------------------
@@ -122,6 +146,10 @@ pl__ecs_animation_cleanup(plComponentLibrary* ptLibrary)
         PL_FREE(ptComponents[i].atChannels);
         ptComponents[i].atChannels = NULL;
         ptComponents[i].atSamplers = NULL;
+        ptComponents[i]._atSampledValues = NULL;
+        ptComponents[i]._auTargetIndices = NULL;
+        ptComponents[i]._auDataIndices = NULL;
+        ptComponents[i]._auKeyCursors = NULL;
         ptComponents[i].uChannelCount = 0;
     }
 }
@@ -164,11 +192,18 @@ pl_animation_create(plComponentLibrary* ptLibrary, const char* pcName, uint32_t
 
     plAnimationComponent* ptCompOut = gptECS->add_component(ptLibrary, gptAnimationCtx->tAnimationComponentType, tNewEntity);
 
-    size_t szAllocationSize = (sizeof(plAnimationChannel) + sizeof(plAnimationSampler)) * uChannelCount;
+    size_t szAllocationSize = (sizeof(plAnimationChannel) + sizeof(plAnimationSampler) + sizeof(plVec4) + 3 * sizeof(uint32_t)) * uChannelCount;
     ptCompOut->uChannelCount = uChannelCount;
     ptCompOut->atChannels = PL_ALLOC(szAllocationSize);
     memset(ptCompOut->atChannels, 0, szAllocationSize);
     ptCompOut->atSamplers = (plAnimationSampler*)&ptCompOut->atChannels[uChannelCount];
+    ptCompOut->_atSampledValues = (plVec4*)&ptCompOut->atSamplers[uChannelCount];
+    ptCompOut->_auTargetIndices = (uint32_t*)&ptCompOut->_atSampledValues[uChannelCount];
+    ptCompOut->_auDataIndices = &ptCompOut->_auTargetIndices[uChannelCount];
+    ptCompOut->_auKeyCursors = &ptCompOut->_auDataIndices[uChannelCount];
+
+    // targets are resolved on first update (channels are filled in by the caller)
+    memset(ptCompOut->_auTargetIndices, 0xFF, 2 * sizeof(uint32_t) * uChannelCount);
 
     if(pptCompOut)
         *pptCompOut = ptCompOut;
@@ -198,190 +233,559 @@ pl_animation_create_data(plComponentLibrary* ptLibrary, const char* pcName, uint
     return tNewEntity;
 }
 
-void
-pl_animation_run_animation_update_system(plComponentLibrary* ptLibrary, float fDeltaTime)
+static inline uint32_t
+pl__animation_resolve_index(plComponentLibrary* ptLibrary, plEcsTypeKey tType, const plEntity* ptEntities, uint32_t uCount, plEntity tEntity, uint32_t* puCachedIndex)
 {
-    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, __FUNCTION__);
+    // cached dense index stays valid until the component storage moves
+    uint32_t uIndex = *puCachedIndex;
+    if(uIndex < uCount && ptEntities[uIndex].uData == tEntity.uData)
+        return uIndex;
 
-    plAnimationComponent* ptComponents = NULL;
-    const uint32_t uComponentCount = gptECS->get_components(ptLibrary, gptAnimationCtx->tAnimationComponentType, (void**)&ptComponents, NULL);
+    uIndex = UINT32_MAX;
+    if(tEntity.uIndex != UINT32_MAX)
+    {
+        const size_t szIndex = gptECS->get_index(ptLibrary, tType, tEntity);
+        if(szIndex < uCount && ptEntities[szIndex].uData == tEntity.uData)
+            uIndex = (uint32_t)szIndex;
+    }
+    *puCachedIndex = uIndex;
+    return uIndex;
+}
 
-    for(uint32_t i = 0; i < uComponentCount; i++)
+static inline uint32_t
+pl__animation_find_key(const float* afKeyFrameTimes, uint32_t uKeyFrameCount, float fTime, uint32_t* puCursor)
+{
+    // returns first keyframe with time >= fTime (uKeyFrameCount if none)
+
+    // playback stays in (or just past) the cached interval most frames
+    uint32_t uKey = *puCursor;
+    if(uKey < uKeyFrameCount && (uKey == 0 || afKeyFrameTimes[uKey - 1] < fTime))
     {
-        plAnimationComponent* ptAnimationComponent = &ptComponents[i];
+        const uint32_t uLastStep = uKey + PL_ANIMATION_CURSOR_MAX_STEPS < uKeyFrameCount ? uKey + PL_ANIMATION_CURSOR_MAX_STEPS : uKeyFrameCount;
+        while(uKey < uLastStep && afKeyFrameTimes[uKey] < fTime)
+            uKey++;
+        if(uKey < uLastStep)
+        {
+            *puCursor = uKey;
+            return uKey;
+        }
+    }
 
-        if(!(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_PLAYING))
-            continue;
+    // seeked, looped or jumped far ahead
+    uint32_t uLow = 0;
+    uint32_t uHigh = uKeyFrameCount;
+    while(uLow < uHigh)
+    {
+        const uint32_t uMid = uLow + (uHigh - uLow) / 2;
+        if(afKeyFrameTimes[uMid] < fTime)
+            uLow = uMid + 1;
+        else
+            uHigh = uMid;
+    }
+    *puCursor = uLow;
+    return uLow;
+}
 
-        ptAnimationComponent->fTimer += fDeltaTime * ptAnimationComponent->fSpeed;
+static inline plVec4
+pl__animation_decode_key(const plAnimationDataComponent* ptData, int iKey, int iStride)
+{
+    plVec4 tValue = {0};
 
-        if(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_LOOPED)
+    if(!(ptData->tFlags & PL_ANIMATION_DATA_FLAG_COMPRESSED))
+    {
+        const float* afKeyFrameData = (const float*)ptData->pKeyFrameData;
+        for(int k = 0; k < iStride; k++)
+            tValue.d[k] = afKeyFrameData[iKey * iStride + k];
+        return tValue;
+    }
+
+    const uint16_t* auKey = &((const uint16_t*)ptData->pKeyFrameData)[iKey * 3];
+
+    if(ptData->tFlags & PL_ANIMATION_DATA_FLAG_QUATERNION)
+    {
+        // smallest three: dropped component index in low bits of first 2 words
+        const int iDropped = (auKey[0] & 1) | ((auKey[1] & 1) << 1);
+        float fSumSq = 0.0f;
+        int iComponent = 0;
+        for(int k = 0; k < 4; k++)
         {
-            ptAnimationComponent->fTimer = fmodf(ptAnimationComponent->fTimer, ptAnimationComponent->fEnd);
+            if(k == iDropped)
+                continue;
+            const float fComponent = (float)(auKey[iComponent++] >> 1) * PL_ANIMATION_QUAT_SCALE - PL_ANIMATION_QUAT_RANGE;
+            tValue.d[k] = fComponent;
+            fSumSq += fComponent * fComponent;
         }
+        tValue.d[iDropped] = sqrtf(pl_maxf(0.0f, 1.0f - fSumSq));
+        return tValue;
+    }
+
+    tValue.x = ptData->tRangeMin.x + (float)auKey[0] * ptData->tRangeScale.x;
+    tValue.y = ptData->tRangeMin.y + (float)auKey[1] * ptData->tRangeScale.y;
+    tValue.z = ptData->tRangeMin.z + (float)auKey[2] * ptData->tRangeScale.z;
+    return tValue;
+}
 
-        if(ptAnimationComponent->fTimer > ptAnimationComponent->fEnd)
+static void
+pl__animation_sample_track(const plAnimationDataComponent* ptData, plAnimationPath tPath, plAnimationMode tMode, float fTime, uint32_t* puCursor, plVec4* ptValueOut)
+{
+    if(ptData->tFlags & PL_ANIMATION_DATA_FLAG_CONSTANT)
+    {
+        *ptValueOut = ptData->tRangeMin;
+        return;
+    }
+
+    // wrap t around, so the animation loops.
+    // make sure that t is never earlier than the first keyframe and never later then the last keyframe.
+    const float fModTime = pl_clampf(ptData->afKeyFrameTimes[0], fTime, ptData->afKeyFrameTimes[ptData->uKeyFrameCount - 1]);
+
+    const uint32_t uKey = pl__animation_find_key(ptData->afKeyFrameTimes, ptData->uKeyFrameCount, fModTime, puCursor);
+    const int iNextKey = uKey < ptData->uKeyFrameCount ? pl_clampi(1, uKey, ptData->uKeyFrameCount - 1) : 0;
+    const int iPrevKey = pl_clampi(0, iNextKey - 1, ptData->uKeyFrameCount - 1);
+
+    const float fKeyDelta = ptData->afKeyFrameTimes[iNextKey] - ptData->afKeyFrameTimes[iPrevKey];
+
+    // normalize t: [t0, t1] -> [0, 1]
+    const float fTn = (fModTime - ptData->afKeyFrameTimes[iPrevKey]) / fKeyDelta;
+
+    const int iStride = tPath == PL_ANIMATION_PATH_ROTATION ? 4 : 3;
+
+    if(tMode == PL_ANIMATION_MODE_LINEAR)
+    {
+        const plVec4 tPrev = pl__animation_decode_key(ptData, iPrevKey, iStride);
+        const plVec4 tNext = pl__animation_decode_key(ptData, iNextKey, iStride);
+        if(tPath == PL_ANIMATION_PATH_ROTATION)
+            *ptValueOut = pl_quat_slerp(tPrev, tNext, fTn);
+        else
         {
-            ptAnimationComponent->tFlags &= ~PL_ANIMATION_FLAG_PLAYING;
-            ptAnimationComponent->fTimer = 0.0f;
+            for(int k = 0; k < 3; k++)
+                ptValueOut->d[k] = tPrev.d[k] * (1.0f - fTn) + tNext.d[k] * fTn;
+        }
+    }
+
+    else if(tMode == PL_ANIMATION_MODE_STEP)
+    {
+        *ptValueOut = pl__animation_decode_key(ptData, iPrevKey, iStride);
+    }
+
+    else if(tMode == PL_ANIMATION_MODE_CUBIC_SPLINE) // never compressed
+    {
+        const float fTSq = fTn * fTn;
+        const float fTCub = fTSq * fTn;
+
+        // keyframes store (in tangent, value, out tangent)
+        const float* afKeyFrameData = (const float*)ptData->pKeyFrameData;
+        const int iPrevIndex = iPrevKey * iStride * 3;
+        const int iNextIndex = iNextKey * iStride * 3;
+        const int iA = 0;
+        const int iV = 1 * iStride;
+        const int iB = 2 * iStride;
+
+        for(int k = 0; k < iStride; k++)
+        {
+            const float v0 = afKeyFrameData[iPrevIndex + k + iV];
+            const float a = fKeyDelta * afKeyFrameData[iNextIndex + k + iA];
+            const float b = fKeyDelta * afKeyFrameData[iPrevIndex + k + iB];
+            const float v1 = afKeyFrameData[iNextIndex + k + iV];
+            ptValueOut->d[k] = ((2 * fTCub - 3 * fTSq + 1) * v0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * v1) + ((fTCub - fTSq) * a);
+        }
+    }
+}
+
+static void
+pl__animation_sample(plComponentLibrary* ptLibrary, plAnimationComponent* ptAnimationComponent, float fDeltaTime)
+{
+    if(!(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_PLAYING))
+        return;
+
+    ptAnimationComponent->fTimer += fDeltaTime * ptAnimationComponent->fSpeed;
+
+    if(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_LOOPED)
+    {
+        ptAnimationComponent->fTimer = fmodf(ptAnimationComponent->fTimer, ptAnimationComponent->fEnd);
+    }
+
+    if(ptAnimationComponent->fTimer > ptAnimationComponent->fEnd)
+    {
+        ptAnimationComponent->tFlags &= ~PL_ANIMATION_FLAG_PLAYING;
+        ptAnimationComponent->fTimer = 0.0f;
+        return;
+    }
+
+    plAnimationDataComponent* ptDataComponents = NULL;
+    const plEntity* ptDataEntities = NULL;
+    const plEntity* ptTransformEntities = NULL;
+    const uint32_t uDataCount = gptECS->get_components(ptLibrary, gptAnimationCtx->tAnimationDataComponentType, (void**)&ptDataComponents, &ptDataEntities);
+    const uint32_t uTransformCount = gptECS->get_components(ptLibrary, gptAnimationCtx->tTransformComponentType, NULL, &ptTransformEntities);
+
+    for(uint32_t j = 0; j < ptAnimationComponent->uChannelCount; j++)
+    {
+        const plAnimationChannel* ptChannel = &ptAnimationComponent->atChannels[j];
+        const plAnimationSampler* ptSampler = &ptAnimationComponent->atSamplers[ptChannel->uSamplerIndex];
+
+        const uint32_t uTargetIndex = pl__animation_resolve_index(ptLibrary, gptAnimationCtx->tTransformComponentType, ptTransformEntities, uTransformCount, ptChannel->tTarget, &ptAnimationComponent->_auTargetIndices[j]);
+        const uint32_t uDataIndex = pl__animation_resolve_index(ptLibrary, gptAnimationCtx->tAnimationDataComponentType, ptDataEntities, uDataCount, ptSampler->tData, &ptAnimationComponent->_auDataIndices[j]);
+        if(uTargetIndex == UINT32_MAX || uDataIndex == UINT32_MAX)
+        {
+            ptAnimationComponent->_auTargetIndices[j] = UINT32_MAX; // skipped when applying
             continue;
         }
+        const plAnimationDataComponent* ptData = &ptDataComponents[uDataIndex];
 
-        for(uint32_t j = 0; j < ptAnimationComponent->uChannelCount; j++)
+        pl__animation_sample_track(ptData, ptChannel->tPath, ptSampler->tMode, ptAnimationComponent->fTimer, &ptAnimationComponent->_auKeyCursors[j], &ptAnimationComponent->_atSampledValues[j]);
+    }
+}
+
+static void
+pl__animation_sample_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plAnimationJobData* ptJobData = pData;
+    pl__animation_sample(ptJobData->ptLibrary, &ptJobData->ptComponents[tInvoData.uGlobalIndex], ptJobData->fDeltaTime);
+}
+
+static bool
+pl__animation_keys_match(plVec4 tA, plVec4 tB, int iStride, float fMaxError)
+{
+    // q & -q are the same rotation
+    if(iStride == 4 && pl_dot_vec4(tA, tB) < 0.0f)
+        tB = pl_mul_vec4_scalarf(tB, -1.0f);
+
+    for(int k = 0; k < iStride; k++)
+    {
+        if(fabsf(tA.d[k] - tB.d[k]) > fMaxError)
+            return false;
+    }
+    return true;
+}
+
+static bool
+pl__animation_segment_within_error(const plVec4* atValues, const float* afTimes, uint32_t uStart, uint32_t uEnd, int iStride, float fMaxError)
+{
+    // can keys between start & end be dropped (linear interpolation)
+    const float fDuration = afTimes[uEnd] - afTimes[uStart];
+    if(fDuration <= 0.0f)
+        return false;
+
+    for(uint32_t i = uStart + 1; i < uEnd; i++)
+    {
+        const float fT = (afTimes[i] - afTimes[uStart]) / fDuration;
+        plVec4 tApprox = {0};
+        if(iStride == 4)
+            tApprox = pl_quat_slerp(atValues[uStart], atValues[uEnd], fT);
+        else
         {
-            
-            const plAnimationChannel* ptChannel = &ptAnimationComponent->atChannels[j];
-            const plAnimationSampler* ptSampler = &ptAnimationComponent->atSamplers[ptChannel->uSamplerIndex];
-            const plAnimationDataComponent* ptData = gptECS->get_component(ptLibrary, gptAnimationCtx->tAnimationDataComponentType, ptSampler->tData);
-            plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, gptAnimationCtx->tTransformComponentType, ptChannel->tTarget);
-            ptTransform->eFlags |= PL_TRANSFORM_FLAGS_DIRTY;
+            for(int k = 0; k < 3; k++)
+                tApprox.d[k] = atValues[uStart].d[k] * (1.0f - fT) + atValues[uEnd].d[k] * fT;
+        }
+        if(!pl__animation_keys_match(tApprox, atValues[i], iStride, fMaxError))
+            return false;
+    }
+    return true;
+}
 
-            // wrap t around, so the animation loops.
-            // make sure that t is never earlier than the first keyframe and never later then the last keyframe.
-            const float fModTime = pl_clampf(ptData->afKeyFrameTimes[0], ptAnimationComponent->fTimer, ptData->afKeyFrameTimes[ptData->uKeyFrameCount - 1]);
-            int iNextKey = 0;
+static void
+pl__animation_compress_track(plAnimationDataComponent* ptData, plAnimationPath tPath, plAnimationMode tMode, float fMaxError)
+{
+    if(ptData->tFlags & (PL_ANIMATION_DATA_FLAG_COMPRESSED | PL_ANIMATION_DATA_FLAG_CONSTANT))
+        return;
+
+    if(tMode != PL_ANIMATION_MODE_LINEAR && tMode != PL_ANIMATION_MODE_STEP)
+        return;
 
-            for(uint32_t k = 0; k < ptData->uKeyFrameCount; k++)
+    if(tPath != PL_ANIMATION_PATH_TRANSLATION && tPath != PL_ANIMATION_PATH_ROTATION && tPath != PL_ANIMATION_PATH_SCALE)
+        return;
+
+    const int iStride = tPath == PL_ANIMATION_PATH_ROTATION ? 4 : 3;
+    const uint32_t uKeyFrameCount = ptData->uKeyFrameCount;
+    if(uKeyFrameCount == 0 || ptData->szDataSize != sizeof(float) * iStride * uKeyFrameCount)
+        return;
+
+    plVec4* atValues = PL_ALLOC(sizeof(plVec4) * uKeyFrameCount);
+    uint32_t* auKeptKeys = PL_ALLOC(sizeof(uint32_t) * uKeyFrameCount);
+    for(uint32_t i = 0; i < uKeyFrameCount; i++)
+    {
+        atValues[i] = pl__animation_decode_key(ptData, (int)i, iStride);
+        if(iStride == 4)
+            atValues[i] = pl_norm_vec4(atValues[i]);
+    }
+
+    // half the error budget goes to key reduction, the rest to quantization
+    const float fReductionError = fMaxError * 0.5f;
+
+    // constant track elimination
+    bool bConstant = true;
+    for(uint32_t i = 1; i < uKeyFrameCount; i++)
+    {
+        if(!pl__animation_keys_match(atValues[0], atValues[i], iStride, fMaxError))
+        {
+            bConstant = false;
+            break;
+        }
+    }
+
+    uint32_t uKeptCount = 0;
+    if(bConstant)
+        auKeptKeys[uKeptCount++] = 0;
+    else if(tMode == PL_ANIMATION_MODE_STEP)
+    {
+        // only keys that change the held value
+        auKeptKeys[uKeptCount++] = 0;
+        for(uint32_t i = 1; i < uKeyFrameCount - 1; i++)
+        {
+            if(!pl__animation_keys_match(atValues[auKeptKeys[uKeptCount - 1]], atValues[i], iStride, fReductionError))
+                auKeptKeys[uKeptCount++] = i;
+        }
+        auKeptKeys[uKeptCount++] = uKeyFrameCount - 1;
+    }
+    else
+    {
+        // greedily extend each segment while dropped keys stay within error
+        uint32_t uAnchor = 0;
+        auKeptKeys[uKeptCount++] = 0;
+        for(uint32_t uEnd = 2; uEnd < uKeyFrameCount; uEnd++)
+        {
+            if(!pl__animation_segment_within_error(atValues, ptData->afKeyFrameTimes, uAnchor, uEnd, iStride, fReductionError))
             {
-                
-                if(fModTime <= ptData->afKeyFrameTimes[k])
-                {
-                    iNextKey = pl_clampi(1, k, ptData->uKeyFrameCount - 1);
-                    break;
-                }
+                uAnchor = uEnd - 1;
+                auKeptKeys[uKeptCount++] = uAnchor;
+            }
+        }
+        if(uKeyFrameCount > 1)
+            auKeptKeys[uKeptCount++] = uKeyFrameCount - 1;
+    }
+
+    plAnimationDataFlags tFlags = iStride == 4 ? PL_ANIMATION_DATA_FLAG_QUATERNION : PL_ANIMATION_DATA_FLAG_NONE;
+    plVec4 tRangeMin = atValues[0];
+    plVec4 tRangeScale = {0};
+
+    // quantization must stay within the remaining error budget (max error is
+    // half a step, or ~1.5 steps for the rebuilt quaternion component),
+    // otherwise the reduced keys are kept as floats
+    const float fQuantizationError = fMaxError - fReductionError;
+    bool bQuantize = !bConstant;
+    if(bQuantize && iStride == 4)
+        bQuantize = 1.5f * PL_ANIMATION_QUAT_SCALE <= fQuantizationError;
+    else if(bQuantize)
+    {
+        plVec4 tRangeMax = tRangeMin;
+        for(uint32_t i = 1; i < uKeptCount; i++)
+        {
+            tRangeMin = pl_min_vec4(tRangeMin, atValues[auKeptKeys[i]]);
+            tRangeMax = pl_max_vec4(tRangeMax, atValues[auKeptKeys[i]]);
+        }
+        for(int k = 0; k < 3; k++)
+        {
+            tRangeScale.d[k] = (tRangeMax.d[k] - tRangeMin.d[k]) / 65535.0f;
+            if(0.5f * tRangeScale.d[k] > fQuantizationError)
+                bQuantize = false;
+        }
+        if(!bQuantize)
+        {
+            tRangeMin = atValues[0];
+            tRangeScale = (plVec4){0};
+        }
+    }
+
+    // times & keys share one allocation (like create_data)
+    size_t szDataSize = 0;
+    if(bQuantize)
+        szDataSize = sizeof(uint16_t) * 3 * uKeptCount;
+    else if(!bConstant)
+        szDataSize = sizeof(float) * iStride * uKeptCount;
+    float* afKeyFrameTimes = PL_ALLOC(sizeof(float) * uKeptCount + szDataSize);
+    void* pKeyFrameData = &afKeyFrameTimes[uKeptCount];
+    for(uint32_t i = 0; i < uKeptCount; i++)
+        afKeyFrameTimes[i] = ptData->afKeyFrameTimes[auKeptKeys[i]];
+
+    if(bConstant)
+    {
+        tFlags |= PL_ANIMATION_DATA_FLAG_CONSTANT;
+        pKeyFrameData = NULL;
+    }
+    else if(!bQuantize)
+    {
+        tFlags = PL_ANIMATION_DATA_FLAG_NONE;
+        float* afKeyFrameData = pKeyFrameData;
+        for(uint32_t i = 0; i < uKeptCount; i++)
+            memcpy(&afKeyFrameData[i * iStride], atValues[auKeptKeys[i]].d, sizeof(float) * iStride);
+    }
+    else if(iStride == 4)
+    {
+        tFlags |= PL_ANIMATION_DATA_FLAG_COMPRESSED;
+        uint16_t* auKeyFrameData = pKeyFrameData;
+        for(uint32_t i = 0; i < uKeptCount; i++)
+        {
+            plVec4 tQuat = atValues[auKeptKeys[i]];
+
+            // drop the largest component (made positive so it can be rebuilt)
+            int iDropped = 0;
+            for(int k = 1; k < 4; k++)
+            {
+                if(fabsf(tQuat.d[k]) > fabsf(tQuat.d[iDropped]))
+                    iDropped = k;
             }
-            const int iPrevKey = pl_clampi(0, iNextKey - 1, ptData->uKeyFrameCount - 1);
+            if(tQuat.d[iDropped] < 0.0f)
+                tQuat = pl_mul_vec4_scalarf(tQuat, -1.0f);
+
+            uint16_t* auKey = &auKeyFrameData[i * 3];
+            int iComponent = 0;
+            for(int k = 0; k < 4; k++)
+            {
+                if(k == iDropped)
+                    continue;
+                const float fNormalized = (pl_clampf(-PL_ANIMATION_QUAT_RANGE, tQuat.d[k], PL_ANIMATION_QUAT_RANGE) + PL_ANIMATION_QUAT_RANGE) / PL_ANIMATION_QUAT_SCALE;
+                auKey[iComponent++] = (uint16_t)((uint32_t)(fNormalized + 0.5f) << 1);
+            }
+            auKey[0] |= (uint16_t)(iDropped & 1);
+            auKey[1] |= (uint16_t)(iDropped >> 1);
+        }
+    }
+    else
+    {
+        // per track range quantization
+        tFlags |= PL_ANIMATION_DATA_FLAG_COMPRESSED;
+        uint16_t* auKeyFrameData = pKeyFrameData;
+        for(uint32_t i = 0; i < uKeptCount; i++)
+        {
+            for(int k = 0; k < 3; k++)
+            {
+                const float fNormalized = tRangeScale.d[k] > 0.0f ? (atValues[auKeptKeys[i]].d[k] - tRangeMin.d[k]) / tRangeScale.d[k] : 0.0f;
+                auKeyFrameData[i * 3 + k] = (uint16_t)pl_clampf(0.0f, fNormalized + 0.5f, 65535.0f);
+            }
+        }
+    }
+
+    PL_FREE(ptData->afKeyFrameTimes);
+    ptData->afKeyFrameTimes = afKeyFrameTimes;
+    ptData->pKeyFrameData = pKeyFrameData;
+    ptData->uKeyFrameCount = uKeptCount;
+    ptData->szDataSize = szDataSize;
+    ptData->tFlags = tFlags;
+    ptData->tRangeMin = tRangeMin;
+    ptData->tRangeScale = tRangeScale;
+
+    PL_FREE(atValues);
+    PL_FREE(auKeptKeys);
+}
+
+void
+pl_animation_compress(plComponentLibrary* ptLibrary, plEntity tAnimation, const plAnimationCompressInfo* ptInfo)
+{
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, __FUNCTION__);
+
+    plAnimationCompressInfo tInfo = {
+        .fMaxTranslationError = 0.001f,
+        .fMaxRotationError    = 0.0005f,
+        .fMaxScaleError       = 0.001f
+    };
+    if(ptInfo)
+    {
+        if(ptInfo->fMaxTranslationError > 0.0f) tInfo.fMaxTranslationError = ptInfo->fMaxTranslationError;
+        if(ptInfo->fMaxRotationError > 0.0f)    tInfo.fMaxRotationError    = ptInfo->fMaxRotationError;
+        if(ptInfo->fMaxScaleError > 0.0f)       tInfo.fMaxScaleError       = ptInfo->fMaxScaleError;
+    }
+
+    plAnimationComponent* ptAnimationComponent = gptECS->get_component(ptLibrary, gptAnimationCtx->tAnimationComponentType, tAnimation);
+    if(ptAnimationComponent == NULL)
+    {
+        PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
+        return;
+    }
+
+    size_t szOriginalSize = 0;
+    size_t szCompressedSize = 0;
+    for(uint32_t i = 0; i < ptAnimationComponent->uChannelCount; i++)
+    {
+        const plAnimationChannel* ptChannel = &ptAnimationComponent->atChannels[i];
+        const plAnimationSampler* ptSampler = &ptAnimationComponent->atSamplers[ptChannel->uSamplerIndex];
+        plAnimationDataComponent* ptData = gptECS->get_component(ptLibrary, gptAnimationCtx->tAnimationDataComponentType, ptSampler->tData);
+        if(ptData == NULL)
+            continue;
+
+        float fMaxError = tInfo.fMaxTranslationError;
+        if(ptChannel->tPath == PL_ANIMATION_PATH_ROTATION)   fMaxError = tInfo.fMaxRotationError;
+        else if(ptChannel->tPath == PL_ANIMATION_PATH_SCALE) fMaxError = tInfo.fMaxScaleError;
+
+        szOriginalSize += sizeof(float) * ptData->uKeyFrameCount + ptData->szDataSize;
+        pl__animation_compress_track(ptData, ptChannel->tPath, ptSampler->tMode, fMaxError);
+        szCompressedSize += sizeof(float) * ptData->uKeyFrameCount + ptData->szDataSize;
+    }
+
+    PL_LOG_DEBUG_API_F(gptLog, gptECS->get_log_channel(), "compressed animation data: %zu -> %zu bytes", szOriginalSize, szCompressedSize);
+    PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
+}
+
+void
+pl_animation_run_animation_update_system(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, __FUNCTION__);
+
+    plAnimationComponent* ptComponents = NULL;
+    const uint32_t uComponentCount = gptECS->get_components(ptLibrary, gptAnimationCtx->tAnimationComponentType, (void**)&ptComponents, NULL);
 
-            const float fKeyDelta = ptData->afKeyFrameTimes[iNextKey] - ptData->afKeyFrameTimes[iPrevKey];
+    // sample channels (components only write their own state)
+    if(gptJob && !gptJob->is_shutting_down() && uComponentCount >= PL_ANIMATION_PARALLEL_THRESHOLD)
+    {
+        plAnimationJobData tJobData = {
+            .ptLibrary    = ptLibrary,
+            .ptComponents = ptComponents,
+            .fDeltaTime   = fDeltaTime
+        };
+        plJobDesc tJobDesc = {
+            .task  = pl__animation_sample_job,
+            .pData = &tJobData
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(uComponentCount, 0, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < uComponentCount; i++)
+            pl__animation_sample(ptLibrary, &ptComponents[i], fDeltaTime);
+    }
+
+    // apply in component order since animations may blend onto the same target
+    plTransformComponent* ptTransforms = NULL;
+    gptECS->get_components(ptLibrary, gptAnimationCtx->tTransformComponentType, (void**)&ptTransforms, NULL);
 
-            // normalize t: [t0, t1] -> [0, 1]
-            const float fTn = (fModTime - ptData->afKeyFrameTimes[iPrevKey]) / fKeyDelta;
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        const plAnimationComponent* ptAnimationComponent = &ptComponents[i];
 
-            const float fTSq = fTn * fTn;
-            const float fTCub = fTSq * fTn;
+        if(!(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_PLAYING))
+            continue;
 
-            const int iA = 0;
+        const float fBlendAmount = ptAnimationComponent->fBlendAmount;
 
-            float* afKeyFrameData = (float*)ptData->pKeyFrameData;
+        for(uint32_t j = 0; j < ptAnimationComponent->uChannelCount; j++)
+        {
+            const uint32_t uTargetIndex = ptAnimationComponent->_auTargetIndices[j];
+            if(uTargetIndex == UINT32_MAX)
+                continue;
+
+            const plAnimationChannel* ptChannel = &ptAnimationComponent->atChannels[j];
+            const plAnimationMode tMode = ptAnimationComponent->atSamplers[ptChannel->uSamplerIndex].tMode;
+            const plVec4 tValue = ptAnimationComponent->_atSampledValues[j];
+
+            plTransformComponent* ptTransform = &ptTransforms[uTargetIndex];
+            ptTransform->eFlags |= PL_TRANSFORM_FLAGS_DIRTY;
+
+            if(tMode != PL_ANIMATION_MODE_LINEAR && tMode != PL_ANIMATION_MODE_STEP && tMode != PL_ANIMATION_MODE_CUBIC_SPLINE)
+                continue;
 
             switch(ptChannel->tPath)
             {
                 case PL_ANIMATION_PATH_TRANSLATION:
-                {
-
-                    if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
-                    {
-                        const plVec3 tPrev = *(plVec3*)&afKeyFrameData[iPrevKey * 3];
-                        const plVec3 tNext = *(plVec3*)&afKeyFrameData[iNextKey * 3];
-                        const plVec3 tTranslation = (plVec3){
-                            .x = tPrev.x * (1.0f - fTn) + tNext.x * fTn,
-                            .y = tPrev.y * (1.0f - fTn) + tNext.y * fTn,
-                            .z = tPrev.z * (1.0f - fTn) + tNext.z * fTn,
-                        };
-                        ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tTranslation, ptAnimationComponent->fBlendAmount);
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
-                    {
-                        const plVec3 tTranslation = *(plVec3*)&afKeyFrameData[iPrevKey * 3];
-                        ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tTranslation, ptAnimationComponent->fBlendAmount);
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
-                    {
-                        const int iPrevIndex = iPrevKey * 3 * 3;
-                        const int iNextIndex = iNextKey * 3 * 3;
-                        const int iV = 1 * 3;
-                        const int iB = 2 * 3;
-
-                        plVec3 tTranslation = {0};
-                        for(uint32_t k = 0; k < 3; k++)
-                        {
-                            const float iV0 = afKeyFrameData[iPrevIndex + k + iV];
-                            const float a = fKeyDelta * afKeyFrameData[iNextIndex + k + iA];
-                            const float b = fKeyDelta * afKeyFrameData[iPrevIndex + k + iB];
-                            const float v1 = afKeyFrameData[iNextIndex + k + iV];
-                            tTranslation.d[k] = ((2 * fTCub - 3 * fTSq + 1) * iV0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * v1) + ((fTCub - fTSq) * a);
-                        }
-                        ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tTranslation, ptAnimationComponent->fBlendAmount);
-                    }
+                    ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tValue.xyz, fBlendAmount);
                     break;
-                }
 
                 case PL_ANIMATION_PATH_SCALE:
-                {
-
-                    if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
-                    {
-                        const plVec3 tPrev = *(plVec3*)&afKeyFrameData[iPrevKey * 3];
-                        const plVec3 tNext = *(plVec3*)&afKeyFrameData[iNextKey * 3];
-                        ptTransform->tScale = (plVec3){
-                            .x = tPrev.x * (1.0f - fTn) + tNext.x * fTn,
-                            .y = tPrev.y * (1.0f - fTn) + tNext.y * fTn,
-                            .z = tPrev.z * (1.0f - fTn) + tNext.z * fTn,
-                        };
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
-                    {
-                        ptTransform->tScale = *(plVec3*)&afKeyFrameData[iPrevKey * 3];
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
-                    {
-                        const int iPrevIndex = iPrevKey * 3 * 3;
-                        const int iNextIndex = iNextKey * 3 * 3;
-                        const int iV = 1 * 3;
-                        const int iB = 2 * 3;
-
-                        for(uint32_t k = 0; k < 3; k++)
-                        {
-                            float v0 = afKeyFrameData[iPrevIndex + k + iV];
-                            float a = fKeyDelta * afKeyFrameData[iNextIndex + k + iA];
-                            float b = fKeyDelta * afKeyFrameData[iPrevIndex + k + iB];
-                            float v1 = afKeyFrameData[iNextIndex + k + iV];
-                            ptTransform->tScale.d[k] = ((2 * fTCub - 3 * fTSq + 1) * v0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * v1) + ((fTCub - fTSq) * a);
-                        }
-                    }
+                    ptTransform->tScale = tValue.xyz;
                     break;
-                }
 
                 case PL_ANIMATION_PATH_ROTATION:
-                {
-
-                    if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
-                    {
-                        const plVec4 tQ0 = *(plVec4*)&afKeyFrameData[iPrevKey * 4];
-                        const plVec4 tQ1 = *(plVec4*)&afKeyFrameData[iNextKey * 4];
-                        const plVec4 tRotation = pl_quat_slerp(tQ0, tQ1, fTn);
-                        ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tRotation, ptAnimationComponent->fBlendAmount);
-                    }
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
-                    {
-                        const plVec4 tRotation = *(plVec4*)&afKeyFrameData[iPrevKey * 4];
-                        ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tRotation, ptAnimationComponent->fBlendAmount);
-                    }
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
-                    {
-                        const int iPrevIndex = iPrevKey * 4 * 3;
-                        const int iNextIndex = iNextKey * 4 * 3;
-                        const int iV = 1 * 4;
-                        const int iB = 2 * 4;
-
-                        plVec4 tResult = {0};
-                        for(uint32_t k = 0; k < 4; k++)
-                        {
-                            const float iV0 = afKeyFrameData[iPrevIndex + k + iV];
-                            const float a = fKeyDelta * afKeyFrameData[iNextIndex + k + iA];
-                            const float b = fKeyDelta * afKeyFrameData[iPrevIndex + k + iB];
-                            const float iV1 = afKeyFrameData[iNextIndex + k + iV];
-
-                            tResult.d[k] = ((2 * fTCub - 3 * fTSq + 1) * iV0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * iV1) + ((fTCub - fTSq) * a);
-                        }
-                        ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tResult, ptAnimationComponent->fBlendAmount);
-                    }
+                    ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tValue, fBlendAmount);
                     break;
-                }
             }
         }
     }
@@ -620,6 +1024,7 @@ pl_load_animation_ext(plApiRegistryI* ptApiRegistry, bool bReload)
         .register_ecs_system                  = pl_animation_register_ecs_system,
         .create                               = pl_animation_create,
         .create_data                          = pl_animation_create_data,
+        .compress                             = pl_animation_compress,
         .run_animation_update_system          = pl_animation_run_animation_update_system,
         .run_inverse_kinematics_update_system = pl_animation_run_inverse_kinematics_update_system,
         .get_ecs_type_key_animation           = pl_animation_get_ecs_type_key_animation,
@@ -632,6 +1037,7 @@ pl_load_animation_ext(plApiRegistryI* ptApiRegistry, bool bReload)
     gptApiRegistry = ptApiRegistry;
     gptExtensionRegistry = pl_get_api_latest(ptApiRegistry, plExtensionRegistryI);
     gptECS = pl_get_api_latest(ptApiRegistry, plEcsI);
+    gptJob = pl_get_api_latest(ptApiRegistry, plJobI);
     gptMemory = pl_get_api_latest(ptApiRegistry, plMemoryI);
     gptProfile = pl_get_api_latest(ptApiRegistry, plProfileI);
     gptLog = pl_get_api_latest(ptApiRegistry, plLogI);
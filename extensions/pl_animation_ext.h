@@ -30,6 +30,26 @@ Index of this file:
         * plEcsI     (v1.x)
         * plProfileI (v1.x)
         * plLogI     (v1.x)
+        * plJobI     (v3.x) (many playing animations; serial if not initialized)
+
+    Animation Update:
+        Channel targets & animation data are resolved to dense ECS indices the
+        first time an animation is evaluated and only looked up again if the
+        component storage moved. Each channel keeps a keyframe cursor so
+        playback advances in O(1) (binary search when seeking/looping).
+        Sampling runs in parallel across animation components; results are
+        applied to transforms afterwards in component order, so blending
+        multiple animations onto the same target is deterministic.
+
+    Compression:
+        "compress" converts the linear & step tracks of an animation in place
+        (cubic spline tracks are left as is). Constant tracks are reduced to a
+        single value, keys that can be reconstructed within the error bounds
+        are removed, vec3 tracks are quantized to 16 bits over their range &
+        quaternions are stored as "smallest three" (3 x 15 bits, the dropped
+        component's index in the low bit of the first two words). Tracks whose
+        quantization step would exceed the error bound keep float keys.
+        Keyframe times stay full precision.
 */
 
 //-----------------------------------------------------------------------------
@@ -47,7 +67,7 @@ extern "C" {
 // [SECTION] apis
 //-----------------------------------------------------------------------------
 
-#define plAnimationI_version {0, 1, 0}
+#define plAnimationI_version {0, 2, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] defines
@@ -65,6 +85,7 @@ extern "C" {
 #include <stddef.h>       // size_t
 #include <stdbool.h>      // bool
 #include "pl_ecs_ext.inl" // plEntity
+#include "pl_math.h"      // plVec4
 
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations & basic types
@@ -73,6 +94,7 @@ extern "C" {
 // basic types
 typedef struct _plAnimationChannel plAnimationChannel;
 typedef struct _plAnimationSampler plAnimationSampler;
+typedef struct _plAnimationCompressInfo plAnimationCompressInfo;
 
 // ecs components
 typedef struct _plAnimationComponent         plAnimationComponent;
@@ -84,6 +106,7 @@ typedef struct _plHumanoidComponent          plHumanoidComponent;
 typedef int plAnimationMode;
 typedef int plAnimationPath;
 typedef int plAnimationFlags;
+typedef int plAnimationDataFlags;
 typedef int plHumanoidBone;
 
 // external
@@ -106,6 +129,9 @@ PL_API void         pl_animation_register_ecs_system(void);
 PL_API plEntity     pl_animation_create     (plComponentLibrary*, const char* name, uint32_t channelCount, plAnimationComponent**);
 PL_API plEntity     pl_animation_create_data(plComponentLibrary*, const char* name, uint32_t keyFrameCount, size_t dataSize, plAnimationDataComponent**);
 
+// offline compression (info may be NULL for defaults)
+PL_API void         pl_animation_compress(plComponentLibrary*, plEntity animation, const plAnimationCompressInfo*);
+
 // systems
 PL_API void         pl_animation_run_animation_update_system         (plComponentLibrary*, float deltaTime);
 PL_API void         pl_animation_run_inverse_kinematics_update_system(plComponentLibrary*);
@@ -131,6 +157,9 @@ typedef struct _plAnimationI
     plEntity (*create)     (plComponentLibrary*, const char* name, uint32_t channelCount, plAnimationComponent**);
     plEntity (*create_data)(plComponentLibrary*, const char* name, uint32_t keyFrameCount, size_t dataSize, plAnimationDataComponent**);
 
+    // offline compression (info may be NULL for defaults)
+    void (*compress)(plComponentLibrary*, plEntity animation, const plAnimationCompressInfo*);
+
     // systems
     void (*run_animation_update_system)         (plComponentLibrary*, float fDeltaTime);
     void (*run_inverse_kinematics_update_system)(plComponentLibrary*);
@@ -171,6 +200,14 @@ enum _plAnimationFlags
     PL_ANIMATION_FLAG_LOOPED  = 1 << 1
 };
 
+enum _plAnimationDataFlags
+{
+    PL_ANIMATION_DATA_FLAG_NONE       = 0,
+    PL_ANIMATION_DATA_FLAG_COMPRESSED = 1 << 0, // pKeyFrameData holds 3 x uint16_t per key
+    PL_ANIMATION_DATA_FLAG_CONSTANT   = 1 << 1, // value stored in tRangeMin (no key data)
+    PL_ANIMATION_DATA_FLAG_QUATERNION = 1 << 2, // keys are "smallest three" encoded
+};
+
 enum _plHumanoidBone
 {
     // torso
@@ -251,6 +288,13 @@ typedef struct _plAnimationSampler
     plEntity        tData;
 } plAnimationSampler;
 
+typedef struct _plAnimationCompressInfo
+{
+    float fMaxTranslationError; // default: 0.001
+    float fMaxRotationError;    // per quaternion component (default: 0.0005)
+    float fMaxScaleError;       // default: 0.001
+} plAnimationCompressInfo;
+
 typedef struct _plAnimationChannel
 {
     plAnimationPath tPath;
@@ -269,10 +313,13 @@ typedef struct _plHumanoidComponent
 
 typedef struct _plAnimationDataComponent
 {
-    uint32_t uKeyFrameCount;
-    size_t   szDataSize;
-    float*   afKeyFrameTimes;
-    void*    pKeyFrameData;
+    uint32_t             uKeyFrameCount;
+    size_t               szDataSize;
+    float*               afKeyFrameTimes;
+    void*                pKeyFrameData;
+    plAnimationDataFlags tFlags;
+    plVec4               tRangeMin;   // compressed: value = tRangeMin + key * tRangeScale
+    plVec4               tRangeScale;
 } plAnimationDataComponent;
 
 typedef struct _plAnimationComponent
@@ -286,6 +333,12 @@ typedef struct _plAnimationComponent
     uint32_t            uChannelCount;
     plAnimationChannel* atChannels;
     plAnimationSampler* atSamplers;
+
+    // [INTERNAL] (per channel, allocated with atChannels)
+    plVec4*   _atSampledValues;
+    uint32_t* _auTargetIndices; // dense transform index (cached)
+    uint32_t* _auDataIndices;   // dense animation data index (cached)
+    uint32_t* _auKeyCursors;    // last next keyframe
 } plAnimationComponent;
 
 typedef struct _plInverseKinematicsComponent
@@ -5,7 +5,11 @@
 /*
 Index of this file:
 // [SECTION] includes
+// [SECTION] defines
+// [SECTION] internal structs
+// [SECTION] internal api
 // [SECTION] public api implementation
+// [SECTION] internal api implementation
 // [SECTION] extension loading
 */
 
@@ -14,12 +18,14 @@ Index of this file:
 //-----------------------------------------------------------------------------
 
 #include <math.h>
+#include <float.h>
 #include <string.h> // memset
 #include "pl.h"
 #include "pl_bvh_ext.h"
 
 // extensions
 #include "pl_collision_ext.h"
+#include "pl_job_ext.h"
 
 #define PL_MATH_INCLUDE_FUNCTIONS
 #include "pl_math.h"
@@ -39,128 +45,333 @@ Index of this file:
     #endif
 
     static const plCollisionI* gptCollision = NULL;
+    static const plJobI*       gptJob       = NULL;
 #endif
 
 #include "pl_ds.h"
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#ifndef PL_BVH_BIN_COUNT
+    #define PL_BVH_BIN_COUNT 16
+#endif
+
+// SAH may still create leaves up to this size if splitting isn't cheaper
+#ifndef PL_BVH_MAX_LEAF_SIZE
+    #define PL_BVH_MAX_LEAF_SIZE 4
+#endif
+
+// subtrees with at least this many primitives are built as jobs
+#ifndef PL_BVH_PARALLEL_THRESHOLD
+    #define PL_BVH_PARALLEL_THRESHOLD 4096
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal structs
+//-----------------------------------------------------------------------------
+
+// primitive data is partitioned directly (instead of indices) so each
+// level of the build streams through memory
+typedef struct _plBvhRef
+{
+    plAABB   tAABB;
+    plVec3   tCentroid;
+    uint32_t uIndex;
+} plBvhRef;
+
+typedef struct _plBvhBuildContext
+{
+    plBvhRef*       atRefs;
+    plBVHNode*      atNodes; // build layout: descendants of a node with n primitives own 2n - 2 nodes
+    plBVHBuildFlags tFlags;
+} plBvhBuildContext;
+
+typedef struct _plBvhBounds
+{
+    plAABB tAABB;
+    plAABB tCentroids;
+} plBvhBounds;
+
+typedef struct _plBvhSplit
+{
+    int      iAxis;     // -1 if centroids coincide (split in half)
+    float    fPosition; // split position or first bin position if binned
+    float    fScale;    // bins per unit if binned, 0 otherwise
+    uint32_t uBin;      // first bin on right side
+} plBvhSplit;
+
+typedef struct _plBvhBuildTask
+{
+    plBvhBuildContext* ptCtx;
+    uint32_t           uNode;
+    uint32_t           uChildNode;
+    uint32_t           uOffset;
+    uint32_t           uCount;
+    uint32_t           uDepth;
+    plBvhBounds        tBounds;
+} plBvhBuildTask;
+
+typedef struct _plBvhBin
+{
+    plAABB   tAABB;
+    uint32_t uCount;
+} plBvhBin;
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api
+//-----------------------------------------------------------------------------
+
+// building
+static void     pl__bvh_build_node    (plBvhBuildContext*, uint32_t uNode, uint32_t uChildNode, uint32_t uOffset, uint32_t uCount, uint32_t uDepth, const plBvhBounds*);
+static void     pl__bvh_compute_bounds(plBvhBuildContext*, uint32_t uOffset, uint32_t uCount, plBvhBounds* ptBoundsOut);
+static uint32_t pl__bvh_compact       (plBVH*, uint32_t uNode);
+
+// storage
+static void     pl__bvh_free              (plBVH*);
+static void     pl__bvh_reserve_nodes     (plBVH*, uint32_t uCount);
+static void     pl__bvh_reserve_leaves    (plBVH*, uint32_t uCount);
+static void     pl__bvh_reserve_primitives(plBVH*, uint32_t uCount);
+static uint32_t pl__bvh_alloc_node_pair   (plBVH*);
+static uint32_t pl__bvh_alloc_leaf_slot   (plBVH*);
+
+// updating
+static void     pl__bvh_refit_node     (plBVH*, const plAABB*, uint32_t uCount, uint32_t uNode);
+static uint32_t pl__bvh_find_sibling   (plBVH*, const plAABB*);
+static void     pl__bvh_link_node      (plBVH*, uint32_t uNode);
+static void     pl__bvh_refit_upwards  (plBVH*, uint32_t uNode);
+
+static inline plAABB
+pl__bvh_empty_aabb(void)
+{
+    return (plAABB){
+        .tMin = {FLT_MAX, FLT_MAX, FLT_MAX},
+        .tMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX}
+    };
+}
+
+static inline void
+pl__bvh_grow(plAABB* ptAABB, const plAABB* ptOther)
+{
+    if(ptOther->tMin.x < ptAABB->tMin.x) ptAABB->tMin.x = ptOther->tMin.x;
+    if(ptOther->tMin.y < ptAABB->tMin.y) ptAABB->tMin.y = ptOther->tMin.y;
+    if(ptOther->tMin.z < ptAABB->tMin.z) ptAABB->tMin.z = ptOther->tMin.z;
+    if(ptOther->tMax.x > ptAABB->tMax.x) ptAABB->tMax.x = ptOther->tMax.x;
+    if(ptOther->tMax.y > ptAABB->tMax.y) ptAABB->tMax.y = ptOther->tMax.y;
+    if(ptOther->tMax.z > ptAABB->tMax.z) ptAABB->tMax.z = ptOther->tMax.z;
+}
+
+static inline void
+pl__bvh_grow_point(plAABB* ptAABB, plVec3 tPoint)
+{
+    if(tPoint.x < ptAABB->tMin.x) ptAABB->tMin.x = tPoint.x;
+    if(tPoint.y < ptAABB->tMin.y) ptAABB->tMin.y = tPoint.y;
+    if(tPoint.z < ptAABB->tMin.z) ptAABB->tMin.z = tPoint.z;
+    if(tPoint.x > ptAABB->tMax.x) ptAABB->tMax.x = tPoint.x;
+    if(tPoint.y > ptAABB->tMax.y) ptAABB->tMax.y = tPoint.y;
+    if(tPoint.z > ptAABB->tMax.z) ptAABB->tMax.z = tPoint.z;
+}
+
+static inline float
+pl__bvh_half_area(const plAABB* ptAABB)
+{
+    const plVec3 tD = pl_sub_vec3(ptAABB->tMax, ptAABB->tMin);
+    return tD.x * tD.y + tD.y * tD.z + tD.z * tD.x;
+}
+
+static inline bool
+pl__bvh_ray_aabb(const plAABB* ptAABB, plVec3 tOrigin, plVec3 tInvDirection, float* pfNearOut)
+{
+    // slab test (fminf/fmaxf drop NaNs from 0 * inf)
+    const float fTx0 = (ptAABB->tMin.x - tOrigin.x) * tInvDirection.x;
+    const float fTx1 = (ptAABB->tMax.x - tOrigin.x) * tInvDirection.x;
+    const float fTy0 = (ptAABB->tMin.y - tOrigin.y) * tInvDirection.y;
+    const float fTy1 = (ptAABB->tMax.y - tOrigin.y) * tInvDirection.y;
+    const float fTz0 = (ptAABB->tMin.z - tOrigin.z) * tInvDirection.z;
+    const float fTz1 = (ptAABB->tMax.z - tOrigin.z) * tInvDirection.z;
+
+    float fNear = fmaxf(fmaxf(fminf(fTx0, fTx1), fminf(fTy0, fTy1)), fminf(fTz0, fTz1));
+    const float fFar = fminf(fminf(fmaxf(fTx0, fTx1), fmaxf(fTy0, fTy1)), fmaxf(fTz0, fTz1));
+
+    if(fNear < 0.0f)
+        fNear = 0.0f;
+    *pfNearOut = fNear;
+    return fNear <= fFar;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
 //-----------------------------------------------------------------------------
 
 void
-pl_bvh_update_node_bounds(plBVH* ptBvh, uint32_t uNodeIndex, const plAABB* ptAABBs)
+pl_bvh_build_ex(plBVH* ptBvh, const plAABB* ptAABBs, uint32_t uCount, plBVHBuildFlags tFlags)
 {
-    plBVHNode* ptNode = &ptBvh->_ptNodes[uNodeIndex];
-    ptNode->tAABB = (plAABB){0};
-    for(uint32_t i = 0; i < ptNode->_uCount; i++)
+    pl__bvh_free(ptBvh);
+    if(uCount == 0)
+        return;
+
+    pl__bvh_reserve_nodes(ptBvh, uCount * 2 - 1);
+    pl__bvh_reserve_leaves(ptBvh, uCount);
+    pl__bvh_reserve_primitives(ptBvh, uCount);
+    ptBvh->_uLeafCount = uCount;
+
+    plBvhRef* atRefs = PL_ALLOC(sizeof(plBvhRef) * uCount);
+    for(uint32_t i = 0; i < uCount; i++)
     {
-        uint32_t uOffset = ptNode->_uOffset + i;
-        uint32_t uIndex = ptBvh->_puLeafIndices[uOffset];
-        ptNode->tAABB = pl_aabb_merge(&ptNode->tAABB, &ptAABBs[uIndex]);
+        atRefs[i].tAABB = ptAABBs[i];
+        atRefs[i].tCentroid = pl_aabb_center(&ptAABBs[i]);
+        atRefs[i].uIndex = i;
     }
+
+    plBvhBuildContext tCtx = {
+        .atRefs  = atRefs,
+        .atNodes = ptBvh->_ptNodes,
+        .tFlags  = tFlags
+    };
+    plBvhBounds tBounds = {0};
+    pl__bvh_compute_bounds(&tCtx, 0, uCount, &tBounds);
+    pl__bvh_build_node(&tCtx, 0, 1, 0, uCount, 0, &tBounds);
+
+    for(uint32_t i = 0; i < uCount; i++)
+        ptBvh->_puLeafIndices[i] = atRefs[i].uIndex;
+    PL_FREE(atRefs);
+
+    // remove gaps left by the build layout (keeps depth first order) & fill
+    // in links needed for updating
+    ptBvh->_uNodeCount = 1;
+    ptBvh->_puNodeParents[0] = UINT32_MAX;
+    pl__bvh_compact(ptBvh, 0);
+}
+
+void
+pl_bvh_build(plBVH* ptBvh, const plAABB* ptAABBs, uint32_t uCount)
+{
+    pl_bvh_build_ex(ptBvh, ptAABBs, uCount, PL_BVH_BUILD_FLAGS_NONE);
 }
 
 void
-pl_bvh_subdivide(plBVH* ptBvh, uint32_t uNodeIndex, const plAABB* ptAABBs)
+pl_bvh_refit(plBVH* ptBvh, const plAABB* ptAABBs, uint32_t uCount)
 {
-    plBVHNode* ptNode = &ptBvh->_ptNodes[uNodeIndex];
-    if(ptNode->_uCount <= 2)
+    if(ptBvh->_uNodeCount == 0)
         return;
+    pl__bvh_refit_node(ptBvh, ptAABBs, uCount, 0);
+}
 
-    plVec3 tExtent = pl_aabb_half_width(&ptNode->tAABB);
-    plVec3 tMin = ptNode->tAABB.tMin;
-    int iAxis = 0;
-    if(tExtent.y > tExtent.x) iAxis = 1;
-    if(tExtent.z > tExtent.d[iAxis]) iAxis = 2;
+void
+pl_bvh_insert(plBVH* ptBvh, uint32_t uIndex, plAABB tAABB)
+{
+    if(uIndex >= ptBvh->_uPrimitiveCapacity)
+        pl__bvh_reserve_primitives(ptBvh, uIndex + 1);
+    PL_ASSERT(ptBvh->_puPrimitiveLeaves[uIndex] == UINT32_MAX && "primitive already in BVH");
 
-    float fSplitPos = tMin.d[iAxis] + tExtent.d[iAxis] * 0.5f;
+    const uint32_t uSlot = pl__bvh_alloc_leaf_slot(ptBvh);
+    ptBvh->_puLeafIndices[uSlot] = uIndex;
+    const plBVHNode tLeaf = {
+        .tAABB   = tAABB,
+        ._uIndex = uSlot,
+        ._uCount = 1
+    };
 
-    // in-place partition
-    int i = ptNode->_uOffset;
-    int j = i + ptNode->_uCount - 1;
-    while (i <= j)
+    if(ptBvh->_uNodeCount == 0) // first primitive becomes root
     {
-        plVec3 tCenter = pl_aabb_center(&ptAABBs[ptBvh->_puLeafIndices[i]]);
-        float fValue = tCenter.d[iAxis];
-
-        if (fValue < fSplitPos)
-        {
-            i++;
-        }
-        else
-        {
-            // swap
-            uint32_t uA = ptBvh->_puLeafIndices[i];
-            uint32_t uB = ptBvh->_puLeafIndices[j--];
-            ptBvh->_puLeafIndices[i] = uB;
-            ptBvh->_puLeafIndices[j + 1] = uA;
-        }
+        pl__bvh_reserve_nodes(ptBvh, 1);
+        ptBvh->_uNodeCount = 1;
+        ptBvh->_ptNodes[0] = tLeaf;
+        ptBvh->_puNodeParents[0] = UINT32_MAX;
+        ptBvh->_puNodeHeights[0] = 0;
+        ptBvh->_puPrimitiveLeaves[uIndex] = 0;
+        return;
     }
 
-    // abort split if one of the sides is empty
-    uint32_t _uLeftCount = i - ptNode->_uOffset;
-    if (_uLeftCount == 0 || _uLeftCount == ptNode->_uCount)
-        return;
+    // sibling is moved down next to the new leaf & its old node becomes
+    // their parent
+    const uint32_t uSibling = pl__bvh_find_sibling(ptBvh, &tAABB);
+    const uint32_t uPair = pl__bvh_alloc_node_pair(ptBvh);
 
-    // create child nodes
-    uint32_t _uLeftChildIndex = ptBvh->_uNodeCount++;
-    uint32_t uRightChildIndex = ptBvh->_uNodeCount++;
-    ptNode->_uLeft = _uLeftChildIndex;
-    ptBvh->_ptNodes[_uLeftChildIndex] = (plBVHNode){0};
-    ptBvh->_ptNodes[_uLeftChildIndex]._uOffset = ptNode->_uOffset;
-    ptBvh->_ptNodes[_uLeftChildIndex]._uCount = _uLeftCount;
-    ptBvh->_ptNodes[uRightChildIndex] = (plBVHNode){0};
-    ptBvh->_ptNodes[uRightChildIndex]._uOffset = i;
-    ptBvh->_ptNodes[uRightChildIndex]._uCount = ptNode->_uCount - _uLeftCount;
-    ptNode->_uCount = 0;
-    pl_bvh_update_node_bounds(ptBvh, _uLeftChildIndex, ptAABBs);
-    pl_bvh_update_node_bounds(ptBvh, uRightChildIndex, ptAABBs);
+    ptBvh->_ptNodes[uPair] = ptBvh->_ptNodes[uSibling];
+    ptBvh->_puNodeHeights[uPair] = ptBvh->_puNodeHeights[uSibling];
+    ptBvh->_puNodeParents[uPair] = uSibling;
+    pl__bvh_link_node(ptBvh, uPair);
 
-    // recurse
-    pl_bvh_subdivide(ptBvh, _uLeftChildIndex, ptAABBs);
-    pl_bvh_subdivide(ptBvh, uRightChildIndex, ptAABBs);
+    ptBvh->_ptNodes[uPair + 1] = tLeaf;
+    ptBvh->_puNodeHeights[uPair + 1] = 0;
+    ptBvh->_puNodeParents[uPair + 1] = uSibling;
+    pl__bvh_link_node(ptBvh, uPair + 1);
+
+    ptBvh->_ptNodes[uSibling]._uIndex = uPair;
+    ptBvh->_ptNodes[uSibling]._uCount = 0;
+    pl__bvh_refit_upwards(ptBvh, uSibling);
+    PL_ASSERT(ptBvh->_puNodeHeights[0] < PL_BVH_MAX_DEPTH && "BVH too deep");
 }
 
 void
-pl_bvh_build(plBVH* ptBvh, const plAABB* ptAABBs, uint32_t uCount)
+pl_bvh_remove(plBVH* ptBvh, uint32_t uIndex)
 {
-    if(ptBvh->_puAllocation)
-    {
-        PL_FREE(ptBvh->_puAllocation);
-        ptBvh->_puAllocation = NULL;
-    }
-    ptBvh->_uNodeCount = 0;
-    if(uCount == 0)
-        return;
+    PL_ASSERT(uIndex < ptBvh->_uPrimitiveCapacity && ptBvh->_puPrimitiveLeaves[uIndex] != UINT32_MAX && "primitive not in BVH");
 
-    const uint32_t uNodeCapacity = uCount * 2 - 1;
+    const uint32_t uLeaf = ptBvh->_puPrimitiveLeaves[uIndex];
+    ptBvh->_puPrimitiveLeaves[uIndex] = UINT32_MAX;
 
-    ptBvh->_puAllocation = PL_ALLOC(sizeof(plBVHNode) * uNodeCapacity + sizeof(uint32_t) * uCount);
-    memset(ptBvh->_puAllocation, 0, sizeof(plBVHNode) * uNodeCapacity + sizeof(uint32_t) * uCount);
+    // swap remove from leaf & free its last slot (bounds stay conservative)
+    plBVHNode* ptLeaf = &ptBvh->_ptNodes[uLeaf];
+    uint32_t* puIndices = &ptBvh->_puLeafIndices[ptLeaf->_uIndex];
+    uint32_t uCurrent = 0;
+    while(puIndices[uCurrent] != uIndex)
+        uCurrent++;
+    ptLeaf->_uCount--;
+    puIndices[uCurrent] = puIndices[ptLeaf->_uCount];
+    puIndices[ptLeaf->_uCount] = ptBvh->_uFreeLeaf;
+    ptBvh->_uFreeLeaf = ptLeaf->_uIndex + ptLeaf->_uCount + 1;
 
-    ptBvh->_ptNodes = (plBVHNode*)ptBvh->_puAllocation;
-    ptBvh->_puLeafIndices = (uint32_t*)(ptBvh->_ptNodes + uNodeCapacity);
-    ptBvh->_uLeafCount = uCount;
+    if(ptLeaf->_uCount > 0)
+        return;
 
-    plBVHNode* ptNode = &ptBvh->_ptNodes[ptBvh->_uNodeCount++];
-    *ptNode = (plBVHNode){0};
-    ptNode->_uCount = uCount;
-    for(uint32_t i = 0; i < uCount; ++i)
+    if(uLeaf == 0) // tree is empty
     {
-        ptNode->tAABB = pl_aabb_merge(&ptNode->tAABB, &ptAABBs[i]);
-        ptBvh->_puLeafIndices[i] = i;
+        ptBvh->_uNodeCount = 0;
+        ptBvh->_uFreeNode  = 0;
+        ptBvh->_uLeafCount = 0;
+        ptBvh->_uFreeLeaf  = 0;
+        return;
     }
-    pl_bvh_subdivide(ptBvh, 0, ptAABBs);
+
+    // sibling replaces parent & the pair is freed
+    const uint32_t uParent = ptBvh->_puNodeParents[uLeaf];
+    const uint32_t uPair = ptBvh->_ptNodes[uParent]._uIndex;
+    const uint32_t uSibling = uLeaf == uPair ? uPair + 1 : uPair;
+
+    ptBvh->_ptNodes[uParent] = ptBvh->_ptNodes[uSibling];
+    ptBvh->_puNodeHeights[uParent] = ptBvh->_puNodeHeights[uSibling];
+    pl__bvh_link_node(ptBvh, uParent);
+
+    ptBvh->_ptNodes[uPair]._uIndex = ptBvh->_uFreeNode;
+    ptBvh->_ptNodes[uPair]._uCount = 0;
+    ptBvh->_uFreeNode = uPair;
+
+    if(ptBvh->_puNodeParents[uParent] != UINT32_MAX)
+        pl__bvh_refit_upwards(ptBvh, ptBvh->_puNodeParents[uParent]);
+}
+
+void
+pl_bvh_update(plBVH* ptBvh, uint32_t uIndex, plAABB tAABB)
+{
+    PL_ASSERT(uIndex < ptBvh->_uPrimitiveCapacity && ptBvh->_puPrimitiveLeaves[uIndex] != UINT32_MAX && "primitive not in BVH");
+
+    // unchanged single primitive leaf
+    const plBVHNode* ptLeaf = &ptBvh->_ptNodes[ptBvh->_puPrimitiveLeaves[uIndex]];
+    if(ptLeaf->_uCount == 1 && memcmp(&ptLeaf->tAABB, &tAABB, sizeof(plAABB)) == 0)
+        return;
+
+    // reinsert (removal frees the node pair & slot that insertion reuses)
+    pl_bvh_remove(ptBvh, uIndex);
+    pl_bvh_insert(ptBvh, uIndex, tAABB);
 }
 
 void
 pl_bvh_cleanup(plBVH* ptBvh)
 {
-    if(ptBvh->_puAllocation)
-    {
-        PL_FREE(ptBvh->_puAllocation);
-        ptBvh->_puAllocation = NULL;
-    }
+    pl__bvh_free(ptBvh);
     pl_sb_free(ptBvh->_sbtNodeStack);
     *ptBvh = (plBVH){0};
 }
@@ -168,71 +379,139 @@ pl_bvh_cleanup(plBVH* ptBvh)
 void
 pl_bvh_intersects_aabb(plBVH* ptBvh, plAABB tAABB, plBVHCallback tCallback, void* pUserData)
 {
-    if(ptBvh->_uNodeCount > 0)
+    if(ptBvh->_uNodeCount == 0)
+        return;
+
+    uint32_t auStack[PL_BVH_MAX_DEPTH];
+    uint32_t uStackSize = 0;
+    auStack[uStackSize++] = 0;
+
+    while(uStackSize > 0)
     {
-        pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[0]);
+        const uint32_t uNode = auStack[--uStackSize];
+        const plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
 
-        while(pl_sb_size(ptBvh->_sbtNodeStack) > 0)
+        if(gptCollision->aabb_aabb(&ptNode->tAABB, &tAABB))
         {
-            plBVHNode* ptNode = pl_sb_pop(ptBvh->_sbtNodeStack);
-
-            if(gptCollision->aabb_aabb(&ptNode->tAABB, &tAABB))
+            if(ptNode->_uCount > 0) // is leaf
             {
-                if(ptNode->_uCount > 0) // is leaf
+                for(uint32_t i = 0; i < ptNode->_uCount; i++)
                 {
-                    for(uint32_t i = 0; i < ptNode->_uCount; i++)
-                    {
-                        uint32_t uIndex = ptBvh->_puLeafIndices[ptNode->_uOffset + i];
-                        tCallback(uIndex, pUserData);
-                    }
-                }
-                else
-                {
-                    pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uLeft]);
-                    pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uLeft + 1]);
+                    uint32_t uIndex = ptBvh->_puLeafIndices[ptNode->_uIndex + i];
+                    tCallback(uIndex, pUserData);
                 }
             }
+            else
+            {
+                auStack[uStackSize++] = ptNode->_uIndex + 1;
+                auStack[uStackSize++] = ptNode->_uIndex;
+            }
         }
     }
-
-    pl_sb_reset(ptBvh->_sbtNodeStack); 
 }
 
 bool
 pl_bvh_intersects_aabb_first(plBVH* ptBvh, plAABB tAABB, plBVHCallback tCallback, void* pUserData)
 {
-    if(ptBvh->_uNodeCount > 0)
+    if(ptBvh->_uNodeCount == 0)
+        return false;
+
+    uint32_t auStack[PL_BVH_MAX_DEPTH];
+    uint32_t uStackSize = 0;
+    auStack[uStackSize++] = 0;
+
+    while(uStackSize > 0)
     {
-        pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[0]);
+        const uint32_t uNode = auStack[--uStackSize];
+        const plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
 
-        while(pl_sb_size(ptBvh->_sbtNodeStack) > 0)
+        if(gptCollision->aabb_aabb(&ptNode->tAABB, &tAABB))
         {
-            plBVHNode* ptNode = pl_sb_pop(ptBvh->_sbtNodeStack);
-
-            if(gptCollision->aabb_aabb(&ptNode->tAABB, &tAABB))
+            if(ptNode->_uCount > 0) // is leaf
             {
-                if(ptNode->_uCount > 0) // is leaf
-                {
-                    for(uint32_t i = 0; i < ptNode->_uCount; i++)
-                    {
-                        uint32_t uIndex = ptBvh->_puLeafIndices[ptNode->_uOffset + i];
-                        if(tCallback(uIndex, pUserData))
-                        {
-                            pl_sb_reset(ptBvh->_sbtNodeStack); 
-                            return true;
-                        }
-                    }
-                }
-                else
+                for(uint32_t i = 0; i < ptNode->_uCount; i++)
                 {
-                    pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uLeft]);
-                    pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uLeft + 1]);
+                    uint32_t uIndex = ptBvh->_puLeafIndices[ptNode->_uIndex + i];
+                    if(tCallback(uIndex, pUserData))
+                        return true;
                 }
             }
+            else
+            {
+                auStack[uStackSize++] = ptNode->_uIndex + 1;
+                auStack[uStackSize++] = ptNode->_uIndex;
+            }
         }
     }
+    return false;
+}
+
+bool
+pl_bvh_intersects_ray(plBVH* ptBvh, plRay tRay, plBVHCallback tCallback, void* pUserData)
+{
+    if(ptBvh->_uNodeCount == 0)
+        return false;
+
+    const plVec3 tInvDirection = {
+        1.0f / tRay.tDirection.x,
+        1.0f / tRay.tDirection.y,
+        1.0f / tRay.tDirection.z
+    };
 
-    pl_sb_reset(ptBvh->_sbtNodeStack);
+    float fNear = 0.0f;
+    if(!pl__bvh_ray_aabb(&ptBvh->_ptNodes[0].tAABB, tRay.tOrigin, tInvDirection, &fNear))
+        return false;
+
+    uint32_t auStack[PL_BVH_MAX_DEPTH];
+    uint32_t uStackSize = 0;
+    uint32_t uNode = 0;
+
+    while(true)
+    {
+        const plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
+
+        if(ptNode->_uCount > 0) // is leaf
+        {
+            for(uint32_t i = 0; i < ptNode->_uCount; i++)
+            {
+                uint32_t uIndex = ptBvh->_puLeafIndices[ptNode->_uIndex + i];
+                if(tCallback(uIndex, pUserData))
+                    return true;
+            }
+
+            if(uStackSize == 0)
+                break;
+            uNode = auStack[--uStackSize];
+            continue;
+        }
+
+        // visit nearest child first, defer the other
+        uint32_t auChildren[2] = {ptNode->_uIndex, ptNode->_uIndex + 1};
+        float afNear[2] = {0};
+        const bool bHit0 = pl__bvh_ray_aabb(&ptBvh->_ptNodes[auChildren[0]].tAABB, tRay.tOrigin, tInvDirection, &afNear[0]);
+        const bool bHit1 = pl__bvh_ray_aabb(&ptBvh->_ptNodes[auChildren[1]].tAABB, tRay.tOrigin, tInvDirection, &afNear[1]);
+
+        if(bHit0 && bHit1)
+        {
+            if(afNear[1] < afNear[0])
+            {
+                auChildren[0] = ptNode->_uIndex + 1;
+                auChildren[1] = ptNode->_uIndex;
+            }
+            auStack[uStackSize++] = auChildren[1];
+            uNode = auChildren[0];
+        }
+        else if(bHit0)
+            uNode = auChildren[0];
+        else if(bHit1)
+            uNode = auChildren[1];
+        else
+        {
+            if(uStackSize == 0)
+                break;
+            uNode = auStack[--uStackSize];
+        }
+    }
     return false;
 }
 
@@ -243,6 +522,7 @@ pl_bvh_traverse(plBVH* ptBvh, plBVHNode** pptNodeOut, uint32_t* puIndexOut)
 
     if(ptNode == NULL) // first run
     {
+        pl_sb_reset(ptBvh->_sbtNodeStack);
         if(ptBvh->_uNodeCount > 0)
         {
             ptNode = &ptBvh->_ptNodes[0];
@@ -256,17 +536,20 @@ pl_bvh_traverse(plBVH* ptBvh, plBVHNode** pptNodeOut, uint32_t* puIndexOut)
 
     if(ptNode->_uCount > 0) // is leaf
     {
-
         if(*puIndexOut == UINT32_MAX) // first leaf
         {
-            ptNode->_uTraverseOffset = 0;
-            *puIndexOut = ptBvh->_puLeafIndices[ptNode->_uOffset];
+            *puIndexOut = ptBvh->_puLeafIndices[ptNode->_uIndex];
             return true;
         }
-        else if(ptNode->_uTraverseOffset < ptNode->_uCount - 1) // next leaf
+
+        // find current leaf (leaves are small)
+        uint32_t uCurrent = 0;
+        while(ptBvh->_puLeafIndices[ptNode->_uIndex + uCurrent] != *puIndexOut)
+            uCurrent++;
+
+        if(uCurrent < ptNode->_uCount - 1) // next leaf
         {
-            ptNode->_uTraverseOffset++;
-            *puIndexOut = ptBvh->_puLeafIndices[ptNode->_uOffset + ptNode->_uTraverseOffset];
+            *puIndexOut = ptBvh->_puLeafIndices[ptNode->_uIndex + uCurrent + 1];
             return true;
         }
         else // no more leaves
@@ -274,8 +557,8 @@ pl_bvh_traverse(plBVH* ptBvh, plBVHNode** pptNodeOut, uint32_t* puIndexOut)
     }
     else
     {
-        pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uLeft]);
-        pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uLeft + 1]);
+        pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uIndex + 1]);
+        pl_sb_push(ptBvh->_sbtNodeStack, &ptBvh->_ptNodes[ptNode->_uIndex]);
     }
 
     // next node
@@ -290,6 +573,538 @@ pl_bvh_traverse(plBVH* ptBvh, plBVHNode** pptNodeOut, uint32_t* puIndexOut)
     return true;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] internal api implementation
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__bvh_partition(plBvhBuildContext* ptCtx, uint32_t uOffset, uint32_t uCount, const plBvhSplit* ptSplit, plBvhBounds atChildBoundsOut[2])
+{
+    // in-place partition, child bounds are gathered on the way
+    plBvhRef* atRefs = ptCtx->atRefs;
+    atChildBoundsOut[0].tAABB = pl__bvh_empty_aabb();
+    atChildBoundsOut[0].tCentroids = pl__bvh_empty_aabb();
+    atChildBoundsOut[1] = atChildBoundsOut[0];
+
+    const int iAxis = ptSplit->iAxis;
+    uint32_t i = uOffset;
+    uint32_t j = uOffset + uCount;
+    while(i < j)
+    {
+        const plVec3 tCentroid = atRefs[i].tCentroid;
+
+        bool bLeft = false;
+        if(ptSplit->fScale > 0.0f) // binned
+        {
+            uint32_t uBin = (uint32_t)((tCentroid.d[iAxis] - ptSplit->fPosition) * ptSplit->fScale);
+            if(uBin >= PL_BVH_BIN_COUNT)
+                uBin = PL_BVH_BIN_COUNT - 1;
+            bLeft = uBin < ptSplit->uBin;
+        }
+        else
+            bLeft = tCentroid.d[iAxis] < ptSplit->fPosition;
+
+        plBvhBounds* ptBounds = &atChildBoundsOut[bLeft ? 0 : 1];
+        pl__bvh_grow(&ptBounds->tAABB, &atRefs[i].tAABB);
+        pl__bvh_grow_point(&ptBounds->tCentroids, tCentroid);
+
+        if(bLeft)
+            i++;
+        else
+        {
+            const plBvhRef tTemp = atRefs[i];
+            atRefs[i] = atRefs[--j];
+            atRefs[j] = tTemp;
+        }
+    }
+    return i - uOffset;
+}
+
+static bool
+pl__bvh_split_midpoint(plBvhBuildContext* ptCtx, const plBvhBounds* ptBounds, uint32_t uCount, plBvhSplit* ptSplitOut)
+{
+    if(uCount <= 2)
+        return false;
+
+    plVec3 tExtent = pl_aabb_half_width(&ptBounds->tAABB);
+    int iAxis = 0;
+    if(tExtent.y > tExtent.x) iAxis = 1;
+    if(tExtent.z > tExtent.d[iAxis]) iAxis = 2;
+
+    ptSplitOut->iAxis = iAxis;
+    ptSplitOut->fPosition = ptBounds->tAABB.tMin.d[iAxis] + tExtent.d[iAxis];
+    ptSplitOut->fScale = 0.0f;
+
+    // abort split if one of the sides would be empty
+    return ptSplitOut->fPosition > ptBounds->tCentroids.tMin.d[iAxis] && ptSplitOut->fPosition <= ptBounds->tCentroids.tMax.d[iAxis];
+}
+
+static bool
+pl__bvh_split_sah(plBvhBuildContext* ptCtx, const plBvhBounds* ptBounds, uint32_t uOffset, uint32_t uCount, plBvhSplit* ptSplitOut)
+{
+    const plBvhRef* atRefs = &ptCtx->atRefs[uOffset];
+    const plVec3 tMin = ptBounds->tCentroids.tMin;
+    const plVec3 tExtent = pl_sub_vec3(ptBounds->tCentroids.tMax, tMin);
+
+    plVec3 tScale = {0};
+    for(int iAxis = 0; iAxis < 3; iAxis++)
+        tScale.d[iAxis] = tExtent.d[iAxis] > 0.0f ? (float)PL_BVH_BIN_COUNT / tExtent.d[iAxis] : 0.0f;
+
+    if(tScale.x == 0.0f && tScale.y == 0.0f && tScale.z == 0.0f) // all centroids coincide
+    {
+        if(uCount <= PL_BVH_MAX_LEAF_SIZE)
+            return false;
+        *ptSplitOut = (plBvhSplit){.iAxis = -1};
+        return true;
+    }
+
+    // bin all axes in a single pass (bin bounds only valid if count > 0)
+    plBvhBin atBins[3][PL_BVH_BIN_COUNT];
+    for(int iAxis = 0; iAxis < 3; iAxis++)
+    {
+        for(uint32_t uBin = 0; uBin < PL_BVH_BIN_COUNT; uBin++)
+            atBins[iAxis][uBin].uCount = 0;
+    }
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plVec3 tCentroid = atRefs[i].tCentroid;
+        for(int iAxis = 0; iAxis < 3; iAxis++)
+        {
+            uint32_t uBin = (uint32_t)((tCentroid.d[iAxis] - tMin.d[iAxis]) * tScale.d[iAxis]);
+            if(uBin >= PL_BVH_BIN_COUNT)
+                uBin = PL_BVH_BIN_COUNT - 1;
+            plBvhBin* ptBin = &atBins[iAxis][uBin];
+            if(ptBin->uCount++ == 0)
+                ptBin->tAABB = atRefs[i].tAABB;
+            else
+                pl__bvh_grow(&ptBin->tAABB, &atRefs[i].tAABB);
+        }
+    }
+
+    // find cheapest bin boundary over all axes
+    float    fBestCost = FLT_MAX;
+    int      iBestAxis = -1;
+    uint32_t uBestSplit = 0;
+    for(int iAxis = 0; iAxis < 3; iAxis++)
+    {
+        if(tScale.d[iAxis] == 0.0f)
+            continue;
+
+        // sweep from the right storing area * count, then from the left
+        // (empty bins don't change the running cost)
+        float afRightCost[PL_BVH_BIN_COUNT] = {0};
+        plAABB tAccum = pl__bvh_empty_aabb();
+        uint32_t uAccumCount = 0;
+        float fAccumCost = 0.0f;
+        for(uint32_t uBin = PL_BVH_BIN_COUNT - 1; uBin > 0; uBin--)
+        {
+            if(atBins[iAxis][uBin].uCount > 0)
+            {
+                pl__bvh_grow(&tAccum, &atBins[iAxis][uBin].tAABB);
+                uAccumCount += atBins[iAxis][uBin].uCount;
+                fAccumCost = pl__bvh_half_area(&tAccum) * (float)uAccumCount;
+            }
+            afRightCost[uBin] = fAccumCost;
+        }
+
+        tAccum = pl__bvh_empty_aabb();
+        uAccumCount = 0;
+        fAccumCost = 0.0f;
+        for(uint32_t uSplit = 1; uSplit < PL_BVH_BIN_COUNT; uSplit++)
+        {
+            const plBvhBin* ptBin = &atBins[iAxis][uSplit - 1];
+            if(ptBin->uCount == 0)
+                continue; // same partition as previous boundary
+            pl__bvh_grow(&tAccum, &ptBin->tAABB);
+            uAccumCount += ptBin->uCount;
+            if(uAccumCount == uCount)
+                break;
+            const float fCost = pl__bvh_half_area(&tAccum) * (float)uAccumCount + afRightCost[uSplit];
+            if(fCost < fBestCost)
+            {
+                fBestCost = fCost;
+                iBestAxis = iAxis;
+                uBestSplit = uSplit;
+            }
+        }
+    }
+
+    // traversal cost of 1, intersection cost of 1
+    const float fArea = pl__bvh_half_area(&ptBounds->tAABB);
+    if(uCount <= PL_BVH_MAX_LEAF_SIZE && fArea + fBestCost >= fArea * (float)uCount)
+        return false;
+
+    ptSplitOut->iAxis     = iBestAxis;
+    ptSplitOut->fPosition = tMin.d[iBestAxis];
+    ptSplitOut->fScale    = tScale.d[iBestAxis];
+    ptSplitOut->uBin      = uBestSplit;
+    return true;
+}
+
+static void
+pl__bvh_build_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plBvhBuildTask* ptTask = &((plBvhBuildTask*)pData)[tInvoData.uGlobalIndex];
+    pl__bvh_build_node(ptTask->ptCtx, ptTask->uNode, ptTask->uChildNode, ptTask->uOffset, ptTask->uCount, ptTask->uDepth, &ptTask->tBounds);
+}
+
+static void
+pl__bvh_build_node(plBvhBuildContext* ptCtx, uint32_t uNode, uint32_t uChildNode, uint32_t uOffset, uint32_t uCount, uint32_t uDepth, const plBvhBounds* ptBounds)
+{
+    plBVHNode* ptNode = &ptCtx->atNodes[uNode];
+    ptNode->tAABB = ptBounds->tAABB;
+
+    bool bSplit = false;
+    plBvhSplit tSplit = {0};
+    if(uCount > 1 && uDepth < PL_BVH_MAX_DEPTH - 1)
+    {
+        if(ptCtx->tFlags & PL_BVH_BUILD_FLAGS_MIDPOINT)
+            bSplit = pl__bvh_split_midpoint(ptCtx, ptBounds, uCount, &tSplit);
+        else
+            bSplit = pl__bvh_split_sah(ptCtx, ptBounds, uOffset, uCount, &tSplit);
+    }
+
+    if(!bSplit) // leaf
+    {
+        ptNode->_uIndex = uOffset;
+        ptNode->_uCount = uCount;
+        return;
+    }
+
+    plBvhBuildTask atTasks[2] = {
+        {.ptCtx = ptCtx, .uOffset = uOffset, .uDepth = uDepth + 1},
+        {.ptCtx = ptCtx, .uDepth = uDepth + 1}
+    };
+
+    uint32_t uLeftCount = 0;
+    if(tSplit.iAxis == -1) // degenerate, split in half
+    {
+        uLeftCount = uCount / 2;
+        pl__bvh_compute_bounds(ptCtx, uOffset, uLeftCount, &atTasks[0].tBounds);
+        pl__bvh_compute_bounds(ptCtx, uOffset + uLeftCount, uCount - uLeftCount, &atTasks[1].tBounds);
+    }
+    else
+    {
+        plBvhBounds atChildBounds[2];
+        uLeftCount = pl__bvh_partition(ptCtx, uOffset, uCount, &tSplit, atChildBounds);
+        atTasks[0].tBounds = atChildBounds[0];
+        atTasks[1].tBounds = atChildBounds[1];
+    }
+
+    // children pair, then left descendants (2n - 2 nodes), then right descendants
+    ptNode->_uIndex = uChildNode;
+    ptNode->_uCount = 0;
+
+    atTasks[0].uNode      = uChildNode;
+    atTasks[0].uChildNode = uChildNode + 2;
+    atTasks[0].uCount     = uLeftCount;
+    atTasks[1].uNode      = uChildNode + 1;
+    atTasks[1].uChildNode = uChildNode + 2 * uLeftCount;
+    atTasks[1].uOffset    = uOffset + uLeftCount;
+    atTasks[1].uCount     = uCount - uLeftCount;
+
+    if((ptCtx->tFlags & PL_BVH_BUILD_FLAGS_PARALLEL) && uCount >= PL_BVH_PARALLEL_THRESHOLD)
+    {
+        plJobDesc tJobDesc = {
+            .task  = pl__bvh_build_task,
+            .pData = atTasks
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(2, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < 2; i++)
+            pl__bvh_build_node(ptCtx, atTasks[i].uNode, atTasks[i].uChildNode, atTasks[i].uOffset, atTasks[i].uCount, atTasks[i].uDepth, &atTasks[i].tBounds);
+    }
+}
+
+static void
+pl__bvh_compute_bounds(plBvhBuildContext* ptCtx, uint32_t uOffset, uint32_t uCount, plBvhBounds* ptBoundsOut)
+{
+    const plBvhRef* atRefs = &ptCtx->atRefs[uOffset];
+    ptBoundsOut->tAABB = pl__bvh_empty_aabb();
+    ptBoundsOut->tCentroids = pl__bvh_empty_aabb();
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        pl__bvh_grow(&ptBoundsOut->tAABB, &atRefs[i].tAABB);
+        pl__bvh_grow_point(&ptBoundsOut->tCentroids, atRefs[i].tCentroid);
+    }
+}
+
+static uint32_t
+pl__bvh_compact(plBVH* ptBvh, uint32_t uNode)
+{
+    // node is already in place, children are moved to the next free pair;
+    // destination never passes source & both are in the same order so this is
+    // safe in place
+    plBVHNode* atNodes = ptBvh->_ptNodes;
+    if(atNodes[uNode]._uCount > 0)
+    {
+        pl__bvh_link_node(ptBvh, uNode);
+        ptBvh->_puNodeHeights[uNode] = 0;
+        return 0;
+    }
+
+    const uint32_t uSrcNode = atNodes[uNode]._uIndex;
+    const uint32_t uDstNode = ptBvh->_uNodeCount;
+    ptBvh->_uNodeCount += 2;
+    atNodes[uDstNode] = atNodes[uSrcNode];
+    atNodes[uDstNode + 1] = atNodes[uSrcNode + 1];
+    atNodes[uNode]._uIndex = uDstNode;
+    ptBvh->_puNodeParents[uDstNode] = uNode;
+    ptBvh->_puNodeParents[uDstNode + 1] = uNode;
+
+    const uint32_t uHeight0 = pl__bvh_compact(ptBvh, uDstNode);
+    const uint32_t uHeight1 = pl__bvh_compact(ptBvh, uDstNode + 1);
+    ptBvh->_puNodeHeights[uNode] = 1 + (uHeight0 > uHeight1 ? uHeight0 : uHeight1);
+    return ptBvh->_puNodeHeights[uNode];
+}
+
+static void*
+pl__bvh_grow_array(void* pOld, size_t szElementSize, uint32_t uOldCapacity, uint32_t uNewCapacity)
+{
+    void* pNew = PL_ALLOC(szElementSize * uNewCapacity);
+    if(pOld)
+    {
+        memcpy(pNew, pOld, szElementSize * uOldCapacity);
+        PL_FREE(pOld);
+    }
+    return pNew;
+}
+
+static void
+pl__bvh_free(plBVH* ptBvh)
+{
+    if(ptBvh->_ptNodes)
+    {
+        PL_FREE(ptBvh->_ptNodes);
+        PL_FREE(ptBvh->_puNodeParents);
+        PL_FREE(ptBvh->_puNodeHeights);
+    }
+    if(ptBvh->_puLeafIndices)
+        PL_FREE(ptBvh->_puLeafIndices);
+    if(ptBvh->_puPrimitiveLeaves)
+        PL_FREE(ptBvh->_puPrimitiveLeaves);
+
+    ptBvh->_ptNodes            = NULL;
+    ptBvh->_puNodeParents      = NULL;
+    ptBvh->_puNodeHeights      = NULL;
+    ptBvh->_uNodeCount         = 0;
+    ptBvh->_uNodeCapacity      = 0;
+    ptBvh->_uFreeNode          = 0;
+    ptBvh->_puLeafIndices      = NULL;
+    ptBvh->_uLeafCount         = 0;
+    ptBvh->_uLeafCapacity      = 0;
+    ptBvh->_uFreeLeaf          = 0;
+    ptBvh->_puPrimitiveLeaves  = NULL;
+    ptBvh->_uPrimitiveCapacity = 0;
+}
+
+static void
+pl__bvh_reserve_nodes(plBVH* ptBvh, uint32_t uCount)
+{
+    if(uCount <= ptBvh->_uNodeCapacity)
+        return;
+    const uint32_t uOldCapacity = ptBvh->_uNodeCapacity;
+    const uint32_t uNewCapacity = uOldCapacity * 2 > uCount ? uOldCapacity * 2 : uCount;
+    ptBvh->_ptNodes       = pl__bvh_grow_array(ptBvh->_ptNodes, sizeof(plBVHNode), uOldCapacity, uNewCapacity);
+    ptBvh->_puNodeParents = pl__bvh_grow_array(ptBvh->_puNodeParents, sizeof(uint32_t), uOldCapacity, uNewCapacity);
+    ptBvh->_puNodeHeights = pl__bvh_grow_array(ptBvh->_puNodeHeights, sizeof(uint32_t), uOldCapacity, uNewCapacity);
+    ptBvh->_uNodeCapacity = uNewCapacity;
+}
+
+static void
+pl__bvh_reserve_leaves(plBVH* ptBvh, uint32_t uCount)
+{
+    if(uCount <= ptBvh->_uLeafCapacity)
+        return;
+    const uint32_t uOldCapacity = ptBvh->_uLeafCapacity;
+    const uint32_t uNewCapacity = uOldCapacity * 2 > uCount ? uOldCapacity * 2 : uCount;
+    ptBvh->_puLeafIndices = pl__bvh_grow_array(ptBvh->_puLeafIndices, sizeof(uint32_t), uOldCapacity, uNewCapacity);
+    ptBvh->_uLeafCapacity = uNewCapacity;
+}
+
+static void
+pl__bvh_reserve_primitives(plBVH* ptBvh, uint32_t uCount)
+{
+    if(uCount <= ptBvh->_uPrimitiveCapacity)
+        return;
+    const uint32_t uOldCapacity = ptBvh->_uPrimitiveCapacity;
+    const uint32_t uNewCapacity = uOldCapacity * 2 > uCount ? uOldCapacity * 2 : uCount;
+    ptBvh->_puPrimitiveLeaves = pl__bvh_grow_array(ptBvh->_puPrimitiveLeaves, sizeof(uint32_t), uOldCapacity, uNewCapacity);
+    memset(&ptBvh->_puPrimitiveLeaves[uOldCapacity], 0xFF, sizeof(uint32_t) * (uNewCapacity - uOldCapacity)); // UINT32_MAX
+    ptBvh->_uPrimitiveCapacity = uNewCapacity;
+}
+
+static uint32_t
+pl__bvh_alloc_node_pair(plBVH* ptBvh)
+{
+    // free pairs are linked through the first node's index (root is never free)
+    if(ptBvh->_uFreeNode > 0)
+    {
+        const uint32_t uPair = ptBvh->_uFreeNode;
+        ptBvh->_uFreeNode = ptBvh->_ptNodes[uPair]._uIndex;
+        return uPair;
+    }
+    pl__bvh_reserve_nodes(ptBvh, ptBvh->_uNodeCount + 2);
+    const uint32_t uPair = ptBvh->_uNodeCount;
+    ptBvh->_uNodeCount += 2;
+    return uPair;
+}
+
+static uint32_t
+pl__bvh_alloc_leaf_slot(plBVH* ptBvh)
+{
+    // free slots are linked through the slots themselves
+    if(ptBvh->_uFreeLeaf > 0)
+    {
+        const uint32_t uSlot = ptBvh->_uFreeLeaf - 1;
+        ptBvh->_uFreeLeaf = ptBvh->_puLeafIndices[uSlot];
+        return uSlot;
+    }
+    pl__bvh_reserve_leaves(ptBvh, ptBvh->_uLeafCount + 1);
+    return ptBvh->_uLeafCount++;
+}
+
+static void
+pl__bvh_refit_node(plBVH* ptBvh, const plAABB* ptAABBs, uint32_t uCount, uint32_t uNode)
+{
+    // recursion is bounded by PL_BVH_MAX_DEPTH
+    plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
+    if(ptNode->_uCount > 0) // is leaf
+    {
+        const uint32_t* puIndices = &ptBvh->_puLeafIndices[ptNode->_uIndex];
+        PL_ASSERT(puIndices[0] < uCount);
+        ptNode->tAABB = ptAABBs[puIndices[0]];
+        for(uint32_t i = 1; i < ptNode->_uCount; i++)
+        {
+            PL_ASSERT(puIndices[i] < uCount);
+            pl__bvh_grow(&ptNode->tAABB, &ptAABBs[puIndices[i]]);
+        }
+        return;
+    }
+
+    const uint32_t uChild = ptNode->_uIndex;
+    pl__bvh_refit_node(ptBvh, ptAABBs, uCount, uChild);
+    pl__bvh_refit_node(ptBvh, ptAABBs, uCount, uChild + 1);
+    ptNode->tAABB = ptBvh->_ptNodes[uChild].tAABB;
+    pl__bvh_grow(&ptNode->tAABB, &ptBvh->_ptNodes[uChild + 1].tAABB);
+}
+
+static uint32_t
+pl__bvh_find_sibling(plBVH* ptBvh, const plAABB* ptAABB)
+{
+    // greedy descent using the surface area increase of the tree
+    uint32_t uNode = 0;
+    while(ptBvh->_ptNodes[uNode]._uCount == 0)
+    {
+        const plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
+        plAABB tCombined = ptNode->tAABB;
+        pl__bvh_grow(&tCombined, ptAABB);
+        const float fArea = pl__bvh_half_area(&ptNode->tAABB);
+        const float fCombinedArea = pl__bvh_half_area(&tCombined);
+
+        // cost of pairing with this node vs. pushing down (ancestors grow either way)
+        const float fCost = 2.0f * fCombinedArea;
+        const float fInheritedCost = 2.0f * (fCombinedArea - fArea);
+
+        float afChildCost[2] = {0};
+        for(uint32_t i = 0; i < 2; i++)
+        {
+            const plBVHNode* ptChild = &ptBvh->_ptNodes[ptNode->_uIndex + i];
+            plAABB tChildCombined = ptChild->tAABB;
+            pl__bvh_grow(&tChildCombined, ptAABB);
+            afChildCost[i] = pl__bvh_half_area(&tChildCombined) + fInheritedCost;
+            if(ptChild->_uCount == 0)
+                afChildCost[i] -= pl__bvh_half_area(&ptChild->tAABB);
+        }
+
+        if(fCost < afChildCost[0] && fCost < afChildCost[1])
+            break;
+        uNode = ptNode->_uIndex + (afChildCost[1] < afChildCost[0] ? 1 : 0);
+    }
+    return uNode;
+}
+
+static void
+pl__bvh_link_node(plBVH* ptBvh, uint32_t uNode)
+{
+    // point children (or primitives) back at a node after it was moved
+    const plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
+    if(ptNode->_uCount > 0)
+    {
+        for(uint32_t i = 0; i < ptNode->_uCount; i++)
+            ptBvh->_puPrimitiveLeaves[ptBvh->_puLeafIndices[ptNode->_uIndex + i]] = uNode;
+    }
+    else
+    {
+        ptBvh->_puNodeParents[ptNode->_uIndex] = uNode;
+        ptBvh->_puNodeParents[ptNode->_uIndex + 1] = uNode;
+    }
+}
+
+static void
+pl__bvh_swap_nodes(plBVH* ptBvh, uint32_t uNode0, uint32_t uNode1)
+{
+    // nodes keep their position in the tree, only contents are swapped
+    const plBVHNode tNode = ptBvh->_ptNodes[uNode0];
+    ptBvh->_ptNodes[uNode0] = ptBvh->_ptNodes[uNode1];
+    ptBvh->_ptNodes[uNode1] = tNode;
+
+    const uint32_t uHeight = ptBvh->_puNodeHeights[uNode0];
+    ptBvh->_puNodeHeights[uNode0] = ptBvh->_puNodeHeights[uNode1];
+    ptBvh->_puNodeHeights[uNode1] = uHeight;
+
+    pl__bvh_link_node(ptBvh, uNode0);
+    pl__bvh_link_node(ptBvh, uNode1);
+}
+
+static void
+pl__bvh_update_node(plBVH* ptBvh, uint32_t uNode)
+{
+    plBVHNode* ptNode = &ptBvh->_ptNodes[uNode];
+    const uint32_t uChild = ptNode->_uIndex;
+    ptNode->tAABB = ptBvh->_ptNodes[uChild].tAABB;
+    pl__bvh_grow(&ptNode->tAABB, &ptBvh->_ptNodes[uChild + 1].tAABB);
+
+    const uint32_t uHeight0 = ptBvh->_puNodeHeights[uChild];
+    const uint32_t uHeight1 = ptBvh->_puNodeHeights[uChild + 1];
+    ptBvh->_puNodeHeights[uNode] = 1 + (uHeight0 > uHeight1 ? uHeight0 : uHeight1);
+}
+
+static void
+pl__bvh_rotate(plBVH* ptBvh, uint32_t uNode)
+{
+    // if one child is more than 1 level taller, swap the other child with the
+    // tall child's taller child (never increases height)
+    const uint32_t uChild = ptBvh->_ptNodes[uNode]._uIndex;
+    const int iBalance = (int)ptBvh->_puNodeHeights[uChild + 1] - (int)ptBvh->_puNodeHeights[uChild];
+    if(iBalance >= -1 && iBalance <= 1)
+        return;
+
+    const uint32_t uTall  = iBalance > 0 ? uChild + 1 : uChild;
+    const uint32_t uShort = iBalance > 0 ? uChild : uChild + 1;
+    const uint32_t uGrandChild = ptBvh->_ptNodes[uTall]._uIndex;
+    const uint32_t uTallGrandChild = ptBvh->_puNodeHeights[uGrandChild] > ptBvh->_puNodeHeights[uGrandChild + 1] ? uGrandChild : uGrandChild + 1;
+
+    pl__bvh_swap_nodes(ptBvh, uShort, uTallGrandChild);
+    pl__bvh_update_node(ptBvh, uTall);
+}
+
+static void
+pl__bvh_refit_upwards(plBVH* ptBvh, uint32_t uNode)
+{
+    while(uNode != UINT32_MAX)
+    {
+        pl__bvh_rotate(ptBvh, uNode);
+        pl__bvh_update_node(ptBvh, uNode);
+        uNode = ptBvh->_puNodeParents[uNode];
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] extension loading
 //-----------------------------------------------------------------------------
@@ -299,15 +1114,22 @@ pl_load_bvh_ext(plApiRegistryI* ptApiRegistry, bool bReload)
 {
     const plBVHI tApi = {
         .build                 = pl_bvh_build,
+        .build_ex              = pl_bvh_build_ex,
+        .refit                 = pl_bvh_refit,
+        .insert                = pl_bvh_insert,
+        .remove                = pl_bvh_remove,
+        .update                = pl_bvh_update,
         .cleanup               = pl_bvh_cleanup,
         .intersects_aabb       = pl_bvh_intersects_aabb,
         .intersects_aabb_first = pl_bvh_intersects_aabb_first,
+        .intersects_ray        = pl_bvh_intersects_ray,
         .traverse              = pl_bvh_traverse,
     };
     pl_set_api(ptApiRegistry, plBVHI, &tApi);
 
     gptCollision = pl_get_api_latest(ptApiRegistry, plCollisionI);
     gptMemory    = pl_get_api_latest(ptApiRegistry, plMemoryI);
+    gptJob       = pl_get_api_latest(ptApiRegistry, plJobI);
 }
 
 void
@@ -8,10 +8,12 @@ Index of this file:
 // [SECTION] header mess
 // [SECTION] APIs
 // [SECTION] includes
+// [SECTION] defines
 // [SECTION] forward declarations
 // [SECTION] public api
 // [SECTION] public api struct
 // [SECTION] structs
+// [SECTION] enums
 */
 
 //-----------------------------------------------------------------------------
@@ -26,6 +28,31 @@ Index of this file:
 
         unstable APIs:
         * plCollisionI
+        * plJobI (only for PL_BVH_BUILD_FLAGS_PARALLEL)
+
+    Building:
+        "build" uses a binned surface area heuristic (SAH) builder. The old
+        spatial midpoint builder is still available through "build_ex" with
+        PL_BVH_BUILD_FLAGS_MIDPOINT (faster to build, slower to query).
+        PL_BVH_BUILD_FLAGS_PARALLEL builds large subtrees concurrently using
+        plJobI (job system must be initialized).
+
+    Layout:
+        Nodes are 32 bytes. The children of an interior node are stored next to
+        each other so only the first child is stored. After a build, nodes are
+        in depth first order. Tree depth is limited to PL_BVH_MAX_DEPTH so
+        queries use a fixed size stack.
+
+    Updating:
+        "refit" recomputes bounds from new primitive AABBs without changing the
+        tree. This is O(n) and allocation free but quality degrades as
+        primitives move far from where they were built.
+
+        "insert", "remove", & "update" only touch the path from the primitive's
+        leaf to the root (O(log n)) and rebalance it with tree rotations. They
+        are meant for mostly static scenes with a few moving primitives. Leaves
+        created by a build may contain several primitives. Removing one of them
+        leaves that leaf's bounds conservative until the next refit or build.
 */
 
 //-----------------------------------------------------------------------------
@@ -43,7 +70,7 @@ extern "C" {
 // [SECTION] APIs
 //-----------------------------------------------------------------------------
 
-#define plBVHI_version {0, 2, 0}
+#define plBVHI_version {0, 4, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -54,6 +81,14 @@ extern "C" {
 #include <stdbool.h>
 #include "pl_math.h"
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#ifndef PL_BVH_MAX_DEPTH
+    #define PL_BVH_MAX_DEPTH 64
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations
 //-----------------------------------------------------------------------------
@@ -62,6 +97,9 @@ extern "C" {
 typedef struct _plBVH     plBVH;
 typedef struct _plBVHNode plBVHNode;
 
+// enums/flags
+typedef int plBVHBuildFlags; // -> enum _plBVHBuildFlags // Flags:
+
 // callback
 typedef bool (*plBVHCallback)(uint32_t index, void* userData);
 
@@ -78,11 +116,25 @@ PL_API void pl_bvh_cleanup              (plBVH*);
 
 // basic usage (stable)
 PL_API void pl_bvh_build                (plBVH*, const plAABB*, uint32_t count);
+PL_API void pl_bvh_build_ex             (plBVH*, const plAABB*, uint32_t count, plBVHBuildFlags);
+
+// updating (experimental)
+//   - indices are primitive indices (same as those passed to the callbacks)
+//   - refit: AABBs must cover all primitive indices in the tree
+PL_API void pl_bvh_refit                (plBVH*, const plAABB*, uint32_t count);
+PL_API void pl_bvh_insert               (plBVH*, uint32_t index, plAABB);
+PL_API void pl_bvh_remove               (plBVH*, uint32_t index);
+PL_API void pl_bvh_update               (plBVH*, uint32_t index, plAABB);
 
 // intersects (stable)
 PL_API void pl_bvh_intersects_aabb      (plBVH*, plAABB, plBVHCallback, void* userData);
 PL_API bool pl_bvh_intersects_aabb_first(plBVH*, plAABB, plBVHCallback, void* userData);
 
+// intersects (experimental)
+//   - leaves are visited nearest child first; return true from callback to stop
+//   - returns true if stopped by callback
+PL_API bool pl_bvh_intersects_ray       (plBVH*, plRay, plBVHCallback, void* userData);
+
 // helpers
 PL_API bool pl_bvh_traverse             (plBVH*, plBVHNode** nodeOut, uint32_t* indexOut);
 
@@ -96,12 +148,22 @@ typedef struct _plBVHI
     void (*cleanup)(plBVH*);
 
     // basic usage (stable)
-    void (*build)(plBVH*, const plAABB*, uint32_t count);
-    
+    void (*build)   (plBVH*, const plAABB*, uint32_t count);
+    void (*build_ex)(plBVH*, const plAABB*, uint32_t count, plBVHBuildFlags);
+
+    // updating (experimental)
+    void (*refit) (plBVH*, const plAABB*, uint32_t count);
+    void (*insert)(plBVH*, uint32_t index, plAABB);
+    void (*remove)(plBVH*, uint32_t index);
+    void (*update)(plBVH*, uint32_t index, plAABB);
+
     // intersects (stable)
     void (*intersects_aabb)      (plBVH*, plAABB, plBVHCallback, void* userData);
     bool (*intersects_aabb_first)(plBVH*, plAABB, plBVHCallback, void* userData);
 
+    // intersects (experimental)
+    bool (*intersects_ray)(plBVH*, plRay, plBVHCallback, void* userData);
+
     // helpers
     bool (*traverse)(plBVH*, plBVHNode** nodeOut, uint32_t* indexOut);
 } plBVHI;
@@ -115,23 +177,39 @@ typedef struct _plBVHNode
     plAABB   tAABB;
 
     // [INTERNAL]
-    uint32_t _uLeft;   // if not leaf, index into left node (+1 for right node)
-    uint32_t _uOffset; // offset into leaf indices
-    uint32_t _uCount;  // leaf node if > 0
-    uint32_t _uTraverseOffset;
+    uint32_t _uIndex; // leaf: offset into leaf indices, otherwise: first child (second child is next node)
+    uint32_t _uCount; // leaf node if > 0
 } plBVHNode;
 
 typedef struct _plBVH
 {
     // [INTERNAL]
     plBVHNode*  _ptNodes;
+    uint32_t*   _puNodeParents;
+    uint32_t*   _puNodeHeights;      // leaves are 0
+    uint32_t    _uNodeCount;         // includes free nodes
+    uint32_t    _uNodeCapacity;
+    uint32_t    _uFreeNode;          // first node of free pair list (0 if empty)
     uint32_t*   _puLeafIndices;
-    uint32_t    _uNodeCount;
-    uint8_t*    _puAllocation;
-    uint32_t    _uLeafCount;
+    uint32_t    _uLeafCount;         // includes free slots
+    uint32_t    _uLeafCapacity;
+    uint32_t    _uFreeLeaf;          // free slot list (slot + 1, 0 if empty)
+    uint32_t*   _puPrimitiveLeaves;  // primitive index -> leaf node (UINT32_MAX if not in tree)
+    uint32_t    _uPrimitiveCapacity;
     plBVHNode** _sbtNodeStack;
 } plBVH;
 
+//-----------------------------------------------------------------------------
+// [SECTION] enums
+//-----------------------------------------------------------------------------
+
+enum _plBVHBuildFlags
+{
+    PL_BVH_BUILD_FLAGS_NONE     = 0,      // binned SAH
+    PL_BVH_BUILD_FLAGS_MIDPOINT = 1 << 0, // split at spatial midpoint of longest axis
+    PL_BVH_BUILD_FLAGS_PARALLEL = 1 << 1, // build large subtrees with plJobI
+};
+
 #ifdef __cplusplus
 }
 #endif
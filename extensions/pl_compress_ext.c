@@ -6,9 +6,11 @@
 Index of this file:
 // [SECTION] notes
 // [SECTION] includes
-// [SECTION] global data
+// [SECTION] defines
+// [SECTION] internal structs
 // [SECTION] helper macros
 // [SECTION] internal api
+// [SECTION] fast codec
 // [SECTION] public api implementation
 // [SECTION] extension loading
 */
@@ -21,7 +23,13 @@ Index of this file:
     The implementation here is based on "stb_compress". Light modifications
     were made to match the code style of this code base. Other changes were
     made to remove unnecessary features and to remove static analysis
-    warnings.
+    warnings. Encoder & decoder state was moved from globals into structs
+    passed through the calls so the functions are reentrant.
+
+    The fast codec writes LZ4 block format sequences (4 bit literal & match
+    lengths in a token, 16 bit offsets). It follows the LZ4 end of block
+    rules (last 5 bytes are literals, last match starts at least 12 bytes
+    before the end) so the decoder can copy in 8/16 byte chunks.
 */
 
 //-----------------------------------------------------------------------------
@@ -46,30 +54,56 @@ Index of this file:
 #endif
 
 //-----------------------------------------------------------------------------
-// [SECTION] global data
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_COMPRESS_WINDOW    0x40000 // 256K
+#define PL_COMPRESS_HASH_SIZE 32768
+
+// fast codec
+#define PL_COMPRESS_FAST_HASH_LOG      16
+#define PL_COMPRESS_FAST_MIN_MATCH     4
+#define PL_COMPRESS_FAST_MAX_OFFSET    65535
+#define PL_COMPRESS_FAST_LAST_LITERALS 5
+#define PL_COMPRESS_FAST_MATCH_LIMIT   12 // last match must start this far from the end
+#define PL_COMPRESS_FAST_HEADER_SIZE   8
+
 //-----------------------------------------------------------------------------
+// [SECTION] internal structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plCompressContext
+{
+    uint8_t** ppuHashTable;     // default codec
+    uint32_t* puFastHashTable;  // fast codec (positions + 1, 0 is empty)
+} plCompressContext;
+
+typedef struct _plCompressEncoder
+{
+    uint8_t* puOut;
+    uint32_t uOutBytes;
+    uint32_t uOutBytesAvailable;
+    uint32_t uRunningAdler;
+} plCompressEncoder;
 
-static uint8_t* gpuOut              = NULL;
-static uint32_t guOutBytes          = 0;
-static uint32_t guOutBytesAvailable = 0;
-static int      gpiWindow           = 0x40000; // 256K
-static uint32_t guHashSize          = 32768;
-static uint32_t guRunningAdler      = 0;
-static uint8_t* gpuBarrier          = NULL;
-static uint8_t* gpuBarrier2         = NULL;
-static uint8_t* gpuBarrier3         = NULL;
-static uint8_t* gpuBarrier4         = NULL;
-static uint8_t* gpuDOut             = NULL;
+typedef struct _plCompressDecoder
+{
+    uint8_t*       puDOut;
+    uint8_t*       puBarrier;  // end of output
+    const uint8_t* puBarrier2; // start of input
+    const uint8_t* puBarrier3; // end of input
+    uint8_t*       puBarrier4; // start of output
+} plCompressDecoder;
 
 //-----------------------------------------------------------------------------
 // [SECTION] helper macros
 //-----------------------------------------------------------------------------
 
-#define pl__out(v) do { ++guOutBytes; if(guOutBytes > guOutBytesAvailable) gpuOut = NULL; if (gpuOut) *gpuOut++ = (uint8_t) (v); } while (0)
+#define pl__out(e, v) do { ++(e)->uOutBytes; if((e)->uOutBytes > (e)->uOutBytesAvailable) (e)->puOut = NULL; if ((e)->puOut) *(e)->puOut++ = (uint8_t) (v); } while (0)
 
-static void pl__out2(uint32_t v) { pl__out(v >> 8); pl__out(v); }
-static void pl__out3(uint32_t v) { pl__out(v >> 16); pl__out(v >> 8); pl__out(v); }
-static void pl__out4(uint32_t v) { pl__out(v >> 24); pl__out(v >> 16); pl__out(v >> 8 ); pl__out(v); }
+static void pl__out2(plCompressEncoder* e, uint32_t v) { pl__out(e, v >> 8); pl__out(e, v); }
+static void pl__out3(plCompressEncoder* e, uint32_t v) { pl__out(e, v >> 16); pl__out(e, v >> 8); pl__out(e, v); }
+static void pl__out4(plCompressEncoder* e, uint32_t v) { pl__out(e, v >> 24); pl__out(e, v >> 16); pl__out(e, v >> 8 ); pl__out(e, v); }
 
 // note that you can play with the hashing functions all you
 // want without needing to change the decompressor
@@ -82,7 +116,7 @@ static void pl__out4(uint32_t v) { pl__out(v >> 24); pl__out(v >> 16); pl__out(v
 //-----------------------------------------------------------------------------
 
 static uint32_t
-pl__adler32(uint32_t uAdler32, uint8_t* puBuffer, uint32_t uLength)
+pl__adler32(uint32_t uAdler32, const uint8_t* puBuffer, uint32_t uLength)
 {
     uint32_t uS1 = uAdler32 & 0xffff;
     uint32_t uS2 = uAdler32 >> 16;
@@ -121,7 +155,7 @@ pl__adler32(uint32_t uAdler32, uint8_t* puBuffer, uint32_t uLength)
 }
 
 static uint32_t
-pl__matchlen(uint8_t* pM1, uint8_t* pM2, uint32_t uMaxLength)
+pl__matchlen(const uint8_t* pM1, const uint8_t* pM2, uint32_t uMaxLength)
 {
     uint32_t i = 0;
     for (i=0; i < uMaxLength; ++i)
@@ -133,32 +167,32 @@ pl__matchlen(uint8_t* pM1, uint8_t* pM2, uint32_t uMaxLength)
 }
 
 static void
-pl__out_literals(uint8_t* puIn, ptrdiff_t tNumlit)
+pl__out_literals(plCompressEncoder* ptEncoder, const uint8_t* puIn, ptrdiff_t tNumlit)
 {
     while(tNumlit > 65536)
     {
-        pl__out_literals(puIn, 65536);
+        pl__out_literals(ptEncoder, puIn, 65536);
         puIn += 65536;
         tNumlit -= 65536;
     }
 
     if (tNumlit == 0);
     else if (tNumlit <= 32)
-        pl__out(0x000020 + (uint32_t)tNumlit - 1);
+        pl__out(ptEncoder, 0x000020 + (uint32_t)tNumlit - 1);
     else if (tNumlit <= 2048)
-        pl__out2(0x000800 + (uint32_t)tNumlit - 1);
+        pl__out2(ptEncoder, 0x000800 + (uint32_t)tNumlit - 1);
     else // tNumlit <= 65536)
-        pl__out3(0x070000 + (uint32_t)tNumlit - 1);
+        pl__out3(ptEncoder, 0x070000 + (uint32_t)tNumlit - 1);
 
-    guOutBytes += (uint32_t)tNumlit;
-    if (gpuOut)
+    ptEncoder->uOutBytes += (uint32_t)tNumlit;
+    if (ptEncoder->puOut)
     {
-        if(guOutBytes > guOutBytesAvailable)
-            gpuOut = NULL;
+        if(ptEncoder->uOutBytes > ptEncoder->uOutBytesAvailable)
+            ptEncoder->puOut = NULL;
         else
         {
-            memcpy(gpuOut, puIn, tNumlit);
-            gpuOut += tNumlit;
+            memcpy(ptEncoder->puOut, puIn, tNumlit);
+            ptEncoder->puOut += tNumlit;
         }
     }
     
@@ -173,13 +207,13 @@ pl__not_crap(int iBest, int iDist)
 }
 
 static int
-pl__compress_chunk(uint8_t* puHistory, uint8_t* puStart, uint8_t* puEnd,
-    int iLength, int* piPendingLiterals, uint8_t** ppuCHash, uint32_t uMask)
+pl__compress_chunk(plCompressEncoder* ptEncoder, const uint8_t* puHistory, const uint8_t* puStart, const uint8_t* puEnd,
+    int iLength, int* piPendingLiterals, const uint8_t** ppuCHash, uint32_t uMask)
 {
-    int iWindow = gpiWindow;
+    int iWindow = PL_COMPRESS_WINDOW;
     uint32_t uMatchMax  = 0;
-    uint8_t* puLitStart = puStart - *piPendingLiterals;
-    uint8_t* puQ        = puStart;
+    const uint8_t* puLitStart = puStart - *piPendingLiterals;
+    const uint8_t* puQ        = puStart;
 
     #define PL__SCRAMBLE(h) (((h) + ((h) >> 16)) & uMask)
 
@@ -194,7 +228,7 @@ pl__compress_chunk(uint8_t* puHistory, uint8_t* puStart, uint8_t* puEnd,
         uint32_t uH3 = 0;
         uint32_t uH4 = 0;
         uint32_t uH = 0;
-        uint8_t* puT = NULL;
+        const uint8_t* puT = NULL;
         int iBest = 2;
         int iDist = 0;
 
@@ -254,49 +288,49 @@ pl__compress_chunk(uint8_t* puHistory, uint8_t* puStart, uint8_t* puEnd,
         }
         else if(iBest <= 0x80 && iDist <= 0x100)
         {
-            pl__out_literals(puLitStart, puQ - puLitStart);
+            pl__out_literals(ptEncoder, puLitStart, puQ - puLitStart);
             puLitStart = (puQ += iBest);
-            pl__out(0x80 + iBest - 1);
-            pl__out(iDist - 1);
+            pl__out(ptEncoder, 0x80 + iBest - 1);
+            pl__out(ptEncoder, iDist - 1);
         }
         else if(iBest > 5 && iBest <= 0x100 && iDist <= 0x4000)
         {
-            pl__out_literals(puLitStart, puQ - puLitStart);
+            pl__out_literals(ptEncoder, puLitStart, puQ - puLitStart);
             puLitStart = (puQ += iBest);
-            pl__out2(0x4000 + iDist - 1);
-            pl__out(iBest - 1);
+            pl__out2(ptEncoder, 0x4000 + iDist - 1);
+            pl__out(ptEncoder, iBest - 1);
         }
         else if(iBest > 7 && iBest <= 0x100 && iDist <= 0x80000)
         {
-            pl__out_literals(puLitStart, puQ - puLitStart);
+            pl__out_literals(ptEncoder, puLitStart, puQ - puLitStart);
             puLitStart = (puQ += iBest);
-            pl__out3(0x180000 + iDist - 1);
-            pl__out(iBest - 1);
+            pl__out3(ptEncoder, 0x180000 + iDist - 1);
+            pl__out(ptEncoder, iBest - 1);
         }
         else if(iBest > 8 && iBest <= 0x10000 && iDist <= 0x80000)
         {
-            pl__out_literals(puLitStart, puQ - puLitStart);
+            pl__out_literals(ptEncoder, puLitStart, puQ - puLitStart);
             puLitStart = (puQ += iBest);
-            pl__out3(0x100000 + iDist - 1);
-            pl__out2(iBest - 1);
+            pl__out3(ptEncoder, 0x100000 + iDist - 1);
+            pl__out2(ptEncoder, iBest - 1);
         }
         else if (iBest > 9 && iDist <= 0x1000000)
         {
             if(iBest > 65536)
                 iBest = 65536;
-            pl__out_literals(puLitStart, puQ - puLitStart);
+            pl__out_literals(ptEncoder, puLitStart, puQ - puLitStart);
             puLitStart = (puQ += iBest);
             if(iBest <= 0x100)
             {
-                pl__out(0x06);
-                pl__out3(iDist - 1);
-                pl__out(iDist - 1);
+                pl__out(ptEncoder, 0x06);
+                pl__out3(ptEncoder, iDist - 1);
+                pl__out(ptEncoder, iDist - 1);
             }
             else
             {
-                pl__out(0x04);
-                pl__out3(iDist - 1);
-                pl__out2(iBest - 1);
+                pl__out(ptEncoder, 0x04);
+                pl__out3(ptEncoder, iDist - 1);
+                pl__out2(ptEncoder, iBest - 1);
             }
         }
         else // fallback literals if no match was a balanced tradeoff
@@ -312,42 +346,37 @@ pl__compress_chunk(uint8_t* puHistory, uint8_t* puStart, uint8_t* puEnd,
     // the literals are everything from lit_start to q
     *piPendingLiterals = (int) (puQ - puLitStart);
 
-    guRunningAdler = pl__adler32(guRunningAdler, puStart, (int) (puQ - puStart));
+    ptEncoder->uRunningAdler = pl__adler32(ptEncoder->uRunningAdler, puStart, (int) (puQ - puStart));
     return (int)(puQ - puStart);
 }
 
 static int
-pl__compress_inner(uint8_t* puInput, uint32_t uLength)
+pl__compress_inner(plCompressEncoder* ptEncoder, const uint8_t** ppuCHash, const uint8_t* puInput, uint32_t uLength)
 {
     int iLiterals = 0;
     uint32_t uLen = 0;
 
-    uint8_t** ppuCHash = PL_ALLOC(guHashSize * sizeof(uint8_t*));
-    if (ppuCHash == NULL)
-        return 0; // failure
-    for (uint32_t i = 0; i < guHashSize; ++i)
+    for (uint32_t i = 0; i < PL_COMPRESS_HASH_SIZE; ++i)
         ppuCHash[i] = NULL;
 
     // stream signature
-    pl__out(0x57);
-    pl__out(0xbc);
-    pl__out2(0);
+    pl__out(ptEncoder, 0x57);
+    pl__out(ptEncoder, 0xbc);
+    pl__out2(ptEncoder, 0);
 
-    pl__out4(0); // 64-bit length requires 32-bit leading 0
-    pl__out4(uLength);
-    pl__out4(gpiWindow);
+    pl__out4(ptEncoder, 0); // 64-bit length requires 32-bit leading 0
+    pl__out4(ptEncoder, uLength);
+    pl__out4(ptEncoder, PL_COMPRESS_WINDOW);
 
-    guRunningAdler = 1;
+    ptEncoder->uRunningAdler = 1;
 
-    uLen = pl__compress_chunk(puInput, puInput, puInput + uLength, uLength, &iLiterals, ppuCHash, guHashSize - 1);
+    uLen = pl__compress_chunk(ptEncoder, puInput, puInput, puInput + uLength, uLength, &iLiterals, ppuCHash, PL_COMPRESS_HASH_SIZE - 1);
     PL_ASSERT(uLen == uLength);
 
-    pl__out_literals(puInput + uLength - iLiterals, iLiterals);
-
-    PL_FREE(ppuCHash);
+    pl__out_literals(ptEncoder, puInput + uLength - iLiterals, iLiterals);
 
-    pl__out2(0x05fa); // end opcode
-    pl__out4(guRunningAdler);
+    pl__out2(ptEncoder, 0x05fa); // end opcode
+    pl__out4(ptEncoder, ptEncoder->uRunningAdler);
     return 1; // success
 }
 
@@ -358,68 +387,70 @@ pl__decompress_length(const uint8_t* puInput)
 }
 
 static void
-pl__match(const uint8_t* puData, uint32_t uLength)
+pl__match(plCompressDecoder* ptDecoder, const uint8_t* puData, uint32_t uLength)
 {
     // INVERSE of memmove... write each byte before copying the next...
-    PL_ASSERT(gpuDOut + uLength <= gpuBarrier);
-    if(gpuDOut + uLength > gpuBarrier)
+    PL_ASSERT(ptDecoder->puDOut + uLength <= ptDecoder->puBarrier);
+    if(ptDecoder->puDOut + uLength > ptDecoder->puBarrier)
     {
-        gpuDOut += uLength;
+        ptDecoder->puDOut += uLength;
         return;
     }
 
-    if(puData < gpuBarrier4)
+    if(puData < ptDecoder->puBarrier4)
     {
-        gpuDOut = gpuBarrier + 1;
+        ptDecoder->puDOut = ptDecoder->puBarrier + 1;
         return;
     }
     
+    uint8_t* puDOut = ptDecoder->puDOut;
     while(uLength--)
-        *gpuDOut++ = *puData++;
+        *puDOut++ = *puData++;
+    ptDecoder->puDOut = puDOut;
 }
 
 static void
-pl__lit(const uint8_t* puData, uint32_t uLength)
+pl__lit(plCompressDecoder* ptDecoder, const uint8_t* puData, uint32_t uLength)
 {
-    PL_ASSERT(gpuDOut + uLength <= gpuBarrier);
-    if(gpuDOut + uLength > gpuBarrier)
+    PL_ASSERT(ptDecoder->puDOut + uLength <= ptDecoder->puBarrier);
+    if(ptDecoder->puDOut + uLength > ptDecoder->puBarrier)
     {
-        gpuDOut += uLength;
+        ptDecoder->puDOut += uLength;
         return;
     }
 
-    if(puData < gpuBarrier2)
+    if(puData < ptDecoder->puBarrier2)
     {
-        gpuDOut = gpuBarrier + 1;
+        ptDecoder->puDOut = ptDecoder->puBarrier + 1;
         return;
     }
 
-    memcpy(gpuDOut, puData, uLength);
-    gpuDOut += uLength;
+    memcpy(ptDecoder->puDOut, puData, uLength);
+    ptDecoder->puDOut += uLength;
 }
 
 #define pl__in2(x) ((puI[x] << 8) + puI[(x)+1])
 #define pl__in3(x) ((puI[x] << 16) + pl__in2((x)+1))
 #define pl__in4(x) ((puI[x] << 24) + pl__in3((x)+1))
 
-static uint8_t*
-pl__decompress_token(uint8_t* puI)
+static const uint8_t*
+pl__decompress_token(plCompressDecoder* ptDecoder, const uint8_t* puI)
 {
     if (*puI >= 0x20) // use fewer if's for cases that expand small
     { 
         if (*puI >= 0x80)
         {
-            pl__match(gpuDOut - puI[1] - 1, puI[0] - 0x80 + 1);
+            pl__match(ptDecoder, ptDecoder->puDOut - puI[1] - 1, puI[0] - 0x80 + 1);
             puI += 2;
         }
         else if (*puI >= 0x40) 
         {
-            pl__match(gpuDOut - (pl__in2(0) - 0x4000 + 1), puI[2] + 1);
+            pl__match(ptDecoder, ptDecoder->puDOut - (pl__in2(0) - 0x4000 + 1), puI[2] + 1);
             puI += 3;
         }
         else /* *i >= 0x20 */
         {
-            pl__lit(puI + 1, puI[0] - 0x20 + 1);
+            pl__lit(ptDecoder, puI + 1, puI[0] - 0x20 + 1);
             puI += 1 + (puI[0] - 0x20 + 1);
         }
     }
@@ -427,32 +458,32 @@ pl__decompress_token(uint8_t* puI)
     { 
         if (*puI >= 0x18)
         {
-            pl__match(gpuDOut - (pl__in3(0) - 0x180000 + 1), puI[3] + 1);
+            pl__match(ptDecoder, ptDecoder->puDOut - (pl__in3(0) - 0x180000 + 1), puI[3] + 1);
             puI += 4;
         }
         else if (*puI >= 0x10)
         {
-            pl__match(gpuDOut - (pl__in3(0) - 0x100000 + 1), pl__in2(3) + 1);
+            pl__match(ptDecoder, ptDecoder->puDOut - (pl__in3(0) - 0x100000 + 1), pl__in2(3) + 1);
             puI += 5;
         }
         else if (*puI >= 0x08)
         {
-            pl__lit(puI + 2, pl__in2(0) - 0x0800 + 1);
+            pl__lit(ptDecoder, puI + 2, pl__in2(0) - 0x0800 + 1);
             puI += 2 + (pl__in2(0) - 0x0800 + 1);
         }
         else if (*puI == 0x07)
         {
-            pl__lit(puI + 3, pl__in2(1) + 1);
+            pl__lit(ptDecoder, puI + 3, pl__in2(1) + 1);
             puI += 3 + (pl__in2(1) + 1);
         }
         else if (*puI == 0x06)
         {
-            pl__match(gpuDOut - (pl__in3(1) + 1), puI[4] + 1);
+            pl__match(ptDecoder, ptDecoder->puDOut - (pl__in3(1) + 1), puI[4] + 1);
             puI += 5;
         }
         else if (*puI == 0x04)
         {
-            pl__match(gpuDOut - (pl__in3(1) + 1), pl__in2(4) + 1);
+            pl__match(ptDecoder, ptDecoder->puDOut - (pl__in3(1) + 1), pl__in2(4) + 1);
             puI += 6;
         }
     }
@@ -460,7 +491,7 @@ pl__decompress_token(uint8_t* puI)
 }
 
 static uint32_t
-pl__decompress(uint8_t* puOutput, uint8_t* puI, uint32_t uLength)
+pl__decompress(uint8_t* puOutput, const uint8_t* puI, uint32_t uLength)
 {
     uint32_t uOLen = 0;
     if (pl__in4(0) != 0x57bC0000)
@@ -468,23 +499,26 @@ pl__decompress(uint8_t* puOutput, uint8_t* puI, uint32_t uLength)
     if (pl__in4(4) != 0) // error! stream is > 4GB
         return 0; 
     uOLen = pl__decompress_length(puI);
-    gpuBarrier2 = puI;
-    gpuBarrier3 = puI + uLength;
-    gpuBarrier = puOutput + uOLen;
-    gpuBarrier4 = puOutput;
+
+    plCompressDecoder tDecoder = {
+        .puDOut     = puOutput,
+        .puBarrier  = puOutput + uOLen,
+        .puBarrier2 = puI,
+        .puBarrier3 = puI + uLength,
+        .puBarrier4 = puOutput
+    };
     puI += 16;
 
-    gpuDOut = puOutput;
     while (1)
     {
-        uint8_t* puOldI = puI;
-        puI = pl__decompress_token(puI);
+        const uint8_t* puOldI = puI;
+        puI = pl__decompress_token(&tDecoder, puI);
         if (puI == puOldI)
         {
             if (*puI == 0x05 && puI[1] == 0xfa)
             {
-                PL_ASSERT(gpuDOut == puOutput + uOLen);
-                if (gpuDOut != puOutput + uOLen)
+                PL_ASSERT(tDecoder.puDOut == puOutput + uOLen);
+                if (tDecoder.puDOut != puOutput + uOLen)
                     return 0;
                 if (pl__adler32(1, puOutput, uOLen) != (uint32_t) pl__in4(2))
                     return 0;
@@ -496,35 +530,387 @@ pl__decompress(uint8_t* puOutput, uint8_t* puI, uint32_t uLength)
                 return 0;
             }
         }
-        PL_ASSERT(gpuDOut <= puOutput + uOLen);
-        if (gpuDOut > puOutput + uOLen)
+        PL_ASSERT(tDecoder.puDOut <= puOutput + uOLen);
+        if (tDecoder.puDOut > puOutput + uOLen)
+            return 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] fast codec
+//-----------------------------------------------------------------------------
+
+static inline uint32_t
+pl__fast_read32(const uint8_t* puData)
+{
+    uint32_t uValue = 0;
+    memcpy(&uValue, puData, sizeof(uint32_t));
+    return uValue;
+}
+
+static inline uint32_t
+pl__fast_hash(uint32_t uValue)
+{
+    return (uValue * 2654435761u) >> (32 - PL_COMPRESS_FAST_HASH_LOG);
+}
+
+static inline uint32_t
+pl__fast_count(const uint8_t* puMatch, const uint8_t* puQ, const uint8_t* puLimit)
+{
+    // compare 8 bytes at a time then finish the mismatching word bytewise
+    const uint8_t* puStart = puQ;
+    while(puQ + 8 <= puLimit)
+    {
+        uint64_t uA = 0;
+        uint64_t uB = 0;
+        memcpy(&uA, puMatch, 8);
+        memcpy(&uB, puQ, 8);
+        if(uA != uB)
+            break;
+        puMatch += 8;
+        puQ += 8;
+    }
+    while(puQ < puLimit && *puMatch == *puQ)
+    {
+        puMatch++;
+        puQ++;
+    }
+    return (uint32_t)(puQ - puStart);
+}
+
+static uint8_t*
+pl__fast_out_sequence(uint8_t* puOp, const uint8_t* puLiterals, uint32_t uLiteralLength, uint32_t uOffset, uint32_t uMatchLength)
+{
+    // token: literal length (high 4 bits), match length - 4 (low 4 bits),
+    // 15 means the length continues in following bytes (255 = keep going)
+    uint8_t* puToken = puOp++;
+    uint32_t uToken = 0;
+    if(uLiteralLength >= 15)
+    {
+        uToken = 15 << 4;
+        uint32_t uRemaining = uLiteralLength - 15;
+        while(uRemaining >= 255)
+        {
+            *puOp++ = 255;
+            uRemaining -= 255;
+        }
+        *puOp++ = (uint8_t)uRemaining;
+    }
+    else
+        uToken = uLiteralLength << 4;
+
+    memcpy(puOp, puLiterals, uLiteralLength);
+    puOp += uLiteralLength;
+
+    if(uMatchLength == 0) // last sequence is literals only
+    {
+        *puToken = (uint8_t)uToken;
+        return puOp;
+    }
+
+    *puOp++ = (uint8_t)(uOffset & 0xff);
+    *puOp++ = (uint8_t)(uOffset >> 8);
+
+    const uint32_t uMatchCode = uMatchLength - PL_COMPRESS_FAST_MIN_MATCH;
+    if(uMatchCode >= 15)
+    {
+        uToken |= 15;
+        uint32_t uRemaining = uMatchCode - 15;
+        while(uRemaining >= 255)
+        {
+            *puOp++ = 255;
+            uRemaining -= 255;
+        }
+        *puOp++ = (uint8_t)uRemaining;
+    }
+    else
+        uToken |= uMatchCode;
+    *puToken = (uint8_t)uToken;
+    return puOp;
+}
+
+static uint32_t
+pl__fast_compress(uint32_t* puHashTable, const uint8_t* puInput, uint32_t uLength, uint8_t* puOutput)
+{
+    // output must hold at least pl_compress_compress_bound() bytes
+
+    // header: signature + uncompressed size (big endian like default codec)
+    uint8_t* puOp = puOutput;
+    *puOp++ = 'P';
+    *puOp++ = 'L';
+    *puOp++ = 'Z';
+    *puOp++ = '4';
+    *puOp++ = (uint8_t)(uLength >> 24);
+    *puOp++ = (uint8_t)(uLength >> 16);
+    *puOp++ = (uint8_t)(uLength >> 8);
+    *puOp++ = (uint8_t)uLength;
+
+    const uint8_t* puAnchor = puInput;
+    const uint8_t* puEnd = puInput + uLength;
+
+    if(uLength > PL_COMPRESS_FAST_MATCH_LIMIT)
+    {
+        memset(puHashTable, 0, sizeof(uint32_t) << PL_COMPRESS_FAST_HASH_LOG);
+
+        const uint8_t* puMatchLimit = puEnd - PL_COMPRESS_FAST_LAST_LITERALS;
+        const uint8_t* puInputLimit = puEnd - PL_COMPRESS_FAST_MATCH_LIMIT;
+        const uint8_t* puQ = puInput;
+
+        while(true)
+        {
+            // find a match, skipping faster through incompressible data
+            const uint8_t* puMatch = NULL;
+            uint32_t uAttempts = 1 << 6;
+            while(true)
+            {
+                if(puQ >= puInputLimit)
+                    goto last_literals;
+
+                const uint32_t uSequence = pl__fast_read32(puQ);
+                const uint32_t uHash = pl__fast_hash(uSequence);
+                const uint32_t uCandidate = puHashTable[uHash];
+                puHashTable[uHash] = (uint32_t)(puQ - puInput) + 1;
+
+                if(uCandidate > 0)
+                {
+                    puMatch = puInput + uCandidate - 1;
+                    if(puQ - puMatch <= PL_COMPRESS_FAST_MAX_OFFSET && pl__fast_read32(puMatch) == uSequence)
+                        break;
+                }
+                puQ += uAttempts++ >> 6;
+            }
+
+            // extend backwards into pending literals
+            while(puQ > puAnchor && puMatch > puInput && puQ[-1] == puMatch[-1])
+            {
+                puQ--;
+                puMatch--;
+            }
+
+            const uint32_t uMatchLength = PL_COMPRESS_FAST_MIN_MATCH + pl__fast_count(puMatch + PL_COMPRESS_FAST_MIN_MATCH, puQ + PL_COMPRESS_FAST_MIN_MATCH, puMatchLimit);
+            puOp = pl__fast_out_sequence(puOp, puAnchor, (uint32_t)(puQ - puAnchor), (uint32_t)(puQ - puMatch), uMatchLength);
+            puQ += uMatchLength;
+            puAnchor = puQ;
+
+            // a position inside the match helps find the next one
+            if(puQ < puInputLimit)
+                puHashTable[pl__fast_hash(pl__fast_read32(puQ - 2))] = (uint32_t)(puQ - 2 - puInput) + 1;
+        }
+    }
+
+last_literals:
+    puOp = pl__fast_out_sequence(puOp, puAnchor, (uint32_t)(puEnd - puAnchor), 0, 0);
+    return (uint32_t)(puOp - puOutput);
+}
+
+static uint32_t
+pl__fast_decompress(const uint8_t* puInput, uint32_t uInputSize, uint8_t* puOutput, uint32_t uOutputSize)
+{
+    // every length & offset is checked against the buffers, chunked copies
+    // are only used when both buffers have room for the overshoot
+    const uint8_t* puI = puInput + PL_COMPRESS_FAST_HEADER_SIZE;
+    const uint8_t* puIEnd = puInput + uInputSize;
+    uint8_t* puOp = puOutput;
+    uint8_t* puOEnd = puOutput + uOutputSize;
+
+    while(puI < puIEnd)
+    {
+        const uint32_t uToken = *puI++;
+
+        size_t szLiteralLength = uToken >> 4;
+        if(szLiteralLength == 15)
+        {
+            uint32_t uByte = 0;
+            do
+            {
+                if(puI >= puIEnd)
+                    return 0;
+                uByte = *puI++;
+                szLiteralLength += uByte;
+            } while(uByte == 255);
+        }
+
+        if(szLiteralLength > (size_t)(puIEnd - puI) || szLiteralLength > (size_t)(puOEnd - puOp))
+            return 0;
+        if(szLiteralLength <= 16 && puIEnd - puI >= 16 && puOEnd - puOp >= 16)
+            memcpy(puOp, puI, 16);
+        else
+            memcpy(puOp, puI, szLiteralLength);
+        puOp += szLiteralLength;
+        puI += szLiteralLength;
+
+        if(puI == puIEnd) // last sequence has no match
+            break;
+
+        if(puIEnd - puI < 2)
+            return 0;
+        const size_t szOffset = (size_t)puI[0] | ((size_t)puI[1] << 8);
+        puI += 2;
+        if(szOffset == 0 || szOffset > (size_t)(puOp - puOutput))
+            return 0;
+
+        size_t szMatchLength = uToken & 15;
+        if(szMatchLength == 15)
+        {
+            uint32_t uByte = 0;
+            do
+            {
+                if(puI >= puIEnd)
+                    return 0;
+                uByte = *puI++;
+                szMatchLength += uByte;
+            } while(uByte == 255);
+        }
+        szMatchLength += PL_COMPRESS_FAST_MIN_MATCH;
+        if(szMatchLength > (size_t)(puOEnd - puOp))
             return 0;
+
+        const uint8_t* puMatch = puOp - szOffset;
+        uint8_t* puMatchEnd = puOp + szMatchLength;
+        if(szOffset >= 8 && (size_t)(puOEnd - puOp) >= szMatchLength + 8)
+        {
+            // chunks don't overlap their source & overshoot stays in output
+            do
+            {
+                memcpy(puOp, puMatch, 8);
+                puOp += 8;
+                puMatch += 8;
+            } while(puOp < puMatchEnd);
+        }
+        else
+        {
+            while(puOp < puMatchEnd)
+                *puOp++ = *puMatch++;
+        }
+        puOp = puMatchEnd;
     }
+    return puOp == puOEnd ? uOutputSize : 0;
+}
+
+static inline bool
+pl__fast_is_stream(const uint8_t* puInput, uint32_t uSize)
+{
+    return uSize >= PL_COMPRESS_FAST_HEADER_SIZE && puInput[0] == 'P' && puInput[1] == 'L' && puInput[2] == 'Z' && puInput[3] == '4';
+}
+
+static inline uint32_t
+pl__fast_decompress_length(const uint8_t* puInput)
+{
+    return ((uint32_t)puInput[4] << 24) + ((uint32_t)puInput[5] << 16) + ((uint32_t)puInput[6] << 8) + (uint32_t)puInput[7];
 }
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
 //-----------------------------------------------------------------------------
 
+plCompressContext*
+pl_compress_create_context(void)
+{
+    plCompressContext* ptContext = PL_ALLOC(sizeof(plCompressContext));
+    memset(ptContext, 0, sizeof(plCompressContext));
+    return ptContext;
+}
+
+void
+pl_compress_cleanup_context(plCompressContext* ptContext)
+{
+    if(ptContext == NULL)
+        return;
+    if(ptContext->ppuHashTable)
+        PL_FREE(ptContext->ppuHashTable);
+    if(ptContext->puFastHashTable)
+        PL_FREE(ptContext->puFastHashTable);
+    PL_FREE(ptContext);
+}
+
+uint32_t
+pl_compress_compress_bound(plCompressCodec tCodec, uint32_t uSize)
+{
+    if(tCodec == PL_COMPRESS_CODEC_FAST)
+        return PL_COMPRESS_FAST_HEADER_SIZE + uSize + uSize / 255 + 16;
+
+    // literal run headers cost less than 1 byte per 16 literals (matches
+    // never expand), plus header & trailer
+    return 16 + uSize + uSize / 16 + 1 + 6;
+}
+
+uint32_t
+pl_compress_compress_ex(plCompressContext* ptContext, plCompressCodec tCodec, const uint8_t* puDataIn, uint32_t uSize, uint8_t* puDataOut, uint32_t uSizeOut)
+{
+    if(tCodec == PL_COMPRESS_CODEC_FAST)
+    {
+        uint32_t* puHashTable = NULL;
+        if(ptContext)
+        {
+            if(ptContext->puFastHashTable == NULL)
+                ptContext->puFastHashTable = PL_ALLOC(sizeof(uint32_t) << PL_COMPRESS_FAST_HASH_LOG);
+            puHashTable = ptContext->puFastHashTable;
+        }
+        else
+            puHashTable = PL_ALLOC(sizeof(uint32_t) << PL_COMPRESS_FAST_HASH_LOG);
+
+        // encoder writes without checks so small output buffers go through
+        // a temporary one
+        uint32_t uResult = 0;
+        const uint32_t uBound = pl_compress_compress_bound(tCodec, uSize);
+        if(puDataOut && uSizeOut >= uBound)
+            uResult = pl__fast_compress(puHashTable, puDataIn, uSize, puDataOut);
+        else
+        {
+            uint8_t* puTemp = PL_ALLOC(uBound);
+            uResult = pl__fast_compress(puHashTable, puDataIn, uSize, puTemp);
+            if(puDataOut)
+                memcpy(puDataOut, puTemp, uResult < uSizeOut ? uResult : uSizeOut);
+            PL_FREE(puTemp);
+        }
+
+        if(ptContext == NULL)
+            PL_FREE(puHashTable);
+        return uResult;
+    }
+
+    const uint8_t** ppuHashTable = NULL;
+    if(ptContext)
+    {
+        if(ptContext->ppuHashTable == NULL)
+            ptContext->ppuHashTable = PL_ALLOC(PL_COMPRESS_HASH_SIZE * sizeof(uint8_t*));
+        ppuHashTable = (const uint8_t**)ptContext->ppuHashTable;
+    }
+    else
+        ppuHashTable = PL_ALLOC(PL_COMPRESS_HASH_SIZE * sizeof(uint8_t*));
+
+    plCompressEncoder tEncoder = {
+        .puOut              = puDataOut,
+        .uOutBytesAvailable = uSizeOut
+    };
+    pl__compress_inner(&tEncoder, ppuHashTable, puDataIn, uSize);
+
+    if(ptContext == NULL)
+        PL_FREE(ppuHashTable);
+    return tEncoder.uOutBytes;
+}
+
 uint32_t
 pl_compress_compress(uint8_t* puDataIn, uint32_t uSize, uint8_t* puDataOut, uint32_t uSizeOut)
 {
-    gpuOut = puDataOut;
-    guOutBytes = 0;
-    guOutBytesAvailable = uSizeOut;
-    pl__compress_inner(puDataIn, uSize);
-    return guOutBytes;
+    return pl_compress_compress_ex(NULL, PL_COMPRESS_CODEC_DEFAULT, puDataIn, uSize, puDataOut, uSizeOut);
 }
 
 uint32_t
 pl_compress_decompress(uint8_t* puDataIn, uint32_t size, uint8_t* puDataOut, uint32_t uSizeOut)
 {
+    const bool bFast = pl__fast_is_stream(puDataIn, size);
+    const uint32_t uLength = bFast ? pl__fast_decompress_length(puDataIn) : pl__decompress_length(puDataIn);
     if(puDataOut == NULL)
-        return pl__decompress_length(puDataIn);
-        
-    uint32_t uResult = pl__decompress(puDataOut, puDataIn, size);
-    PL_ASSERT(uResult <= uSizeOut);
-    return uResult;
+        return uLength;
+
+    PL_ASSERT(uLength <= uSizeOut);
+    if(uLength > uSizeOut)
+        return 0;
+
+    if(bFast)
+        return pl__fast_decompress(puDataIn, size, puDataOut, uLength);
+    return pl__decompress(puDataOut, puDataIn, size);
 }
 
 //-----------------------------------------------------------------------------
@@ -535,8 +921,12 @@ void
 pl_load_compress_ext(plApiRegistryI* ptApiRegistry, bool bReload)
 {
     const plCompressI tApi = {
-        .compress   = pl_compress_compress,
-        .decompress = pl_compress_decompress,
+        .compress        = pl_compress_compress,
+        .decompress      = pl_compress_decompress,
+        .create_context  = pl_compress_create_context,
+        .cleanup_context = pl_compress_cleanup_context,
+        .compress_ex     = pl_compress_compress_ex,
+        .compress_bound  = pl_compress_compress_bound,
     };
     pl_set_api(ptApiRegistry, plCompressI, &tApi);
 
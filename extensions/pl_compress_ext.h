@@ -1,15 +1,37 @@
 /*
    pl_compress_ext.h
      - DEFLATE-style sliding-window dictionary compression
+     - LZ4-style codec for fast decompression
 */
 
 /*
 Index of this file:
+// [SECTION] implementation notes
 // [SECTION] header mess
 // [SECTION] APIs
 // [SECTION] includes
+// [SECTION] forward declarations
 // [SECTION] public api
 // [SECTION] public api struct
+// [SECTION] enums
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementation notes
+//-----------------------------------------------------------------------------
+
+/*
+
+    Codecs:
+        PL_COMPRESS_CODEC_DEFAULT is based on "stb_compress" and gives the
+        better ratio. PL_COMPRESS_CODEC_FAST uses the LZ4 block format
+        (64KB window, no checksum) and decompresses many times faster. The
+        codec is stored in the stream header so "decompress" handles both.
+
+    Threading:
+        All functions are reentrant. A context only caches the encoder's hash
+        tables so repeated compression doesn't allocate. A context must only
+        be used by one thread at a time (i.e. one per thread/job).
 */
 
 //-----------------------------------------------------------------------------
@@ -27,7 +49,7 @@ extern "C" {
 // [SECTION] APIs
 //-----------------------------------------------------------------------------
 
-#define plCompressI_version {1, 1, 0}
+#define plCompressI_version {1, 2, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -36,6 +58,16 @@ extern "C" {
 #include "pl.inc"
 #include <stdint.h> // uint*_t
 
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+// basic types
+typedef struct _plCompressContext plCompressContext; // opaque
+
+// enums/flags
+typedef int plCompressCodec; // -> enum _plCompressCodec // Enum:
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api
 //-----------------------------------------------------------------------------
@@ -62,6 +94,17 @@ PL_API uint32_t pl_compress_compress(uint8_t* dataIn, uint32_t sizeIn, uint8_t*
 //   size in bytes.
 PL_API uint32_t pl_compress_decompress(uint8_t* dataIn, uint32_t sizeIn, uint8_t* dataOut, uint32_t sizeOut);
 
+// contexts (optional, see threading notes above)
+PL_API plCompressContext* pl_compress_create_context (void);
+PL_API void               pl_compress_cleanup_context(plCompressContext*);
+
+// compression (extended)
+//   Same as "compress" but with an explicit codec & optional context (NULL
+//   allocates scratch memory per call). "compress_bound" returns the largest
+//   possible output size for an input size.
+PL_API uint32_t pl_compress_compress_ex   (plCompressContext*, plCompressCodec, const uint8_t* dataIn, uint32_t sizeIn, uint8_t* dataOut, uint32_t sizeOut);
+PL_API uint32_t pl_compress_compress_bound(plCompressCodec, uint32_t sizeIn);
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api struct
 //-----------------------------------------------------------------------------
@@ -70,8 +113,26 @@ typedef struct _plCompressI
 {
     uint32_t (*compress)  (uint8_t* dataIn, uint32_t sizeIn, uint8_t* dataOut, uint32_t sizeOut);
     uint32_t (*decompress)(uint8_t* dataIn, uint32_t sizeIn, uint8_t* dataOut, uint32_t sizeOut);
+
+    // contexts
+    plCompressContext* (*create_context) (void);
+    void               (*cleanup_context)(plCompressContext*);
+
+    // compression (extended)
+    uint32_t (*compress_ex)   (plCompressContext*, plCompressCodec, const uint8_t* dataIn, uint32_t sizeIn, uint8_t* dataOut, uint32_t sizeOut);
+    uint32_t (*compress_bound)(plCompressCodec, uint32_t sizeIn);
 } plCompressI;
 
+//-----------------------------------------------------------------------------
+// [SECTION] enums
+//-----------------------------------------------------------------------------
+
+enum _plCompressCodec
+{
+    PL_COMPRESS_CODEC_DEFAULT = 0, // stb_compress based (better ratio)
+    PL_COMPRESS_CODEC_FAST    = 1, // LZ4 style (faster decompression)
+};
+
 #ifdef __cplusplus
 }
 #endif
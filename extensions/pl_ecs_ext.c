@@ -5,11 +5,16 @@
 /*
 Index of this file:
 // [SECTION] includes
+// [SECTION] defines
 // [SECTION] structs
 // [SECTION] global data
 // [SECTION] internal api
 // [SECTION] public api implementations
 // [SECTION] internal api implementations
+// [SECTION] hierarchy order
+// [SECTION] groups & queries
+// [SECTION] bulk operations
+// [SECTION] command buffers
 // [SECTION] extension loading
 */
 
@@ -17,7 +22,9 @@ Index of this file:
 // [SECTION] includes
 //-----------------------------------------------------------------------------
 
-#include <float.h> // FLT_MAX
+#include <float.h>  // FLT_MAX
+#include <stddef.h> // offsetof
+#include <stdlib.h> // qsort
 #define PL_MATH_INCLUDE_FUNCTIONS
 #include "pl.h"
 #include "pl_ecs_ext.h"
@@ -27,6 +34,7 @@ Index of this file:
 #include "pl_script_ext.h"
 #include "pl_profile_ext.h"
 #include "pl_log_ext.h"
+#include "pl_job_ext.h"
 
 #ifdef PL_UNITY_BUILD
     #include "pl_unity_ext.inc"
@@ -44,10 +52,38 @@ Index of this file:
 
     static const plProfileI* gptProfile = NULL;
     static const plLogI*     gptLog     = NULL;
+    static const plJobI*     gptJob     = NULL;
 #endif
 
 #include "pl_ds.h"
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+// transform/hierarchy work below this count runs on the calling thread
+#ifndef PL_ECS_PARALLEL_THRESHOLD
+    #define PL_ECS_PARALLEL_THRESHOLD 2048
+#endif
+
+// marks entities created by a command buffer that are not resolved yet
+#define PL_ECS_DEFERRED_GENERATION UINT32_MAX
+
+// stretchy buffers grow by the exact amount requested, so hot arrays
+// reserve geometrically to keep appends amortized O(1)
+#define pl__ecs_sb_reserve(buf, n) \
+    do { \
+        const uint32_t _uRequired = pl_sb_size(buf) + (uint32_t)(n); \
+        const uint32_t _uCapacity = pl_sb_capacity(buf); \
+        if(_uRequired > _uCapacity) \
+        { \
+            uint32_t _uNewCapacity = _uCapacity < 16 ? 16 : _uCapacity * 2; \
+            if(_uNewCapacity < _uRequired) \
+                _uNewCapacity = _uRequired; \
+            pl_sb_reserve((buf), _uNewCapacity - pl_sb_size(buf)); \
+        } \
+    } while(0)
+
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
@@ -61,17 +97,71 @@ typedef struct _plComponentManager
     size_t              szSize;
     void*               pComponents; // aligned with sbtEntites
     void*               pInternal;
+    uint32_t*           sbuSparse;   // entity index -> index in sbtEntities/pComponents (UINT32_MAX if none)
+    uint32_t            uGroup;      // owning group (UINT32_MAX if none)
+    uint32_t            uGeneration; // bumped whenever dense layout changes (add/remove/reorder)
 } plComponentManager;
 
+typedef struct _plEcsGroup
+{
+    uint32_t     uTypeCount;
+    plEcsTypeKey atTypes[PL_ECS_QUERY_MAX_TYPES];
+    uint32_t     uCount; // entities with all types (stored first & aligned in each type)
+} plEcsGroup;
+
 typedef struct _plComponentLibrary
 {
     // [INTERNAL]
     uint32_t*           _sbtEntityGenerations;
     uint32_t*           _sbtEntityFreeIndices;
-    plHashMap*          _atHashmaps; // map entity -> index in sbtEntities/pComponents
-    plComponentManager* _sbtManagers; // just for internal convenience
+    plHashMap64         _tNameHashmap; // map name -> entity index
+    plComponentManager* _sbtManagers;  // just for internal convenience
+    plEcsGroup*         _sbtGroups;
+
+    // hierarchy order (attached entities bucketed by depth, parents first)
+    plEntity**          _sbsbtHierarchyLevels;
+    uint32_t*           _sbuHierarchyLevel;      // entity index -> level (UINT32_MAX if detached)
+    uint32_t*           _sbuHierarchySlot;       // entity index -> index within level
+    uint32_t*           _sbuHierarchyChildCount; // entity index -> direct children
+    plEntity*           _sbtHierarchyScratch;
+    bool                _bHierarchyOrderDirty;   // full rebuild required
 } plComponentLibrary;
 
+typedef struct _plEcsHierarchyJobData
+{
+    plComponentLibrary* ptLibrary;
+    const plEntity*     ptEntities;
+} plEcsHierarchyJobData;
+
+// playback order follows enum order
+typedef int plEcsCommandType;
+enum _plEcsCommandType
+{
+    PL_ECS_COMMAND_TYPE_CREATE_ENTITY,
+    PL_ECS_COMMAND_TYPE_REMOVE_COMPONENT,
+    PL_ECS_COMMAND_TYPE_ADD_COMPONENT,
+    PL_ECS_COMMAND_TYPE_REMOVE_ENTITY
+};
+
+typedef struct _plEcsCommand
+{
+    plEcsCommandType eType;
+    plEcsTypeKey     tType;
+    plEntity         tEntity;
+    uint32_t         uDataOffset; // component payload in sbucData (add only)
+    uint32_t         uOrder;      // recording order (keeps sort stable)
+    uint8_t*         pucData;     // resolved payload (playback only)
+} plEcsCommand;
+
+typedef struct _plEcsCommandBuffer
+{
+    plComponentLibrary* ptLibrary;
+    plEcsCommand*       sbtCommands;
+    uint8_t*            sbucData;
+    uint32_t            uDeferredCount; // entities recorded with record_create_entity
+    plEntity*           sbtResolved;    // deferred index -> entity (playback only)
+} plEcsCommandBuffer;
+
 typedef struct _plEcsContext
 {
     bool                bFinalized;
@@ -94,15 +184,121 @@ static plEcsContext* gptEcsCtx = NULL;
 // [SECTION] internal api
 //-----------------------------------------------------------------------------
 
+static inline uint32_t
+pl__ecs_sparse_lookup(const plComponentManager* ptManager, uint32_t uEntityIndex)
+{
+    if(uEntityIndex >= pl_sb_size(ptManager->sbuSparse))
+        return UINT32_MAX;
+    return ptManager->sbuSparse[uEntityIndex];
+}
+
 static inline bool
 pl_ecs_has_entity(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity tEntity)
 {
     if(ptLibrary == NULL)
         ptLibrary = gptEcsCtx->ptDefaultLibrary;
     PL_ASSERT(tEntity.uIndex != UINT32_MAX);
-    return pl_hm_has_key(&ptLibrary->_atHashmaps[tType], tEntity.uIndex);
+    return pl__ecs_sparse_lookup(&ptLibrary->_sbtManagers[tType], tEntity.uIndex) != UINT32_MAX;
+}
+
+static void
+pl__ecs_reserve_sparse(plComponentManager* ptManager, uint32_t uEntityIndex)
+{
+    const uint32_t uOldSize = pl_sb_size(ptManager->sbuSparse);
+    if(uEntityIndex < uOldSize)
+        return;
+    pl__ecs_sb_reserve(ptManager->sbuSparse, uEntityIndex + 1 - uOldSize);
+    pl_sb_resize(ptManager->sbuSparse, uEntityIndex + 1);
+    for(uint32_t i = uOldSize; i <= uEntityIndex; i++)
+        ptManager->sbuSparse[i] = UINT32_MAX;
 }
 
+static void
+pl__ecs_reserve_components(plComponentManager* ptManager, uint32_t uCount)
+{
+    if(uCount <= ptManager->uCapacity)
+        return;
+
+    uint32_t uNewCapacity = ptManager->uCapacity == 0 ? 16 : ptManager->uCapacity * 2;
+    if(uNewCapacity < uCount)
+        uNewCapacity = uCount;
+
+    void* pOldComponents = ptManager->pComponents;
+    ptManager->pComponents = PL_ALLOC(ptManager->szSize * uNewCapacity);
+    memset(ptManager->pComponents, 0, ptManager->szSize * uNewCapacity);
+    if(pOldComponents)
+    {
+        memcpy(ptManager->pComponents, pOldComponents, ptManager->szSize * ptManager->uCount);
+        PL_FREE(pOldComponents);
+    }
+    ptManager->uCapacity = uNewCapacity;
+    pl__ecs_sb_reserve(ptManager->sbtEntities, uNewCapacity - pl_sb_size(ptManager->sbtEntities));
+}
+
+static void pl__ecs_group_add_entity   (plComponentLibrary*, uint32_t uGroup, plEntity);
+
+// appends component (capacity & sparse must already be reserved)
+static void*
+pl__ecs_push_component(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity tEntity, const void* pData)
+{
+    plComponentManager* ptManager = &ptLibrary->_sbtManagers[tType];
+
+    const uint32_t uComponentIndex = ptManager->uCount;
+    pl_sb_push(ptManager->sbtEntities, tEntity);
+    ptManager->sbuSparse[tEntity.uIndex] = uComponentIndex;
+    ptManager->uCount++;
+    ptManager->uGeneration++;
+
+    char* pNewComponent = &((char*)ptManager->pComponents)[ptManager->szSize * uComponentIndex];
+    if(pData)
+        memcpy(pNewComponent, pData, ptManager->szSize);
+    else if(gptEcsCtx->sbtComponentDescriptions[tType]._pTemplate)
+        memcpy(pNewComponent, gptEcsCtx->sbtComponentDescriptions[tType]._pTemplate, ptManager->szSize);
+    else
+        memset(pNewComponent, 0, ptManager->szSize);
+
+    // may move component into group prefix
+    if(ptManager->uGroup != UINT32_MAX)
+    {
+        pl__ecs_group_add_entity(ptLibrary, ptManager->uGroup, tEntity);
+        pNewComponent = &((char*)ptManager->pComponents)[ptManager->szSize * ptManager->sbuSparse[tEntity.uIndex]];
+    }
+    return pNewComponent;
+}
+
+// swap removes component (entity must already be out of any group)
+static void
+pl__ecs_remove_dense(plComponentManager* ptManager, plEntity tEntity)
+{
+    const uint32_t uIndex = pl__ecs_sparse_lookup(ptManager, tEntity.uIndex);
+    if(uIndex == UINT32_MAX)
+        return;
+
+    // must keep valid entities contiguous (move last entity into removed slot)
+    const uint32_t uLastIndex = ptManager->uCount - 1;
+    if(uIndex != uLastIndex)
+    {
+        const plEntity tLastEntity = ptManager->sbtEntities[uLastIndex];
+        ptManager->sbtEntities[uIndex] = tLastEntity;
+        ptManager->sbuSparse[tLastEntity.uIndex] = uIndex;
+        memcpy(
+            &((char*)ptManager->pComponents)[ptManager->szSize * uIndex],
+            &((char*)ptManager->pComponents)[ptManager->szSize * uLastIndex],
+            ptManager->szSize
+        );
+    }
+    pl_sb_pop(ptManager->sbtEntities);
+    ptManager->sbuSparse[tEntity.uIndex] = UINT32_MAX;
+    ptManager->uCount--;
+    ptManager->uGeneration++;
+}
+
+static void pl__ecs_group_remove_entity(plComponentLibrary*, uint32_t uGroup, plEntity);
+
+static void pl__ecs_hierarchy_set_parent   (plComponentLibrary*, plEntity, plEntity tParent);
+static void pl__ecs_hierarchy_free         (plComponentLibrary*, bool bRelease);
+static void pl__ecs_rebuild_hierarchy_order(plComponentLibrary*);
+
 //-----------------------------------------------------------------------------
 // [SECTION] internal api implementation
 //-----------------------------------------------------------------------------
@@ -202,17 +398,16 @@ pl_ecs_create_library(plComponentLibrary** pptLibrary)
 
     const uint32_t uComponentTypeCount = pl_sb_size(gptEcsCtx->sbtComponentDescriptions);
 
-    ptLibrary->_atHashmaps = PL_ALLOC(sizeof(plHashMap64) * (uComponentTypeCount + 1));
-    memset(ptLibrary->_atHashmaps, 0, sizeof(plHashMap64) * (uComponentTypeCount + 1));
-
     pl_sb_resize(ptLibrary->_sbtManagers, pl_sb_size(gptEcsCtx->sbtComponentDescriptions));
 
     // initialize component managers
 
     for(uint32_t i = 0; i < uComponentTypeCount; i++)
     {
+        memset(&ptLibrary->_sbtManagers[i], 0, sizeof(plComponentManager));
         ptLibrary->_sbtManagers[i].szSize = gptEcsCtx->sbtComponentDescriptions[i].szSize;
         ptLibrary->_sbtManagers[i].ptParentLibrary = ptLibrary;
+        ptLibrary->_sbtManagers[i].uGroup = UINT32_MAX;
         if(gptEcsCtx->sbtComponentDescriptions[i].init)
             gptEcsCtx->sbtComponentDescriptions[i].init(ptLibrary);
     }
@@ -263,10 +458,17 @@ pl_ecs_reset_library(plComponentLibrary* ptLibrary)
             gptEcsCtx->sbtComponentDescriptions[i].reset(ptLibrary);
 
         ptLibrary->_sbtManagers[i].uCount = 0;
+        ptLibrary->_sbtManagers[i].uGeneration++;
         pl_sb_reset(ptLibrary->_sbtManagers[i].sbtEntities);
-        pl_hm_free(&ptLibrary->_atHashmaps[i]);
+        pl_sb_reset(ptLibrary->_sbtManagers[i].sbuSparse);
     }
-    pl_hm_free(&ptLibrary->_atHashmaps[uComponentTypeCount]);
+    pl_hm_free(&ptLibrary->_tNameHashmap);
+    pl__ecs_hierarchy_free(ptLibrary, false);
+
+    // groups stay registered
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->_sbtGroups); i++)
+        ptLibrary->_sbtGroups[i].uCount = 0;
+
     // general
     pl_sb_reset(ptLibrary->_sbtEntityFreeIndices);
     pl_sb_reset(ptLibrary->_sbtEntityGenerations);
@@ -291,15 +493,16 @@ pl_ecs_cleanup_library(plComponentLibrary** pptLibrary)
             ptLibrary->_sbtManagers[i].pComponents = NULL;
         }
         pl_sb_free(ptLibrary->_sbtManagers[i].sbtEntities);
-        pl_hm_free(&ptLibrary->_atHashmaps[i]);
+        pl_sb_free(ptLibrary->_sbtManagers[i].sbuSparse);
     }
-    pl_hm_free(&ptLibrary->_atHashmaps[uComponentTypeCount]);
+    pl_hm_free(&ptLibrary->_tNameHashmap);
+    pl__ecs_hierarchy_free(ptLibrary, true);
 
     // general
     pl_sb_free(ptLibrary->_sbtManagers);
+    pl_sb_free(ptLibrary->_sbtGroups);
     pl_sb_free(ptLibrary->_sbtEntityFreeIndices);
     pl_sb_free(ptLibrary->_sbtEntityGenerations);
-    PL_FREE(ptLibrary->_atHashmaps);
 
     PL_FREE(ptLibrary);
     *pptLibrary = NULL;
@@ -310,6 +513,7 @@ pl_ecs_cleanup(void)
 {
     pl_ecs_cleanup_library(&gptEcsCtx->ptDefaultLibrary);
     pl_sb_free(gptEcsCtx->sbtComponentDescriptions);
+    gptEcsCtx->bFinalized = false; // allows initializing again
 }
 
 bool
@@ -331,8 +535,7 @@ pl_ecs_get_entity_by_name(plComponentLibrary* ptLibrary, const char* pcName)
 
     const uint64_t ulHash = pl_hm_hash_str(pcName, 0);
     uint64_t uIndex = 0;
-    const uint32_t uComponentTypeCount = pl_sb_size(gptEcsCtx->sbtComponentDescriptions);
-    if(pl_hm_has_key_ex(&ptLibrary->_atHashmaps[uComponentTypeCount], ulHash, &uIndex))
+    if(pl_hm_has_key_ex(&ptLibrary->_tNameHashmap, ulHash, &uIndex))
     {
         return (plEntity){.uIndex = (uint32_t)uIndex, .uGeneration = ptLibrary->_sbtEntityGenerations[uIndex]};
     }
@@ -357,8 +560,8 @@ pl_ecs_get_index(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity tEn
         ptLibrary = gptEcsCtx->ptDefaultLibrary;
 
     PL_ASSERT(tEntity.uIndex != UINT32_MAX);
-    size_t szIndex = pl_hm_lookup(&ptLibrary->_atHashmaps[tType], (uint64_t)tEntity.uIndex);
-    return szIndex;
+    const uint32_t uIndex = pl__ecs_sparse_lookup(&ptLibrary->_sbtManagers[tType], tEntity.uIndex);
+    return uIndex == UINT32_MAX ? UINT64_MAX : (size_t)uIndex;
 }
 
 void*
@@ -375,13 +578,13 @@ pl_ecs_get_component(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity
     if(ptLibrary->_sbtEntityGenerations[tEntity.uIndex] != tEntity.uGeneration)
         return NULL;
 
-    size_t szIndex = pl_ecs_get_index(ptLibrary, tType, tEntity);
+    const uint32_t uIndex = pl__ecs_sparse_lookup(ptManager, tEntity.uIndex);
 
-    if(szIndex == UINT64_MAX)
+    if(uIndex == UINT32_MAX)
         return NULL;
 
     unsigned char* pucData = ptManager->pComponents;
-    return &pucData[szIndex * gptEcsCtx->sbtComponentDescriptions[tType].szSize];
+    return &pucData[uIndex * ptManager->szSize];
 }
 
 void
@@ -392,44 +595,35 @@ pl_ecs_remove_entity(plComponentLibrary* ptLibrary, plEntity tEntity)
         ptLibrary = gptEcsCtx->ptDefaultLibrary;
 
     const uint32_t uComponentTypeCount = pl_sb_size(gptEcsCtx->sbtComponentDescriptions);
+    pl__ecs_sb_reserve(ptLibrary->_sbtEntityFreeIndices, 1);
     pl_sb_push(ptLibrary->_sbtEntityFreeIndices, tEntity.uIndex);
 
     // remove from tag hashmap
     plTagComponent* ptTag = pl_ecs_get_component(ptLibrary, gptEcsCtx->tTagComponentType, tEntity);
     if(ptTag)
     {
-        pl_hm_remove_str(&ptLibrary->_atHashmaps[uComponentTypeCount], ptTag->acName);
+        pl_hm_remove_str(&ptLibrary->_tNameHashmap, ptTag->acName);
     }
 
-    ptLibrary->_sbtEntityGenerations[tEntity.uIndex]++;
-
-    // remove from individual managers
-    for(uint32_t i = 0; i < uComponentTypeCount; i++)
+    // leave hierarchy order (orphaned children require a rebuild)
+    if(pl_ecs_has_entity(ptLibrary, gptEcsCtx->tHierarchyComponentType, tEntity))
+        pl__ecs_hierarchy_set_parent(ptLibrary, tEntity, (plEntity){.uIndex = UINT32_MAX});
+    if(tEntity.uIndex < pl_sb_size(ptLibrary->_sbuHierarchyChildCount) && ptLibrary->_sbuHierarchyChildCount[tEntity.uIndex] > 0)
     {
-        if(pl_hm_has_key(&ptLibrary->_atHashmaps[i], tEntity.uIndex))
-        {
-            pl_hm_remove(&ptLibrary->_atHashmaps[i], tEntity.uIndex);
-            const uint64_t uEntityValue = pl_hm_get_free_index(&ptLibrary->_atHashmaps[i]);
-            
-            // must keep valid entities contiguous (move last entity into removed slot)
-            if(pl_sb_size(ptLibrary->_sbtManagers[i].sbtEntities) > 1)
-            {
-                plEntity tLastEntity = pl_sb_back(ptLibrary->_sbtManagers[i].sbtEntities);
-                pl_hm_remove(&ptLibrary->_atHashmaps[i], tLastEntity.uIndex);
-                uint64_t _unUsed = pl_hm_get_free_index(&ptLibrary->_atHashmaps[i]); // burn slot
-                pl_hm_insert(&ptLibrary->_atHashmaps[i], tLastEntity.uIndex, uEntityValue);
-            }
+        ptLibrary->_sbuHierarchyChildCount[tEntity.uIndex] = 0;
+        ptLibrary->_bHierarchyOrderDirty = true;
+    }
 
-            pl_sb_del_swap(ptLibrary->_sbtManagers[i].sbtEntities, uEntityValue);
+    ptLibrary->_sbtEntityGenerations[tEntity.uIndex]++;
 
-            memmove(
-                &((char*)ptLibrary->_sbtManagers[i].pComponents)[ptLibrary->_sbtManagers[i].szSize * uEntityValue],
-                &((char*)ptLibrary->_sbtManagers[i].pComponents)[ptLibrary->_sbtManagers[i].szSize * ptLibrary->_sbtManagers[i].uCount],
-                ptLibrary->_sbtManagers[i].szSize
-            );
-            ptLibrary->_sbtManagers[i].uCount--;
-        }
-    }
+    // leave groups first so group prefixes stay intact
+    const uint32_t uGroupCount = pl_sb_size(ptLibrary->_sbtGroups);
+    for(uint32_t i = 0; i < uGroupCount; i++)
+        pl__ecs_group_remove_entity(ptLibrary, i, tEntity);
+
+    // remove from individual managers (sparse check is a single array read)
+    for(uint32_t i = 0; i < uComponentTypeCount; i++)
+        pl__ecs_remove_dense(&ptLibrary->_sbtManagers[i], tEntity);
 }
 
 bool
@@ -459,6 +653,14 @@ pl_ecs_get_components(plComponentLibrary* ptLibrary, plEcsTypeKey tType, void**
     return ptManager->uCount;
 }
 
+uint32_t
+pl_ecs_get_component_generation(plComponentLibrary* ptLibrary, plEcsTypeKey tType)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+    return ptLibrary->_sbtManagers[tType].uGeneration;
+}
+
 void*
 pl_ecs_add_component(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity tEntity)
 {
@@ -473,43 +675,37 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity
     if(ptManager->ptParentLibrary->_sbtEntityGenerations[tEntity.uIndex] != tEntity.uGeneration)
         return NULL;
 
-    uint64_t uComponentIndex = pl_hm_get_free_index(&ptLibrary->_atHashmaps[tType]);
-    bool bAddSlot = false; // can't add component with SB without correct type
-    if(uComponentIndex == UINT64_MAX)
-    {
-        uComponentIndex = pl_sb_size(ptManager->sbtEntities);
-        pl_sb_add(ptManager->sbtEntities);
-        bAddSlot = true;
-    }
-    pl_hm_insert(&ptLibrary->_atHashmaps[tType], (uint64_t)tEntity.uIndex, uComponentIndex);
+    pl__ecs_reserve_sparse(ptManager, tEntity.uIndex);
+    PL_ASSERT(ptManager->sbuSparse[tEntity.uIndex] == UINT32_MAX && "entity already has component");
 
-    ptManager->sbtEntities[uComponentIndex] = tEntity;
+    pl__ecs_reserve_components(ptManager, ptManager->uCount + 1);
+    return pl__ecs_push_component(ptLibrary, tType, tEntity, NULL);
+}
 
-    
-    if(bAddSlot)
-    {
-        ptManager->uCount++;
-        if(ptManager->uCapacity == 0) // first allocation
-        {
-            ptManager->uCapacity = 16;
-            ptManager->pComponents = PL_ALLOC(ptManager->szSize * ptManager->uCapacity);
-            memset(ptManager->pComponents, 0, ptManager->szSize * ptManager->uCapacity);
-        }
+void
+pl_ecs_remove_component(plComponentLibrary* ptLibrary, plEcsTypeKey tType, plEntity tEntity)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
 
-        if(ptManager->uCount > ptManager->uCapacity) // need to grow
-        {
-            void* pOldComponents = ptManager->pComponents;
-            ptManager->pComponents = PL_ALLOC(ptManager->szSize * ptManager->uCapacity * 2);
-            memset(ptManager->pComponents, 0, ptManager->szSize * ptManager->uCapacity * 2);
-            memcpy(ptManager->pComponents, pOldComponents, ptManager->szSize * ptManager->uCapacity);
-            PL_FREE(pOldComponents);
-            ptManager->uCapacity *= 2;
-        }
+    if(!pl_ecs_is_entity_valid(ptLibrary, tEntity))
+        return;
+
+    plComponentManager* ptManager = &ptLibrary->_sbtManagers[tType];
+    if(pl__ecs_sparse_lookup(ptManager, tEntity.uIndex) == UINT32_MAX)
+        return;
+
+    if(tType == gptEcsCtx->tHierarchyComponentType)
+        pl__ecs_hierarchy_set_parent(ptLibrary, tEntity, (plEntity){.uIndex = UINT32_MAX});
+    else if(tType == gptEcsCtx->tTagComponentType)
+    {
+        plTagComponent* ptTag = pl_ecs_get_component(ptLibrary, tType, tEntity);
+        pl_hm_remove_str(&ptLibrary->_tNameHashmap, ptTag->acName);
     }
-    char* pNewComponent = &((char*)ptManager->pComponents)[ptManager->szSize * uComponentIndex];
-    if(gptEcsCtx->sbtComponentDescriptions[tType]._pTemplate)
-        memcpy(pNewComponent, gptEcsCtx->sbtComponentDescriptions[tType]._pTemplate, ptManager->szSize);
-    return pNewComponent;
+
+    if(ptManager->uGroup != UINT32_MAX)
+        pl__ecs_group_remove_entity(ptLibrary, ptManager->uGroup, tEntity);
+    pl__ecs_remove_dense(ptManager, tEntity);
 }
 
 plEntity
@@ -527,11 +723,10 @@ pl_ecs_create_entity(plComponentLibrary* ptLibrary, const char* pcName)
     else // create new slot
     {
         tNewEntity.uIndex = pl_sb_size(ptLibrary->_sbtEntityGenerations);
+        pl__ecs_sb_reserve(ptLibrary->_sbtEntityGenerations, 1);
         pl_sb_push(ptLibrary->_sbtEntityGenerations, 0);
     }
 
-    const uint32_t uComponentTypeCount = pl_sb_size(gptEcsCtx->sbtComponentDescriptions);
-
     plTagComponent* ptTag = pl_ecs_add_component(ptLibrary, gptEcsCtx->tTagComponentType, tNewEntity);
     if(pcName)
         strncpy(ptTag->acName, pcName, 128);
@@ -539,7 +734,7 @@ pl_ecs_create_entity(plComponentLibrary* ptLibrary, const char* pcName)
         strncpy(ptTag->acName, "unnamed", 128);
 
     if(pcName)
-        pl_hm_insert_str(&ptLibrary->_atHashmaps[uComponentTypeCount], pcName, tNewEntity.uIndex);
+        pl_hm_insert_str(&ptLibrary->_tNameHashmap, pcName, tNewEntity.uIndex);
 
     return tNewEntity;
 }
@@ -605,8 +800,9 @@ pl_ecs_attach_component(plComponentLibrary* ptLibrary, plEntity tEntity, plEntit
     else
     {
         ptHierarchyComponent = pl_ecs_add_component(ptLibrary, gptEcsCtx->tHierarchyComponentType, tEntity);
+        ptHierarchyComponent->tParent.uIndex = UINT32_MAX;
     }
-    ptHierarchyComponent->tParent = tParent;
+    pl__ecs_hierarchy_set_parent(ptLibrary, tEntity, tParent);
 }
 
 void
@@ -622,8 +818,55 @@ pl_ecs_deattach_component(plComponentLibrary* ptLibrary, plEntity tEntity)
     else
     {
         ptHierarchyComponent = pl_ecs_add_component(ptLibrary, gptEcsCtx->tHierarchyComponentType, tEntity);
+        ptHierarchyComponent->tParent.uIndex = UINT32_MAX;
+    }
+    pl__ecs_hierarchy_set_parent(ptLibrary, tEntity, (plEntity){.uIndex = UINT32_MAX});
+}
+
+static inline void
+pl__ecs_update_transform(plTransformComponent* ptTransform)
+{
+    if(ptTransform->eFlags & PL_TRANSFORM_FLAGS_DIRTY)
+    {
+        ptTransform->tWorld = pl_rotation_translation_scale(ptTransform->tRotation, ptTransform->tTranslation, ptTransform->tScale);
+        ptTransform->eFlags = (ptTransform->eFlags & ~PL_TRANSFORM_FLAGS_DIRTY) | PL_TRANSFORM_FLAGS_UPDATED;
     }
-    ptHierarchyComponent->tParent.uIndex = UINT32_MAX;
+    else
+        ptTransform->eFlags &= ~PL_TRANSFORM_FLAGS_UPDATED;
+}
+
+static void
+pl__ecs_transform_update_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    pl__ecs_update_transform(&((plTransformComponent*)pData)[tInvoData.uGlobalIndex]);
+}
+
+static inline void
+pl__ecs_propagate_transform(plComponentLibrary* ptLibrary, plEntity tChildEntity)
+{
+    const plHierarchyComponent* ptHierarchyComponent = pl_ecs_get_component(ptLibrary, gptEcsCtx->tHierarchyComponentType, tChildEntity);
+    plTransformComponent* ptParentTransform = pl_ecs_get_component(ptLibrary, gptEcsCtx->tTransformComponentType, ptHierarchyComponent->tParent);
+    plTransformComponent* ptChildTransform = pl_ecs_get_component(ptLibrary, gptEcsCtx->tTransformComponentType, tChildEntity);
+    if(ptParentTransform == NULL || ptChildTransform == NULL)
+        return;
+
+    // clean subtree
+    if(!((ptParentTransform->eFlags | ptChildTransform->eFlags) & PL_TRANSFORM_FLAGS_UPDATED))
+        return;
+
+    // updated children hold their local matrix, otherwise tWorld is last frame's world
+    plMat4 tLocal = ptChildTransform->tWorld;
+    if(!(ptChildTransform->eFlags & PL_TRANSFORM_FLAGS_UPDATED))
+        tLocal = pl_rotation_translation_scale(ptChildTransform->tRotation, ptChildTransform->tTranslation, ptChildTransform->tScale);
+    ptChildTransform->tWorld = pl_mul_mat4(&ptParentTransform->tWorld, &tLocal);
+    ptChildTransform->eFlags |= PL_TRANSFORM_FLAGS_UPDATED;
+}
+
+static void
+pl__ecs_hierarchy_update_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plEcsHierarchyJobData* ptData = pData;
+    pl__ecs_propagate_transform(ptData->ptLibrary, ptData->ptEntities[tInvoData.uGlobalIndex]);
 }
 
 void
@@ -634,14 +877,20 @@ pl_ecs_run_transform_update_system(plComponentLibrary* ptLibrary)
     plTransformComponent* ptComponents = NULL;
     const uint32_t uComponentCount = pl_ecs_get_components(ptLibrary, gptEcsCtx->tTransformComponentType, (void**)&ptComponents, NULL);
 
-    for(uint32_t i = 0; i < uComponentCount; i++)
+    if(gptJob && !gptJob->is_shutting_down() && uComponentCount >= PL_ECS_PARALLEL_THRESHOLD)
     {
-        plTransformComponent* ptTransform = &ptComponents[i];
-        if(ptTransform->eFlags & PL_TRANSFORM_FLAGS_DIRTY)
-        {
-            ptTransform->tWorld = pl_rotation_translation_scale(ptTransform->tRotation, ptTransform->tTranslation, ptTransform->tScale);
-            ptTransform->eFlags &= ~PL_TRANSFORM_FLAGS_DIRTY;
-        }
+        plJobDesc tJobDesc = {
+            .task  = pl__ecs_transform_update_job,
+            .pData = ptComponents
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(uComponentCount, 0, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < uComponentCount; i++)
+            pl__ecs_update_transform(&ptComponents[i]);
     }
 
     PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
@@ -652,30 +901,809 @@ pl_ecs_run_hierarchy_update_system(plComponentLibrary* ptLibrary)
 {
     PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, __FUNCTION__);
 
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    if(ptLibrary->_bHierarchyOrderDirty)
+        pl__ecs_rebuild_hierarchy_order(ptLibrary);
+
+    // parents always live in earlier levels, so each level is independent
+    const uint32_t uLevelCount = pl_sb_size(ptLibrary->_sbsbtHierarchyLevels);
+    for(uint32_t uLevel = 0; uLevel < uLevelCount; uLevel++)
+    {
+        const plEntity* ptEntities = ptLibrary->_sbsbtHierarchyLevels[uLevel];
+        const uint32_t uEntityCount = pl_sb_size(ptLibrary->_sbsbtHierarchyLevels[uLevel]);
+
+        if(gptJob && !gptJob->is_shutting_down() && uEntityCount >= PL_ECS_PARALLEL_THRESHOLD)
+        {
+            plEcsHierarchyJobData tData = {
+                .ptLibrary  = ptLibrary,
+                .ptEntities = ptEntities
+            };
+            plJobDesc tJobDesc = {
+                .task  = pl__ecs_hierarchy_update_job,
+                .pData = &tData
+            };
+            plJobCounter* ptCounter = NULL;
+            gptJob->dispatch_batch(uEntityCount, 0, tJobDesc, &ptCounter);
+            gptJob->wait_for_counter(ptCounter);
+        }
+        else
+        {
+            for(uint32_t i = 0; i < uEntityCount; i++)
+                pl__ecs_propagate_transform(ptLibrary, ptEntities[i]);
+        }
+    }
+
+    PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
+}
+
+uint64_t
+pl_ecs_get_log_channel(void)
+{
+    return gptEcsCtx->uLogChannel;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] hierarchy order
+//-----------------------------------------------------------------------------
+
+static inline bool
+pl__ecs_hierarchy_has_parent(plEntity tParent)
+{
+    return tParent.uIndex != 0 && tParent.uIndex != UINT32_MAX;
+}
+
+static inline uint32_t
+pl__ecs_hierarchy_level(const plComponentLibrary* ptLibrary, uint32_t uEntityIndex)
+{
+    if(uEntityIndex >= pl_sb_size(ptLibrary->_sbuHierarchyLevel))
+        return UINT32_MAX;
+    return ptLibrary->_sbuHierarchyLevel[uEntityIndex];
+}
+
+static void
+pl__ecs_hierarchy_reserve(plComponentLibrary* ptLibrary, uint32_t uEntityIndex)
+{
+    const uint32_t uOldSize = pl_sb_size(ptLibrary->_sbuHierarchyLevel);
+    if(uEntityIndex < uOldSize)
+        return;
+
+    pl__ecs_sb_reserve(ptLibrary->_sbuHierarchyLevel, uEntityIndex + 1 - uOldSize);
+    pl__ecs_sb_reserve(ptLibrary->_sbuHierarchySlot, uEntityIndex + 1 - uOldSize);
+    pl__ecs_sb_reserve(ptLibrary->_sbuHierarchyChildCount, uEntityIndex + 1 - uOldSize);
+    pl_sb_resize(ptLibrary->_sbuHierarchyLevel, uEntityIndex + 1);
+    pl_sb_resize(ptLibrary->_sbuHierarchySlot, uEntityIndex + 1);
+    pl_sb_resize(ptLibrary->_sbuHierarchyChildCount, uEntityIndex + 1);
+    for(uint32_t i = uOldSize; i <= uEntityIndex; i++)
+    {
+        ptLibrary->_sbuHierarchyLevel[i] = UINT32_MAX;
+        ptLibrary->_sbuHierarchySlot[i] = UINT32_MAX;
+        ptLibrary->_sbuHierarchyChildCount[i] = 0;
+    }
+}
+
+static void
+pl__ecs_hierarchy_link(plComponentLibrary* ptLibrary, plEntity tEntity, uint32_t uLevel)
+{
+    while(pl_sb_size(ptLibrary->_sbsbtHierarchyLevels) <= uLevel)
+        pl_sb_push(ptLibrary->_sbsbtHierarchyLevels, NULL);
+
+    pl__ecs_hierarchy_reserve(ptLibrary, tEntity.uIndex);
+    ptLibrary->_sbuHierarchyLevel[tEntity.uIndex] = uLevel;
+    ptLibrary->_sbuHierarchySlot[tEntity.uIndex] = pl_sb_size(ptLibrary->_sbsbtHierarchyLevels[uLevel]);
+    pl__ecs_sb_reserve(ptLibrary->_sbsbtHierarchyLevels[uLevel], 1);
+    pl_sb_push(ptLibrary->_sbsbtHierarchyLevels[uLevel], tEntity);
+}
+
+static void
+pl__ecs_hierarchy_unlink(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    const uint32_t uLevel = pl__ecs_hierarchy_level(ptLibrary, tEntity.uIndex);
+    if(uLevel == UINT32_MAX)
+        return;
+
+    // swap remove within level
+    plEntity* sbtLevel = ptLibrary->_sbsbtHierarchyLevels[uLevel];
+    const uint32_t uSlot = ptLibrary->_sbuHierarchySlot[tEntity.uIndex];
+    const plEntity tLast = pl_sb_pop(sbtLevel);
+    if(tLast.uIndex != tEntity.uIndex)
+    {
+        sbtLevel[uSlot] = tLast;
+        ptLibrary->_sbuHierarchySlot[tLast.uIndex] = uSlot;
+    }
+    ptLibrary->_sbuHierarchyLevel[tEntity.uIndex] = UINT32_MAX;
+    ptLibrary->_sbuHierarchySlot[tEntity.uIndex] = UINT32_MAX;
+}
+
+static void
+pl__ecs_hierarchy_set_parent(plComponentLibrary* ptLibrary, plEntity tEntity, plEntity tParent)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    plHierarchyComponent* ptHierarchyComponent = pl_ecs_get_component(ptLibrary, gptEcsCtx->tHierarchyComponentType, tEntity);
+
+    // detach from previous parent
+    const plEntity tOldParent = ptHierarchyComponent->tParent;
+    if(pl__ecs_hierarchy_has_parent(tOldParent))
+    {
+        pl__ecs_hierarchy_unlink(ptLibrary, tEntity);
+        if(tOldParent.uIndex < pl_sb_size(ptLibrary->_sbuHierarchyChildCount) && ptLibrary->_sbuHierarchyChildCount[tOldParent.uIndex] > 0)
+            ptLibrary->_sbuHierarchyChildCount[tOldParent.uIndex]--;
+    }
+
+    ptHierarchyComponent->tParent = tParent;
+
+    if(pl__ecs_hierarchy_has_parent(tParent))
+    {
+        pl__ecs_hierarchy_reserve(ptLibrary, tParent.uIndex);
+        ptLibrary->_sbuHierarchyChildCount[tParent.uIndex]++;
+        const uint32_t uParentLevel = pl__ecs_hierarchy_level(ptLibrary, tParent.uIndex);
+        pl__ecs_hierarchy_link(ptLibrary, tEntity, uParentLevel == UINT32_MAX ? 0 : uParentLevel + 1);
+    }
+
+    // moving an entity with children shifts its whole subtree
+    if(tEntity.uIndex < pl_sb_size(ptLibrary->_sbuHierarchyChildCount) && ptLibrary->_sbuHierarchyChildCount[tEntity.uIndex] > 0)
+        ptLibrary->_bHierarchyOrderDirty = true;
+
+    // world matrix must be recomputed against new parent
+    plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, gptEcsCtx->tTransformComponentType, tEntity);
+    if(ptTransform)
+        ptTransform->eFlags |= PL_TRANSFORM_FLAGS_DIRTY;
+}
+
+static void
+pl__ecs_rebuild_hierarchy_order(plComponentLibrary* ptLibrary)
+{
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, __FUNCTION__);
+
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->_sbsbtHierarchyLevels); i++)
+        pl_sb_reset(ptLibrary->_sbsbtHierarchyLevels[i]);
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->_sbuHierarchyLevel); i++)
+    {
+        ptLibrary->_sbuHierarchyLevel[i] = UINT32_MAX;
+        ptLibrary->_sbuHierarchySlot[i] = UINT32_MAX;
+        ptLibrary->_sbuHierarchyChildCount[i] = 0;
+    }
+
     plHierarchyComponent* ptComponents = NULL;
     const plEntity* ptEntities = NULL;
     const uint32_t uComponentCount = pl_ecs_get_components(ptLibrary, gptEcsCtx->tHierarchyComponentType, (void**)&ptComponents, &ptEntities);
 
     for(uint32_t i = 0; i < uComponentCount; i++)
     {
-        const plEntity tChildEntity = ptEntities[i];
-        plHierarchyComponent* ptHierarchyComponent = pl_ecs_get_component(ptLibrary, gptEcsCtx->tHierarchyComponentType, tChildEntity);
-        plTransformComponent* ptParentTransform = pl_ecs_get_component(ptLibrary, gptEcsCtx->tTransformComponentType, ptHierarchyComponent->tParent);
-        plTransformComponent* ptChildTransform = pl_ecs_get_component(ptLibrary, gptEcsCtx->tTransformComponentType, tChildEntity);
-        if(ptParentTransform && ptChildTransform)
+        if(pl__ecs_hierarchy_has_parent(ptComponents[i].tParent))
+        {
+            pl__ecs_hierarchy_reserve(ptLibrary, ptComponents[i].tParent.uIndex);
+            ptLibrary->_sbuHierarchyChildCount[ptComponents[i].tParent.uIndex]++;
+        }
+    }
+
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        if(!pl__ecs_hierarchy_has_parent(ptComponents[i].tParent) || pl__ecs_hierarchy_level(ptLibrary, ptEntities[i].uIndex) != UINT32_MAX)
+            continue;
+
+        // walk up until a placed ancestor or root (bounded to guard against cycles)
+        pl_sb_reset(ptLibrary->_sbtHierarchyScratch);
+        pl_sb_push(ptLibrary->_sbtHierarchyScratch, ptEntities[i]);
+        plEntity tCurrent = ptComponents[i].tParent;
+        uint32_t uBaseLevel = UINT32_MAX;
+        while(pl_sb_size(ptLibrary->_sbtHierarchyScratch) <= uComponentCount)
         {
-            ptChildTransform->tWorld = pl_mul_mat4(&ptParentTransform->tWorld, &ptChildTransform->tWorld);
-            ptChildTransform->eFlags |= PL_TRANSFORM_FLAGS_DIRTY;
+            uBaseLevel = pl__ecs_hierarchy_level(ptLibrary, tCurrent.uIndex);
+            if(uBaseLevel != UINT32_MAX)
+                break;
+
+            const plHierarchyComponent* ptCurrent = pl_ecs_get_component(ptLibrary, gptEcsCtx->tHierarchyComponentType, tCurrent);
+            if(ptCurrent == NULL || !pl__ecs_hierarchy_has_parent(ptCurrent->tParent))
+                break;
+            pl__ecs_sb_reserve(ptLibrary->_sbtHierarchyScratch, 1);
+            pl_sb_push(ptLibrary->_sbtHierarchyScratch, tCurrent);
+            tCurrent = ptCurrent->tParent;
+        }
+
+        // place from top-most ancestor down
+        for(uint32_t j = pl_sb_size(ptLibrary->_sbtHierarchyScratch); j > 0; j--)
+        {
+            uBaseLevel = uBaseLevel == UINT32_MAX ? 0 : uBaseLevel + 1;
+            pl__ecs_hierarchy_link(ptLibrary, ptLibrary->_sbtHierarchyScratch[j - 1], uBaseLevel);
         }
     }
 
+    ptLibrary->_bHierarchyOrderDirty = false;
     PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
 }
 
-uint64_t
-pl_ecs_get_log_channel(void)
+static void
+pl__ecs_hierarchy_free(plComponentLibrary* ptLibrary, bool bRelease)
 {
-    return gptEcsCtx->uLogChannel;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->_sbsbtHierarchyLevels); i++)
+    {
+        if(bRelease)
+        {
+            pl_sb_free(ptLibrary->_sbsbtHierarchyLevels[i]);
+        }
+        else
+        {
+            pl_sb_reset(ptLibrary->_sbsbtHierarchyLevels[i]);
+        }
+    }
+    if(bRelease)
+    {
+        pl_sb_free(ptLibrary->_sbsbtHierarchyLevels);
+        pl_sb_free(ptLibrary->_sbuHierarchyLevel);
+        pl_sb_free(ptLibrary->_sbuHierarchySlot);
+        pl_sb_free(ptLibrary->_sbuHierarchyChildCount);
+        pl_sb_free(ptLibrary->_sbtHierarchyScratch);
+    }
+    else
+    {
+        pl_sb_reset(ptLibrary->_sbuHierarchyLevel);
+        pl_sb_reset(ptLibrary->_sbuHierarchySlot);
+        pl_sb_reset(ptLibrary->_sbuHierarchyChildCount);
+    }
+    ptLibrary->_bHierarchyOrderDirty = false;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] groups & queries
+//-----------------------------------------------------------------------------
+
+static void
+pl__ecs_swap_dense(plComponentManager* ptManager, uint32_t uA, uint32_t uB)
+{
+    if(uA == uB)
+        return;
+
+    const plEntity tEntityA = ptManager->sbtEntities[uA];
+    const plEntity tEntityB = ptManager->sbtEntities[uB];
+    ptManager->sbtEntities[uA] = tEntityB;
+    ptManager->sbtEntities[uB] = tEntityA;
+    ptManager->sbuSparse[tEntityA.uIndex] = uB;
+    ptManager->sbuSparse[tEntityB.uIndex] = uA;
+    ptManager->uGeneration++;
+
+    // swap component bytes in small pieces to avoid large stack buffers
+    unsigned char* pucA = &((unsigned char*)ptManager->pComponents)[uA * ptManager->szSize];
+    unsigned char* pucB = &((unsigned char*)ptManager->pComponents)[uB * ptManager->szSize];
+    unsigned char aucScratch[64];
+    size_t szRemaining = ptManager->szSize;
+    while(szRemaining > 0)
+    {
+        const size_t szPiece = szRemaining < sizeof(aucScratch) ? szRemaining : sizeof(aucScratch);
+        memcpy(aucScratch, pucA, szPiece);
+        memcpy(pucA, pucB, szPiece);
+        memcpy(pucB, aucScratch, szPiece);
+        pucA += szPiece;
+        pucB += szPiece;
+        szRemaining -= szPiece;
+    }
+}
+
+static void
+pl__ecs_group_add_entity(plComponentLibrary* ptLibrary, uint32_t uGroup, plEntity tEntity)
+{
+    plEcsGroup* ptGroup = &ptLibrary->_sbtGroups[uGroup];
+
+    // group members occupy [0, uCount) of every owned type
+    const uint32_t uFirstIndex = pl__ecs_sparse_lookup(&ptLibrary->_sbtManagers[ptGroup->atTypes[0]], tEntity.uIndex);
+    if(uFirstIndex != UINT32_MAX && uFirstIndex < ptGroup->uCount)
+        return;
+
+    for(uint32_t i = 0; i < ptGroup->uTypeCount; i++)
+    {
+        if(pl__ecs_sparse_lookup(&ptLibrary->_sbtManagers[ptGroup->atTypes[i]], tEntity.uIndex) == UINT32_MAX)
+            return;
+    }
+
+    for(uint32_t i = 0; i < ptGroup->uTypeCount; i++)
+    {
+        plComponentManager* ptManager = &ptLibrary->_sbtManagers[ptGroup->atTypes[i]];
+        pl__ecs_swap_dense(ptManager, ptManager->sbuSparse[tEntity.uIndex], ptGroup->uCount);
+    }
+    ptGroup->uCount++;
+}
+
+static void
+pl__ecs_group_remove_entity(plComponentLibrary* ptLibrary, uint32_t uGroup, plEntity tEntity)
+{
+    plEcsGroup* ptGroup = &ptLibrary->_sbtGroups[uGroup];
+
+    const uint32_t uFirstIndex = pl__ecs_sparse_lookup(&ptLibrary->_sbtManagers[ptGroup->atTypes[0]], tEntity.uIndex);
+    if(uFirstIndex == UINT32_MAX || uFirstIndex >= ptGroup->uCount)
+        return;
+
+    ptGroup->uCount--;
+    for(uint32_t i = 0; i < ptGroup->uTypeCount; i++)
+    {
+        plComponentManager* ptManager = &ptLibrary->_sbtManagers[ptGroup->atTypes[i]];
+        pl__ecs_swap_dense(ptManager, ptManager->sbuSparse[tEntity.uIndex], ptGroup->uCount);
+    }
+}
+
+bool
+pl_ecs_create_group(plComponentLibrary* ptLibrary, uint32_t uTypeCount, const plEcsTypeKey* atTypes)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    PL_ASSERT(uTypeCount > 1 && uTypeCount <= PL_ECS_QUERY_MAX_TYPES && "invalid group type count");
+    if(uTypeCount < 2 || uTypeCount > PL_ECS_QUERY_MAX_TYPES)
+        return false;
+
+    for(uint32_t i = 0; i < uTypeCount; i++)
+    {
+        PL_ASSERT(ptLibrary->_sbtManagers[atTypes[i]].uGroup == UINT32_MAX && "component type already owned by a group");
+        if(ptLibrary->_sbtManagers[atTypes[i]].uGroup != UINT32_MAX)
+            return false;
+    }
+
+    const uint32_t uGroup = pl_sb_size(ptLibrary->_sbtGroups);
+    plEcsGroup tGroup = {.uTypeCount = uTypeCount};
+    memcpy(tGroup.atTypes, atTypes, sizeof(plEcsTypeKey) * uTypeCount);
+    pl_sb_push(ptLibrary->_sbtGroups, tGroup);
+
+    // gather existing entities (walking the smallest type)
+    uint32_t uSmallest = 0;
+    for(uint32_t i = 0; i < uTypeCount; i++)
+    {
+        ptLibrary->_sbtManagers[atTypes[i]].uGroup = uGroup;
+        if(ptLibrary->_sbtManagers[atTypes[i]].uCount < ptLibrary->_sbtManagers[atTypes[uSmallest]].uCount)
+            uSmallest = i;
+    }
+
+    plComponentManager* ptDriver = &ptLibrary->_sbtManagers[atTypes[uSmallest]];
+    for(uint32_t i = 0; i < ptDriver->uCount; i++)
+    {
+        // entity at i is either already grouped (i < group count) or untouched
+        pl__ecs_group_add_entity(ptLibrary, uGroup, ptDriver->sbtEntities[i]);
+    }
+    return true;
+}
+
+void
+pl_ecs_query_begin(plComponentLibrary* ptLibrary, uint32_t uTypeCount, const plEcsTypeKey* atTypes, plEcsQueryIterator* ptIter)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    PL_ASSERT(uTypeCount > 0 && uTypeCount <= PL_ECS_QUERY_MAX_TYPES && "invalid query type count");
+
+    memset(ptIter, 0, offsetof(plEcsQueryIterator, _atEntities));
+    ptIter->_ptLibrary = ptLibrary;
+    ptIter->_uTypeCount = uTypeCount;
+
+    uint32_t uSmallest = 0;
+    for(uint32_t i = 0; i < uTypeCount; i++)
+    {
+        ptIter->_atTypes[i] = atTypes[i];
+        ptIter->_aszSizes[i] = ptLibrary->_sbtManagers[atTypes[i]].szSize;
+        if(ptLibrary->_sbtManagers[atTypes[i]].uCount < ptLibrary->_sbtManagers[atTypes[uSmallest]].uCount)
+            uSmallest = i;
+    }
+    ptIter->_uDriver = uSmallest;
+    ptIter->_uEnd = ptLibrary->_sbtManagers[atTypes[uSmallest]].uCount;
+
+    // single type queries are trivially aligned
+    if(uTypeCount == 1)
+    {
+        ptIter->_bAligned = true;
+        return;
+    }
+
+    // groups with exactly the queried types are aligned over their prefix
+    const uint32_t uGroup = ptLibrary->_sbtManagers[atTypes[0]].uGroup;
+    if(uGroup != UINT32_MAX && ptLibrary->_sbtGroups[uGroup].uTypeCount == uTypeCount)
+    {
+        bool bMatch = true;
+        for(uint32_t i = 1; i < uTypeCount; i++)
+        {
+            if(ptLibrary->_sbtManagers[atTypes[i]].uGroup != uGroup)
+            {
+                bMatch = false;
+                break;
+            }
+        }
+        if(bMatch)
+        {
+            ptIter->_bAligned = true;
+            ptIter->_uEnd = ptLibrary->_sbtGroups[uGroup].uCount;
+        }
+    }
+}
+
+bool
+pl_ecs_query_next(plEcsQueryIterator* ptIter)
+{
+    plComponentLibrary* ptLibrary = ptIter->_ptLibrary;
+    const uint32_t uTypeCount = ptIter->_uTypeCount;
+    ptIter->uCount = 0;
+
+    if(ptIter->_bAligned)
+    {
+        if(ptIter->_uCursor >= ptIter->_uEnd)
+            return false;
+
+        const uint32_t uStart = ptIter->_uCursor;
+        const uint32_t uRemaining = ptIter->_uEnd - uStart;
+        ptIter->uCount = uRemaining < PL_ECS_QUERY_CHUNK_SIZE ? uRemaining : PL_ECS_QUERY_CHUNK_SIZE;
+        ptIter->_uCursor += ptIter->uCount;
+
+        ptIter->ptEntities = &ptLibrary->_sbtManagers[ptIter->_atTypes[0]].sbtEntities[uStart];
+        for(uint32_t i = 0; i < uTypeCount; i++)
+        {
+            ptIter->apComponents[i] = &((char*)ptLibrary->_sbtManagers[ptIter->_atTypes[i]].pComponents)[uStart * ptIter->_aszSizes[i]];
+            ptIter->apuIndices[i] = NULL;
+        }
+        return true;
+    }
+
+    // walk smallest type & gather matches through sparse lookups
+    const plComponentManager* ptDriver = &ptLibrary->_sbtManagers[ptIter->_atTypes[ptIter->_uDriver]];
+    while(ptIter->_uCursor < ptIter->_uEnd && ptIter->uCount < PL_ECS_QUERY_CHUNK_SIZE)
+    {
+        const plEntity tEntity = ptDriver->sbtEntities[ptIter->_uCursor];
+        uint32_t auIndices[PL_ECS_QUERY_MAX_TYPES];
+        bool bMatch = true;
+        for(uint32_t i = 0; i < uTypeCount; i++)
+        {
+            if(i == ptIter->_uDriver)
+            {
+                auIndices[i] = ptIter->_uCursor;
+                continue;
+            }
+            auIndices[i] = pl__ecs_sparse_lookup(&ptLibrary->_sbtManagers[ptIter->_atTypes[i]], tEntity.uIndex);
+            if(auIndices[i] == UINT32_MAX)
+            {
+                bMatch = false;
+                break;
+            }
+        }
+        ptIter->_uCursor++;
+
+        if(bMatch)
+        {
+            ptIter->_atEntities[ptIter->uCount] = tEntity;
+            for(uint32_t i = 0; i < uTypeCount; i++)
+                ptIter->_auIndices[i][ptIter->uCount] = auIndices[i];
+            ptIter->uCount++;
+        }
+    }
+
+    if(ptIter->uCount == 0)
+        return false;
+
+    ptIter->ptEntities = ptIter->_atEntities;
+    for(uint32_t i = 0; i < uTypeCount; i++)
+    {
+        ptIter->apComponents[i] = ptLibrary->_sbtManagers[ptIter->_atTypes[i]].pComponents;
+        ptIter->apuIndices[i] = ptIter->_auIndices[i];
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] bulk operations
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_create_entities(plComponentLibrary* ptLibrary, uint32_t uCount, plEntity* atEntitiesOut)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    if(uCount == 0)
+        return;
+
+    // reuse free slots first, then append new slots in one step
+    uint32_t uFreeCount = pl_sb_size(ptLibrary->_sbtEntityFreeIndices);
+    if(uFreeCount > uCount)
+        uFreeCount = uCount;
+    for(uint32_t i = 0; i < uFreeCount; i++)
+    {
+        atEntitiesOut[i].uIndex = pl_sb_pop(ptLibrary->_sbtEntityFreeIndices);
+        atEntitiesOut[i].uGeneration = ptLibrary->_sbtEntityGenerations[atEntitiesOut[i].uIndex];
+    }
+
+    const uint32_t uNewCount = uCount - uFreeCount;
+    const uint32_t uFirstNewIndex = pl_sb_size(ptLibrary->_sbtEntityGenerations);
+    if(uNewCount > 0)
+    {
+        pl__ecs_sb_reserve(ptLibrary->_sbtEntityGenerations, uNewCount);
+        pl_sb_resize(ptLibrary->_sbtEntityGenerations, uFirstNewIndex + uNewCount);
+        for(uint32_t i = 0; i < uNewCount; i++)
+        {
+            ptLibrary->_sbtEntityGenerations[uFirstNewIndex + i] = 0;
+            atEntitiesOut[uFreeCount + i].uIndex = uFirstNewIndex + i;
+            atEntitiesOut[uFreeCount + i].uGeneration = 0;
+        }
+    }
+
+    // every entity gets a tag (unnamed entities are not added to the name map)
+    plComponentManager* ptTagManager = &ptLibrary->_sbtManagers[gptEcsCtx->tTagComponentType];
+    pl__ecs_reserve_components(ptTagManager, ptTagManager->uCount + uCount);
+    pl__ecs_reserve_sparse(ptTagManager, pl_sb_size(ptLibrary->_sbtEntityGenerations) - 1);
+
+    plTagComponent tTag = {.acName = "unnamed"};
+    for(uint32_t i = 0; i < uCount; i++)
+        pl__ecs_push_component(ptLibrary, gptEcsCtx->tTagComponentType, atEntitiesOut[i], &tTag);
+}
+
+void
+pl_ecs_add_components(plComponentLibrary* ptLibrary, plEcsTypeKey tType, uint32_t uCount, const plEntity* atEntities)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    plComponentManager* ptManager = &ptLibrary->_sbtManagers[tType];
+
+    // grow once for the whole batch
+    uint32_t uMaxIndex = 0;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        if(atEntities[i].uIndex != UINT32_MAX && atEntities[i].uIndex > uMaxIndex)
+            uMaxIndex = atEntities[i].uIndex;
+    }
+    pl__ecs_reserve_components(ptManager, ptManager->uCount + uCount);
+    pl__ecs_reserve_sparse(ptManager, uMaxIndex);
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plEntity tEntity = atEntities[i];
+        if(!pl_ecs_is_entity_valid(ptLibrary, tEntity) || ptManager->sbuSparse[tEntity.uIndex] != UINT32_MAX)
+            continue;
+        pl__ecs_push_component(ptLibrary, tType, tEntity, NULL);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] command buffers
+//-----------------------------------------------------------------------------
+
+plEcsCommandBuffer*
+pl_ecs_create_command_buffer(plComponentLibrary* ptLibrary)
+{
+    if(ptLibrary == NULL)
+        ptLibrary = gptEcsCtx->ptDefaultLibrary;
+
+    plEcsCommandBuffer* ptBuffer = PL_ALLOC(sizeof(plEcsCommandBuffer));
+    memset(ptBuffer, 0, sizeof(plEcsCommandBuffer));
+    ptBuffer->ptLibrary = ptLibrary;
+    return ptBuffer;
+}
+
+void
+pl_ecs_cleanup_command_buffer(plEcsCommandBuffer** pptBuffer)
+{
+    plEcsCommandBuffer* ptBuffer = *pptBuffer;
+    if(ptBuffer == NULL)
+        return;
+    pl_sb_free(ptBuffer->sbtCommands);
+    pl_sb_free(ptBuffer->sbucData);
+    pl_sb_free(ptBuffer->sbtResolved);
+    PL_FREE(ptBuffer);
+    *pptBuffer = NULL;
+}
+
+static void
+pl__ecs_record_command(plEcsCommandBuffer* ptBuffer, plEcsCommandType eType, plEcsTypeKey tType, plEntity tEntity, uint32_t uDataOffset)
+{
+    const plEcsCommand tCommand = {
+        .eType       = eType,
+        .tType       = tType,
+        .tEntity     = tEntity,
+        .uDataOffset = uDataOffset,
+        .uOrder      = pl_sb_size(ptBuffer->sbtCommands)
+    };
+    pl__ecs_sb_reserve(ptBuffer->sbtCommands, 1);
+    pl_sb_push(ptBuffer->sbtCommands, tCommand);
+}
+
+plEntity
+pl_ecs_record_create_entity(plEcsCommandBuffer* ptBuffer)
+{
+    const plEntity tEntity = {
+        .uIndex      = ptBuffer->uDeferredCount++,
+        .uGeneration = PL_ECS_DEFERRED_GENERATION
+    };
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_TYPE_CREATE_ENTITY, 0, tEntity, 0);
+    return tEntity;
+}
+
+void
+pl_ecs_record_remove_entity(plEcsCommandBuffer* ptBuffer, plEntity tEntity)
+{
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_TYPE_REMOVE_ENTITY, 0, tEntity, 0);
+}
+
+void*
+pl_ecs_record_add_component(plEcsCommandBuffer* ptBuffer, plEcsTypeKey tType, plEntity tEntity)
+{
+    const size_t szSize = gptEcsCtx->sbtComponentDescriptions[tType].szSize;
+
+    // payloads are 16 byte aligned within the buffer
+    const uint32_t uDataOffset = (pl_sb_size(ptBuffer->sbucData) + 15) & ~15u;
+    pl__ecs_sb_reserve(ptBuffer->sbucData, uDataOffset + (uint32_t)szSize - pl_sb_size(ptBuffer->sbucData));
+    pl_sb_resize(ptBuffer->sbucData, uDataOffset + (uint32_t)szSize);
+
+    uint8_t* pucData = &ptBuffer->sbucData[uDataOffset];
+    if(gptEcsCtx->sbtComponentDescriptions[tType]._pTemplate)
+        memcpy(pucData, gptEcsCtx->sbtComponentDescriptions[tType]._pTemplate, szSize);
+    else
+        memset(pucData, 0, szSize);
+
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_TYPE_ADD_COMPONENT, tType, tEntity, uDataOffset);
+    return pucData;
+}
+
+void
+pl_ecs_record_remove_component(plEcsCommandBuffer* ptBuffer, plEcsTypeKey tType, plEntity tEntity)
+{
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_TYPE_REMOVE_COMPONENT, tType, tEntity, 0);
+}
+
+static int
+pl__ecs_compare_commands(const void* pA, const void* pB)
+{
+    // entity, then recording order (commands on one entity apply as recorded)
+    const plEcsCommand* ptA = pA;
+    const plEcsCommand* ptB = pB;
+    if(ptA->tEntity.uIndex != ptB->tEntity.uIndex) return ptA->tEntity.uIndex < ptB->tEntity.uIndex ? -1 : 1;
+    if(ptA->uOrder != ptB->uOrder) return ptA->uOrder < ptB->uOrder ? -1 : 1;
+    return 0;
+}
+
+void
+pl_ecs_playback_command_buffers(uint32_t uBufferCount, plEcsCommandBuffer** aptBuffers)
+{
+    if(uBufferCount == 0)
+        return;
+
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, __FUNCTION__);
+
+    plComponentLibrary* ptLibrary = aptBuffers[0]->ptLibrary;
+
+    // create deferred entities (all buffers at once)
+    uint32_t uTotalCommands = 0;
+    for(uint32_t i = 0; i < uBufferCount; i++)
+    {
+        plEcsCommandBuffer* ptBuffer = aptBuffers[i];
+        PL_ASSERT(ptBuffer->ptLibrary == ptLibrary && "command buffers must target the same library");
+        pl_sb_resize(ptBuffer->sbtResolved, ptBuffer->uDeferredCount);
+        pl_ecs_create_entities(ptLibrary, ptBuffer->uDeferredCount, ptBuffer->sbtResolved);
+        uTotalCommands += pl_sb_size(ptBuffer->sbtCommands);
+    }
+
+    // gather remaining commands with resolved entities & payloads
+    plEcsCommand* atCommands = PL_ALLOC(sizeof(plEcsCommand) * (uTotalCommands + 1));
+    uint32_t uCommandCount = 0;
+    for(uint32_t i = 0; i < uBufferCount; i++)
+    {
+        plEcsCommandBuffer* ptBuffer = aptBuffers[i];
+        const uint32_t uBufferCommandCount = pl_sb_size(ptBuffer->sbtCommands);
+        for(uint32_t j = 0; j < uBufferCommandCount; j++)
+        {
+            plEcsCommand tCommand = ptBuffer->sbtCommands[j];
+            if(tCommand.eType == PL_ECS_COMMAND_TYPE_CREATE_ENTITY)
+                continue;
+            if(tCommand.tEntity.uGeneration == PL_ECS_DEFERRED_GENERATION)
+                tCommand.tEntity = ptBuffer->sbtResolved[tCommand.tEntity.uIndex];
+            tCommand.pucData = tCommand.eType == PL_ECS_COMMAND_TYPE_ADD_COMPONENT ? &ptBuffer->sbucData[tCommand.uDataOffset] : NULL;
+
+            // recorded parents may be deferred entities of the same buffer
+            if(tCommand.pucData && tCommand.tType == gptEcsCtx->tHierarchyComponentType)
+            {
+                plHierarchyComponent* ptHierarchy = (plHierarchyComponent*)tCommand.pucData;
+                if(ptHierarchy->tParent.uGeneration == PL_ECS_DEFERRED_GENERATION && ptHierarchy->tParent.uIndex < ptBuffer->uDeferredCount)
+                    ptHierarchy->tParent = ptBuffer->sbtResolved[ptHierarchy->tParent.uIndex];
+            }
+            tCommand.uOrder = uCommandCount; // buffer order, then recording order
+            atCommands[uCommandCount++] = tCommand;
+        }
+    }
+
+    // each manager grows once for all additions
+    const uint32_t uTypeCount = pl_sb_size(gptEcsCtx->sbtComponentDescriptions);
+    uint32_t* auAddCounts = PL_ALLOC(sizeof(uint32_t) * 2 * uTypeCount);
+    uint32_t* auMaxIndices = &auAddCounts[uTypeCount];
+    memset(auAddCounts, 0, sizeof(uint32_t) * 2 * uTypeCount);
+    for(uint32_t i = 0; i < uCommandCount; i++)
+    {
+        const plEcsCommand* ptCommand = &atCommands[i];
+        if(ptCommand->eType != PL_ECS_COMMAND_TYPE_ADD_COMPONENT || ptCommand->tEntity.uIndex == UINT32_MAX)
+            continue;
+        auAddCounts[ptCommand->tType]++;
+        if(ptCommand->tEntity.uIndex > auMaxIndices[ptCommand->tType])
+            auMaxIndices[ptCommand->tType] = ptCommand->tEntity.uIndex;
+    }
+    for(uint32_t i = 0; i < uTypeCount; i++)
+    {
+        if(auAddCounts[i] == 0)
+            continue;
+        plComponentManager* ptManager = &ptLibrary->_sbtManagers[i];
+        pl__ecs_reserve_components(ptManager, ptManager->uCount + auAddCounts[i]);
+        pl__ecs_reserve_sparse(ptManager, auMaxIndices[i]);
+    }
+    PL_FREE(auAddCounts);
+
+    // grouped by entity so sparse lookups stay local, recording order kept
+    // per entity (i.e. add then remove leaves the component removed)
+    qsort(atCommands, uCommandCount, sizeof(plEcsCommand), pl__ecs_compare_commands);
+
+    for(uint32_t uCommand = 0; uCommand < uCommandCount; uCommand++)
+    {
+        const plEcsCommand* ptCommand = &atCommands[uCommand];
+        if(!pl_ecs_is_entity_valid(ptLibrary, ptCommand->tEntity))
+            continue;
+
+        switch(ptCommand->eType)
+        {
+            case PL_ECS_COMMAND_TYPE_REMOVE_COMPONENT:
+                pl_ecs_remove_component(ptLibrary, ptCommand->tType, ptCommand->tEntity);
+                break;
+
+            case PL_ECS_COMMAND_TYPE_ADD_COMPONENT:
+            {
+                plComponentManager* ptManager = &ptLibrary->_sbtManagers[ptCommand->tType];
+                const uint32_t uIndex = ptManager->sbuSparse[ptCommand->tEntity.uIndex];
+
+                // hierarchy goes through the depth order like attach_component
+                if(ptCommand->tType == gptEcsCtx->tHierarchyComponentType)
+                {
+                    if(uIndex == UINT32_MAX)
+                    {
+                        const plHierarchyComponent tDetached = {.tParent = {.uIndex = UINT32_MAX}};
+                        pl__ecs_push_component(ptLibrary, ptCommand->tType, ptCommand->tEntity, &tDetached);
+                    }
+                    pl__ecs_hierarchy_set_parent(ptLibrary, ptCommand->tEntity, ((const plHierarchyComponent*)ptCommand->pucData)->tParent);
+                    break;
+                }
+
+                // tags keep the name map in sync like create_entity
+                if(ptCommand->tType == gptEcsCtx->tTagComponentType && uIndex != UINT32_MAX)
+                {
+                    const plTagComponent* ptOldTag = pl_ecs_get_component(ptLibrary, ptCommand->tType, ptCommand->tEntity);
+                    uint64_t uNameIndex = 0;
+                    if(pl_hm_has_key_str_ex(&ptLibrary->_tNameHashmap, ptOldTag->acName, &uNameIndex) && uNameIndex == ptCommand->tEntity.uIndex)
+                        pl_hm_remove_str(&ptLibrary->_tNameHashmap, ptOldTag->acName);
+                }
+
+                if(uIndex != UINT32_MAX) // later adds overwrite
+                    memcpy(&((char*)ptManager->pComponents)[uIndex * ptManager->szSize], ptCommand->pucData, ptManager->szSize);
+                else
+                    pl__ecs_push_component(ptLibrary, ptCommand->tType, ptCommand->tEntity, ptCommand->pucData);
+
+                if(ptCommand->tType == gptEcsCtx->tTagComponentType)
+                {
+                    const plTagComponent* ptTag = (const plTagComponent*)ptCommand->pucData;
+                    if(ptTag->acName[0] != 0)
+                        pl_hm_insert_str(&ptLibrary->_tNameHashmap, ptTag->acName, ptCommand->tEntity.uIndex);
+                }
+                break;
+            }
+
+            case PL_ECS_COMMAND_TYPE_REMOVE_ENTITY:
+                pl_ecs_remove_entity(ptLibrary, ptCommand->tEntity); // duplicates fail validity check
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    PL_FREE(atCommands);
+
+    for(uint32_t i = 0; i < uBufferCount; i++)
+    {
+        pl_sb_reset(aptBuffers[i]->sbtCommands);
+        pl_sb_reset(aptBuffers[i]->sbucData);
+        pl_sb_reset(aptBuffers[i]->sbtResolved);
+        aptBuffers[i]->uDeferredCount = 0;
+    }
+
+    PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -716,13 +1744,28 @@ pl_load_ecs_ext(plApiRegistryI* ptApiRegistry, bool bReload)
         .run_transform_update_system = pl_ecs_run_transform_update_system,
         .run_hierarchy_update_system = pl_ecs_run_hierarchy_update_system,
         .get_ecs_type_key_transform  = pl_ecs_get_ecs_type_key_transform,
-        .get_ecs_type_key_hierarchy  = pl_ecs_get_ecs_type_key_hierarchy
+        .get_ecs_type_key_hierarchy  = pl_ecs_get_ecs_type_key_hierarchy,
+        .create_group                = pl_ecs_create_group,
+        .query_begin                 = pl_ecs_query_begin,
+        .query_next                  = pl_ecs_query_next,
+        .remove_component            = pl_ecs_remove_component,
+        .create_entities             = pl_ecs_create_entities,
+        .add_components              = pl_ecs_add_components,
+        .create_command_buffer       = pl_ecs_create_command_buffer,
+        .cleanup_command_buffer      = pl_ecs_cleanup_command_buffer,
+        .record_create_entity        = pl_ecs_record_create_entity,
+        .record_remove_entity        = pl_ecs_record_remove_entity,
+        .record_add_component        = pl_ecs_record_add_component,
+        .record_remove_component     = pl_ecs_record_remove_component,
+        .playback_command_buffers    = pl_ecs_playback_command_buffers,
+        .get_component_generation    = pl_ecs_get_component_generation
     };
     pl_set_api(ptApiRegistry, plEcsI, &tApi);
 
     gptMemory  = pl_get_api_latest(ptApiRegistry, plMemoryI);
     gptProfile = pl_get_api_latest(ptApiRegistry, plProfileI);
     gptLog     = pl_get_api_latest(ptApiRegistry, plLogI);
+    gptJob     = pl_get_api_latest(ptApiRegistry, plJobI);
 
     const plDataRegistryI* ptDataRegistry = pl_get_api_latest(ptApiRegistry, plDataRegistryI);
 
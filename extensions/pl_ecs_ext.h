@@ -7,12 +7,14 @@ Index of this file:
 // [SECTION] implementation notes
 // [SECTION] header mess
 // [SECTION] apis
+// [SECTION] defines
 // [SECTION] forward declarations & basic types
 // [SECTION] public api
 // [SECTION] public api struct
 // [SECTION] components
 // [SECTION] structs
 // [SECTION] enums
+// [SECTION] inline API implementations
 */
 
 //-----------------------------------------------------------------------------
@@ -27,6 +29,73 @@ Index of this file:
 
         * plLogI (v1.x)
         * plProfileI (v1.x)
+        * plJobI (v3.x) (large transform/hierarchy updates; serial if not initialized)
+
+    Storage:
+        Each component type is stored densely (see get_components) with a
+        sparse entity index -> dense index table, so has/get/get_index are
+        O(1) without hashing.
+
+        Groups (create_group) let several component types share an aligned
+        prefix: entities owning every type of the group are kept at the start
+        of each type's dense array in the same order. A type can belong to at
+        most one group. Adding components of grouped types or removing
+        entities reorders dense arrays, so do not hold component pointers or
+        dense indices across those calls.
+
+    Hierarchy:
+        Entities attached with attach_component are kept bucketed by depth
+        (parents before children) and the order is maintained incrementally
+        by attach_component/deattach_component/remove_entity (reparenting an
+        entity that has children triggers a rebuild during the next
+        hierarchy update). Set parents through these functions rather than
+        writing plHierarchyComponent::tParent directly.
+
+        run_transform_update_system recomputes local matrices of transforms
+        flagged PL_TRANSFORM_FLAGS_DIRTY and marks them
+        PL_TRANSFORM_FLAGS_UPDATED. run_hierarchy_update_system then
+        propagates world matrices level by level, only into children whose
+        own transform or parent was updated. Both split large workloads
+        across plJobI.
+
+    Command buffers:
+        Structural changes (create/remove entity, add/remove component) are
+        not thread safe. Jobs can instead record them into their own
+        plEcsCommandBuffer (one per thread; recording only touches the
+        buffer) and the owner plays all buffers back at a sync point with
+        playback_command_buffers. Playback creates all deferred entities
+        first, grows each component type once, then applies the commands
+        grouped by entity. Commands on the same entity apply in recording
+        order (buffer order, then order within a buffer). Commands targeting
+        entities that are no longer valid are skipped and adding a component
+        an entity already has overwrites it.
+
+        Recorded hierarchy components are attached to their parent (which may
+        be a deferred entity of the same buffer) and recorded tags are added
+        to the name lookup, same as attach_component and create_entity.
+
+        Entities returned by record_create_entity may only be used with the
+        buffer that created them until it is played back.
+
+    Queries:
+        query_begin/query_next walk all entities owning a set of component
+        types in chunks of up to PL_ECS_QUERY_CHUNK_SIZE. When the type set
+        matches a group exactly (or is a single type) chunks are contiguous
+        slices of the dense arrays (apuIndices[] are NULL); otherwise the
+        smallest type drives the walk and apuIndices[] hold the dense index
+        of each match. pl_ecs_query_component(...) handles both cases.
+
+        plEcsTypeKey atTypes[] = {tTransformType, tVelocityType};
+        plEcsQueryIterator tIter;
+        gptEcs->query_begin(ptLibrary, 2, atTypes, &tIter);
+        while(gptEcs->query_next(&tIter))
+        {
+            for(uint32_t i = 0; i < tIter.uCount; i++)
+            {
+                plTransformComponent* ptTransform = pl_ecs_query_component(&tIter, 0, i);
+                plVelocityComponent*  ptVelocity  = pl_ecs_query_component(&tIter, 1, i);
+            }
+        }
 */
 
 //-----------------------------------------------------------------------------
@@ -44,7 +113,19 @@ extern "C" {
 // [SECTION] apis
 //-----------------------------------------------------------------------------
 
-#define plEcsI_version {2, 0, 0}
+#define plEcsI_version {2, 2, 0}
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#ifndef PL_ECS_QUERY_MAX_TYPES
+    #define PL_ECS_QUERY_MAX_TYPES 8
+#endif
+
+#ifndef PL_ECS_QUERY_CHUNK_SIZE
+    #define PL_ECS_QUERY_CHUNK_SIZE 256
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -62,6 +143,8 @@ extern "C" {
 typedef struct _plEcsInit          plEcsInit;          // reserved for future use
 typedef struct _plComponentDesc    plComponentDesc;    // describes a component
 typedef struct _plComponentLibrary plComponentLibrary; // opaque
+typedef struct _plEcsQueryIterator plEcsQueryIterator; // multi-component query state
+typedef struct _plEcsCommandBuffer plEcsCommandBuffer; // opaque (deferred structural changes)
 
 // ecs components
 typedef struct _plTagComponent       plTagComponent;
@@ -103,13 +186,30 @@ PL_API void     pl_ecs_remove_entity     (plComponentLibrary*, plEntity);
 PL_API bool     pl_ecs_is_entity_valid   (plComponentLibrary*, plEntity);
 PL_API plEntity pl_ecs_get_entity_by_name(plComponentLibrary*, const char* name);
 PL_API plEntity pl_ecs_get_current_entity(plComponentLibrary*, plEntity);
+PL_API void     pl_ecs_create_entities   (plComponentLibrary*, uint32_t count, plEntity* entitiesOut); // unnamed
 
 // components
-PL_API void*    pl_ecs_add_component (plComponentLibrary*, plEcsTypeKey, plEntity); // do not store
-PL_API void*    pl_ecs_get_component (plComponentLibrary*, plEcsTypeKey, plEntity); // do not store
-PL_API bool     pl_ecs_has_component (plComponentLibrary*, plEcsTypeKey, plEntity);
-PL_API size_t   pl_ecs_get_index     (plComponentLibrary*, plEcsTypeKey, plEntity);
-PL_API uint32_t pl_ecs_get_components(plComponentLibrary*, plEcsTypeKey, void**, const plEntity**); // do not store
+PL_API void*    pl_ecs_add_component   (plComponentLibrary*, plEcsTypeKey, plEntity); // do not store
+PL_API void     pl_ecs_add_components  (plComponentLibrary*, plEcsTypeKey, uint32_t count, const plEntity*); // template initialized
+PL_API void     pl_ecs_remove_component(plComponentLibrary*, plEcsTypeKey, plEntity);
+PL_API void*    pl_ecs_get_component   (plComponentLibrary*, plEcsTypeKey, plEntity); // do not store
+PL_API bool     pl_ecs_has_component   (plComponentLibrary*, plEcsTypeKey, plEntity);
+PL_API size_t   pl_ecs_get_index       (plComponentLibrary*, plEcsTypeKey, plEntity);
+PL_API uint32_t pl_ecs_get_components  (plComponentLibrary*, plEcsTypeKey, void**, const plEntity**); // do not store
+
+// groups & queries
+PL_API bool pl_ecs_create_group(plComponentLibrary*, uint32_t typeCount, const plEcsTypeKey*);
+PL_API void pl_ecs_query_begin (plComponentLibrary*, uint32_t typeCount, const plEcsTypeKey*, plEcsQueryIterator*);
+PL_API bool pl_ecs_query_next  (plEcsQueryIterator*); // false when exhausted
+
+// command buffers
+PL_API plEcsCommandBuffer* pl_ecs_create_command_buffer   (plComponentLibrary*);
+PL_API void                pl_ecs_cleanup_command_buffer  (plEcsCommandBuffer**);
+PL_API plEntity            pl_ecs_record_create_entity    (plEcsCommandBuffer*); // only valid within same buffer
+PL_API void                pl_ecs_record_remove_entity    (plEcsCommandBuffer*, plEntity);
+PL_API void*               pl_ecs_record_add_component    (plEcsCommandBuffer*, plEcsTypeKey, plEntity); // do not store
+PL_API void                pl_ecs_record_remove_component (plEcsCommandBuffer*, plEcsTypeKey, plEntity);
+PL_API void                pl_ecs_playback_command_buffers(uint32_t count, plEcsCommandBuffer**);
 
 //----------------------------CORE COMPONENTS----------------------------------
 
@@ -191,6 +291,33 @@ typedef struct _plEcsI
     void (*run_transform_update_system)(plComponentLibrary*);
     void (*run_hierarchy_update_system)(plComponentLibrary*);
 
+    //-------------------------------v2.1.0----------------------------------------
+
+    // groups & queries
+    bool (*create_group)(plComponentLibrary*, uint32_t typeCount, const plEcsTypeKey*);
+    void (*query_begin) (plComponentLibrary*, uint32_t typeCount, const plEcsTypeKey*, plEcsQueryIterator*);
+    bool (*query_next)  (plEcsQueryIterator*); // false when exhausted
+
+    //-------------------------------v2.2.0----------------------------------------
+
+    // bulk entities & components
+    void (*create_entities) (plComponentLibrary*, uint32_t count, plEntity* entitiesOut); // unnamed
+    void (*add_components)  (plComponentLibrary*, plEcsTypeKey, uint32_t count, const plEntity*); // template initialized
+    void (*remove_component)(plComponentLibrary*, plEcsTypeKey, plEntity);
+
+    // command buffers
+    plEcsCommandBuffer* (*create_command_buffer)   (plComponentLibrary*);
+    void                (*cleanup_command_buffer)  (plEcsCommandBuffer**);
+    plEntity            (*record_create_entity)    (plEcsCommandBuffer*); // only valid within same buffer
+    void                (*record_remove_entity)    (plEcsCommandBuffer*, plEntity);
+    void*               (*record_add_component)    (plEcsCommandBuffer*, plEcsTypeKey, plEntity); // do not store
+    void                (*record_remove_component) (plEcsCommandBuffer*, plEcsTypeKey, plEntity);
+    void                (*playback_command_buffers)(uint32_t count, plEcsCommandBuffer**);
+
+    // changes whenever components of a type are added, removed, or reordered
+    // (cached dense indices are invalid once it differs)
+    uint32_t (*get_component_generation)(plComponentLibrary*, plEcsTypeKey);
+
 } plEcsI;
 
 //-----------------------------------------------------------------------------
@@ -248,6 +375,26 @@ typedef struct _plComponentDesc
     const void*  _pTemplate;
 } plComponentDesc;
 
+typedef struct _plEcsQueryIterator
+{
+    uint32_t        uCount;                               // matches in current chunk
+    const plEntity* ptEntities;                           // entities of current chunk (do not store)
+    void*           apComponents[PL_ECS_QUERY_MAX_TYPES]; // per query slot component base (do not store)
+    const uint32_t* apuIndices[PL_ECS_QUERY_MAX_TYPES];   // per query slot dense indices (NULL when contiguous)
+
+    // [INTERNAL]
+    plComponentLibrary* _ptLibrary;
+    uint32_t            _uTypeCount;
+    plEcsTypeKey        _atTypes[PL_ECS_QUERY_MAX_TYPES];
+    size_t              _aszSizes[PL_ECS_QUERY_MAX_TYPES];
+    uint32_t            _uDriver;
+    uint32_t            _uCursor;
+    uint32_t            _uEnd;
+    bool                _bAligned;
+    plEntity            _atEntities[PL_ECS_QUERY_CHUNK_SIZE];
+    uint32_t            _auIndices[PL_ECS_QUERY_MAX_TYPES][PL_ECS_QUERY_CHUNK_SIZE];
+} plEcsQueryIterator;
+
 //-----------------------------------------------------------------------------
 // [SECTION] enums
 //-----------------------------------------------------------------------------
@@ -255,9 +402,21 @@ typedef struct _plComponentDesc
 enum _plTransformFlags
 {
     PL_TRANSFORM_FLAGS_NONE  = 0,
-    PL_TRANSFORM_FLAGS_DIRTY = 1 << 0,
+    PL_TRANSFORM_FLAGS_DIRTY   = 1 << 0,
+    PL_TRANSFORM_FLAGS_UPDATED = 1 << 1, // world matrix changed during last transform/hierarchy update (set by ECS)
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] inline API implementations
+//-----------------------------------------------------------------------------
+
+static inline void*
+pl_ecs_query_component(const plEcsQueryIterator* ptIter, uint32_t uSlot, uint32_t uIndex)
+{
+    const uint32_t uDenseIndex = ptIter->apuIndices[uSlot] ? ptIter->apuIndices[uSlot][uIndex] : uIndex;
+    return &((char*)ptIter->apComponents[uSlot])[uDenseIndex * ptIter->_aszSizes[uSlot]];
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,56 @@ Index of this file:
 #include "pl_memory.h"
 #include "pl_graphics_internal.h"
 #include "pl_shader_interop_cpu.h"
+#include "pl_job_ext.h"
+#include <float.h> // DBL_MAX
+
+// rasterizer simd path (scalar fallback otherwise)
+#if defined(__AVX__)
+    #define PL_CPU_RASTER_AVX
+    #define PL_CPU_RASTER_SSE2
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PL_CPU_RASTER_SSE2
+    #include <emmintrin.h>
+#endif
+
+// optional apis (parallel rasterization)
+static const plJobI*     gptJob     = NULL;
+static const plAtomicsI* gptAtomics = NULL;
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define SUBPIXEL_BITS  8
+#define SUBPIXEL_SCALE (1 << SUBPIXEL_BITS)
+#define SUBPIXEL_HALF  (SUBPIXEL_SCALE / 2)
+
+#define PL_CPU_DEFAULT_TILE_SIZE 64
+
+// pixels evaluated together along a row & block size used for trivial accept/reject
+#define PL_CPU_RASTER_LANES      4
+#define PL_CPU_RASTER_BLOCK_SIZE 8
+
+// binned post vertex shader vertices before tiles are flushed
+#define PL_CPU_MAX_BINNED_VERTICES 65536
+
+// triangles whose unique vertices are gathered & shaded together
+#define PL_CPU_VERTEX_BATCH_SIZE 64
+
+// homogeneous clipping: triangles are only clipped against x/y when they leave
+// the guard band (in NDC units) which keeps fixed point coordinates in range,
+// anything closer than the minimum w is clipped to avoid the w = 0 singularity
+#define PL_CPU_CLIP_GUARD_BAND 16.0f
+#define PL_CPU_CLIP_MIN_W      1e-5f
+#define PL_CPU_CLIP_MAX_VERTS  16 // 3 + 1 per clip plane (7)
+
+// pl_sb grows linearly, scratch arrays refilled every submit grow geometrically instead
+#define pl__cpu_sb_reserve_more(buf, n) \
+    do { \
+        if(pl_sb_size(buf) + (n) > pl_sb_capacity(buf)) \
+            pl_sb_reserve((buf), pl_sb_capacity(buf) + (n) + 64); \
+    } while(0)
 
 //-----------------------------------------------------------------------------
 // [SECTION] internal structs
@@ -37,6 +87,8 @@ enum _plCpuCommandBufferItemType
     PL_CPU_COMMAND_BUFFER_ITEM_TYPE_COPY_BUFFER_TO_TEXTURE,
     PL_CPU_COMMAND_BUFFER_ITEM_TYPE_SET_VIEWPORT,
     PL_CPU_COMMAND_BUFFER_ITEM_TYPE_SET_SCISSOR,
+    PL_CPU_COMMAND_BUFFER_ITEM_TYPE_BEGIN_RENDER_PASS,
+    PL_CPU_COMMAND_BUFFER_ITEM_TYPE_DISPATCH,
 };
 
 typedef struct _plInternalDeviceAllocatorData
@@ -90,12 +142,9 @@ typedef struct _plCpuShader
 
 typedef struct _plCpuComputeShader
 {
-    // VkPipelineLayout         tPipelineLayout;
-    // VkPipeline               tPipeline;
-    // VkShaderModule           tShaderModule;
-    // VkSpecializationMapEntry atSpecializationEntries[PL_MAX_SHADER_SPECIALIZATION_CONSTANTS];
-    size_t                   szSpecializationSize;
-    // VkDescriptorSetLayout    atDescriptorSetLayouts[4];
+    plComputeKernel tComputeKernel;
+    size_t          szSpecializationSize;
+    void*           pSpecializationData; // copy of plComputeShaderDesc::pTempConstantData
 } plCpuComputeShader;
 
 //-----------------------------------------------------------------------------
@@ -112,6 +161,11 @@ typedef struct _plCommandBufferItem
     plShaderHandle  tShader;
     plBufferHandle  tVertexBuffer;
     plDescriptorSet atCurrentDescriptorSets[4];
+    plDescriptor    tDynamicDescriptor; // set 3 points here at submit (per draw dynamic data)
+
+    // dispatch (also uses atCurrentDescriptorSets & tDynamicDescriptor)
+    plComputeShaderHandle tComputeShader;
+    plDispatch            tDispatch;
 
     // copy buffer to texture
     plBufferImageCopy tBufferImageCopy;
@@ -125,12 +179,74 @@ typedef struct _plCommandBufferItem
     plScissor tScissor;
 } plCommandBufferItem;
 
-typedef struct _plVertexCache
+typedef struct _plCpuVertex
 {
-    bool          bValid;
-    plVec2        tPosition;
+    plVec4        tClipPosition;
+    plVec2        tPosition; // framebuffer space
+    float         fDepth;    // viewport depth (z / w)
+    float         fInvW;     // 1 / w (perspective correct interpolation)
     plVaryingData tVaryings;
-} plVertexCache;
+} plCpuVertex;
+
+typedef struct _plCpuVertexCacheEntry
+{
+    uint32_t uGeneration; // valid when equal to plCommandBuffer::uVertexCacheGeneration
+    uint32_t uVertex;     // into sbtVertices
+} plCpuVertexCacheEntry;
+
+typedef struct _plCpuTriangle
+{
+    const plCommandBufferItem* ptItem; // shader & descriptor sets
+    uint32_t                   auVertices[3]; // into sbtVertices
+    int                        iMinX; // bounds clipped to viewport, scissor & framebuffer
+    int                        iMinY;
+    int                        iMaxX;
+    int                        iMaxY;
+    int64_t                    aiEdgeA[3]; // AB, BC, CA (oriented so inside is positive)
+    int64_t                    aiEdgeB[3];
+    int64_t                    aiEdgeC[3];
+    bool                       abTopLeft[3];
+    float                      fInvArea;
+    float                      fMinDepth; // depth range of vertices (interpolated depth is clamped to it)
+    float                      fMaxDepth;
+    bool                       bPerspective; // vertex w differs (varyings need perspective correction)
+} plCpuTriangle;
+
+typedef struct _plCpuTileBin
+{
+    uint32_t* sbuTriangles; // into sbtTriangles, in submission order
+} plCpuTileBin;
+
+typedef struct _plCpuRasterTile
+{
+    const plCommandBufferItem* ptItem;      // draw the varying layout below was taken from
+    uint32_t                   uFloatCount; // varying floats (multiple of 4)
+    plVaryingData              atVaryings[PL_CPU_RASTER_LANES]; // pixel shader inputs per lane
+
+    // depth (NULL when no depth attachment is bound)
+    float*   afDepth;
+    uint32_t uDepthStride; // in floats
+    uint32_t uTargetWidth;
+    uint32_t uTargetHeight;
+
+    // hierarchical depth (tile min/max is the min/max of the tile's hi-z blocks)
+    float*   afHiZMin;
+    float*   afHiZMax;
+    uint32_t uHiZCountX;
+    int      iTileMinX;
+    int      iTileMinY;
+    int      iTileMaxX;
+    int      iTileMaxY;
+    bool     bTileHiZDirty;
+    float    fTileHiZMin;
+    float    fTileHiZMax;
+} plCpuRasterTile;
+
+typedef struct _plCpuDispatchJob
+{
+    plDevice*                  ptDevice;
+    const plCommandBufferItem* ptItem;
+} plCpuDispatchJob;
 
 typedef struct _plCommandBuffer
 {
@@ -145,8 +261,34 @@ typedef struct _plCommandBuffer
     uint32_t             uCurrentStreamItem;
     plDescriptorSet      atCurrentDescriptorSets[4];
 
-    plVertexCache* sbtVertexCache;
-    
+    // compute state (separate bind point from graphics)
+    plComputeShaderHandle tCurrentComputeShader;
+    plDescriptorSet       atCurrentComputeDescriptorSets[4];
+    plDescriptor          tCurrentComputeDynamicDescriptor;
+    char*                 sbcComputeSharedMemory; // workgroups run on the submitting thread
+
+    // vertex stage (reset per flush)
+    plCpuVertexCacheEntry* sbtVertexCache;         // vertex buffer index -> sbtVertices (grows to highest index drawn)
+    uint32_t               uVertexCacheGeneration; // entries from older draws are stale (no clearing)
+    plCpuVertex*           sbtVertices;
+    plCpuTriangle* sbtTriangles;
+
+    // binning
+    plTextureHandle  tBinTarget;
+    plTextureHandle  tBinDepthTarget;
+    bool             bBinDepth; // tBinDepthTarget is a bound D32 attachment
+    uint32_t         uTileSize;
+    uint32_t         uTileCountX;
+    uint32_t         uTileCountY;
+    plCpuTileBin*    sbtTileBins;
+    uint32_t*        sbuActiveTiles;
+    plAtomicCounter* ptNextActiveTile;
+
+    // hierarchical depth (conservative min/max per raster block of the depth target)
+    uint32_t uHiZCountX;
+    uint32_t uHiZCountY;
+    float*   sbfHiZMin;
+    float*   sbfHiZMax;
 } plCommandBuffer;
 
 typedef struct _plCommandPool
@@ -316,36 +458,1060 @@ pl__is_top_left_edge(plVec2 a, plVec2 b)
     return dy < 0.0f || (dy == 0.0f && dx > 0.0f);
 }
 
+static inline void
+pl__cpu_blend_pixel(uint8_t* puPixel, plVec4 tColor)
+{
+    const float srcA = tColor.a;
+    const float invA = 1.0f - srcA;
+
+    plVec4 tDestColor;
+    tDestColor.r = puPixel[0];
+    tDestColor.g = puPixel[1];
+    tDestColor.b = puPixel[2];
+    tDestColor.a = puPixel[3];
+
+    puPixel[0] = (unsigned char)((255.0f * tColor.r * srcA + tDestColor.r * invA));
+    puPixel[1] = (unsigned char)((255.0f * tColor.g * srcA + tDestColor.g * invA));
+    puPixel[2] = (unsigned char)((255.0f * tColor.b * srcA + tDestColor.b * invA));
+    puPixel[3] = (unsigned char)((255.0f * tColor.a + tDestColor.a * invA));
+}
+
+static inline void
+pl__cpu_write_pixel(uint8_t* puPixel, plVec4 tColor)
+{
+    // blending disabled (opaque)
+    puPixel[0] = (unsigned char)(255.0f * pl_clampf(0.0f, tColor.r, 1.0f));
+    puPixel[1] = (unsigned char)(255.0f * pl_clampf(0.0f, tColor.g, 1.0f));
+    puPixel[2] = (unsigned char)(255.0f * pl_clampf(0.0f, tColor.b, 1.0f));
+    puPixel[3] = (unsigned char)(255.0f * pl_clampf(0.0f, tColor.a, 1.0f));
+}
+
+static inline bool
+pl__cpu_depth_test(plCompareMode eMode, float fDepth, float fStoredDepth)
+{
+    switch(eMode)
+    {
+        case PL_COMPARE_MODE_LESS:             return fDepth <  fStoredDepth;
+        case PL_COMPARE_MODE_EQUAL:            return fDepth == fStoredDepth;
+        case PL_COMPARE_MODE_LESS_OR_EQUAL:    return fDepth <= fStoredDepth;
+        case PL_COMPARE_MODE_GREATER:          return fDepth >  fStoredDepth;
+        case PL_COMPARE_MODE_NOT_EQUAL:        return fDepth != fStoredDepth;
+        case PL_COMPARE_MODE_GREATER_OR_EQUAL: return fDepth >= fStoredDepth;
+        case PL_COMPARE_MODE_ALWAYS:           return true;
+    }
+    return false; // never & unspecified (same as vulkan backend)
+}
+
+static inline bool
+pl__cpu_hiz_reject(plCompareMode eMode, float fMinDepth, float fMaxDepth, float fHiZMin, float fHiZMax)
+{
+    // true when no depth in [fMinDepth, fMaxDepth] can pass against stored depths in [fHiZMin, fHiZMax]
+    switch(eMode)
+    {
+        case PL_COMPARE_MODE_LESS:             return fMinDepth >= fHiZMax;
+        case PL_COMPARE_MODE_EQUAL:            return fMinDepth > fHiZMax || fMaxDepth < fHiZMin;
+        case PL_COMPARE_MODE_LESS_OR_EQUAL:    return fMinDepth > fHiZMax;
+        case PL_COMPARE_MODE_GREATER:          return fMaxDepth <= fHiZMin;
+        case PL_COMPARE_MODE_GREATER_OR_EQUAL: return fMaxDepth < fHiZMin;
+        case PL_COMPARE_MODE_NOT_EQUAL:
+        case PL_COMPARE_MODE_ALWAYS:           return false;
+    }
+    return true;
+}
+
+static inline bool
+pl__cpu_hiz_accept(plCompareMode eMode, float fMinDepth, float fMaxDepth, float fHiZMin, float fHiZMax)
+{
+    // true when every depth in [fMinDepth, fMaxDepth] passes against stored depths in [fHiZMin, fHiZMax]
+    switch(eMode)
+    {
+        case PL_COMPARE_MODE_LESS:             return fMaxDepth < fHiZMin;
+        case PL_COMPARE_MODE_LESS_OR_EQUAL:    return fMaxDepth <= fHiZMin;
+        case PL_COMPARE_MODE_GREATER:          return fMinDepth > fHiZMax;
+        case PL_COMPARE_MODE_GREATER_OR_EQUAL: return fMinDepth >= fHiZMax;
+        case PL_COMPARE_MODE_ALWAYS:           return true;
+    }
+    return false;
+}
+
+static void
+pl__cpu_update_hiz_block(float* afHiZMin, float* afHiZMax, uint32_t uHiZCountX, const float* afDepth, uint32_t uDepthStride, uint32_t uWidth, uint32_t uHeight, uint32_t uBlockX, uint32_t uBlockY)
+{
+    const uint32_t uMinX = uBlockX * PL_CPU_RASTER_BLOCK_SIZE;
+    const uint32_t uMinY = uBlockY * PL_CPU_RASTER_BLOCK_SIZE;
+    const uint32_t uMaxX = pl_min(uMinX + PL_CPU_RASTER_BLOCK_SIZE, uWidth);
+    const uint32_t uMaxY = pl_min(uMinY + PL_CPU_RASTER_BLOCK_SIZE, uHeight);
+    float fMin = FLT_MAX;
+    float fMax = -FLT_MAX;
+    for(uint32_t uY = uMinY; uY < uMaxY; uY++)
+    {
+        const float* afDepthRow = &afDepth[(size_t)uY * uDepthStride];
+        for(uint32_t uX = uMinX; uX < uMaxX; uX++)
+        {
+            fMin = pl_min(fMin, afDepthRow[uX]);
+            fMax = pl_max(fMax, afDepthRow[uX]);
+        }
+    }
+    afHiZMin[uBlockY * uHiZCountX + uBlockX] = fMin;
+    afHiZMax[uBlockY * uHiZCountX + uBlockX] = fMax;
+}
+
+static void
+pl__cpu_update_tile_hiz(plCpuRasterTile* ptTile)
+{
+    const uint32_t uHiZCountY = (ptTile->uTargetHeight + PL_CPU_RASTER_BLOCK_SIZE - 1) / PL_CPU_RASTER_BLOCK_SIZE;
+    const uint32_t uMinX = (uint32_t)ptTile->iTileMinX / PL_CPU_RASTER_BLOCK_SIZE;
+    const uint32_t uMinY = (uint32_t)ptTile->iTileMinY / PL_CPU_RASTER_BLOCK_SIZE;
+    const uint32_t uMaxX = pl_min((uint32_t)ptTile->iTileMaxX / PL_CPU_RASTER_BLOCK_SIZE, ptTile->uHiZCountX - 1);
+    const uint32_t uMaxY = pl_min((uint32_t)ptTile->iTileMaxY / PL_CPU_RASTER_BLOCK_SIZE, uHiZCountY - 1);
+    ptTile->fTileHiZMin = FLT_MAX;
+    ptTile->fTileHiZMax = -FLT_MAX;
+    for(uint32_t uY = uMinY; uY <= uMaxY; uY++)
+    {
+        for(uint32_t uX = uMinX; uX <= uMaxX; uX++)
+        {
+            ptTile->fTileHiZMin = pl_min(ptTile->fTileHiZMin, ptTile->afHiZMin[uY * ptTile->uHiZCountX + uX]);
+            ptTile->fTileHiZMax = pl_max(ptTile->fTileHiZMax, ptTile->afHiZMax[uY * ptTile->uHiZCountX + uX]);
+        }
+    }
+    ptTile->bTileHiZDirty = false;
+}
+
+static uint32_t
+pl__cpu_rasterize_lanes(uint32_t uMask, const double adEdges[3], const double adEdgeStepX[3], const double adEdgeBias[3], double dInvArea, float afWeights[3][PL_CPU_RASTER_LANES])
+{
+    // edge values are exact integers in doubles so coverage & weights match a
+    // per pixel evaluation on every path; weights are ordered A, B, C (edges BC, CA, AB)
+#if defined(PL_CPU_RASTER_AVX)
+    const __m256d tLanes = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d tInvArea = _mm256_set1_pd(dInvArea);
+    int iInside = 0xF;
+    for(uint32_t uEdge = 0; uEdge < 3; uEdge++)
+    {
+        const __m256d tEdge = _mm256_add_pd(_mm256_set1_pd(adEdges[uEdge]), _mm256_mul_pd(tLanes, _mm256_set1_pd(adEdgeStepX[uEdge])));
+        iInside &= _mm256_movemask_pd(_mm256_cmp_pd(tEdge, _mm256_set1_pd(adEdgeBias[uEdge]), _CMP_GE_OQ));
+        _mm_storeu_ps(afWeights[(uEdge + 2) % 3], _mm256_cvtpd_ps(_mm256_mul_pd(tEdge, tInvArea)));
+    }
+    uMask &= (uint32_t)iInside;
+#elif defined(PL_CPU_RASTER_SSE2)
+    const __m128d tLanes01 = _mm_set_pd(1.0, 0.0);
+    const __m128d tLanes23 = _mm_set_pd(3.0, 2.0);
+    const __m128d tInvArea = _mm_set1_pd(dInvArea);
+    int iInside = 0xF;
+    for(uint32_t uEdge = 0; uEdge < 3; uEdge++)
+    {
+        const __m128d tEdge = _mm_set1_pd(adEdges[uEdge]);
+        const __m128d tStep = _mm_set1_pd(adEdgeStepX[uEdge]);
+        const __m128d tBias = _mm_set1_pd(adEdgeBias[uEdge]);
+        const __m128d tEdge01 = _mm_add_pd(tEdge, _mm_mul_pd(tLanes01, tStep));
+        const __m128d tEdge23 = _mm_add_pd(tEdge, _mm_mul_pd(tLanes23, tStep));
+        iInside &= _mm_movemask_pd(_mm_cmpge_pd(tEdge01, tBias)) | (_mm_movemask_pd(_mm_cmpge_pd(tEdge23, tBias)) << 2);
+        _mm_storeu_ps(afWeights[(uEdge + 2) % 3], _mm_movelh_ps(_mm_cvtpd_ps(_mm_mul_pd(tEdge01, tInvArea)), _mm_cvtpd_ps(_mm_mul_pd(tEdge23, tInvArea))));
+    }
+    uMask &= (uint32_t)iInside;
+#else
+    for(uint32_t uLane = 0; uLane < PL_CPU_RASTER_LANES; uLane++)
+    {
+        for(uint32_t uEdge = 0; uEdge < 3; uEdge++)
+        {
+            const double dEdge = adEdges[uEdge] + (double)uLane * adEdgeStepX[uEdge];
+            if(dEdge < adEdgeBias[uEdge])
+                uMask &= ~(1u << uLane);
+            afWeights[(uEdge + 2) % 3][uLane] = (float)(dEdge * dInvArea);
+        }
+    }
+#endif
+    return uMask;
+}
+
+static void
+pl__cpu_interpolate_lanes(plCpuRasterTile* ptTile, const float* afVarying0, const float* afVarying1, const float* afVarying2, const float afWeights[3][PL_CPU_RASTER_LANES])
+{
+    // varyings are interpolated for all lanes at once (SoA) then transposed
+    // into each lane's plVaryingData, 4 floats at a time
+#if defined(PL_CPU_RASTER_SSE2)
+    const __m128 tWeightA = _mm_loadu_ps(afWeights[0]);
+    const __m128 tWeightB = _mm_loadu_ps(afWeights[1]);
+    const __m128 tWeightC = _mm_loadu_ps(afWeights[2]);
+    for(uint32_t i = 0; i < ptTile->uFloatCount; i += 4)
+    {
+        __m128 atBlended[4];
+        for(uint32_t j = 0; j < 4; j++)
+        {
+            atBlended[j] = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(afVarying0[i + j]), tWeightA),
+                _mm_mul_ps(_mm_set1_ps(afVarying1[i + j]), tWeightB)),
+                _mm_mul_ps(_mm_set1_ps(afVarying2[i + j]), tWeightC));
+        }
+        _MM_TRANSPOSE4_PS(atBlended[0], atBlended[1], atBlended[2], atBlended[3]);
+        for(uint32_t uLane = 0; uLane < PL_CPU_RASTER_LANES; uLane++)
+            _mm_storeu_ps(&((float*)ptTile->atVaryings[uLane].acVaryingData)[i], atBlended[uLane]);
+    }
+#else
+    for(uint32_t uLane = 0; uLane < PL_CPU_RASTER_LANES; uLane++)
+    {
+        float* afBlended = (float*)ptTile->atVaryings[uLane].acVaryingData;
+        for(uint32_t i = 0; i < ptTile->uFloatCount; i++)
+            afBlended[i] = afVarying0[i] * afWeights[0][uLane] + afVarying1[i] * afWeights[1][uLane] + afVarying2[i] * afWeights[2][uLane];
+    }
+#endif
+}
+
+static inline void
+pl__cpu_interpolate_depth(const plCpuTriangle* ptTriangle, float fDepth0, float fDepth1, float fDepth2, const float afWeights[3][PL_CPU_RASTER_LANES], float afDepthOut[PL_CPU_RASTER_LANES])
+{
+    // clamped to the vertex range so hi-z decisions agree with per pixel tests
+#if defined(PL_CPU_RASTER_SSE2)
+    __m128 tDepth = _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_set1_ps(fDepth0), _mm_loadu_ps(afWeights[0])),
+        _mm_mul_ps(_mm_set1_ps(fDepth1), _mm_loadu_ps(afWeights[1]))),
+        _mm_mul_ps(_mm_set1_ps(fDepth2), _mm_loadu_ps(afWeights[2])));
+    tDepth = _mm_min_ps(_mm_max_ps(tDepth, _mm_set1_ps(ptTriangle->fMinDepth)), _mm_set1_ps(ptTriangle->fMaxDepth));
+    _mm_storeu_ps(afDepthOut, tDepth);
+#else
+    for(uint32_t uLane = 0; uLane < PL_CPU_RASTER_LANES; uLane++)
+    {
+        const float fDepth = fDepth0 * afWeights[0][uLane] + fDepth1 * afWeights[1][uLane] + fDepth2 * afWeights[2][uLane];
+        afDepthOut[uLane] = pl_clampf(ptTriangle->fMinDepth, fDepth, ptTriangle->fMaxDepth);
+    }
+#endif
+}
+
+static inline void
+pl__cpu_perspective_weights(float fInvW0, float fInvW1, float fInvW2, float afWeights[3][PL_CPU_RASTER_LANES])
+{
+    // screen space weights -> perspective correct weights ((b / w) / sum(b / w)),
+    // depth is interpolated before this since z / w is linear in screen space
+#if defined(PL_CPU_RASTER_SSE2)
+    const __m128 tWeightA = _mm_mul_ps(_mm_loadu_ps(afWeights[0]), _mm_set1_ps(fInvW0));
+    const __m128 tWeightB = _mm_mul_ps(_mm_loadu_ps(afWeights[1]), _mm_set1_ps(fInvW1));
+    const __m128 tWeightC = _mm_mul_ps(_mm_loadu_ps(afWeights[2]), _mm_set1_ps(fInvW2));
+    const __m128 tInvSum = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(tWeightA, tWeightB), tWeightC));
+    _mm_storeu_ps(afWeights[0], _mm_mul_ps(tWeightA, tInvSum));
+    _mm_storeu_ps(afWeights[1], _mm_mul_ps(tWeightB, tInvSum));
+    _mm_storeu_ps(afWeights[2], _mm_mul_ps(tWeightC, tInvSum));
+#else
+    for(uint32_t uLane = 0; uLane < PL_CPU_RASTER_LANES; uLane++)
+    {
+        const float fWeightA = afWeights[0][uLane] * fInvW0;
+        const float fWeightB = afWeights[1][uLane] * fInvW1;
+        const float fWeightC = afWeights[2][uLane] * fInvW2;
+        const float fInvSum = 1.0f / (fWeightA + fWeightB + fWeightC);
+        afWeights[0][uLane] = fWeightA * fInvSum;
+        afWeights[1][uLane] = fWeightB * fInvSum;
+        afWeights[2][uLane] = fWeightC * fInvSum;
+    }
+#endif
+}
+
+static uint32_t
+pl__cpu_varying_float_count(const plVaryingData* ptVaryingData)
+{
+    uint32_t uFloatCount = 0;
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const plVaryingType tType = ptVaryingData->atTypes[i];
+        if(tType == PL_VARYING_TYPE_NONE)
+            break;
+        else if(tType == PL_VARYING_TYPE_FLOAT) uFloatCount += 1;
+        else if(tType == PL_VARYING_TYPE_VEC2)  uFloatCount += 2;
+        else if(tType == PL_VARYING_TYPE_VEC3)  uFloatCount += 3;
+        else if(tType == PL_VARYING_TYPE_VEC4)  uFloatCount += 4;
+    }
+    return uFloatCount;
+}
+
+static void
+pl__cpu_shade_pixels(plDevice* ptDevice, plCpuRasterTile* ptTile, const plCpuTriangle* ptTriangle, const plCpuVertex* atVertices, int iMinX, int iMinY, int iMaxX, int iMaxY, plCpuTexture* ptTarget, uint32_t uTargetWidth, uint32_t uTargetHeight)
+{
+    const plCommandBufferItem* ptCmdBufferItem = ptTriangle->ptItem;
+    const plCpuShader* ptCpuPipeline = &ptDevice->sbtShadersHot[ptCmdBufferItem->tShader.uIndex];
+    plDescriptorSet* atDescriptorSets = (plDescriptorSet*)ptCmdBufferItem->atCurrentDescriptorSets;
+
+    // depth state (early depth test is always valid, cpu pixel shaders can't discard or write depth)
+    const plGraphicsState tGraphicsState = ptDevice->sbtShadersCold[ptCmdBufferItem->tShader.uIndex].tDesc.tGraphicsState;
+    const plCompareMode eDepthMode = (plCompareMode)tGraphicsState.eDepthMode;
+    const bool bDepthTest  = ptTile->afDepth && eDepthMode != PL_COMPARE_MODE_ALWAYS;
+    const bool bDepthWrite = ptTile->afDepth && tGraphicsState.bDepthWriteEnabled;
+    const bool bBlend = ptDevice->sbtShadersCold[ptCmdBufferItem->tShader.uIndex].tDesc.atBlendStates[0].bBlendEnabled;
+    const float fDepth0 = atVertices[ptTriangle->auVertices[0]].fDepth;
+    const float fDepth1 = atVertices[ptTriangle->auVertices[1]].fDepth;
+    const float fDepth2 = atVertices[ptTriangle->auVertices[2]].fDepth;
+
+    // whole triangle rejected against the tile
+    if(bDepthTest)
+    {
+        if(ptTile->bTileHiZDirty)
+            pl__cpu_update_tile_hiz(ptTile);
+        if(pl__cpu_hiz_reject(eDepthMode, ptTriangle->fMinDepth, ptTriangle->fMaxDepth, ptTile->fTileHiZMin, ptTile->fTileHiZMax))
+            return;
+    }
+
+    const plVaryingData* ptVaryingData0 = &atVertices[ptTriangle->auVertices[0]].tVaryings;
+    const float* afVarying0 = (const float*)ptVaryingData0->acVaryingData;
+    const float* afVarying1 = (const float*)atVertices[ptTriangle->auVertices[1]].tVaryings.acVaryingData;
+    const float* afVarying2 = (const float*)atVertices[ptTriangle->auVertices[2]].tVaryings.acVaryingData;
+
+    // varying layout only changes between draws
+    if(ptTile->ptItem != ptCmdBufferItem)
+    {
+        ptTile->ptItem = ptCmdBufferItem;
+
+        // rounded up since varyings are interpolated 4 at a time (acVaryingData has room)
+        ptTile->uFloatCount = (pl__cpu_varying_float_count(ptVaryingData0) + 3) & ~3u;
+        for(uint32_t uLane = 0; uLane < PL_CPU_RASTER_LANES; uLane++)
+        {
+            plVaryingData* ptLaneVaryings = &ptTile->atVaryings[uLane];
+            memcpy(ptLaneVaryings->atTypes, ptVaryingData0->atTypes, sizeof(ptLaneVaryings->atTypes));
+            memcpy(ptLaneVaryings->_auOffset, ptVaryingData0->_auOffset, sizeof(ptLaneVaryings->_auOffset));
+            ptLaneVaryings->_uCurrentVarying = ptVaryingData0->_uCurrentVarying;
+            ptLaneVaryings->_uCurrentOffset = ptVaryingData0->_uCurrentOffset;
+        }
+    }
+
+    // edge function values at pixel (iMinX, iMinY) & per pixel steps
+    const int64_t sampleX = (int64_t)iMinX * SUBPIXEL_SCALE + SUBPIXEL_HALF;
+    const int64_t sampleY = (int64_t)iMinY * SUBPIXEL_SCALE + SUBPIXEL_HALF;
+    int64_t aiEdgeOrigin[3] = {0};
+    int64_t aiEdgeStepX[3] = {0};
+    int64_t aiEdgeStepY[3] = {0};
+    int64_t aiEdgeBias[3] = {0};
+    double adEdgeStepX[3] = {0};
+    double adEdgeStepY[3] = {0};
+    double adEdgeBias[3] = {0};
+    for(uint32_t uEdge = 0; uEdge < 3; uEdge++)
+    {
+        aiEdgeOrigin[uEdge] = ptTriangle->aiEdgeA[uEdge] * sampleX + ptTriangle->aiEdgeB[uEdge] * sampleY + ptTriangle->aiEdgeC[uEdge];
+        aiEdgeStepX[uEdge] = ptTriangle->aiEdgeA[uEdge] * SUBPIXEL_SCALE;
+        aiEdgeStepY[uEdge] = ptTriangle->aiEdgeB[uEdge] * SUBPIXEL_SCALE;
+
+        // inside when value > 0, or == 0 on a top-left edge
+        aiEdgeBias[uEdge] = ptTriangle->abTopLeft[uEdge] ? 0 : 1;
+        adEdgeStepX[uEdge] = (double)aiEdgeStepX[uEdge];
+        adEdgeStepY[uEdge] = (double)aiEdgeStepY[uEdge];
+        adEdgeBias[uEdge] = (double)aiEdgeBias[uEdge];
+    }
+    const double dInvArea = (double)ptTriangle->fInvArea;
+
+    // blocks aligned to the block grid, trivially rejected or accepted using
+    // the edge values at their corners
+    for(int iBlockMinY = iMinY; iBlockMinY <= iMaxY; iBlockMinY = (iBlockMinY | (PL_CPU_RASTER_BLOCK_SIZE - 1)) + 1)
+    {
+        const int iBlockMaxY = pl_min(iBlockMinY | (PL_CPU_RASTER_BLOCK_SIZE - 1), iMaxY);
+        for(int iBlockMinX = iMinX; iBlockMinX <= iMaxX; iBlockMinX = (iBlockMinX | (PL_CPU_RASTER_BLOCK_SIZE - 1)) + 1)
+        {
+            const int iBlockMaxX = pl_min(iBlockMinX | (PL_CPU_RASTER_BLOCK_SIZE - 1), iMaxX);
+
+            bool bRejected = false;
+            bool bAccepted = true;
+            double adRowEdges[3] = {0};
+            for(uint32_t uEdge = 0; uEdge < 3; uEdge++)
+            {
+                const int64_t iBlockOrigin = aiEdgeOrigin[uEdge] + aiEdgeStepX[uEdge] * (iBlockMinX - iMinX) + aiEdgeStepY[uEdge] * (iBlockMinY - iMinY);
+                const int64_t iSpanX = aiEdgeStepX[uEdge] * (iBlockMaxX - iBlockMinX);
+                const int64_t iSpanY = aiEdgeStepY[uEdge] * (iBlockMaxY - iBlockMinY);
+                const int64_t iMinValue = iBlockOrigin + pl_min(iSpanX, 0) + pl_min(iSpanY, 0);
+                const int64_t iMaxValue = iBlockOrigin + pl_max(iSpanX, 0) + pl_max(iSpanY, 0);
+                if(iMaxValue < aiEdgeBias[uEdge])
+                    bRejected = true;
+                if(iMinValue < aiEdgeBias[uEdge])
+                    bAccepted = false;
+                adRowEdges[uEdge] = (double)iBlockOrigin;
+            }
+
+            if(bRejected)
+                continue;
+
+            // hierarchical depth
+            const uint32_t uHiZBlockX = (uint32_t)iBlockMinX / PL_CPU_RASTER_BLOCK_SIZE;
+            const uint32_t uHiZBlockY = (uint32_t)iBlockMinY / PL_CPU_RASTER_BLOCK_SIZE;
+            bool bDepthAccepted = !bDepthTest;
+            bool bDepthWritten = false;
+            if(bDepthTest)
+            {
+                const float fHiZMin = ptTile->afHiZMin[uHiZBlockY * ptTile->uHiZCountX + uHiZBlockX];
+                const float fHiZMax = ptTile->afHiZMax[uHiZBlockY * ptTile->uHiZCountX + uHiZBlockX];
+                if(pl__cpu_hiz_reject(eDepthMode, ptTriangle->fMinDepth, ptTriangle->fMaxDepth, fHiZMin, fHiZMax))
+                    continue;
+                bDepthAccepted = pl__cpu_hiz_accept(eDepthMode, ptTriangle->fMinDepth, ptTriangle->fMaxDepth, fHiZMin, fHiZMax);
+            }
+
+            // accepted blocks still evaluate edges for the interpolation weights
+            const double* adLaneBias = adEdgeBias;
+            static const double adAcceptBias[3] = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
+            if(bAccepted)
+                adLaneBias = adAcceptBias;
+
+            for(int iY = iBlockMinY; iY <= iBlockMaxY; iY++)
+            {
+                uint8_t* puTargetRow = &((uint8_t*)ptTarget->pData)[(size_t)iY * uTargetWidth * 4];
+                for(int iX = iBlockMinX; iX <= iBlockMaxX; iX += PL_CPU_RASTER_LANES)
+                {
+                    const double adLaneEdges[3] = {
+                        adRowEdges[0] + adEdgeStepX[0] * (double)(iX - iBlockMinX),
+                        adRowEdges[1] + adEdgeStepX[1] * (double)(iX - iBlockMinX),
+                        adRowEdges[2] + adEdgeStepX[2] * (double)(iX - iBlockMinX)
+                    };
+                    const uint32_t uLaneCount = (uint32_t)pl_min(PL_CPU_RASTER_LANES, iBlockMaxX - iX + 1);
+                    float afWeights[3][PL_CPU_RASTER_LANES];
+                    uint32_t uMask = pl__cpu_rasterize_lanes((1u << uLaneCount) - 1, adLaneEdges, adEdgeStepX, adLaneBias, dInvArea, afWeights);
+                    if(uMask == 0)
+                        continue;
+
+                    // early depth test
+                    if(bDepthTest || bDepthWrite)
+                    {
+                        float afLaneDepth[PL_CPU_RASTER_LANES];
+                        pl__cpu_interpolate_depth(ptTriangle, fDepth0, fDepth1, fDepth2, afWeights, afLaneDepth);
+                        float* afDepthRow = &ptTile->afDepth[(size_t)iY * ptTile->uDepthStride + iX];
+                        for(uint32_t uLane = 0; uLane < uLaneCount; uLane++)
+                        {
+                            if((uMask & (1u << uLane)) == 0)
+                                continue;
+                            if(!bDepthAccepted && !pl__cpu_depth_test(eDepthMode, afLaneDepth[uLane], afDepthRow[uLane]))
+                            {
+                                uMask &= ~(1u << uLane);
+                                continue;
+                            }
+                            if(bDepthWrite)
+                            {
+                                afDepthRow[uLane] = afLaneDepth[uLane];
+                                bDepthWritten = true;
+                            }
+                        }
+                        if(uMask == 0)
+                            continue;
+                    }
+
+                    if(ptTriangle->bPerspective)
+                        pl__cpu_perspective_weights(atVertices[ptTriangle->auVertices[0]].fInvW, atVertices[ptTriangle->auVertices[1]].fInvW, atVertices[ptTriangle->auVertices[2]].fInvW, afWeights);
+                    pl__cpu_interpolate_lanes(ptTile, afVarying0, afVarying1, afVarying2, afWeights);
+
+                    // run pixel shader
+                    for(uint32_t uLane = 0; uLane < uLaneCount; uLane++)
+                    {
+                        if((uMask & (1u << uLane)) == 0)
+                            continue;
+
+                        // pixel rect is already clamped to the target
+                        plPixelShaderBuiltIns tBuiltIns = {
+                            .gl_FragCoord.xy = {
+                                (float)(iX + (int)uLane) + 0.5f,
+                                (float)iY + 0.5f
+                            }
+                        };
+                        plVec4 tFinalColor = ptCpuPipeline->tPixelShader(tBuiltIns, atDescriptorSets, &ptTile->atVaryings[uLane]);
+                        if(bBlend)
+                            pl__cpu_blend_pixel(&puTargetRow[(iX + (int)uLane) * 4], tFinalColor);
+                        else
+                            pl__cpu_write_pixel(&puTargetRow[(iX + (int)uLane) * 4], tFinalColor);
+                    }
+                }
+                adRowEdges[0] += adEdgeStepY[0];
+                adRowEdges[1] += adEdgeStepY[1];
+                adRowEdges[2] += adEdgeStepY[2];
+            }
+
+            if(bDepthWritten)
+            {
+                pl__cpu_update_hiz_block(ptTile->afHiZMin, ptTile->afHiZMax, ptTile->uHiZCountX, ptTile->afDepth, ptTile->uDepthStride,
+                    ptTile->uTargetWidth, ptTile->uTargetHeight, uHiZBlockX, uHiZBlockY);
+                ptTile->bTileHiZDirty = true;
+            }
+        }
+    }
+}
+
+static void
+pl__cpu_raster_tile(plCommandBuffer* ptCommandBuffer, uint32_t uTile)
+{
+    plDevice* ptDevice = ptCommandBuffer->ptDevice;
+    plTexture* ptTexture = &ptDevice->sbtTexturesCold[ptCommandBuffer->tBinTarget.uIndex];
+    plCpuTexture* ptCpuTexture = &ptDevice->sbtTexturesHot[ptCommandBuffer->tBinTarget.uIndex];
+    const uint32_t uTargetWidth  = (uint32_t)ptTexture->tDesc.tDimensions.x;
+    const uint32_t uTargetHeight = (uint32_t)ptTexture->tDesc.tDimensions.y;
+
+    const int iTileSize = (int)ptCommandBuffer->uTileSize;
+    const int iTileMinX = (int)(uTile % ptCommandBuffer->uTileCountX) * iTileSize;
+    const int iTileMinY = (int)(uTile / ptCommandBuffer->uTileCountX) * iTileSize;
+    const int iTileMaxX = iTileMinX + iTileSize - 1;
+    const int iTileMaxY = iTileMinY + iTileSize - 1;
+
+    plCpuRasterTile tTile = {
+        .uTargetWidth  = uTargetWidth,
+        .uTargetHeight = uTargetHeight,
+        .iTileMinX     = iTileMinX,
+        .iTileMinY     = iTileMinY,
+        .iTileMaxX     = iTileMaxX,
+        .iTileMaxY     = iTileMaxY,
+        .bTileHiZDirty = true
+    };
+    if(ptCommandBuffer->bBinDepth)
+    {
+        const plTexture* ptDepthTexture = &ptDevice->sbtTexturesCold[ptCommandBuffer->tBinDepthTarget.uIndex];
+        tTile.afDepth      = ptDevice->sbtTexturesHot[ptCommandBuffer->tBinDepthTarget.uIndex].pData;
+        tTile.uDepthStride = (uint32_t)ptDepthTexture->tDesc.tDimensions.x;
+        tTile.afHiZMin     = ptCommandBuffer->sbfHiZMin;
+        tTile.afHiZMax     = ptCommandBuffer->sbfHiZMax;
+        tTile.uHiZCountX   = ptCommandBuffer->uHiZCountX;
+    }
+
+    const uint32_t* sbuTriangles = ptCommandBuffer->sbtTileBins[uTile].sbuTriangles;
+    const uint32_t uTriangleCount = pl_sb_size(sbuTriangles);
+    for(uint32_t i = 0; i < uTriangleCount; i++)
+    {
+        const plCpuTriangle* ptTriangle = &ptCommandBuffer->sbtTriangles[sbuTriangles[i]];
+        pl__cpu_shade_pixels(ptDevice, &tTile, ptTriangle, ptCommandBuffer->sbtVertices,
+            pl_max(ptTriangle->iMinX, iTileMinX),
+            pl_max(ptTriangle->iMinY, iTileMinY),
+            pl_min(ptTriangle->iMaxX, iTileMaxX),
+            pl_min(ptTriangle->iMaxY, iTileMaxY),
+            ptCpuTexture, uTargetWidth, uTargetHeight);
+    }
+}
+
+static void
+pl__cpu_raster_tile_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    // each job pulls tiles until none are left (costliest first)
+    plCommandBuffer* ptCommandBuffer = pData;
+    const uint32_t uActiveTileCount = pl_sb_size(ptCommandBuffer->sbuActiveTiles);
+    while(true)
+    {
+        const uint32_t uActiveTile = (uint32_t)gptAtomics->increment(ptCommandBuffer->ptNextActiveTile);
+        if(uActiveTile >= uActiveTileCount)
+            break;
+        pl__cpu_raster_tile(ptCommandBuffer, ptCommandBuffer->sbuActiveTiles[uActiveTile]);
+    }
+}
+
+static plCommandBuffer* gptTileSortCommandBuffer = NULL;
+
+static int
+pl__cpu_tile_cost_compare(const void* pA, const void* pB)
+{
+    const uint32_t uCostA = pl_sb_size(gptTileSortCommandBuffer->sbtTileBins[*(const uint32_t*)pA].sbuTriangles);
+    const uint32_t uCostB = pl_sb_size(gptTileSortCommandBuffer->sbtTileBins[*(const uint32_t*)pB].sbuTriangles);
+    if(uCostA != uCostB)
+        return uCostA > uCostB ? -1 : 1;
+    return *(const uint32_t*)pA < *(const uint32_t*)pB ? -1 : 1;
+}
+
+static void
+pl__cpu_flush_bins(plCommandBuffer* ptCommandBuffer)
+{
+    if(pl_sb_size(ptCommandBuffer->sbtTriangles) == 0)
+    {
+        pl_sb_reset(ptCommandBuffer->sbtVertices);
+        return;
+    }
+
+    pl_sb_reset(ptCommandBuffer->sbuActiveTiles);
+    const uint32_t uTileCount = ptCommandBuffer->uTileCountX * ptCommandBuffer->uTileCountY;
+    for(uint32_t i = 0; i < uTileCount; i++)
+    {
+        if(pl_sb_size(ptCommandBuffer->sbtTileBins[i].sbuTriangles) > 0)
+        {
+            pl__cpu_sb_reserve_more(ptCommandBuffer->sbuActiveTiles, 1);
+            pl_sb_push(ptCommandBuffer->sbuActiveTiles, i);
+        }
+    }
+    const uint32_t uActiveTileCount = pl_sb_size(ptCommandBuffer->sbuActiveTiles);
+
+    const uint32_t uThreadCount = pl_min(ptCommandBuffer->ptDevice->tInit.uCpuThreadCount, uActiveTileCount);
+    if(uThreadCount > 1 && gptJob && gptAtomics && !gptJob->is_shutting_down())
+    {
+        // larger bins first so stragglers are cheap
+        gptTileSortCommandBuffer = ptCommandBuffer;
+        qsort(ptCommandBuffer->sbuActiveTiles, uActiveTileCount, sizeof(uint32_t), pl__cpu_tile_cost_compare);
+        gptTileSortCommandBuffer = NULL;
+
+        if(ptCommandBuffer->ptNextActiveTile == NULL)
+            gptAtomics->create_counter(0, &ptCommandBuffer->ptNextActiveTile);
+        gptAtomics->store(ptCommandBuffer->ptNextActiveTile, 0);
+
+        plJobDesc tJobDesc = {
+            .task  = pl__cpu_raster_tile_job,
+            .pData = ptCommandBuffer
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(uThreadCount, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < uActiveTileCount; i++)
+            pl__cpu_raster_tile(ptCommandBuffer, ptCommandBuffer->sbuActiveTiles[i]);
+    }
+
+    for(uint32_t i = 0; i < uActiveTileCount; i++)
+    {
+        pl_sb_reset(ptCommandBuffer->sbtTileBins[ptCommandBuffer->sbuActiveTiles[i]].sbuTriangles);
+    }
+    pl_sb_reset(ptCommandBuffer->sbtTriangles);
+    pl_sb_reset(ptCommandBuffer->sbtVertices);
+}
+
+static void
+pl__cpu_run_workgroup(plDevice* ptDevice, const plCommandBufferItem* ptItem, uint32_t uGroup, void* pGroupSharedMemory, size_t szGroupSharedMemorySize)
+{
+    const plDispatch* ptDispatch = &ptItem->tDispatch;
+    const plCpuComputeShader* ptCpuShader = &ptDevice->sbtComputeShadersHot[ptItem->tComputeShader.uIndex];
+    const plComputeShaderBuiltIns tBuiltIns = {
+        .gl_WorkGroupID = {
+            uGroup % ptDispatch->uGroupCountX,
+            (uGroup / ptDispatch->uGroupCountX) % ptDispatch->uGroupCountY,
+            uGroup / (ptDispatch->uGroupCountX * ptDispatch->uGroupCountY)
+        },
+        .gl_NumWorkGroups        = {ptDispatch->uGroupCountX, ptDispatch->uGroupCountY, ptDispatch->uGroupCountZ},
+        .gl_WorkGroupSize        = {ptDispatch->uThreadPerGroupX, ptDispatch->uThreadPerGroupY, ptDispatch->uThreadPerGroupZ},
+        .pGroupSharedMemory      = pGroupSharedMemory,
+        .szGroupSharedMemorySize = szGroupSharedMemorySize,
+        .pSpecializationData     = ptCpuShader->pSpecializationData
+    };
+    ptCpuShader->tComputeKernel(tBuiltIns, (plDescriptorSet*)ptItem->atCurrentDescriptorSets);
+}
+
+static void
+pl__cpu_dispatch_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    // one job per workgroup, shared memory is the job system's per thread block
+    const plCpuDispatchJob* ptJob = pData;
+    pl__cpu_run_workgroup(ptJob->ptDevice, ptJob->ptItem, tInvoData.uGlobalIndex, pGroupSharedMemory, PL_CPU_COMPUTE_SHARED_MEMORY_SIZE);
+}
+
+static void
+pl__cpu_dispatch(plCommandBuffer* ptCommandBuffer, const plCommandBufferItem* ptItem)
+{
+    plDevice* ptDevice = ptCommandBuffer->ptDevice;
+    const plDispatch* ptDispatch = &ptItem->tDispatch;
+    if(ptDevice->sbtComputeShadersHot[ptItem->tComputeShader.uIndex].tComputeKernel == NULL)
+        return;
+
+    const uint32_t uGroupCount = ptDispatch->uGroupCountX * ptDispatch->uGroupCountY * ptDispatch->uGroupCountZ;
+    const uint32_t uThreadCount = ptDevice->tInit.uCpuThreadCount;
+
+    // kernels may assume PL_CPU_COMPUTE_SHARED_MEMORY_SIZE bytes of shared memory,
+    // so only use the job system if its per thread block is at least that large
+    if(uThreadCount > 1 && uGroupCount > 1 && gptJob && !gptJob->is_shutting_down() &&
+        gptJob->get_shared_memory_size() >= PL_CPU_COMPUTE_SHARED_MEMORY_SIZE)
+    {
+        // workgroups are batched so each thread gets a few batches to balance with
+        plCpuDispatchJob tDispatchJob = {
+            .ptDevice = ptDevice,
+            .ptItem   = ptItem
+        };
+        plJobDesc tJobDesc = {
+            .task  = pl__cpu_dispatch_job,
+            .pData = &tDispatchJob
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(uGroupCount, pl_max(1, uGroupCount / (uThreadCount * 4)), tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else
+    {
+        if(ptCommandBuffer->sbcComputeSharedMemory == NULL)
+            pl_sb_resize(ptCommandBuffer->sbcComputeSharedMemory, PL_CPU_COMPUTE_SHARED_MEMORY_SIZE);
+        for(uint32_t uGroup = 0; uGroup < uGroupCount; uGroup++)
+            pl__cpu_run_workgroup(ptDevice, ptItem, uGroup, ptCommandBuffer->sbcComputeSharedMemory, PL_CPU_COMPUTE_SHARED_MEMORY_SIZE);
+    }
+}
+
+static bool
+pl__cpu_get_depth_attachment(plDevice* ptDevice, const plRenderInfo* ptRenderInfo, plTextureHandle* ptDepthTargetOut)
+{
+    // only 32 bit float depth is supported
+    const plTextureHandle tColorTarget = ptRenderInfo->atColorAttachments[0].tTexture;
+    const plTextureHandle tDepthTarget = ptRenderInfo->tDepthAttachment.tTexture;
+    if(!pl_graphics_is_texture_valid(ptDevice, tDepthTarget) || tDepthTarget.uData == tColorTarget.uData)
+        return false;
+
+    const plTexture* ptColorTexture = &ptDevice->sbtTexturesCold[tColorTarget.uIndex];
+    const plTexture* ptDepthTexture = &ptDevice->sbtTexturesCold[tDepthTarget.uIndex];
+    if(ptDepthTexture->tDesc.eFormat != PL_FORMAT_D32_FLOAT || ptDevice->sbtTexturesHot[tDepthTarget.uIndex].pData == NULL)
+        return false;
+    if(ptDepthTexture->tDesc.tDimensions.x < ptColorTexture->tDesc.tDimensions.x || ptDepthTexture->tDesc.tDimensions.y < ptColorTexture->tDesc.tDimensions.y)
+        return false;
+
+    *ptDepthTargetOut = tDepthTarget;
+    return true;
+}
+
+static void
+pl__cpu_set_bin_target(plCommandBuffer* ptCommandBuffer, const plRenderInfo* ptRenderInfo)
+{
+    plDevice* ptDevice = ptCommandBuffer->ptDevice;
+    const plTextureHandle tTarget = ptRenderInfo->atColorAttachments[0].tTexture;
+    plTextureHandle tDepthTarget = {0};
+    const bool bDepth = pl__cpu_get_depth_attachment(ptDevice, ptRenderInfo, &tDepthTarget);
+
+    if(ptCommandBuffer->uTileSize != 0 && ptCommandBuffer->tBinTarget.uData == tTarget.uData &&
+        ptCommandBuffer->bBinDepth == bDepth && ptCommandBuffer->tBinDepthTarget.uData == tDepthTarget.uData)
+        return;
+
+    pl__cpu_flush_bins(ptCommandBuffer);
+
+    const plTexture* ptTexture = &ptDevice->sbtTexturesCold[tTarget.uIndex];
+    const uint32_t uTileSize = ptDevice->tInit.uCpuTileSize;
+    ptCommandBuffer->tBinTarget  = tTarget;
+    ptCommandBuffer->tBinDepthTarget = tDepthTarget;
+    ptCommandBuffer->bBinDepth   = bDepth;
+    ptCommandBuffer->uTileSize   = uTileSize;
+    ptCommandBuffer->uTileCountX = ((uint32_t)ptTexture->tDesc.tDimensions.x + uTileSize - 1) / uTileSize;
+    ptCommandBuffer->uTileCountY = ((uint32_t)ptTexture->tDesc.tDimensions.y + uTileSize - 1) / uTileSize;
+
+    // bins are only ever added (keeps their allocations around)
+    const uint32_t uTileCount = ptCommandBuffer->uTileCountX * ptCommandBuffer->uTileCountY;
+    const uint32_t uOldTileCount = pl_sb_size(ptCommandBuffer->sbtTileBins);
+    if(uTileCount > uOldTileCount)
+    {
+        pl_sb_resize(ptCommandBuffer->sbtTileBins, uTileCount);
+        memset(&ptCommandBuffer->sbtTileBins[uOldTileCount], 0, (uTileCount - uOldTileCount) * sizeof(plCpuTileBin));
+    }
+
+    // hi-z built from the current depth contents
+    if(bDepth)
+    {
+        const uint32_t uWidth  = (uint32_t)ptTexture->tDesc.tDimensions.x;
+        const uint32_t uHeight = (uint32_t)ptTexture->tDesc.tDimensions.y;
+        const plTexture* ptDepthTexture = &ptDevice->sbtTexturesCold[tDepthTarget.uIndex];
+        const float* afDepth = ptDevice->sbtTexturesHot[tDepthTarget.uIndex].pData;
+        ptCommandBuffer->uHiZCountX = (uWidth + PL_CPU_RASTER_BLOCK_SIZE - 1) / PL_CPU_RASTER_BLOCK_SIZE;
+        ptCommandBuffer->uHiZCountY = (uHeight + PL_CPU_RASTER_BLOCK_SIZE - 1) / PL_CPU_RASTER_BLOCK_SIZE;
+        pl_sb_resize(ptCommandBuffer->sbfHiZMin, ptCommandBuffer->uHiZCountX * ptCommandBuffer->uHiZCountY);
+        pl_sb_resize(ptCommandBuffer->sbfHiZMax, ptCommandBuffer->uHiZCountX * ptCommandBuffer->uHiZCountY);
+        for(uint32_t uY = 0; uY < ptCommandBuffer->uHiZCountY; uY++)
+        {
+            for(uint32_t uX = 0; uX < ptCommandBuffer->uHiZCountX; uX++)
+                pl__cpu_update_hiz_block(ptCommandBuffer->sbfHiZMin, ptCommandBuffer->sbfHiZMax, ptCommandBuffer->uHiZCountX,
+                    afDepth, (uint32_t)ptDepthTexture->tDesc.tDimensions.x, uWidth, uHeight, uX, uY);
+        }
+    }
+}
+
+static inline void
+pl__cpu_project_vertex(plCpuVertex* ptVertex, const plRenderViewport* ptViewport)
+{
+    // frame buffer space (vertices behind the eye are only used through clipping)
+    const plVec4 tClipPosition = ptVertex->tClipPosition;
+    ptVertex->fInvW = tClipPosition.w > 0.0f ? 1.0f / tClipPosition.w : 0.0f;
+    ptVertex->tPosition.x = ptViewport->fX + ptViewport->fWidth * (0.5f + 0.5f * tClipPosition.x * ptVertex->fInvW);
+    ptVertex->tPosition.y = ptViewport->fY + ptViewport->fHeight * (0.5f + 0.5f * tClipPosition.y * ptVertex->fInvW);
+    ptVertex->fDepth = ptViewport->fMinDepth + (ptViewport->fMaxDepth - ptViewport->fMinDepth) * tClipPosition.z * ptVertex->fInvW;
+}
+
+static inline float
+pl__cpu_clip_distance(plVec4 tClipPosition, uint32_t uPlane)
+{
+    // inside when >= 0
+    switch(uPlane)
+    {
+        case 0: return tClipPosition.w - PL_CPU_CLIP_MIN_W;
+        case 1: return PL_CPU_CLIP_GUARD_BAND * tClipPosition.w - tClipPosition.x;
+        case 2: return PL_CPU_CLIP_GUARD_BAND * tClipPosition.w + tClipPosition.x;
+        case 3: return PL_CPU_CLIP_GUARD_BAND * tClipPosition.w - tClipPosition.y;
+        case 4: return PL_CPU_CLIP_GUARD_BAND * tClipPosition.w + tClipPosition.y;
+        case 5: return tClipPosition.z;                   // near (0 <= z)
+        case 6: return tClipPosition.w - tClipPosition.z; // far (z <= w)
+    }
+    return 0.0f;
+}
+
+static inline uint32_t
+pl__cpu_clip_outcode(plVec4 tClipPosition, bool bClipDepth)
+{
+    // bit per violated plane (depth planes are skipped when depth clamping)
+    const uint32_t uPlaneCount = bClipDepth ? 7 : 5;
+    uint32_t uOutcode = 0;
+    for(uint32_t uPlane = 0; uPlane < uPlaneCount; uPlane++)
+    {
+        if(pl__cpu_clip_distance(tClipPosition, uPlane) < 0.0f)
+            uOutcode |= 1u << uPlane;
+    }
+    return uOutcode;
+}
+
+static uint32_t
+pl__cpu_clip_triangle(plCommandBuffer* ptCommandBuffer, const uint32_t auVertices[3], uint32_t uClipMask, uint32_t uFloatCount, const plRenderViewport* ptViewport, uint32_t auPolygonOut[PL_CPU_CLIP_MAX_VERTS])
+{
+    // sutherland-hodgman in clip space, new vertices are appended to
+    // sbtVertices with linearly interpolated varyings (correct before the w divide)
+    uint32_t auPolygon[2][PL_CPU_CLIP_MAX_VERTS];
+    uint32_t uCount = 3;
+    memcpy(auPolygon[0], auVertices, 3 * sizeof(uint32_t));
+    uint32_t uCurrent = 0;
+
+    for(uint32_t uPlane = 0; uPlane < 7 && uCount >= 3; uPlane++)
+    {
+        if((uClipMask & (1u << uPlane)) == 0)
+            continue;
+
+        const uint32_t* auIn = auPolygon[uCurrent];
+        uint32_t* auOut = auPolygon[uCurrent ^ 1];
+        uint32_t uOutCount = 0;
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const uint32_t uA = auIn[i];
+            const uint32_t uB = auIn[(i + 1) % uCount];
+            const float fDistA = pl__cpu_clip_distance(ptCommandBuffer->sbtVertices[uA].tClipPosition, uPlane);
+            const float fDistB = pl__cpu_clip_distance(ptCommandBuffer->sbtVertices[uB].tClipPosition, uPlane);
+            const bool bInsideA = fDistA >= 0.0f;
+            const bool bInsideB = fDistB >= 0.0f;
+            if(bInsideA)
+                auOut[uOutCount++] = uA;
+            if(bInsideA == bInsideB)
+                continue;
+
+            // always interpolated from the inside vertex so edges shared
+            // between triangles produce the same intersection
+            const uint32_t uInside  = bInsideA ? uA : uB;
+            const uint32_t uOutside = bInsideA ? uB : uA;
+            const float fInside  = bInsideA ? fDistA : fDistB;
+            const float fOutside = bInsideA ? fDistB : fDistA;
+            const float fT = fInside / (fInside - fOutside);
+
+            pl__cpu_sb_reserve_more(ptCommandBuffer->sbtVertices, 1);
+            pl_sb_add(ptCommandBuffer->sbtVertices);
+            plCpuVertex* ptNewVertex = &pl_sb_back(ptCommandBuffer->sbtVertices);
+            const plCpuVertex* ptInside = &ptCommandBuffer->sbtVertices[uInside];
+            const plCpuVertex* ptOutside = &ptCommandBuffer->sbtVertices[uOutside];
+            ptNewVertex->tClipPosition = pl_add_vec4(ptInside->tClipPosition, pl_mul_vec4_scalarf(pl_sub_vec4(ptOutside->tClipPosition, ptInside->tClipPosition), fT));
+            memcpy(&ptNewVertex->tVaryings, &ptInside->tVaryings, sizeof(plVaryingData));
+            const float* afInside = (const float*)ptInside->tVaryings.acVaryingData;
+            const float* afOutside = (const float*)ptOutside->tVaryings.acVaryingData;
+            float* afNew = (float*)ptNewVertex->tVaryings.acVaryingData;
+            for(uint32_t j = 0; j < uFloatCount; j++)
+                afNew[j] = afInside[j] + (afOutside[j] - afInside[j]) * fT;
+            pl__cpu_project_vertex(ptNewVertex, ptViewport);
+            auOut[uOutCount++] = pl_sb_size(ptCommandBuffer->sbtVertices) - 1;
+        }
+        uCount = uOutCount;
+        uCurrent ^= 1;
+    }
+
+    if(uCount < 3)
+        return 0;
+    memcpy(auPolygonOut, auPolygon[uCurrent], uCount * sizeof(uint32_t));
+    return uCount;
+}
+
 static void
-pl_set_pixel(plCpuTexture* ptTexture, plVec2 input, plVec4 tColor, uint32_t uWidth, uint32_t uHeight)
+pl__cpu_setup_triangle(plCommandBuffer* ptCommandBuffer, const plCommandBufferItem* ptCmdBufferItem, const plShader* ptShader, const uint32_t auVertices[3], const int aiClipRect[4], float fViewportMinDepth, float fViewportMaxDepth)
 {
-    if(input.x < 0)
+    const plGraphicsState tGraphicsState = ptShader->tDesc.tGraphicsState;
+    const plCpuVertex* ptCpuVertex0 = &ptCommandBuffer->sbtVertices[auVertices[0]];
+    const plCpuVertex* ptCpuVertex1 = &ptCommandBuffer->sbtVertices[auVertices[1]];
+    const plCpuVertex* ptCpuVertex2 = &ptCommandBuffer->sbtVertices[auVertices[2]];
+
+    // depth range (clipping keeps it inside the viewport range unless depth clamping)
+    float fMinDepth = pl_min(pl_min(ptCpuVertex0->fDepth, ptCpuVertex1->fDepth), ptCpuVertex2->fDepth);
+    float fMaxDepth = pl_max(pl_max(ptCpuVertex0->fDepth, ptCpuVertex1->fDepth), ptCpuVertex2->fDepth);
+    if(tGraphicsState.bDepthClampEnabled)
+    {
+        fMinDepth = pl_clampf(fViewportMinDepth, fMinDepth, fViewportMaxDepth);
+        fMaxDepth = pl_clampf(fViewportMinDepth, fMaxDepth, fViewportMaxDepth);
+    }
+
+    const plVec2 tVertex0 = ptCpuVertex0->tPosition;
+    const plVec2 tVertex1 = ptCpuVertex1->tPosition;
+    const plVec2 tVertex2 = ptCpuVertex2->tPosition;
+
+    const int64_t x0 = llroundf(tVertex0.x * SUBPIXEL_SCALE);
+    const int64_t y0 = llroundf(tVertex0.y * SUBPIXEL_SCALE);
+
+    const int64_t x1 = llroundf(tVertex1.x * SUBPIXEL_SCALE);
+    const int64_t y1 = llroundf(tVertex1.y * SUBPIXEL_SCALE);
+
+    const int64_t x2 = llroundf(tVertex2.x * SUBPIXEL_SCALE);
+    const int64_t y2 = llroundf(tVertex2.y * SUBPIXEL_SCALE);
+
+    const int64_t ABC = pl__edge_function_fixed(x0, y0, x1, y1, x2, y2);
+
+    if(ABC == 0)
         return;
-    if(input.y < 0)
+
+    // With your Y-down framebuffer mapping, verify this sign once.
+    const bool bFrontFacing = ABC < 0;
+
+    if(tGraphicsState.eCullMode == PL_CULL_MODE_CULL_BACK && !bFrontFacing)
         return;
-    if(input.x >= uWidth)
+
+    if(tGraphicsState.eCullMode == PL_CULL_MODE_CULL_FRONT && bFrontFacing)
         return;
-    if(input.y >= uHeight)
+
+    // Bounding box with clamping
+    const int minX = pl_max(aiClipRect[0], pl_min3((int)tVertex0.x, (int)tVertex1.x, (int)tVertex2.x) - 1);
+    const int minY = pl_max(aiClipRect[1], pl_min3((int)tVertex0.y, (int)tVertex1.y, (int)tVertex2.y) - 1);
+    const int maxX = pl_min(aiClipRect[2], pl_max3((int)tVertex0.x, (int)tVertex1.x, (int)tVertex2.x) + 1);
+    const int maxY = pl_min(aiClipRect[3], pl_max3((int)tVertex0.y, (int)tVertex1.y, (int)tVertex2.y) + 1);
+
+    if(minX > maxX || minY > maxY)
         return;
 
-    int iRowOffset = uWidth * 4 * (int)input.y;
-    int iPixelStart = iRowOffset + (int)input.x * 4;
-    uint8_t* puData = ptTexture->pData;
+    // Reverse edge direction when triangle winding is reversed,
+    // so the inside test & top-left test are always evaluated in the same orientation.
+    const int64_t orientation = ABC > 0 ? 1 : -1;
+    plCpuTriangle tTriangle = {
+        .ptItem     = ptCmdBufferItem,
+        .auVertices = {auVertices[0], auVertices[1], auVertices[2]},
+        .iMinX      = minX,
+        .iMinY      = minY,
+        .iMaxX      = maxX,
+        .iMaxY      = maxY,
+        .aiEdgeA    = {(y0 - y1) * orientation, (y1 - y2) * orientation, (y2 - y0) * orientation},
+        .aiEdgeB    = {(x1 - x0) * orientation, (x2 - x1) * orientation, (x0 - x2) * orientation},
+        .aiEdgeC    = {(x0 * y1 - x1 * y0) * orientation, (x1 * y2 - x2 * y1) * orientation, (x2 * y0 - x0 * y2) * orientation},
+        .abTopLeft  = {
+            orientation > 0 ? pl__is_top_left_edge_fixed(x0, y0, x1, y1) : pl__is_top_left_edge_fixed(x1, y1, x0, y0),
+            orientation > 0 ? pl__is_top_left_edge_fixed(x1, y1, x2, y2) : pl__is_top_left_edge_fixed(x2, y2, x1, y1),
+            orientation > 0 ? pl__is_top_left_edge_fixed(x2, y2, x0, y0) : pl__is_top_left_edge_fixed(x0, y0, x2, y2)
+        },
+        .fInvArea     = 1.0f / (float)(ABC * orientation),
+        .fMinDepth    = fMinDepth,
+        .fMaxDepth    = fMaxDepth,
+        .bPerspective = ptCpuVertex0->fInvW != ptCpuVertex1->fInvW || ptCpuVertex0->fInvW != ptCpuVertex2->fInvW
+    };
+    const uint32_t uTriangle = pl_sb_size(ptCommandBuffer->sbtTriangles);
+    pl__cpu_sb_reserve_more(ptCommandBuffer->sbtTriangles, 1);
+    pl_sb_push(ptCommandBuffer->sbtTriangles, tTriangle);
+
+    // binning (submission order is preserved within each tile)
+    const uint32_t uTileSize = ptCommandBuffer->uTileSize;
+    const uint32_t uTileMinX = (uint32_t)minX / uTileSize;
+    const uint32_t uTileMinY = (uint32_t)minY / uTileSize;
+    const uint32_t uTileMaxX = (uint32_t)maxX / uTileSize;
+    const uint32_t uTileMaxY = (uint32_t)maxY / uTileSize;
+    for(uint32_t uTileY = uTileMinY; uTileY <= uTileMaxY; uTileY++)
+    {
+        for(uint32_t uTileX = uTileMinX; uTileX <= uTileMaxX; uTileX++)
+        {
+            plCpuTileBin* ptBin = &ptCommandBuffer->sbtTileBins[uTileY * ptCommandBuffer->uTileCountX + uTileX];
+            pl__cpu_sb_reserve_more(ptBin->sbuTriangles, 1);
+            pl_sb_push(ptBin->sbuTriangles, uTriangle);
+        }
+    }
+}
 
-    const float srcA = tColor.a;
-    const float invA = 1.0f - srcA;
+static void
+pl__cpu_bin_draw(plCommandBuffer* ptCommandBuffer, const plCommandBufferItem* ptCmdBufferItem, const plRenderViewport* ptViewport, const plScissor* ptScissor)
+{
+    plDevice* ptDevice = ptCommandBuffer->ptDevice;
+    const plShader* ptShader = &ptDevice->sbtShadersCold[ptCmdBufferItem->tShader.uIndex];
+    const plCpuShader* ptCpuPipeline = &ptDevice->sbtShadersHot[ptCmdBufferItem->tShader.uIndex];
+    const plTexture* ptTexture = &ptDevice->sbtTexturesCold[ptCommandBuffer->tBinTarget.uIndex];
+    const int fbWidth  = (int)ptTexture->tDesc.tDimensions.x;
+    const int fbHeight = (int)ptTexture->tDesc.tDimensions.y;
+
+    const char* pcVtxBuffer = (const char*)ptDevice->sbtBuffersHot[ptCmdBufferItem->tVertexBuffer.uIndex].pData;
+    const uint32_t* puIndexBufferData = ptDevice->sbtBuffersHot[ptCmdBufferItem->tDraw.tIndexBuffer.uIndex].pData;
+    const uint32_t stride = ptShader->tDesc.atVertexBufferLayouts[0].uByteStride;
+
+    // new generation invalidates every cached vertex (cleared only on wrap around)
+    ptCommandBuffer->uVertexCacheGeneration++;
+    if(ptCommandBuffer->uVertexCacheGeneration == 0)
+    {
+        memset(ptCommandBuffer->sbtVertexCache, 0, pl_sb_size(ptCommandBuffer->sbtVertexCache) * sizeof(plCpuVertexCacheEntry));
+        ptCommandBuffer->uVertexCacheGeneration = 1;
+    }
+    const uint32_t uGeneration = ptCommandBuffer->uVertexCacheGeneration;
+
+    const bool bClipDepth = !ptShader->tDesc.tGraphicsState.bDepthClampEnabled;
+    const float fViewportMinDepth = pl_min(ptViewport->fMinDepth, ptViewport->fMaxDepth);
+    const float fViewportMaxDepth = pl_max(ptViewport->fMinDepth, ptViewport->fMaxDepth);
+
+    const int viewportMinX = (int)floorf(ptViewport->fX);
+    const int viewportMinY = (int)floorf(ptViewport->fY);
+    const int viewportMaxX = (int)ceilf(ptViewport->fX + ptViewport->fWidth) - 1;
+    const int viewportMaxY = (int)ceilf(ptViewport->fY + ptViewport->fHeight) - 1;
+
+    const int aiClipRect[4] = {
+        pl_max(pl_max(viewportMinX, ptScissor->iOffsetX), 0),
+        pl_max(pl_max(viewportMinY, ptScissor->iOffsetY), 0),
+        pl_min(pl_min(viewportMaxX, ptScissor->iOffsetX + (int)ptScissor->uWidth - 1), fbWidth - 1),
+        pl_min(pl_min(viewportMaxY, ptScissor->iOffsetY + (int)ptScissor->uHeight - 1), fbHeight - 1)
+    };
 
-    plVec4 tDestColor;
-    tDestColor.r = puData[iPixelStart + 0];
-    tDestColor.g = puData[iPixelStart + 1];
-    tDestColor.b = puData[iPixelStart + 2];
-    tDestColor.a = puData[iPixelStart + 3];
-
-    puData[iPixelStart + 0] = (unsigned char)((255.0f * tColor.r * srcA + tDestColor.r * invA));
-    puData[iPixelStart + 1] = (unsigned char)((255.0f * tColor.g * srcA + tDestColor.g * invA));
-    puData[iPixelStart + 2] = (unsigned char)((255.0f * tColor.b * srcA + tDestColor.b * invA));
-    puData[iPixelStart + 3] = (unsigned char)((255.0f * tColor.a + tDestColor.a * invA));
-};
+    const uint32_t uTriangleCount = ptCmdBufferItem->tDraw.uIndexCount / 3;
+    for(uint32_t uBatchStart = 0; uBatchStart < uTriangleCount; uBatchStart += PL_CPU_VERTEX_BATCH_SIZE)
+    {
+        const uint32_t uBatchCount = pl_min(PL_CPU_VERTEX_BATCH_SIZE, uTriangleCount - uBatchStart);
+        const uint32_t* puBatchIndices = &puIndexBufferData[ptCmdBufferItem->tDraw.uIndexStart + uBatchStart * 3];
+
+        // gather vertices not yet shaded this draw (each vertex shaded once per draw)
+        uint32_t auBatchVertices[PL_CPU_VERTEX_BATCH_SIZE * 3];
+        uint32_t auShadeIndices[PL_CPU_VERTEX_BATCH_SIZE * 3];
+        uint32_t uShadeCount = 0;
+        const uint32_t uFirstVertex = pl_sb_size(ptCommandBuffer->sbtVertices);
+        for(uint32_t j = 0; j < uBatchCount * 3; j++)
+        {
+            const uint32_t uIndex = ptCmdBufferItem->tDraw.uVertexStart + puBatchIndices[j];
+            if(uIndex >= pl_sb_size(ptCommandBuffer->sbtVertexCache))
+            {
+                const uint32_t uOldSize = pl_sb_size(ptCommandBuffer->sbtVertexCache);
+                pl__cpu_sb_reserve_more(ptCommandBuffer->sbtVertexCache, uIndex + 1 - uOldSize);
+                pl_sb_resize(ptCommandBuffer->sbtVertexCache, uIndex + 1);
+                memset(&ptCommandBuffer->sbtVertexCache[uOldSize], 0, (uIndex + 1 - uOldSize) * sizeof(plCpuVertexCacheEntry));
+            }
+            plCpuVertexCacheEntry* ptEntry = &ptCommandBuffer->sbtVertexCache[uIndex];
+            if(ptEntry->uGeneration != uGeneration)
+            {
+                ptEntry->uGeneration = uGeneration;
+                ptEntry->uVertex = uFirstVertex + uShadeCount;
+                auShadeIndices[uShadeCount++] = uIndex;
+            }
+            auBatchVertices[j] = ptEntry->uVertex;
+        }
+
+        // vertex shader stage (batch shaded back to back, then projected)
+        pl__cpu_sb_reserve_more(ptCommandBuffer->sbtVertices, uShadeCount);
+        pl_sb_resize(ptCommandBuffer->sbtVertices, uFirstVertex + uShadeCount);
+        plCpuVertex* atShadedVertices = &ptCommandBuffer->sbtVertices[uFirstVertex];
+        const plVertexShader tVertexShader = ptCpuPipeline->tVertexShader;
+        plDescriptorSet* atDescriptorSets = (plDescriptorSet*)ptCmdBufferItem->atCurrentDescriptorSets;
+        plVertexShaderBuiltIns tVSBuiltIns = {
+            .atLayouts = ptShader->tDesc.atVertexBufferLayouts
+        };
+        for(uint32_t j = 0; j < uShadeCount; j++)
+        {
+            memset(&atShadedVertices[j].tVaryings, 0, sizeof(plVaryingData));
+            tVSBuiltIns.uVertexID = auShadeIndices[j];
+            atShadedVertices[j].tClipPosition = tVertexShader(tVSBuiltIns, atDescriptorSets, &pcVtxBuffer[auShadeIndices[j] * stride], &atShadedVertices[j].tVaryings);
+        }
+        for(uint32_t j = 0; j < uShadeCount; j++)
+            pl__cpu_project_vertex(&atShadedVertices[j], ptViewport);
+
+        for(uint32_t uTriangle = 0; uTriangle < uBatchCount; uTriangle++)
+        {
+            const uint32_t* auVertices = &auBatchVertices[uTriangle * 3];
+
+            // trivially rejected when all vertices are outside the same plane,
+            // trivially accepted when inside all of them
+            const uint32_t uOutcode0 = pl__cpu_clip_outcode(ptCommandBuffer->sbtVertices[auVertices[0]].tClipPosition, bClipDepth);
+            const uint32_t uOutcode1 = pl__cpu_clip_outcode(ptCommandBuffer->sbtVertices[auVertices[1]].tClipPosition, bClipDepth);
+            const uint32_t uOutcode2 = pl__cpu_clip_outcode(ptCommandBuffer->sbtVertices[auVertices[2]].tClipPosition, bClipDepth);
+            if(uOutcode0 & uOutcode1 & uOutcode2)
+                continue;
+
+            const uint32_t uClipMask = uOutcode0 | uOutcode1 | uOutcode2;
+            if(uClipMask == 0)
+            {
+                pl__cpu_setup_triangle(ptCommandBuffer, ptCmdBufferItem, ptShader, auVertices, aiClipRect, fViewportMinDepth, fViewportMaxDepth);
+                continue;
+            }
+
+            // clipped polygon is triangulated as a fan (keeps winding)
+            uint32_t auPolygon[PL_CPU_CLIP_MAX_VERTS];
+            const uint32_t uFloatCount = pl__cpu_varying_float_count(&ptCommandBuffer->sbtVertices[auVertices[0]].tVaryings);
+            const uint32_t uPolygonCount = pl__cpu_clip_triangle(ptCommandBuffer, auVertices, uClipMask, uFloatCount, ptViewport, auPolygon);
+            for(uint32_t j = 1; j + 1 < uPolygonCount; j++)
+            {
+                const uint32_t auFan[3] = {auPolygon[0], auPolygon[j], auPolygon[j + 1]};
+                pl__cpu_setup_triangle(ptCommandBuffer, ptCmdBufferItem, ptShader, auFan, aiClipRect, fViewportMinDepth, fViewportMaxDepth);
+            }
+        }
+    }
+}
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
@@ -563,6 +1729,7 @@ pl_graphics_update_bind_group(plDevice* ptDevice, plBindGroupHandle tHandle, con
     {
         const plBindGroupUpdateBufferData* ptUpdate = &ptData->atBufferBindings[i];
         ptCpuBindGroup->atDescriptors[ptUpdate->uSlot].eType = PL_DESCRIPTOR_TYPE_BUFFER;
+        ptCpuBindGroup->atDescriptors[ptUpdate->uSlot].puData = ptDevice->sbtBuffersHot[ptUpdate->tBuffer.uIndex].pData;
     }
 
     for(uint32_t i = 0; i < ptBindGroupLayout->_uTextureBindingCount; i++)
@@ -640,6 +1807,32 @@ plComputeShaderHandle
 pl_graphics_create_compute_shader(plDevice* ptDevice, const plComputeShaderDesc* ptDescription)
 {
     plComputeShaderHandle tHandle = pl__get_new_compute_shader_handle(ptDevice);
+    plComputeShader* ptShader = pl_graphics_get_compute_shader(ptDevice, tHandle);
+    ptShader->tDesc = *ptDescription;
+
+    plCpuComputeShader* ptCpuShader = &ptDevice->sbtComputeShadersHot[tHandle.uIndex];
+    memset(ptCpuShader, 0, sizeof(plCpuComputeShader));
+    ptCpuShader->tComputeKernel = (plComputeKernel)ptDescription->tShader.puCode;
+
+    // specialization constants (kernels read them as a struct)
+    ptShader->tDesc._uConstantCount = 0;
+    uint32_t uConstantOffset = 0;
+    for (uint32_t i = 0; i < PL_MAX_SHADER_SPECIALIZATION_CONSTANTS; i++)
+    {
+        const plSpecializationConstant* ptConstant = &ptShader->tDesc.atConstants[i];
+        if(ptConstant->eType == PL_DATA_TYPE_UNSPECIFIED)
+            break;
+        const uint32_t uOffset = ptConstant->uOffset == 0 ? uConstantOffset : ptConstant->uOffset;
+        uConstantOffset = uOffset + (uint32_t)pl_graphics_get_data_type_size(ptConstant->eType);
+        ptCpuShader->szSpecializationSize = pl_max(ptCpuShader->szSpecializationSize, uConstantOffset);
+        ptShader->tDesc._uConstantCount++;
+    }
+    if(ptCpuShader->szSpecializationSize > 0 && ptDescription->pTempConstantData)
+    {
+        ptCpuShader->pSpecializationData = PL_ALLOC(ptCpuShader->szSpecializationSize);
+        memcpy(ptCpuShader->pSpecializationData, ptDescription->pTempConstantData, ptCpuShader->szSpecializationSize);
+    }
+    ptShader->tDesc.pTempConstantData = NULL;
     return tHandle;
 }
 
@@ -726,6 +1919,12 @@ pl_graphics_begin_render_pass(plCommandBuffer* ptCmdBuffer, const plRenderInfo*
 {
     ptCmdBuffer->tCurrentRenderInfo = *ptInfo;
 
+    // depth attachment cleared at submit
+    ptCmdBuffer->uCurrentStreamItem++;
+    pl_sb_add(ptCmdBuffer->sbtStream);
+    ptCmdBuffer->sbtStream[ptCmdBuffer->uCurrentStreamItem].eType = PL_CPU_COMMAND_BUFFER_ITEM_TYPE_BEGIN_RENDER_PASS;
+    ptCmdBuffer->sbtStream[ptCmdBuffer->uCurrentStreamItem].tRenderInfo = *ptInfo;
+
     plScissor tScissor = {
         .iOffsetX = 0,
         .iOffsetY = 0,
@@ -788,6 +1987,7 @@ pl_graphics_draw_indexed(plCommandBuffer* ptCommandBuffer, uint32_t uCount, cons
         ptCommandBuffer->sbtStream[ptCommandBuffer->uCurrentStreamItem].atCurrentDescriptorSets[1] = ptCommandBuffer->atCurrentDescriptorSets[1];
         ptCommandBuffer->sbtStream[ptCommandBuffer->uCurrentStreamItem].atCurrentDescriptorSets[2] = ptCommandBuffer->atCurrentDescriptorSets[2];
         ptCommandBuffer->sbtStream[ptCommandBuffer->uCurrentStreamItem].atCurrentDescriptorSets[3] = ptCommandBuffer->atCurrentDescriptorSets[3];
+        ptCommandBuffer->sbtStream[ptCommandBuffer->uCurrentStreamItem].tDynamicDescriptor = ptCommandBuffer->atCurrentDescriptorSets[3].atDescriptors[0];
     }
 }
 
@@ -799,9 +1999,9 @@ pl_graphics_bind_shader(plCommandBuffer* ptCommandBuffer, plShaderHandle tHandle
 }
 
 void
-pl_graphics_bind_compute_shader(plCommandBuffer* ptEncoder, plComputeShaderHandle tHandle)
+pl_graphics_bind_compute_shader(plCommandBuffer* ptCommandBuffer, plComputeShaderHandle tHandle)
 {
-    PL_ASSERT(false && "NOT IMPLEMENTED");
+    ptCommandBuffer->tCurrentComputeShader = tHandle;
 }
 
 void
@@ -847,7 +2047,10 @@ pl_graphics_allocate_memory(plDevice* ptDevice, size_t szSize, plMemoryFlags tMe
 void
 pl_graphics_free_memory(plDevice* ptDevice, plDeviceMemoryAllocation* ptBlock)
 {
-    free(ptBlock->pHostMapped);
+    // staging allocator only passes the handle (which is the host pointer)
+    void* pMemory = ptBlock->pHostMapped ? ptBlock->pHostMapped : (void*)ptBlock->uHandle;
+    if(pMemory)
+        PL_FREE(pMemory);
     ptBlock->pHostMapped = NULL;
 }
 
@@ -998,6 +2201,17 @@ pl_graphics_create_device(const plDeviceInit* ptInit)
 
     if(ptDevice->tInit.szDynamicBufferBlockSize == 0) ptDevice->tInit.szDynamicBufferBlockSize = 134217728;
     if(ptDevice->tInit.szDynamicDataMaxSize == 0)     ptDevice->tInit.szDynamicDataMaxSize = 256;
+    if(ptDevice->tInit.uCpuThreadCount == 0)          ptDevice->tInit.uCpuThreadCount = 1;
+    if(ptDevice->tInit.uCpuTileSize == 0)             ptDevice->tInit.uCpuTileSize = PL_CPU_DEFAULT_TILE_SIZE;
+
+    // tiles own whole hi-z blocks (no sharing between threads)
+    ptDevice->tInit.uCpuTileSize = (ptDevice->tInit.uCpuTileSize + PL_CPU_RASTER_BLOCK_SIZE - 1) & ~(uint32_t)(PL_CPU_RASTER_BLOCK_SIZE - 1);
+
+    if(ptDevice->tInit.uCpuThreadCount > 1 && (gptJob == NULL || gptAtomics == NULL || gptJob->is_shutting_down()))
+    {
+        PL_LOG_WARN_API(gptLog, uLogChannelGraphics, "plJobI/plAtomicsI not available or job system not running, CPU rasterization will not be parallel");
+        ptDevice->tInit.uCpuThreadCount = 1;
+    }
 
 
     // const size_t szMaxDynamicBufferDescriptors = ptDevice->tInit.szDynamicBufferBlockSize / ptDevice->tInit.szDynamicDataMaxSize;
@@ -1163,6 +2377,11 @@ pl_graphics_cleanup_device(plDevice* ptDevice)
             ptDevice->sbtBindGroupsHot[i].atDescriptors = NULL;
         }
     }
+    for(uint32_t i = 0; i < pl_sb_size(ptDevice->sbtComputeShadersHot); i++)
+    {
+        if(ptDevice->sbtComputeShadersHot[i].pSpecializationData)
+            PL_FREE(ptDevice->sbtComputeShadersHot[i].pSpecializationData);
+    }
     pl_sb_free(ptDevice->sbtShadersHot);
     pl_sb_free(ptDevice->sbtComputeShadersHot);
     pl_sb_free(ptDevice->sbtBuffersHot);
@@ -1186,16 +2405,37 @@ pl_graphics_end_compute_pass(plCommandBuffer* ptEncoder)
 }
 
 void
-pl_graphics_dispatch(plCommandBuffer* ptEncoder, uint32_t uDispatchCount, const plDispatch *atDispatches)
+pl_graphics_dispatch(plCommandBuffer* ptCommandBuffer, uint32_t uDispatchCount, const plDispatch *atDispatches)
 {
-    PL_ASSERT(false && "NOT IMPLEMENTED");
+    for(uint32_t uDispatchIndex = 0; uDispatchIndex < uDispatchCount; uDispatchIndex++)
+    {
+        ptCommandBuffer->uCurrentStreamItem++;
+        pl_sb_add(ptCommandBuffer->sbtStream);
+        plCommandBufferItem* ptItem = &ptCommandBuffer->sbtStream[ptCommandBuffer->uCurrentStreamItem];
+        ptItem->eType              = PL_CPU_COMMAND_BUFFER_ITEM_TYPE_DISPATCH;
+        ptItem->tDispatch          = atDispatches[uDispatchIndex];
+        ptItem->tComputeShader     = ptCommandBuffer->tCurrentComputeShader;
+        ptItem->tDynamicDescriptor = ptCommandBuffer->tCurrentComputeDynamicDescriptor;
+        memcpy(ptItem->atCurrentDescriptorSets, ptCommandBuffer->atCurrentComputeDescriptorSets, sizeof(ptItem->atCurrentDescriptorSets));
+    }
 }
 
 void
-pl_graphics_bind_compute_bind_groups(plCommandBuffer* ptEncoder, plComputeShaderHandle tHandle, uint32_t uFirst,
+pl_graphics_bind_compute_bind_groups(plCommandBuffer* ptCommandBuffer, plComputeShaderHandle tHandle, uint32_t uFirst,
     uint32_t uCount, const plBindGroupHandle *atBindGroups, uint32_t uDynamicBindingCount, const plDynamicBinding* ptDynamicBinding)
 {
-    PL_ASSERT(false && "NOT IMPLEMENTED");
+    plDevice* ptDevice = ptCommandBuffer->ptDevice;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plCpuBindGroup* ptCpuBindGroup = &ptDevice->sbtBindGroupsHot[atBindGroups[i].uIndex];
+        ptCommandBuffer->atCurrentComputeDescriptorSets[uFirst + i].atDescriptors = ptCpuBindGroup->atDescriptors;
+    }
+
+    if(uDynamicBindingCount > 0)
+    {
+        ptCommandBuffer->tCurrentComputeDynamicDescriptor.eType = PL_DESCRIPTOR_TYPE_BUFFER;
+        ptCommandBuffer->tCurrentComputeDynamicDescriptor.puData = (uint8_t*)ptDynamicBinding[0].pcData;
+    }
 }
 
 void
@@ -1217,10 +2457,6 @@ pl_graphics_bind_graphics_bind_groups(plCommandBuffer* ptCommandBuffer, plShader
     }
 }
 
-#define SUBPIXEL_BITS  8
-#define SUBPIXEL_SCALE (1 << SUBPIXEL_BITS)
-#define SUBPIXEL_HALF  (SUBPIXEL_SCALE / 2)
-
 void
 pl_graphics_submit_command_buffer(plCommandBuffer* ptCommandBuffer, const plSubmitInfo* ptSubmitInfo)
 {
@@ -1228,6 +2464,7 @@ pl_graphics_submit_command_buffer(plCommandBuffer* ptCommandBuffer, const plSubm
     uint32_t uDrawCount = pl_sb_size(ptCommandBuffer->sbtStream);
     plRenderViewport tCurrentViewport = {0};
     plScissor tCurrentScissor = {0};
+    ptCommandBuffer->uTileSize = 0; // rebind bin target
     for(uint32_t uDrawIndex = 0; uDrawIndex < uDrawCount; uDrawIndex++)
     {
         plCommandBufferItem* ptCmdBufferItem = &ptCommandBuffer->sbtStream[uDrawIndex];
@@ -1242,6 +2479,9 @@ pl_graphics_submit_command_buffer(plCommandBuffer* ptCommandBuffer, const plSubm
         }
         else if(ptCmdBufferItem->eType == PL_CPU_COMMAND_BUFFER_ITEM_TYPE_COPY_BUFFER_TO_TEXTURE)
         {
+            // binned draws may target or sample this texture
+            pl__cpu_flush_bins(ptCommandBuffer);
+
             plCpuBuffer* ptBuffer = &ptDevice->sbtBuffersHot[ptCmdBufferItem->tBufferHandle.uIndex];
             plTexture* ptTexture = &ptDevice->sbtTexturesCold[ptCmdBufferItem->tTextureHandle.uIndex];
             plCpuTexture* ptCpuTexture = &ptDevice->sbtTexturesHot[ptCmdBufferItem->tTextureHandle.uIndex];
@@ -1261,313 +2501,48 @@ pl_graphics_submit_command_buffer(plCommandBuffer* ptCommandBuffer, const plSubm
                     memcpy(&puBufferDst[(dstY * iDstWidth + dstX) * szStride], &puBufferSrc[(y * iSrcRowLength + x) * szStride], szStride);
                 }
             }
-            
+
+            // rebuild hi-z
+            if(ptCommandBuffer->bBinDepth && ptCommandBuffer->tBinDepthTarget.uData == ptCmdBufferItem->tTextureHandle.uData)
+                ptCommandBuffer->uTileSize = 0;
         }
-        else if(ptCmdBufferItem->eType == PL_CPU_COMMAND_BUFFER_ITEM_TYPE_DRAW_INDEXED)
+        else if(ptCmdBufferItem->eType == PL_CPU_COMMAND_BUFFER_ITEM_TYPE_BEGIN_RENDER_PASS)
         {
-            const plShader* ptShader = &ptDevice->sbtShadersCold[ptCmdBufferItem->tShader.uIndex];
-            const plShader* ptPipeline = &ptDevice->sbtShadersCold[ptCmdBufferItem->tShader.uIndex];
-            const plCpuShader* ptCpuPipeline = &ptDevice->sbtShadersHot[ptCmdBufferItem->tShader.uIndex];
-            plTexture* ptTexture = &ptDevice->sbtTexturesCold[ptCmdBufferItem->tRenderInfo.atColorAttachments[0].tTexture.uIndex];
-            const int fbWidth  = (int)ptTexture->tDesc.tDimensions.x;
-            const int fbHeight = (int)ptTexture->tDesc.tDimensions.y;
-        
-            plVec2 vertexP = {0};  
-
-            const void* pVerticies = ptDevice->sbtBuffersHot[ptCmdBufferItem->tVertexBuffer.uIndex].pData;
-            const uint32_t* puIndexBufferData = ptDevice->sbtBuffersHot[ptCmdBufferItem->tDraw.tIndexBuffer.uIndex].pData;
-            const uint32_t stride = ptShader->tDesc.atVertexBufferLayouts[0].uByteStride;
-            plCpuTexture* ptCpuTexture = &ptDevice->sbtTexturesHot[ptCmdBufferItem->tRenderInfo.atColorAttachments[0].tTexture.uIndex];
-            const uint32_t uVertexCount = (uint32_t)ptDevice->sbtBuffersCold[ptCmdBufferItem->tVertexBuffer.uIndex].tDesc.szByteSize / stride;
-            pl_sb_reset(ptCommandBuffer->sbtVertexCache);
-            pl_sb_resize(ptCommandBuffer->sbtVertexCache, uVertexCount);
-            memset(ptCommandBuffer->sbtVertexCache, 0, uVertexCount * sizeof(plVertexCache));
-
-            for(uint32_t i = 0; i < ptCmdBufferItem->tDraw.uIndexCount; i += 3)
+            plTextureHandle tDepthTarget = {0};
+            const plRenderAttachment* ptDepthAttachment = &ptCmdBufferItem->tRenderInfo.tDepthAttachment;
+            if(ptDepthAttachment->eLoadOp == PL_LOAD_OP_CLEAR && pl__cpu_get_depth_attachment(ptDevice, &ptCmdBufferItem->tRenderInfo, &tDepthTarget))
             {
-
-                const uint32_t uIndex0 = ptCmdBufferItem->tDraw.uVertexStart + puIndexBufferData[ptCmdBufferItem->tDraw.uIndexStart + i];
-                const uint32_t uIndex1 = ptCmdBufferItem->tDraw.uVertexStart + puIndexBufferData[ptCmdBufferItem->tDraw.uIndexStart + i + 1];
-                const uint32_t uIndex2 = ptCmdBufferItem->tDraw.uVertexStart + puIndexBufferData[ptCmdBufferItem->tDraw.uIndexStart + i + 2];
-
-                // type casting void buffer
-                const char* pcVtxBuffer = (char*)pVerticies;
-
-                // vertex shader stage
-                // setting vertex ID
-                plVertexShaderBuiltIns tVSBuiltIns0 = {
-                    .uVertexID = uIndex0,
-                    .atLayouts = ptShader->tDesc.atVertexBufferLayouts
-                };
-                plVertexShaderBuiltIns tVSBuiltIns1 = {
-                    .uVertexID = uIndex1,
-                    .atLayouts = ptShader->tDesc.atVertexBufferLayouts
-                };
-                plVertexShaderBuiltIns tVSBuiltIns2 = {
-                    .uVertexID = uIndex2,
-                    .atLayouts = ptShader->tDesc.atVertexBufferLayouts
-                };
-
-                if(!ptCommandBuffer->sbtVertexCache[uIndex0].bValid)
-                {
-                    ptCommandBuffer->sbtVertexCache[uIndex0].tPosition = ptCpuPipeline->tVertexShader(tVSBuiltIns0, ptCmdBufferItem->atCurrentDescriptorSets, &pcVtxBuffer[uIndex0 * stride], &ptCommandBuffer->sbtVertexCache[uIndex0].tVaryings);
-                    ptCommandBuffer->sbtVertexCache[uIndex0].bValid = true;
-                }
-
-                if(!ptCommandBuffer->sbtVertexCache[uIndex1].bValid)
-                {
-                    ptCommandBuffer->sbtVertexCache[uIndex1].tPosition = ptCpuPipeline->tVertexShader(tVSBuiltIns1, ptCmdBufferItem->atCurrentDescriptorSets, &pcVtxBuffer[uIndex1 * stride], &ptCommandBuffer->sbtVertexCache[uIndex1].tVaryings);
-                    ptCommandBuffer->sbtVertexCache[uIndex1].bValid = true;
-                }
-
-                if(!ptCommandBuffer->sbtVertexCache[uIndex2].bValid)
-                {
-                    ptCommandBuffer->sbtVertexCache[uIndex2].tPosition = ptCpuPipeline->tVertexShader(tVSBuiltIns2, ptCmdBufferItem->atCurrentDescriptorSets, &pcVtxBuffer[uIndex2 * stride], &ptCommandBuffer->sbtVertexCache[uIndex2].tVaryings);
-                    ptCommandBuffer->sbtVertexCache[uIndex2].bValid = true;
-                }
-
-                // defining varying data
-                plVaryingData tVaryingData0 = ptCommandBuffer->sbtVertexCache[uIndex0].tVaryings;
-                plVaryingData tVaryingData1 = ptCommandBuffer->sbtVertexCache[uIndex1].tVaryings;
-                plVaryingData tVaryingData2 = ptCommandBuffer->sbtVertexCache[uIndex2].tVaryings;
-
-                plVaryingData tVaryingTemplate = {0};
-
-                for(uint32_t j = 0; j < 16; j++)
-                    tVaryingTemplate._auOffset[j] = tVaryingData0._auOffset[j];
-
-                int iVaryingCount = 0;
-                for(int varyIndex = 0; varyIndex < 16; varyIndex++)
-                {
-                    if(tVaryingData0.atTypes[varyIndex] == PL_VARYING_TYPE_NONE)
-                        break;
-                    iVaryingCount++;
-                }
-
-                // frame buffer space
-                plVec2 tVertex0 = ptCommandBuffer->sbtVertexCache[uIndex0].tPosition;
-                plVec2 tVertex1 = ptCommandBuffer->sbtVertexCache[uIndex1].tPosition;
-                plVec2 tVertex2 = ptCommandBuffer->sbtVertexCache[uIndex2].tPosition;
-
-                const float viewportX = tCurrentViewport.fX;
-                const float viewportY = tCurrentViewport.fY;
-                const float viewportWidth  = tCurrentViewport.fWidth;
-                const float viewportHeight = tCurrentViewport.fHeight;
-
-                tVertex0.x = viewportX + viewportWidth * (0.5f + 0.5f * tVertex0.x);
-                tVertex1.x = viewportX + viewportWidth * (0.5f + 0.5f * tVertex1.x);
-                tVertex2.x = viewportX + viewportWidth * (0.5f + 0.5f * tVertex2.x);
-
-                tVertex0.y = viewportY + viewportHeight * (0.5f + 0.5f * tVertex0.y);
-                tVertex1.y = viewportY + viewportHeight * (0.5f + 0.5f * tVertex1.y);
-                tVertex2.y = viewportY + viewportHeight * (0.5f + 0.5f * tVertex2.y);
-
-                const int64_t x0 = llroundf(tVertex0.x * SUBPIXEL_SCALE);
-                const int64_t y0 = llroundf(tVertex0.y * SUBPIXEL_SCALE);
-
-                const int64_t x1 = llroundf(tVertex1.x * SUBPIXEL_SCALE);
-                const int64_t y1 = llroundf(tVertex1.y * SUBPIXEL_SCALE);
-
-                const int64_t x2 = llroundf(tVertex2.x * SUBPIXEL_SCALE);
-                const int64_t y2 = llroundf(tVertex2.y * SUBPIXEL_SCALE);
-
-                const int64_t ABC = pl__edge_function_fixed(x0, y0, x1, y1, x2, y2);
-
-                // PL_ASSERT(ABC != 0);
-
-                if(ABC == 0)
-                    continue;
-
-                const int64_t orientation = ABC > 0 ? 1 : -1;
-                const float invABC = 1.0f / (float)ABC;
-
-                // edge function for entire triangle 
-                // float ABC = (float)pl__edge_function(tVertex0, tVertex1, tVertex2);
-
-                const int viewportMinX = (int)floorf(viewportX);
-                const int viewportMinY = (int)floorf(viewportY);
-
-                const int viewportMaxX = (int)ceilf(viewportX + viewportWidth) - 1;
-                const int viewportMaxY = (int)ceilf(viewportY + viewportHeight) - 1;
-
-                // Bounding box with clamping
-                int minX = pl_max(viewportMinX, pl_min3((int)tVertex0.x, (int)tVertex1.x, (int)tVertex2.x) - 1);
-                int minY = pl_max(viewportMinY, pl_min3((int)tVertex0.y, (int)tVertex1.y, (int)tVertex2.y) - 1);
-                int maxX = pl_min(viewportMaxX, pl_max3((int)tVertex0.x, (int)tVertex1.x, (int)tVertex2.x) + 1);
-                int maxY = pl_min(viewportMaxY, pl_max3((int)tVertex0.y, (int)tVertex1.y, (int)tVertex2.y) + 1);
-
-                minX = pl_max(minX, tCurrentScissor.iOffsetX);
-                minY = pl_max(minY, tCurrentScissor.iOffsetY);
-                maxX = pl_min(maxX, tCurrentScissor.iOffsetX + (int)tCurrentScissor.uWidth - 1);
-                maxY = pl_min(maxY, tCurrentScissor.iOffsetY + (int)tCurrentScissor.uHeight - 1);
-
-                // Precompute edge function deltas
-                const int64_t ABa = y0 - y1;
-                const int64_t ABb = x1 - x0;
-                const int64_t ABc = x0 * y1 - x1 * y0;
-
-                const int64_t BCa = y1 - y2;
-                const int64_t BCb = x2 - x1;
-                const int64_t BCc = x1 * y2 - x2 * y1;
-
-                const int64_t CAa = y2 - y0;
-                const int64_t CAb = x0 - x2;
-                const int64_t CAc = x2 * y0 - x0 * y2;
-
-                const int64_t sampleX = (int64_t)minX * SUBPIXEL_SCALE + SUBPIXEL_HALF;
-                const int64_t sampleY = (int64_t)minY * SUBPIXEL_SCALE + SUBPIXEL_HALF;
-
-                int64_t ABP = ABa * sampleX + ABb * sampleY + ABc;
-                int64_t BCP = BCa * sampleX + BCb * sampleY + BCc;
-                int64_t CAP = CAa * sampleX + CAb * sampleY + CAc;
-
-                // if(ABC == 0.0f)
-                //     continue;
-
-                // const float invABC = 1.0f / ABC;
-
-                // With your Y-down framebuffer mapping, verify this sign once.
-                const bool bFrontFacing = ABC < 0.0f;
-
-                if(ptPipeline->tDesc.tGraphicsState.eCullMode == PL_CULL_MODE_CULL_BACK && !bFrontFacing)
-                    continue;
-
-                if(ptPipeline->tDesc.tGraphicsState.eCullMode == PL_CULL_MODE_CULL_FRONT && bFrontFacing)
-                    continue;
-
-                // const float orientation = ABC > 0.0f ? 1.0f : -1.0f;
-
-                // Reverse edge direction when triangle winding is reversed,
-                // so the top-left test is always evaluated in the same orientation.
-                const bool ABTopLeft = orientation > 0.0f ? pl__is_top_left_edge_fixed(x0, y0, x1, y1) : pl__is_top_left_edge_fixed(x1, y1, x0, y0);
-                const bool BCTopLeft = orientation > 0.0f ? pl__is_top_left_edge_fixed(x1, y1, x2, y2) : pl__is_top_left_edge_fixed(x2, y2, x1, y1);
-                const bool CATopLeft = orientation > 0.0f ? pl__is_top_left_edge_fixed(x2, y2, x0, y0) : pl__is_top_left_edge_fixed(x0, y0, x2, y2);
-
-
-                for(vertexP.y = (float)minY; vertexP.y <= (float)maxY; vertexP.y++)
-                {
-                    int64_t rowABP = ABP;
-                    int64_t rowBCP = BCP;
-                    int64_t rowCAP = CAP;
-                
-                    for(vertexP.x = (float)minX; vertexP.x <= (float)maxX; vertexP.x++)
-                    {
-
-                        // if(!(vertexP.x >= tCurrentScissor.iOffsetX && vertexP.x < tCurrentScissor.iOffsetX + tCurrentScissor.uWidth && vertexP.y >= tCurrentScissor.iOffsetY && vertexP.y < tCurrentScissor.iOffsetY + tCurrentScissor.uHeight))
-                        //     continue;
-                        const int64_t eAB = rowABP * orientation;
-                        const int64_t eBC = rowBCP * orientation;
-                        const int64_t eCA = rowCAP * orientation;
-
-                        const bool inside = (eAB > 0.0f || (eAB == 0.0f && ABTopLeft)) && (eBC > 0.0f || (eBC == 0.0f && BCTopLeft)) && (eCA > 0.0f || (eCA == 0.0f && CATopLeft));
-
-                        // if(rowABP <= 0 && rowBCP <= 0 && rowCAP <= 0) // back culling
-                        // if((rowABP >= 0 && rowBCP >= 0 && rowCAP >= 0) || (rowABP <= 0 && rowBCP <= 0 && rowCAP <= 0)) // no culling
-                        if(inside) // no culling
-                        {
-                            const float weightA = (float)((double)rowBCP * invABC);
-                            const float weightB = (float)((double)rowCAP * invABC);
-                            const float weightC = (float)((double)rowABP * invABC);
-                            
-                            plPixelShaderBuiltIns tBuiltIns = {
-                                .gl_FragCoord.xy = {
-                                    vertexP.x + 0.5f,
-                                    vertexP.y + 0.5f
-                                }
-                            };
-
-                            // Varying system
-                            int varyDataOffset = 0;
-                            plVaryingData blendedVaryingData = tVaryingTemplate;
-
-                            for(int varyIndex = 0; varyIndex < iVaryingCount; varyIndex++)
-                            {
-                                if(tVaryingData0.atTypes[varyIndex] == PL_VARYING_TYPE_VEC2)
-                                {
-                                    // 1st input 
-                                    // Vec2 blending
-                                    const plVec2 twoFloats0 = *(plVec2*)&tVaryingData0.acVaryingData[varyDataOffset];
-                                    const plVec2 twoFloats1 = *(plVec2*)&tVaryingData1.acVaryingData[varyDataOffset];
-                                    const plVec2 twoFloats2 = *(plVec2*)&tVaryingData2.acVaryingData[varyDataOffset];
-
-                                    plVec2 blendedVec2 = {
-                                        .x = ((float)(twoFloats0.x * weightA) + (float)(twoFloats1.x * weightB) + (float)(twoFloats2.x * weightC)),
-                                        .y = ((float)(twoFloats0.y * weightA) + (float)(twoFloats1.y * weightB) + (float)(twoFloats2.y * weightC)),
-                                    };
-                                    memcpy(&blendedVaryingData.acVaryingData[varyDataOffset], &blendedVec2, sizeof(plVec2));
-                                    varyDataOffset += sizeof(plVec2);
-                                }
-                                if(tVaryingData0.atTypes[varyIndex] == PL_VARYING_TYPE_VEC3)
-                                {
-                                    // 2nd input 
-                                    // Vec3 blending 
-                                    const plVec3* ptVecThree0 = (plVec3*)&tVaryingData0.acVaryingData[varyDataOffset];
-                                    const plVec3* ptVecThree1 = (plVec3*)&tVaryingData1.acVaryingData[varyDataOffset];
-                                    const plVec3* ptVecThree2 = (plVec3*)&tVaryingData2.acVaryingData[varyDataOffset];
-
-                                    plVec4 tBlendedVecThree = {
-                                        .x = ((float)(ptVecThree0->x * weightA) + (float)(ptVecThree1->x * weightB) + (float)(ptVecThree2->x * weightC)),
-                                        .y = ((float)(ptVecThree0->y * weightA) + (float)(ptVecThree1->y * weightB) + (float)(ptVecThree2->y * weightC)),
-                                        .z = ((float)(ptVecThree0->z * weightA) + (float)(ptVecThree1->z * weightB) + (float)(ptVecThree2->z * weightC))
-                                    };
-                                    memcpy(&blendedVaryingData.acVaryingData[varyDataOffset], &tBlendedVecThree, sizeof(plVec3));
-                                    varyDataOffset += sizeof(plVec3);
-                                }
-                                if(tVaryingData0.atTypes[varyIndex] == PL_VARYING_TYPE_VEC4)
-                                {
-                                    // 3rd input
-                                    // Vec4 blending 
-                                    const plVec4* ptColor0 = (plVec4*)&tVaryingData0.acVaryingData[varyDataOffset];
-                                    const plVec4* ptColor1 = (plVec4*)&tVaryingData1.acVaryingData[varyDataOffset];
-                                    const plVec4* ptColor2 = (plVec4*)&tVaryingData2.acVaryingData[varyDataOffset];
-
-                                    plVec4 tBlendedColor = {
-                                        .x = ((float)(ptColor0->x * weightA) + (float)(ptColor1->x * weightB) + (float)(ptColor2->x * weightC)),
-                                        .y = ((float)(ptColor0->y * weightA) + (float)(ptColor1->y * weightB) + (float)(ptColor2->y * weightC)),
-                                        .z = ((float)(ptColor0->z * weightA) + (float)(ptColor1->z * weightB) + (float)(ptColor2->z * weightC)),
-                                        .w = ((float)(ptColor0->w * weightA) + (float)(ptColor1->w * weightB) + (float)(ptColor2->w * weightC))
-                                    };
-                                    memcpy(&blendedVaryingData.acVaryingData[varyDataOffset], &tBlendedColor, sizeof(plVec4));
-                                    varyDataOffset += sizeof(plVec4);
-                                }
-                                if(tVaryingData0.atTypes[varyIndex] == PL_VARYING_TYPE_FLOAT)
-                                {
-                                    // 4th input 
-                                    // float blending 
-                                    const float tData0 = *(float*)&tVaryingData0.acVaryingData[varyDataOffset];
-                                    const float tData1 = *(float*)&tVaryingData1.acVaryingData[varyDataOffset];
-                                    const float tData2 = *(float*)&tVaryingData2.acVaryingData[varyDataOffset];
-
-                                    float fBlendedData2 = ((float)(tData0 * weightA) + (float)(tData1 * weightB) + (float)(tData2 * weightC));
-
-                                    memcpy(&blendedVaryingData.acVaryingData[varyDataOffset], &fBlendedData2, sizeof(float));
-                                    varyDataOffset += sizeof(float);
-                                }
-                            }
-
-                            // scissor check
-                            // if(vertexP.x >= tCurrentScissor.iOffsetX && vertexP.x < tCurrentScissor.iOffsetX + tCurrentScissor.uWidth && vertexP.y >= tCurrentScissor.iOffsetY && vertexP.y < tCurrentScissor.iOffsetY + tCurrentScissor.uHeight)
-                            {
-                                // run pixel shader
-                                plVec4 tFinalColor = ptCpuPipeline->tPixelShader(tBuiltIns, ptCmdBufferItem->atCurrentDescriptorSets, &blendedVaryingData);
-                                
-
-                                pl_set_pixel(ptCpuTexture, vertexP, tFinalColor, (uint32_t)fbWidth, (uint32_t)fbHeight);
-                            }
-                        }
-                        // Incrementally update edge functions for next pixel in row
-                        rowABP += ABa * SUBPIXEL_SCALE;
-                        rowBCP += BCa * SUBPIXEL_SCALE;
-                        rowCAP += CAa * SUBPIXEL_SCALE;
-                    }
-                    // Incrementally update edge functions for next row
-                    ABP += ABb * SUBPIXEL_SCALE;
-                    BCP += BCb * SUBPIXEL_SCALE;
-                    CAP += CAb * SUBPIXEL_SCALE;
-                }
+                pl__cpu_flush_bins(ptCommandBuffer);
+                const plTexture* ptDepthTexture = &ptDevice->sbtTexturesCold[tDepthTarget.uIndex];
+                float* afDepth = ptDevice->sbtTexturesHot[tDepthTarget.uIndex].pData;
+                const size_t szDepthCount = (size_t)ptDepthTexture->tDesc.tDimensions.x * (size_t)ptDepthTexture->tDesc.tDimensions.y;
+                for(size_t i = 0; i < szDepthCount; i++)
+                    afDepth[i] = ptDepthAttachment->fClearZ;
+                ptCommandBuffer->uTileSize = 0; // rebuild hi-z
             }
         }
+        else if(ptCmdBufferItem->eType == PL_CPU_COMMAND_BUFFER_ITEM_TYPE_DISPATCH)
+        {
+            // binned draws may produce what the kernel reads & the kernel may
+            // write to the depth target
+            pl__cpu_flush_bins(ptCommandBuffer);
+            ptCmdBufferItem->atCurrentDescriptorSets[3].atDescriptors = &ptCmdBufferItem->tDynamicDescriptor;
+            pl__cpu_dispatch(ptCommandBuffer, ptCmdBufferItem);
+            ptCommandBuffer->uTileSize = 0; // rebuild hi-z
+        }
+        else if(ptCmdBufferItem->eType == PL_CPU_COMMAND_BUFFER_ITEM_TYPE_DRAW_INDEXED)
+        {
+            // front end: shade vertices, set up & bin triangles into screen tiles
+            ptCmdBufferItem->atCurrentDescriptorSets[3].atDescriptors = &ptCmdBufferItem->tDynamicDescriptor;
+            pl__cpu_set_bin_target(ptCommandBuffer, &ptCmdBufferItem->tRenderInfo);
+            pl__cpu_bin_draw(ptCommandBuffer, ptCmdBufferItem, &tCurrentViewport, &tCurrentScissor);
+
+            // back end: rasterize tiles (in parallel when enabled)
+            if(pl_sb_size(ptCommandBuffer->sbtVertices) > PL_CPU_MAX_BINNED_VERTICES)
+                pl__cpu_flush_bins(ptCommandBuffer);
+        }
     }
+    pl__cpu_flush_bins(ptCommandBuffer);
 }
 
 void
@@ -1620,6 +2595,20 @@ pl_graphics_cleanup_command_pool(plCommandPool* ptPool)
     {
         plCommandBuffer* ptNextCmdBuffer = ptCmdBuffer->ptNext;
         pl_sb_free(ptCmdBuffer->sbtStream);
+        pl_sb_free(ptCmdBuffer->sbtVertexCache);
+        pl_sb_free(ptCmdBuffer->sbtVertices);
+        pl_sb_free(ptCmdBuffer->sbtTriangles);
+        pl_sb_free(ptCmdBuffer->sbcComputeSharedMemory);
+        for(uint32_t i = 0; i < pl_sb_size(ptCmdBuffer->sbtTileBins); i++)
+        {
+            pl_sb_free(ptCmdBuffer->sbtTileBins[i].sbuTriangles);
+        }
+        pl_sb_free(ptCmdBuffer->sbtTileBins);
+        pl_sb_free(ptCmdBuffer->sbuActiveTiles);
+        pl_sb_free(ptCmdBuffer->sbfHiZMin);
+        pl_sb_free(ptCmdBuffer->sbfHiZMax);
+        if(ptCmdBuffer->ptNextActiveTile)
+            gptAtomics->destroy_counter(&ptCmdBuffer->ptNextActiveTile);
         PL_FREE(ptCmdBuffer);
         ptCmdBuffer = ptNextCmdBuffer;
         
@@ -1725,6 +2714,12 @@ pl_graphics_destroy_shader(plDevice* ptDevice, plShaderHandle tHandle)
 void
 pl_graphics_destroy_compute_shader(plDevice* ptDevice, plComputeShaderHandle tHandle)
 {
+    plCpuComputeShader* ptCpuShader = &ptDevice->sbtComputeShadersHot[tHandle.uIndex];
+    if(ptCpuShader->pSpecializationData)
+    {
+        PL_FREE(ptCpuShader->pSpecializationData);
+        ptCpuShader->pSpecializationData = NULL;
+    }
 }
 
 void
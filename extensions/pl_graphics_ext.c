@@ -1053,6 +1053,11 @@ pl_load_graphics_ext(plApiRegistryI* ptApiRegistry, bool bReload)
     gptWindows      = pl_get_api_latest(ptApiRegistry, plWindowI);
     gptIO           = gptIOI->get_io();
 
+    #ifdef PL_CPU_BACKEND
+        gptJob          = pl_get_api_latest(ptApiRegistry, plJobI);
+        gptAtomics      = pl_get_api_latest(ptApiRegistry, plAtomicsI);
+    #endif
+
     if(bReload)
     {
         gptGraphics = gptDataRegistry->get_data("plGraphics");
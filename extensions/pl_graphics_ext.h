@@ -69,6 +69,19 @@ Index of this file:
         * plLogI
         * plProfileI
 
+        The CPU backend additionally uses the following APIs when
+        "uCpuThreadCount" is greater than 1 (job system must be initialized
+        before the device is created, otherwise rasterization is serial):
+
+        * plJobI
+        * plAtomicsI
+
+        CPU compute shaders are plComputeKernel functions (pl_shader_interop_cpu.h)
+        called once per workgroup with PL_CPU_COMPUTE_SHARED_MEMORY_SIZE bytes
+        of group shared memory. Workgroups only run through plJobI when
+        plJobSystemInit::szSharedMemorySize is at least that large (otherwise
+        they run serially on the submitting thread).
+
     WARNING:
 
     The purpose of the graphics extension is NOT to make low level graphics
@@ -121,7 +134,7 @@ extern "C" {
 // [SECTION] apis
 //-----------------------------------------------------------------------------
 
-#define plGraphicsI_version {2, 1, 3}
+#define plGraphicsI_version {2, 3, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -1275,6 +1288,10 @@ typedef struct _plDeviceInit
     size_t            szDynamicBufferBlockSize;
     size_t            szDynamicDataMaxSize;
     plSurface*        ptSurface;
+
+    // cpu backend only
+    uint32_t          uCpuThreadCount; // tiles & compute workgroups run in parallel w/ plJobI (default: 1, i.e. submitting thread only)
+    uint32_t          uCpuTileSize;    // binning tile size in pixels (default: 64)
 } plDeviceInit;
 
 //-----------------------------------------------------------------------------
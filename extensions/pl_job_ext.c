@@ -8,7 +8,12 @@ Index of this file:
 // [SECTION] defines
 // [SECTION] internal structs
 // [SECTION] global data
-// [SECTION] free list & helper functions
+// [SECTION] counter pool
+// [SECTION] helper functions
+// [SECTION] shared queue
+// [SECTION] work stealing
+// [SECTION] submission
+// [SECTION] job graphs
 // [SECTION] implementation
 // [SECTION] extension loading
 */
@@ -24,6 +29,7 @@ Index of this file:
 
 // extensions
 #include "pl_platform_ext.h" // atomics & threads
+#include "pl_stats_ext.h"
 
 #ifdef PL_UNITY_BUILD
     #include "pl_unity_ext.inc"
@@ -41,6 +47,7 @@ Index of this file:
 
     static const plAtomicsI* gptAtomics = NULL;
     static const plThreadsI* gptThreads = NULL;
+    static const plStatsI*   gptStats   = NULL;
 #endif
 
 #include "pl_ds.h"
@@ -53,46 +60,147 @@ Index of this file:
     #define PL_MAX_JOB_THREADS 64
 #endif
 
+// per worker deque size (work stealing mode), must be a power of 2
+#ifndef PL_JOB_DEQUE_CAPACITY
+    #define PL_JOB_DEQUE_CAPACITY 1024
+#endif
+
+// max batches a worker moves from the shared queue into its deque at once
+#ifndef PL_JOB_SHARED_QUEUE_GRAB
+    #define PL_JOB_SHARED_QUEUE_GRAB 32
+#endif
+
+// counters are allocated in blocks so handles stay valid as the pool grows
+#ifndef PL_JOB_COUNTER_BLOCK_SIZE
+    #define PL_JOB_COUNTER_BLOCK_SIZE 256
+#endif
+
+#ifndef PL_JOB_MAX_COUNTER_BLOCKS
+    #define PL_JOB_MAX_COUNTER_BLOCKS 256
+#endif
+
+// high & normal lanes get per worker deques, background always goes through
+// the shared queue
+#define PL__JOB_DEQUE_LANE_COUNT 2
+
+// max shared queue entries a waiting thread scans for the awaited counter
+#ifndef PL_JOB_WAIT_SCAN_LIMIT
+    #define PL_JOB_WAIT_SCAN_LIMIT 64
+#endif
+
+#ifdef _MSC_VER
+    #define PL__JOB_THREAD_LOCAL __declspec(thread)
+#else
+    #define PL__JOB_THREAD_LOCAL _Thread_local
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] internal structs
 //-----------------------------------------------------------------------------
 
-typedef struct _plAtomicCounterNode
+typedef struct _plJobCounter
 {
-    plAtomicCounter* ptCounter;
-    uint32_t         uNextNode;
-} plAtomicCounterNode;
+    plAtomicCounter* ptValue;   // remaining batches
+    uint32_t         uIndex;    // index into counter pool (O(1) release)
+    uint32_t         uNextFree; // free list link
+} plJobCounter;
 
 typedef struct _plSubmittedBatch
 {
     void            (*task)(plInvocationData, void*, void*);
     void*            pData;
-    plAtomicCounter* ptCounter;
+    plJobCounter*    ptCounter;
     plInvocationData tInvocationData;
+    plJobGraph*      ptGraph; // optional, graph owning this batch
+    uint32_t         uGraphNode;
+    plJobPriority    ePriority;
 } plSubmittedBatch;
 
-typedef struct _plJobContext
+typedef struct _plJobQueue
+{
+    uint32_t          uFrontIndex;
+    uint32_t          uBackIndex;
+    uint32_t          uBatchCount;
+    uint32_t          uBatchCapacity;
+    plSubmittedBatch* sbtBatches; // ring buffer
+} plJobQueue;
+
+typedef struct _plJobSubmission
+{
+    const plJobDesc* ptJobs;   // one batch per job (dispatch_jobs style) or NULL
+    plJobDesc        tJobDesc; // used if ptJobs is NULL (dispatch_batch style)
+    uint32_t         uJobCount;
+    uint32_t         uGroupSize;
+    uint32_t         uBatchCount;
+    plJobCounter*    ptCounter;
+    plJobGraph*      ptGraph;
+    uint32_t         uGraphNode;
+} plJobSubmission;
+
+typedef struct _plJobGraphNode
+{
+    plJobDesc*       sbtJobs;  // dispatch_jobs style node
+    plJobDesc        tJobDesc; // dispatch_batch style node
+    bool             bJobArray;
+    uint32_t         uJobCount;
+    uint32_t         uGroupSize;
+    uint32_t         uPredecessorCount;
+    uint32_t*        sbuSuccessors;
+    plAtomicCounter* ptPendingPredecessors;
+    plAtomicCounter* ptPendingBatches;
+} plJobGraphNode;
+
+typedef struct _plJobGraph
 {
-    bool         bRunning;
-    uint32_t     uThreadCount;
-    plThread*    aptThreads[PL_MAX_JOB_THREADS];
-    plThreadKey* ptThreadLocalKey;
-    size_t       szSharedMemorySize;
-    void*        pThreadLocalData;
+    plJobGraphNode*  sbtNodes;
+    plAtomicCounter* ptPendingNodes;
+    plJobCounter*    ptCounter; // optional user counter of current dispatch
+} plJobGraph;
 
-    // counter free list data
-    plAtomicCounterNode* sbtNodes;
-    uint32_t             uFreeList;
+typedef struct _plJobDeque
+{
+    // Chase-Lev deque: owner pushes & pops at the bottom, thieves take from the top
+    plAtomicCounter*  ptTop;
+    plAtomicCounter*  ptBottom;
+    plSubmittedBatch* atBatches; // PL_JOB_DEQUE_CAPACITY
+} plJobDeque;
+
+typedef struct _plJobWorker
+{
+    uint32_t   uIndex;
+    uint32_t   uRandomState; // xorshift state for picking victims
+    plJobDeque atDeques[PL__JOB_DEQUE_LANE_COUNT]; // indexed by priority
+} plJobWorker;
 
-    // queue data
+typedef struct _plJobContext
+{
+    bool             bRunning;
+    plJobSystemFlags eFlags;
+    uint32_t         uThreadCount;
+    plThread*        aptThreads[PL_MAX_JOB_THREADS];
+    plThreadKey*     ptThreadLocalKey;
+    size_t           szSharedMemorySize;
+    void*            pThreadLocalData;
+
+    // counter pool (blocks only grow, free list is lock-free)
+    plJobCounter*    aptCounterBlocks[PL_JOB_MAX_COUNTER_BLOCKS];
+    uint32_t         uCounterBlockCount; // guarded by queue latch
+    plAtomicCounter* ptFreeCounterHead;  // ABA tag (high 32 bits) | counter index (low 32 bits)
+
+    // queue data (one shared queue per lane, all guarded by the latch)
     plConditionVariable* ptConditionVariable;
     plCriticalSection*   ptCriticalSection;
     plAtomicCounter*     ptQueueLatch; // 1 - locked, 0 - unlocked
-    uint32_t             uFrontIndex;
-    uint32_t             uBackIndex;
-    uint32_t             uBatchCount;
-    uint32_t             uBatchCapacity;
-    plSubmittedBatch*    sbtBatches; // ring buffer
+    plJobQueue           atQueues[PL_JOB_PRIORITY_COUNT];
+
+    // lane data
+    uint32_t         uMaxBackgroundThreads;
+    plAtomicCounter* ptActiveBackground;                   // workers currently running background batches
+    plAtomicCounter* aptLaneDepth[PL_JOB_PRIORITY_COUNT]; // queued (not yet started) batches per lane
+
+    // work stealing data
+    plJobWorker      atWorkers[PL_MAX_JOB_THREADS];
+    plAtomicCounter* ptSleepingCount;
 } plJobContext;
 
 //-----------------------------------------------------------------------------
@@ -101,123 +209,665 @@ typedef struct _plJobContext
 
 static plJobContext* gptJobCtx = NULL;
 
+// worker owned by the calling thread (set at worker startup in both
+// scheduler modes, NULL on non worker threads)
+static PL__JOB_THREAD_LOCAL plJobWorker* gptJobCurrentWorker = NULL;
+
+// order in which workers look for work
+static const plJobPriority gaeJobLaneOrder[PL_JOB_PRIORITY_COUNT] = {
+    PL_JOB_PRIORITY_HIGH,
+    PL_JOB_PRIORITY_NORMAL,
+    PL_JOB_PRIORITY_BACKGROUND
+};
+
 //-----------------------------------------------------------------------------
-// [SECTION] free list & helper functions
+// [SECTION] helper functions
 //-----------------------------------------------------------------------------
 
+static inline void
+pl__job_lock_queue(void)
+{
+    // spin lock
+    while(!gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
+        ;
+}
+
+static inline void
+pl__job_unlock_queue(void)
+{
+    gptAtomics->store(gptJobCtx->ptQueueLatch, 0);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] counter pool
+//-----------------------------------------------------------------------------
+
+static inline plJobCounter*
+pl__job_get_counter(uint32_t uIndex)
+{
+    return &gptJobCtx->aptCounterBlocks[uIndex / PL_JOB_COUNTER_BLOCK_SIZE][uIndex % PL_JOB_COUNTER_BLOCK_SIZE];
+}
+
+// pushes an already linked chain of counters (first -> ... -> last)
 static void
-pl__job_add_node_to_freelist(uint32_t uNode)
+pl__job_push_free_counters(plJobCounter* ptFirst, plJobCounter* ptLast)
 {
-    gptJobCtx->sbtNodes[uNode].uNextNode = gptJobCtx->uFreeList;
-    gptJobCtx->uFreeList = uNode;
+    while(true)
+    {
+        const uint64_t uHead = (uint64_t)gptAtomics->load(gptJobCtx->ptFreeCounterHead);
+        ptLast->uNextFree = (uint32_t)uHead;
+        const uint64_t uNewHead = (((uHead >> 32) + 1) << 32) | ptFirst->uIndex;
+        if(gptAtomics->compare_exchange(gptJobCtx->ptFreeCounterHead, (int64_t)uHead, (int64_t)uNewHead))
+            return;
+    }
+}
+
+static plJobCounter*
+pl__job_pop_free_counter(void)
+{
+    while(true)
+    {
+        const uint64_t uHead = (uint64_t)gptAtomics->load(gptJobCtx->ptFreeCounterHead);
+        const uint32_t uIndex = (uint32_t)uHead;
+        if(uIndex == UINT32_MAX)
+            return NULL;
+
+        // next link may be stale if another thread raced us, the tag
+        // makes the exchange fail in that case
+        plJobCounter* ptCounter = pl__job_get_counter(uIndex);
+        const uint64_t uNewHead = (((uHead >> 32) + 1) << 32) | ptCounter->uNextFree;
+        if(gptAtomics->compare_exchange(gptJobCtx->ptFreeCounterHead, (int64_t)uHead, (int64_t)uNewHead))
+            return ptCounter;
+    }
 }
 
 static void
-pl__job_remove_node_from_freelist(uint32_t uNode)
+pl__job_grow_counter_pool(void)
+{
+    pl__job_lock_queue();
+
+    // another thread may have grown the pool while we were spinning
+    if((uint32_t)gptAtomics->load(gptJobCtx->ptFreeCounterHead) == UINT32_MAX)
+    {
+        const uint32_t uBlock = gptJobCtx->uCounterBlockCount;
+        PL_ASSERT(uBlock < PL_JOB_MAX_COUNTER_BLOCKS && "job counter pool exhausted (counters not waited on?)");
+
+        plJobCounter* atCounters = PL_ALLOC(sizeof(plJobCounter) * PL_JOB_COUNTER_BLOCK_SIZE);
+        for(uint32_t i = 0; i < PL_JOB_COUNTER_BLOCK_SIZE; i++)
+        {
+            atCounters[i].uIndex = uBlock * PL_JOB_COUNTER_BLOCK_SIZE + i;
+            atCounters[i].uNextFree = atCounters[i].uIndex + 1;
+            gptAtomics->create_counter(0, &atCounters[i].ptValue);
+        }
+        gptJobCtx->aptCounterBlocks[uBlock] = atCounters;
+        gptJobCtx->uCounterBlockCount++;
+
+        pl__job_push_free_counters(&atCounters[0], &atCounters[PL_JOB_COUNTER_BLOCK_SIZE - 1]);
+    }
+
+    pl__job_unlock_queue();
+}
+
+static plJobCounter*
+pl__job_acquire_counter(uint64_t uValue)
+{
+    plJobCounter* ptCounter = pl__job_pop_free_counter();
+    while(ptCounter == NULL)
+    {
+        pl__job_grow_counter_pool();
+        ptCounter = pl__job_pop_free_counter();
+    }
+    gptAtomics->store(ptCounter->ptValue, (int64_t)uValue);
+    return ptCounter;
+}
+
+static inline void
+pl__job_release_counter(plJobCounter* ptCounter)
 {
+    pl__job_push_free_counters(ptCounter, ptCounter);
+}
 
-    bool bFound = false;
-    if(gptJobCtx->uFreeList == uNode)
+static inline uint32_t
+pl__job_resolve_group_size(uint32_t uJobCount, uint32_t uGroupSize)
+{
+    // find optimal group size
+    if(uGroupSize == 0)
     {
-        gptJobCtx->uFreeList = gptJobCtx->sbtNodes[uNode].uNextNode;
-        bFound = true;
+        uGroupSize = uJobCount / gptJobCtx->uThreadCount;
+
+        // possible if job count is less than thread count
+        if(uGroupSize == 0)
+            uGroupSize = 1;
+    }
+
+    if(uGroupSize > uJobCount)
+        uGroupSize = uJobCount;
+    return uGroupSize;
+}
+
+static void pl__job_complete_graph_batch(plJobGraph*, uint32_t uNode);
+
+static inline void
+pl__job_run_batch(const plSubmittedBatch* ptBatch, void* pThreadLocalData)
+{
+    gptAtomics->decrement(gptJobCtx->aptLaneDepth[ptBatch->ePriority]);
+
+    plInvocationData tInvocationData = ptBatch->tInvocationData;
+    for(uint32_t i = 0; i < ptBatch->tInvocationData.uBatchSize; i++)
+    {
+        // set per job invocation members
+        tInvocationData.uLocalIndex = i;
+        tInvocationData.uGlobalIndex = ptBatch->tInvocationData.uGlobalIndex + i;
+
+        // run actual job
+        ptBatch->task(tInvocationData, ptBatch->pData, pThreadLocalData);
+    }
+
+    // decrement atomic counter (graph batches also release successors)
+    if(ptBatch->ptGraph)
+        pl__job_complete_graph_batch(ptBatch->ptGraph, ptBatch->uGraphNode);
+    else if(ptBatch->ptCounter)
+        gptAtomics->decrement(ptBatch->ptCounter->ptValue);
+}
+
+static inline plSubmittedBatch
+pl__job_make_batch(const plJobSubmission* ptSubmission, uint32_t uBatchIndex)
+{
+    plSubmittedBatch tBatch = {
+        .ptCounter  = ptSubmission->ptCounter,
+        .ptGraph    = ptSubmission->ptGraph,
+        .uGraphNode = ptSubmission->uGraphNode,
+        .tInvocationData = {
+            .szSharedMemorySize = gptJobCtx->szSharedMemorySize
+        }
+    };
+
+    if(ptSubmission->ptJobs)
+    {
+        tBatch.task = ptSubmission->ptJobs[uBatchIndex].task;
+        tBatch.pData = ptSubmission->ptJobs[uBatchIndex].pData;
+        tBatch.ePriority = ptSubmission->ptJobs[uBatchIndex].ePriority;
+        tBatch.tInvocationData.uBatchIndex = 0;
+        tBatch.tInvocationData.uGlobalIndex = uBatchIndex;
+        tBatch.tInvocationData.uBatchSize = 1;
     }
     else
     {
-        uint32_t uNextNode = gptJobCtx->uFreeList;
-        while(uNextNode != UINT32_MAX)
+        const uint32_t uFullBatches = ptSubmission->uJobCount / ptSubmission->uGroupSize;
+        tBatch.task = ptSubmission->tJobDesc.task;
+        tBatch.pData = ptSubmission->tJobDesc.pData;
+        tBatch.ePriority = ptSubmission->tJobDesc.ePriority;
+        tBatch.tInvocationData.uBatchIndex = uBatchIndex;
+        tBatch.tInvocationData.uGlobalIndex = uBatchIndex * ptSubmission->uGroupSize;
+        tBatch.tInvocationData.uBatchSize = uBatchIndex < uFullBatches ? ptSubmission->uGroupSize : ptSubmission->uJobCount % ptSubmission->uGroupSize;
+    }
+    PL_ASSERT(tBatch.ePriority >= 0 && tBatch.ePriority < PL_JOB_PRIORITY_COUNT);
+    return tBatch;
+}
+
+// plAtomicsI has no fetch_add
+static inline void
+pl__job_atomic_add(plAtomicCounter* ptCounter, int64_t ilValue)
+{
+    int64_t ilCurrent = gptAtomics->load(ptCounter);
+    while(!gptAtomics->compare_exchange(ptCounter, ilCurrent, ilCurrent + ilValue))
+        ilCurrent = gptAtomics->load(ptCounter);
+}
+
+// caps concurrent background work so frame work always has workers left
+static inline bool
+pl__job_try_begin_background(void)
+{
+    int64_t ilActive = gptAtomics->load(gptJobCtx->ptActiveBackground);
+    while(ilActive < (int64_t)gptJobCtx->uMaxBackgroundThreads)
+    {
+        if(gptAtomics->compare_exchange(gptJobCtx->ptActiveBackground, ilActive, ilActive + 1))
+            return true;
+        ilActive = gptAtomics->load(gptJobCtx->ptActiveBackground);
+    }
+    return false;
+}
+
+static inline void
+pl__job_end_background(void)
+{
+    gptAtomics->decrement(gptJobCtx->ptActiveBackground);
+}
+
+// only called from non worker threads (see pl__job_is_worker_thread) so
+// values aren't overwritten concurrently
+static void
+pl__job_update_stats(void)
+{
+    if(gptStats == NULL)
+        return;
+
+    static double* apdLaneDepth[PL_JOB_PRIORITY_COUNT] = {0};
+    if(!apdLaneDepth[0])
+    {
+        apdLaneDepth[PL_JOB_PRIORITY_NORMAL]     = gptStats->get_counter("job queue depth (normal)");
+        apdLaneDepth[PL_JOB_PRIORITY_HIGH]       = gptStats->get_counter("job queue depth (high)");
+        apdLaneDepth[PL_JOB_PRIORITY_BACKGROUND] = gptStats->get_counter("job queue depth (background)");
+    }
+
+    for(uint32_t i = 0; i < PL_JOB_PRIORITY_COUNT; i++)
+        *apdLaneDepth[i] = (double)gptAtomics->load(gptJobCtx->aptLaneDepth[i]);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] shared queue
+//-----------------------------------------------------------------------------
+
+// requires queue latch
+static void
+pl__job_init_queue(plJobQueue* ptQueue)
+{
+    ptQueue->uBatchCapacity = 128;
+    ptQueue->uBatchCount = 0;
+    ptQueue->uFrontIndex = 0;
+    ptQueue->uBackIndex = 0;
+    pl_sb_resize(ptQueue->sbtBatches, ptQueue->uBatchCapacity);
+    memset(ptQueue->sbtBatches, 0, sizeof(plSubmittedBatch) * ptQueue->uBatchCapacity);
+}
+
+static void
+pl__job_reserve_queue(plJobQueue* ptQueue, uint32_t uJobCount)
+{
+    if(ptQueue->uBatchCount + uJobCount < ptQueue->uBatchCapacity)
+        return;
+
+    uint32_t uNewCapacity = ptQueue->uBatchCapacity * 2;
+    while(ptQueue->uBatchCount + uJobCount >= uNewCapacity)
+        uNewCapacity *= 2;
+
+    // copy into new ring buffer in queue order so wrapped entries stay
+    // contiguous (front starts at the end & moves toward 0)
+    plSubmittedBatch* sbtNewBatches = NULL;
+    pl_sb_resize(sbtNewBatches, uNewCapacity);
+    uint32_t uSrcIndex = ptQueue->uFrontIndex;
+    for(uint32_t i = 0; i < ptQueue->uBatchCount; i++)
+    {
+        sbtNewBatches[uNewCapacity - 1 - i] = ptQueue->sbtBatches[uSrcIndex];
+        uSrcIndex = uSrcIndex == 0 ? ptQueue->uBatchCapacity - 1 : uSrcIndex - 1;
+    }
+
+    pl_sb_free(ptQueue->sbtBatches);
+    ptQueue->sbtBatches = sbtNewBatches;
+    ptQueue->uFrontIndex = uNewCapacity - 1;
+    ptQueue->uBackIndex = uNewCapacity - 1 - ptQueue->uBatchCount;
+    ptQueue->uBatchCapacity = uNewCapacity;
+}
+
+// requires queue latch
+static inline void
+pl__job_push_to_queue(plJobQueue* ptQueue, const plSubmittedBatch* ptBatch)
+{
+    pl__job_reserve_queue(ptQueue, 1);
+    ptQueue->sbtBatches[ptQueue->uBackIndex] = *ptBatch;
+    ptQueue->uBackIndex--;
+    if(ptQueue->uBackIndex == UINT32_MAX) // wrap around
+        ptQueue->uBackIndex = ptQueue->uBatchCapacity - 1;
+    ptQueue->uBatchCount++;
+}
+
+// requires queue latch
+static inline void
+pl__job_pop_from_queue(plJobQueue* ptQueue, plSubmittedBatch* ptBatchOut)
+{
+    *ptBatchOut = ptQueue->sbtBatches[ptQueue->uFrontIndex];
+    ptQueue->sbtBatches[ptQueue->uFrontIndex].pData = NULL;
+    ptQueue->sbtBatches[ptQueue->uFrontIndex].task = NULL;
+    ptQueue->sbtBatches[ptQueue->uFrontIndex].ptCounter = NULL;
+    ptQueue->uFrontIndex--;
+    if(ptQueue->uFrontIndex == UINT32_MAX) // wrap
+        ptQueue->uFrontIndex = ptQueue->uBatchCapacity - 1;
+
+    // update total job count
+    ptQueue->uBatchCount--;
+}
+
+// used by shared queue mode workers (background only if allowed by cap)
+static bool
+pl__pop_batch_off_queue(bool bWorker, plSubmittedBatch* ptBatchOut)
+{
+    bool bHasBatch = false;
+
+    pl__job_lock_queue();
+    for(uint32_t i = 0; i < PL_JOB_PRIORITY_COUNT; i++)
+    {
+        const plJobPriority ePriority = gaeJobLaneOrder[i];
+        plJobQueue* ptQueue = &gptJobCtx->atQueues[ePriority];
+        if(ptQueue->uBatchCount == 0)
+            continue;
+
+        if(ePriority == PL_JOB_PRIORITY_BACKGROUND && !(bWorker && pl__job_try_begin_background()))
+            break;
+
+        pl__job_pop_from_queue(ptQueue, ptBatchOut);
+        bHasBatch = true;
+        break;
+    }
+    pl__job_unlock_queue();
+
+    return bHasBatch;
+}
+
+// scans the newest entries of the shared queues for a batch of the counter
+// (try lock only, waiting threads fall back to other work)
+static bool
+pl__job_take_counter_batch_from_queue(const plJobCounter* ptCounter, plSubmittedBatch* ptBatchOut)
+{
+    if(!gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
+        return false;
+
+    bool bHasBatch = false;
+    for(uint32_t uLane = 0; uLane < PL_JOB_PRIORITY_COUNT && !bHasBatch; uLane++)
+    {
+        plJobQueue* ptQueue = &gptJobCtx->atQueues[gaeJobLaneOrder[uLane]];
+        const uint32_t uCapacity = ptQueue->uBatchCapacity;
+        const uint32_t uScanCount = ptQueue->uBatchCount < PL_JOB_WAIT_SCAN_LIMIT ? ptQueue->uBatchCount : PL_JOB_WAIT_SCAN_LIMIT;
+        const uint32_t uNewestIndex = (ptQueue->uBackIndex + 1) % uCapacity;
+        uint32_t uIndex = uNewestIndex;
+        for(uint32_t i = 0; i < uScanCount; i++)
         {
-            uint32_t uPrevNode = uNextNode;
-            uNextNode = gptJobCtx->sbtNodes[uPrevNode].uNextNode;
-            
-            if(uNextNode == uNode)
+            if(ptQueue->sbtBatches[uIndex].ptCounter == ptCounter)
             {
-                gptJobCtx->sbtNodes[uPrevNode].uNextNode = gptJobCtx->sbtNodes[uNode].uNextNode;
-                bFound = true;
+                // move newest entry into the hole & pop from the back
+                *ptBatchOut = ptQueue->sbtBatches[uIndex];
+                ptQueue->sbtBatches[uIndex] = ptQueue->sbtBatches[uNewestIndex];
+                ptQueue->sbtBatches[uNewestIndex].ptCounter = NULL;
+                ptQueue->uBackIndex = uNewestIndex;
+                ptQueue->uBatchCount--;
+                bHasBatch = true;
                 break;
             }
+            uIndex = (uIndex + 1) % uCapacity;
         }
     }
+    pl__job_unlock_queue();
+    return bHasBatch;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] work stealing
+//-----------------------------------------------------------------------------
+
+static bool
+pl__job_deque_push(plJobDeque* ptDeque, const plSubmittedBatch* ptBatch)
+{
+    const int64_t ilBottom = gptAtomics->load(ptDeque->ptBottom);
+    const int64_t ilTop = gptAtomics->load(ptDeque->ptTop);
+    if(ilBottom - ilTop >= PL_JOB_DEQUE_CAPACITY)
+        return false; // full, caller falls back to shared queue
+
+    ptDeque->atBatches[ilBottom & (PL_JOB_DEQUE_CAPACITY - 1)] = *ptBatch;
+    gptAtomics->store(ptDeque->ptBottom, ilBottom + 1);
+    return true;
+}
 
-    plAtomicCounterNode* ptNode = &gptJobCtx->sbtNodes[uNode];
-    ptNode->uNextNode = UINT32_MAX;
-    PL_ASSERT(bFound && "could not find node to remove");
+static bool
+pl__job_deque_pop(plJobDeque* ptDeque, plSubmittedBatch* ptBatchOut)
+{
+    const int64_t ilBottom = gptAtomics->load(ptDeque->ptBottom) - 1;
+    gptAtomics->store(ptDeque->ptBottom, ilBottom);
+    const int64_t ilTop = gptAtomics->load(ptDeque->ptTop);
 
-    if(gptJobCtx->uFreeList == UINT32_MAX)
+    if(ilTop > ilBottom) // empty
     {
-        plAtomicCounterNode tNewNode = {
-            .uNextNode = UINT32_MAX
-        };
-        gptAtomics->create_counter(0, &tNewNode.ptCounter);
-        pl_sb_push(gptJobCtx->sbtNodes, tNewNode);
+        gptAtomics->store(ptDeque->ptBottom, ilBottom + 1);
+        return false;
     }
 
+    *ptBatchOut = ptDeque->atBatches[ilBottom & (PL_JOB_DEQUE_CAPACITY - 1)];
+    if(ilTop < ilBottom)
+        return true;
+
+    // last item, race against thieves
+    const bool bWon = gptAtomics->compare_exchange(ptDeque->ptTop, ilTop, ilTop + 1);
+    gptAtomics->store(ptDeque->ptBottom, ilBottom + 1);
+    return bWon;
 }
 
 static bool
-pl__pop_batch_off_queue(plSubmittedBatch* ptBatchOut)
+pl__job_deque_steal(plJobDeque* ptDeque, plSubmittedBatch* ptBatchOut)
 {
-    bool bHasBatch = false;
+    const int64_t ilTop = gptAtomics->load(ptDeque->ptTop);
+    const int64_t ilBottom = gptAtomics->load(ptDeque->ptBottom);
+    if(ilTop >= ilBottom)
+        return false;
+
+    // copy before claiming; slot can't be reused by owner until top moves
+    plSubmittedBatch tBatch = ptDeque->atBatches[ilTop & (PL_JOB_DEQUE_CAPACITY - 1)];
+    if(!gptAtomics->compare_exchange(ptDeque->ptTop, ilTop, ilTop + 1))
+        return false;
+    *ptBatchOut = tBatch;
+    return true;
+}
 
-    // try to unlock (spin lock)
-    while(true)
+// only steals the top batch if it belongs to the counter
+static bool
+pl__job_deque_steal_counter_batch(plJobDeque* ptDeque, const plJobCounter* ptCounter, plSubmittedBatch* ptBatchOut)
+{
+    const int64_t ilTop = gptAtomics->load(ptDeque->ptTop);
+    const int64_t ilBottom = gptAtomics->load(ptDeque->ptBottom);
+    if(ilTop >= ilBottom)
+        return false;
+
+    plSubmittedBatch tBatch = ptDeque->atBatches[ilTop & (PL_JOB_DEQUE_CAPACITY - 1)];
+    if(tBatch.ptCounter != ptCounter)
+        return false;
+    if(!gptAtomics->compare_exchange(ptDeque->ptTop, ilTop, ilTop + 1))
+        return false;
+    *ptBatchOut = tBatch;
+    return true;
+}
+
+static inline bool
+pl__job_deque_empty(plJobDeque* ptDeque)
+{
+    return gptAtomics->load(ptDeque->ptTop) >= gptAtomics->load(ptDeque->ptBottom);
+}
+
+static inline bool
+pl__job_is_worker_thread(void)
+{
+    return gptJobCurrentWorker != NULL;
+}
+
+// worker with local deques (work stealing mode only)
+static inline plJobWorker*
+pl__job_current_worker(void)
+{
+    if(!(gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING))
+        return NULL;
+    return gptJobCurrentWorker;
+}
+
+static inline uint32_t
+pl__job_next_random(uint32_t* puState)
+{
+    uint32_t uX = *puState;
+    uX ^= uX << 13;
+    uX ^= uX >> 17;
+    uX ^= uX << 5;
+    *puState = uX;
+    return uX;
+}
+
+static bool
+pl__job_steal(plJobPriority ePriority, uint32_t uThiefIndex, uint32_t* puRandomState, plSubmittedBatch* ptBatchOut)
+{
+    const uint32_t uThreadCount = gptJobCtx->uThreadCount;
+    const uint32_t uStart = pl__job_next_random(puRandomState) % uThreadCount;
+    for(uint32_t i = 0; i < uThreadCount; i++)
     {
-        if(gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
+        const uint32_t uVictim = (uStart + i) % uThreadCount;
+        if(uVictim == uThiefIndex)
+            continue;
+        if(pl__job_deque_steal(&gptJobCtx->atWorkers[uVictim].atDeques[ePriority], ptBatchOut))
+            return true;
+    }
+    return false;
+}
+
+// moves a chunk of a shared lane queue into the worker's deque (returning
+// the first batch) so other workers steal from it instead of hitting the latch
+static bool
+pl__job_take_from_shared_queue(plJobPriority ePriority, plJobWorker* ptWorker, plSubmittedBatch* ptBatchOut)
+{
+    plJobQueue* ptQueue = &gptJobCtx->atQueues[ePriority];
+    if(ptQueue->uBatchCount == 0) // racy peek, avoids latch traffic for empty lanes
+        return false;
+
+    // try lock only, idle workers steal instead of spinning here
+    if(!gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
+        return false;
+
+    bool bHasBatch = false;
+    if(ptQueue->uBatchCount != 0)
+    {
+        pl__job_pop_from_queue(ptQueue, ptBatchOut);
+        bHasBatch = true;
+
+        if(ptWorker && ePriority != PL_JOB_PRIORITY_BACKGROUND)
         {
-            if(gptJobCtx->uBatchCount != 0)
+            uint32_t uGrabCount = ptQueue->uBatchCount / gptJobCtx->uThreadCount;
+            if(uGrabCount > PL_JOB_SHARED_QUEUE_GRAB)
+                uGrabCount = PL_JOB_SHARED_QUEUE_GRAB;
+
+            plSubmittedBatch tBatch = {0};
+            for(uint32_t i = 0; i < uGrabCount; i++)
             {
-                *ptBatchOut = gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex];
-                gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex].pData = NULL;
-                gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex].task = NULL;
-                gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex].ptCounter = NULL;
-                gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex].tInvocationData.uBatchSize = UINT32_MAX;
-                gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex].tInvocationData.uGlobalIndex = UINT32_MAX;
-                gptJobCtx->sbtBatches[gptJobCtx->uFrontIndex].tInvocationData.uBatchIndex = UINT32_MAX;
-                gptJobCtx->uFrontIndex--;
-                if(gptJobCtx->uFrontIndex == UINT32_MAX) // wrap
-                    gptJobCtx->uFrontIndex = gptJobCtx->uBatchCapacity - 1;
-
-                // update total job count
-                gptJobCtx->uBatchCount--;
-                bHasBatch = true;
+                pl__job_pop_from_queue(ptQueue, &tBatch);
+                if(!pl__job_deque_push(&ptWorker->atDeques[ePriority], &tBatch))
+                {
+                    pl__job_push_to_queue(ptQueue, &tBatch); // can't grow, just popped
+                    break;
+                }
             }
-            break;
         }
     }
+    pl__job_unlock_queue();
+    return bHasBatch;
+}
 
-    // unlock
-    gptAtomics->store(gptJobCtx->ptQueueLatch, 0);
+// frame lanes (high, normal): own deque -> shared queue -> steal; background
+// lane only for workers & only while below the background thread cap
+static bool
+pl__job_find_batch(plJobWorker* ptWorker, bool bAllowBackground, uint32_t* puRandomState, plSubmittedBatch* ptBatchOut)
+{
+    for(uint32_t i = 0; i < PL__JOB_DEQUE_LANE_COUNT; i++)
+    {
+        const plJobPriority ePriority = gaeJobLaneOrder[i];
+        if(ptWorker && pl__job_deque_pop(&ptWorker->atDeques[ePriority], ptBatchOut))
+            return true;
 
-    return bHasBatch;
+        if(pl__job_take_from_shared_queue(ePriority, ptWorker, ptBatchOut))
+            return true;
+
+        if(pl__job_steal(ePriority, ptWorker ? ptWorker->uIndex : UINT32_MAX, puRandomState, ptBatchOut))
+            return true;
+    }
+
+    if(bAllowBackground && gptJobCtx->atQueues[PL_JOB_PRIORITY_BACKGROUND].uBatchCount > 0 && pl__job_try_begin_background())
+    {
+        if(pl__job_take_from_shared_queue(PL_JOB_PRIORITY_BACKGROUND, ptWorker, ptBatchOut))
+            return true;
+        pl__job_end_background();
+    }
+    return false;
 }
 
-static void
-pl__maybe_grow_batch_capacity(uint32_t uJobCount)
+// help while waiting: prefer batches of the awaited counter so the waiter
+// doesn't get stuck in unrelated (possibly long) work
+static bool
+pl__job_find_counter_batch(plJobWorker* ptWorker, const plJobCounter* ptCounter, plSubmittedBatch* ptBatchOut)
 {
-    gptJobCtx->uBatchCount += uJobCount;
-    if(gptJobCtx->uBatchCount < gptJobCtx->uBatchCapacity)
-        return;
+    // local deques are LIFO, newest batches are usually the ones we wait on
+    if(ptWorker)
+    {
+        for(uint32_t i = 0; i < PL__JOB_DEQUE_LANE_COUNT; i++)
+        {
+            if(pl__job_deque_pop(&ptWorker->atDeques[gaeJobLaneOrder[i]], ptBatchOut))
+                return true;
+        }
+    }
 
-    const uint32_t uNewJobsNeeded = gptJobCtx->uBatchCount - gptJobCtx->uBatchCapacity;
-    pl_sb_resize(gptJobCtx->sbtBatches, gptJobCtx->uBatchCapacity + uNewJobsNeeded);
+    if(pl__job_take_counter_batch_from_queue(ptCounter, ptBatchOut))
+        return true;
 
-    for(uint32_t i = 0; i < uNewJobsNeeded; i++)
+    if(gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING)
     {
-        gptJobCtx->sbtBatches[gptJobCtx->uBatchCapacity + i].task = NULL;
-        gptJobCtx->sbtBatches[gptJobCtx->uBatchCapacity + i].pData = NULL;
-        gptJobCtx->sbtBatches[gptJobCtx->uBatchCapacity + i].tInvocationData.uBatchIndex = UINT32_MAX;
-        gptJobCtx->sbtBatches[gptJobCtx->uBatchCapacity + i].tInvocationData.uGlobalIndex = UINT32_MAX;
-        gptJobCtx->sbtBatches[gptJobCtx->uBatchCapacity + i].tInvocationData.uBatchSize = UINT32_MAX;
-        gptJobCtx->sbtBatches[gptJobCtx->uBatchCapacity + i].tInvocationData.szSharedMemorySize = gptJobCtx->szSharedMemorySize;
+        for(uint32_t i = 0; i < gptJobCtx->uThreadCount; i++)
+        {
+            if(ptWorker && ptWorker->uIndex == i)
+                continue;
+            for(uint32_t j = 0; j < PL__JOB_DEQUE_LANE_COUNT; j++)
+            {
+                if(pl__job_deque_steal_counter_batch(&gptJobCtx->atWorkers[i].atDeques[j], ptCounter, ptBatchOut))
+                    return true;
+            }
+        }
     }
+    return false;
+}
+
+// used before sleeping (with critical section held) to avoid lost wakeups
+static bool
+pl__job_has_pending_work(void)
+{
+    pl__job_lock_queue();
+    bool bSharedWork = gptJobCtx->atQueues[PL_JOB_PRIORITY_HIGH].uBatchCount > 0 || gptJobCtx->atQueues[PL_JOB_PRIORITY_NORMAL].uBatchCount > 0;
 
-    gptJobCtx->uBatchCapacity += uNewJobsNeeded;
+    // background work only counts if this worker would be allowed to run it
+    if(gptJobCtx->atQueues[PL_JOB_PRIORITY_BACKGROUND].uBatchCount > 0 && gptAtomics->load(gptJobCtx->ptActiveBackground) < (int64_t)gptJobCtx->uMaxBackgroundThreads)
+        bSharedWork = true;
+    pl__job_unlock_queue();
+    if(bSharedWork)
+        return true;
+
+    for(uint32_t i = 0; i < gptJobCtx->uThreadCount; i++)
+    {
+        for(uint32_t j = 0; j < PL__JOB_DEQUE_LANE_COUNT; j++)
+        {
+            if(!pl__job_deque_empty(&gptJobCtx->atWorkers[i].atDeques[j]))
+                return true;
+        }
+    }
+    return false;
+}
+
+static void
+pl__job_wake_workers(uint32_t uBatchCount)
+{
+    if(!(gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING))
+    {
+        gptThreads->wake_all_condition_variable(gptJobCtx->ptConditionVariable);
+        return;
+    }
+
+    // workers increment this with the critical section held before their
+    // final work check, so either they see the new work or we see them
+    if(gptAtomics->load(gptJobCtx->ptSleepingCount) == 0)
+        return;
+
+    gptThreads->enter_critical_section(gptJobCtx->ptCriticalSection);
+    int64_t ilSleeping = gptAtomics->load(gptJobCtx->ptSleepingCount);
+    if((int64_t)uBatchCount < ilSleeping)
+        ilSleeping = (int64_t)uBatchCount;
+    for(int64_t i = 0; i < ilSleeping; i++)
+        gptThreads->wake_condition_variable(gptJobCtx->ptConditionVariable);
+    gptThreads->leave_critical_section(gptJobCtx->ptCriticalSection);
 }
 
 static void*
 pl__thread_procedure(void* pData)
 {
-    
+    plJobWorker* ptWorker = pData;
+
+    gptJobCurrentWorker = ptWorker;
+    const bool bWorkStealing = (gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING) != 0;
+
     plSubmittedBatch tBatch = {0};
 
     // allocate thread local storage data for groups
@@ -230,239 +880,369 @@ pl__thread_procedure(void* pData)
 
     while(gptJobCtx->bRunning)
     {
-        
-        // check for available batch
-        if(pl__pop_batch_off_queue(&tBatch))
-        {
-            // run tasks
-            plInvocationData tInvocationData = tBatch.tInvocationData;
-            for(uint32_t i = 0; i < tBatch.tInvocationData.uBatchSize; i++)
-            {
-                // set per job invocation members
-                tInvocationData.uLocalIndex = i;
-                tInvocationData.uGlobalIndex = tBatch.tInvocationData.uGlobalIndex + i;
-
-                // run actual job
-                tBatch.task(tInvocationData, tBatch.pData, pThreadLocalData);
-            }
 
-            // decrement atomic counter
-            if(tBatch.ptCounter)
-                gptAtomics->decrement(tBatch.ptCounter);
+        // check for available batch
+        bool bHasBatch = false;
+        if(bWorkStealing)
+            bHasBatch = pl__job_find_batch(ptWorker, true, &ptWorker->uRandomState, &tBatch);
+        else
+            bHasBatch = pl__pop_batch_off_queue(true, &tBatch);
 
+        if(bHasBatch)
+        {
+            pl__job_run_batch(&tBatch, pThreadLocalData);
+            if(tBatch.ePriority == PL_JOB_PRIORITY_BACKGROUND)
+                pl__job_end_background();
+        }
+        else if(bWorkStealing)
+        {
+            // sleep thread (only if nothing showed up while getting ready)
+            gptThreads->enter_critical_section(gptJobCtx->ptCriticalSection);
+            gptAtomics->increment(gptJobCtx->ptSleepingCount);
+            if(gptJobCtx->bRunning && !pl__job_has_pending_work())
+                gptThreads->sleep_condition_variable(gptJobCtx->ptConditionVariable, gptJobCtx->ptCriticalSection);
+            gptAtomics->decrement(gptJobCtx->ptSleepingCount);
+            gptThreads->leave_critical_section(gptJobCtx->ptCriticalSection);
         }
         else // no jobs
         {
             // sleep thread based on conditional variable (to be awaken once new jobs are pushed onto queue)
             gptThreads->enter_critical_section(gptJobCtx->ptCriticalSection);
-            gptThreads->sleep_condition_variable(gptJobCtx->ptConditionVariable, gptJobCtx->ptCriticalSection);
+            if(gptJobCtx->bRunning)
+                gptThreads->sleep_condition_variable(gptJobCtx->ptConditionVariable, gptJobCtx->ptCriticalSection);
             gptThreads->leave_critical_section(gptJobCtx->ptCriticalSection);
         }
     }
 
     if(gptJobCtx->szSharedMemorySize > 0)
         gptThreads->free_thread_local_data(gptJobCtx->ptThreadLocalKey, pThreadLocalData);
+    gptJobCurrentWorker = NULL;
     return NULL;
 }
 
 //-----------------------------------------------------------------------------
-// [SECTION] implementation
+// [SECTION] submission
 //-----------------------------------------------------------------------------
 
-void
-pl_job_dispatch_jobs(uint32_t uJobCount, plJobDesc* ptJobs, plAtomicCounter** pptCounter)
+// pushes batches to local deque of their lane if called from a worker (work
+// stealing mode), otherwise (background, or once full) to the shared queues
+static void
+pl__job_submit(const plJobSubmission* ptSubmission)
 {
+    plJobWorker* ptWorker = pl__job_current_worker();
 
-    plAtomicCounter* ptCounter = NULL;
+    // lane depth must be raised before batches become visible
+    if(ptSubmission->ptJobs)
+    {
+        for(uint32_t i = 0; i < ptSubmission->uBatchCount; i++)
+            gptAtomics->increment(gptJobCtx->aptLaneDepth[ptSubmission->ptJobs[i].ePriority]);
+    }
+    else
+        pl__job_atomic_add(gptJobCtx->aptLaneDepth[ptSubmission->tJobDesc.ePriority], (int64_t)ptSubmission->uBatchCount);
 
-    // try to unlock (spin lock)
-    while(true)
+    uint32_t uBatchIndex = 0;
+    if(ptWorker)
     {
-        if(gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
+        for(; uBatchIndex < ptSubmission->uBatchCount; uBatchIndex++)
         {
-
-            if(pptCounter)
-            {
-                // get free atomic counter node
-                uint32_t uNode = gptJobCtx->uFreeList;
-                pl__job_remove_node_from_freelist(uNode);
-                
-                ptCounter = gptJobCtx->sbtNodes[uNode].ptCounter;
-                *pptCounter = ptCounter;
-
-                // store job count into counter
-                gptAtomics->store(ptCounter, (uint64_t)uJobCount);
-            }
-
-            // set total job count in queue
-            pl__maybe_grow_batch_capacity(uJobCount);
-
-            // push jobs into queue
-            for(uint32_t i = 0; i < uJobCount; i++)
-            {
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].task = ptJobs[i].task;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].pData = ptJobs[i].pData;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].ptCounter = ptCounter;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uBatchIndex = 0;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uGlobalIndex = i;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uBatchSize = 1;
-                gptJobCtx->uBackIndex--;
-                if(gptJobCtx->uBackIndex == UINT32_MAX) // wrap around
-                    gptJobCtx->uBackIndex = gptJobCtx->uBatchCapacity - 1;
-            }
-            break;
+            const plSubmittedBatch tBatch = pl__job_make_batch(ptSubmission, uBatchIndex);
+            if(tBatch.ePriority == PL_JOB_PRIORITY_BACKGROUND)
+                break;
+            if(!pl__job_deque_push(&ptWorker->atDeques[tBatch.ePriority], &tBatch))
+                break;
         }
     }
 
-    // unlock
-    gptAtomics->store(gptJobCtx->ptQueueLatch, 0);
+    if(uBatchIndex < ptSubmission->uBatchCount)
+    {
+        pl__job_lock_queue();
+        for(; uBatchIndex < ptSubmission->uBatchCount; uBatchIndex++)
+        {
+            const plSubmittedBatch tBatch = pl__job_make_batch(ptSubmission, uBatchIndex);
+            pl__job_push_to_queue(&gptJobCtx->atQueues[tBatch.ePriority], &tBatch);
+        }
+        pl__job_unlock_queue();
+    }
 
     // wake any sleeping threads
-    gptThreads->wake_all_condition_variable(gptJobCtx->ptConditionVariable);
+    pl__job_wake_workers(ptSubmission->uBatchCount);
+
+    if(!pl__job_is_worker_thread())
+        pl__job_update_stats();
 }
 
-void
-pl_job_dispatch_batch(uint32_t uJobCount, uint32_t uGroupSize, plJobDesc tJobDesc, plAtomicCounter** pptCounter)
+//-----------------------------------------------------------------------------
+// [SECTION] job graphs
+//-----------------------------------------------------------------------------
+
+static void pl__job_submit_graph_node(plJobGraph*, uint32_t uNode);
+
+static void
+pl__job_complete_graph_node(plJobGraph* ptGraph, uint32_t uNode)
 {
+    plJobGraphNode* ptNode = &ptGraph->sbtNodes[uNode];
 
-    if(uJobCount == 0)
-        return;
+    // release successors
+    const uint32_t uSuccessorCount = pl_sb_size(ptNode->sbuSuccessors);
+    for(uint32_t i = 0; i < uSuccessorCount; i++)
+    {
+        const uint32_t uSuccessor = ptNode->sbuSuccessors[i];
+        if(gptAtomics->decrement(ptGraph->sbtNodes[uSuccessor].ptPendingPredecessors) == 1)
+            pl__job_submit_graph_node(ptGraph, uSuccessor);
+    }
 
-    plAtomicCounter* ptCounter = NULL;
+    // graph must not be touched once last node signals the user counter
+    plJobCounter* ptCounter = ptGraph->ptCounter;
+    if(gptAtomics->decrement(ptGraph->ptPendingNodes) == 1 && ptCounter)
+        gptAtomics->decrement(ptCounter->ptValue);
+}
 
-    // find optimal group size
-    if(uGroupSize == 0)
+static void
+pl__job_complete_graph_batch(plJobGraph* ptGraph, uint32_t uNode)
+{
+    if(gptAtomics->decrement(ptGraph->sbtNodes[uNode].ptPendingBatches) == 1)
+        pl__job_complete_graph_node(ptGraph, uNode);
+}
+
+static void
+pl__job_submit_graph_node(plJobGraph* ptGraph, uint32_t uNode)
+{
+    plJobGraphNode* ptNode = &ptGraph->sbtNodes[uNode];
+
+    plJobSubmission tSubmission = {
+        .uJobCount  = ptNode->uJobCount,
+        .ptCounter  = ptGraph->ptCounter, // lets waiters find graph batches
+        .ptGraph    = ptGraph,
+        .uGraphNode = uNode
+    };
+
+    if(ptNode->bJobArray)
     {
-        uGroupSize = (uint32_t)floorf((float)uJobCount / (float)gptJobCtx->uThreadCount);
+        tSubmission.ptJobs = ptNode->sbtJobs;
+        tSubmission.uBatchCount = ptNode->uJobCount;
+    }
+    else if(ptNode->uJobCount > 0)
+    {
+        tSubmission.tJobDesc = ptNode->tJobDesc;
+        tSubmission.uGroupSize = pl__job_resolve_group_size(ptNode->uJobCount, ptNode->uGroupSize);
+        tSubmission.uBatchCount = (ptNode->uJobCount + tSubmission.uGroupSize - 1) / tSubmission.uGroupSize;
+    }
 
-        // possible if job count is less than thread count
-        if(uGroupSize == 0)
-            uGroupSize = 1;
+    // empty nodes complete immediately
+    if(tSubmission.uBatchCount == 0)
+    {
+        pl__job_complete_graph_node(ptGraph, uNode);
+        return;
     }
 
-    if(uGroupSize > uJobCount)
-        uGroupSize = uJobCount;
+    gptAtomics->store(ptNode->ptPendingBatches, (int64_t)tSubmission.uBatchCount);
+    pl__job_submit(&tSubmission);
+}
 
-    // try to unlock (spin lock)
-    while(true)
+static uint32_t
+pl__job_add_graph_node(plJobGraph* ptGraph)
+{
+    plJobGraphNode tNode = {0};
+    gptAtomics->create_counter(0, &tNode.ptPendingPredecessors);
+    gptAtomics->create_counter(0, &tNode.ptPendingBatches);
+    pl_sb_push(ptGraph->sbtNodes, tNode);
+    return pl_sb_size(ptGraph->sbtNodes) - 1;
+}
+
+plJobGraph*
+pl_job_create_graph(void)
+{
+    plJobGraph* ptGraph = PL_ALLOC(sizeof(plJobGraph));
+    memset(ptGraph, 0, sizeof(plJobGraph));
+    gptAtomics->create_counter(0, &ptGraph->ptPendingNodes);
+    return ptGraph;
+}
+
+void
+pl_job_reset_graph(plJobGraph* ptGraph)
+{
+    PL_ASSERT(gptAtomics->load(ptGraph->ptPendingNodes) == 0 && "graph still running");
+
+    const uint32_t uNodeCount = pl_sb_size(ptGraph->sbtNodes);
+    for(uint32_t i = 0; i < uNodeCount; i++)
     {
-        if(gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
-        {
-            
-            uint32_t uBatches = (uint32_t)floorf((float)uJobCount / (float)uGroupSize);
-            uint32_t uLeftOverJobs = uJobCount % uGroupSize;
+        plJobGraphNode* ptNode = &ptGraph->sbtNodes[i];
+        pl_sb_free(ptNode->sbtJobs);
+        pl_sb_free(ptNode->sbuSuccessors);
+        gptAtomics->destroy_counter(&ptNode->ptPendingPredecessors);
+        gptAtomics->destroy_counter(&ptNode->ptPendingBatches);
+    }
+    pl_sb_reset(ptGraph->sbtNodes);
+}
 
-            if(pptCounter)
-            {
-                uint32_t uNode = gptJobCtx->uFreeList;
-                pl__job_remove_node_from_freelist(uNode);
-                ptCounter = gptJobCtx->sbtNodes[uNode].ptCounter;
-                *pptCounter = ptCounter;
-                gptAtomics->store(ptCounter, (uint64_t)uBatches + (uLeftOverJobs > 0 ? 1 : 0));
-            }
+void
+pl_job_destroy_graph(plJobGraph* ptGraph)
+{
+    if(ptGraph == NULL)
+        return;
+    pl_job_reset_graph(ptGraph);
+    pl_sb_free(ptGraph->sbtNodes);
+    gptAtomics->destroy_counter(&ptGraph->ptPendingNodes);
+    PL_FREE(ptGraph);
+}
 
-            pl__maybe_grow_batch_capacity(uBatches + (uLeftOverJobs > 0 ? 1 : 0));
+uint32_t
+pl_job_add_graph_jobs(plJobGraph* ptGraph, uint32_t uJobCount, plJobDesc* ptJobs)
+{
+    const uint32_t uNode = pl__job_add_graph_node(ptGraph);
+    plJobGraphNode* ptNode = &ptGraph->sbtNodes[uNode];
+    ptNode->bJobArray = true;
+    ptNode->uJobCount = uJobCount;
+    pl_sb_resize(ptNode->sbtJobs, uJobCount);
+    if(uJobCount > 0)
+        memcpy(ptNode->sbtJobs, ptJobs, sizeof(plJobDesc) * uJobCount);
+    return uNode;
+}
 
-            // push batches into queue
-            for(uint32_t i = 0; i < uBatches; i++)
-            {
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].task = tJobDesc.task;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].pData = tJobDesc.pData;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].ptCounter = ptCounter;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uGlobalIndex = i * uGroupSize;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uBatchSize = uGroupSize;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uBatchIndex = i;
-                gptJobCtx->uBackIndex--;
-                if(gptJobCtx->uBackIndex == UINT32_MAX) // wrap around
-                    gptJobCtx->uBackIndex = gptJobCtx->uBatchCapacity - 1;
-            }
+uint32_t
+pl_job_add_graph_batch(plJobGraph* ptGraph, uint32_t uJobCount, uint32_t uGroupSize, plJobDesc tJobDesc)
+{
+    const uint32_t uNode = pl__job_add_graph_node(ptGraph);
+    plJobGraphNode* ptNode = &ptGraph->sbtNodes[uNode];
+    ptNode->tJobDesc = tJobDesc;
+    ptNode->uJobCount = uJobCount;
+    ptNode->uGroupSize = uGroupSize;
+    return uNode;
+}
 
-            if(uLeftOverJobs > 0)
-            {
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].task = tJobDesc.task;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].pData = tJobDesc.pData;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].ptCounter = ptCounter;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uGlobalIndex = uBatches * uGroupSize;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uBatchIndex = uBatches;
-                gptJobCtx->sbtBatches[gptJobCtx->uBackIndex].tInvocationData.uBatchSize = uLeftOverJobs;
-                gptJobCtx->uBackIndex--;
-                if(gptJobCtx->uBackIndex == UINT32_MAX) // wrap around
-                    gptJobCtx->uBackIndex = gptJobCtx->uBatchCapacity - 1; 
-            }
+void
+pl_job_add_graph_edge(plJobGraph* ptGraph, uint32_t uPredecessorNode, uint32_t uSuccessorNode)
+{
+    PL_ASSERT(uPredecessorNode < pl_sb_size(ptGraph->sbtNodes));
+    PL_ASSERT(uSuccessorNode < pl_sb_size(ptGraph->sbtNodes));
+    PL_ASSERT(uPredecessorNode != uSuccessorNode);
+    pl_sb_push(ptGraph->sbtNodes[uPredecessorNode].sbuSuccessors, uSuccessorNode);
+    ptGraph->sbtNodes[uSuccessorNode].uPredecessorCount++;
+}
 
-            break;
-        }
+void
+pl_job_dispatch_graph(plJobGraph* ptGraph, plJobCounter** pptCounter)
+{
+    PL_ASSERT(gptAtomics->load(ptGraph->ptPendingNodes) == 0 && "graph already dispatched");
+
+    const uint32_t uNodeCount = pl_sb_size(ptGraph->sbtNodes);
+
+    ptGraph->ptCounter = NULL;
+    if(pptCounter)
+    {
+        ptGraph->ptCounter = pl__job_acquire_counter(uNodeCount > 0 ? 1 : 0);
+        *pptCounter = ptGraph->ptCounter;
     }
 
-    // unlock
-    gptAtomics->store(gptJobCtx->ptQueueLatch, 0);
+    if(uNodeCount == 0)
+        return;
 
-    // wake any sleeping threads
-    gptThreads->wake_all_condition_variable(gptJobCtx->ptConditionVariable);
+    // reset all dependency counts before any node can complete
+    for(uint32_t i = 0; i < uNodeCount; i++)
+        gptAtomics->store(ptGraph->sbtNodes[i].ptPendingPredecessors, (int64_t)ptGraph->sbtNodes[i].uPredecessorCount);
+    gptAtomics->store(ptGraph->ptPendingNodes, (int64_t)uNodeCount);
+
+    // submit root nodes
+    for(uint32_t i = 0; i < uNodeCount; i++)
+    {
+        if(ptGraph->sbtNodes[i].uPredecessorCount == 0)
+            pl__job_submit_graph_node(ptGraph, i);
+    }
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] implementation
+//-----------------------------------------------------------------------------
+
 void
-pl_job_wait_for_counter(plAtomicCounter* ptCounter)
+pl_job_dispatch_jobs(uint32_t uJobCount, plJobDesc* ptJobs, plJobCounter** pptCounter)
 {
-    if(ptCounter == NULL)
+
+    if(uJobCount == 0)
         return;
-        
-    const uint32_t uValue = 0;
 
-    // wait for counter to reach value (or less)
-    while(true)
+    plJobSubmission tSubmission = {
+        .ptJobs      = ptJobs,
+        .uJobCount   = uJobCount,
+        .uBatchCount = uJobCount
+    };
+
+    if(pptCounter)
     {
-        const int64_t ilLoadedValue = gptAtomics->load(ptCounter);
-        if(ilLoadedValue <= (int64_t)uValue)
-            break;
+        tSubmission.ptCounter = pl__job_acquire_counter(uJobCount);
+        *pptCounter = tSubmission.ptCounter;
+    }
 
-        gptThreads->wake_condition_variable(gptJobCtx->ptConditionVariable);
+    pl__job_submit(&tSubmission);
+}
 
-        // check for available batch (instead of wasting main thread)
-        plSubmittedBatch tBatch = {0};
-        if(pl__pop_batch_off_queue(&tBatch))
-        {
-            // run tasks
-            plInvocationData tInvocationData = tBatch.tInvocationData;
-            for(uint32_t i = 0; i < tBatch.tInvocationData.uBatchSize; i++)
-            {
-                // set per job invocation members
-                tInvocationData.uLocalIndex = i;
-                tInvocationData.uGlobalIndex = tBatch.tInvocationData.uGlobalIndex + i;
+void
+pl_job_dispatch_batch(uint32_t uJobCount, uint32_t uGroupSize, plJobDesc tJobDesc, plJobCounter** pptCounter)
+{
 
-                // run actual job
-                tBatch.task(tInvocationData, tBatch.pData, gptJobCtx->pThreadLocalData);
-            }
+    if(uJobCount == 0)
+        return;
 
-            // decrement atomic counter
-            if(tBatch.ptCounter)
-                gptAtomics->decrement(tBatch.ptCounter);
-        }
+    uGroupSize = pl__job_resolve_group_size(uJobCount, uGroupSize);
+
+    plJobSubmission tSubmission = {
+        .tJobDesc    = tJobDesc,
+        .uJobCount   = uJobCount,
+        .uGroupSize  = uGroupSize,
+        .uBatchCount = (uJobCount + uGroupSize - 1) / uGroupSize
+    };
+
+    if(pptCounter)
+    {
+        tSubmission.ptCounter = pl__job_acquire_counter(tSubmission.uBatchCount);
+        *pptCounter = tSubmission.ptCounter;
     }
 
-    // try to unlock (spin lock)
-    while(true)
+    pl__job_submit(&tSubmission);
+}
+
+void
+pl_job_wait_for_counter(plJobCounter* ptCounter)
+{
+    if(ptCounter == NULL)
+        return;
+
+    const bool bWorkStealing = (gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING) != 0;
+    plJobWorker* ptWorker = pl__job_current_worker();
+    uint32_t uRandomState = (uint32_t)(uintptr_t)ptCounter | 1;
+    void* pThreadLocalData = gptJobCtx->pThreadLocalData;
+    if(pl__job_is_worker_thread() && gptJobCtx->szSharedMemorySize > 0)
+        pThreadLocalData = gptThreads->get_thread_local_data(gptJobCtx->ptThreadLocalKey);
+
+    // wait for counter to reach 0
+    while(gptAtomics->load(ptCounter->ptValue) > 0)
     {
-        if(gptAtomics->compare_exchange(gptJobCtx->ptQueueLatch, 0, 1))
+
+        // help with awaited batches first, then other frame work (instead of
+        // wasting thread), never unrelated background work
+        plSubmittedBatch tBatch = {0};
+        if(pl__job_find_counter_batch(ptWorker, ptCounter, &tBatch))
         {
-            // find counter index & return to free list
-            bool bFound = false;
-            for(uint32_t i = 0; i < gptJobCtx->uBatchCapacity; i++)
-            {
-                if(gptJobCtx->sbtNodes[i].ptCounter == ptCounter)
-                {
-                    pl__job_add_node_to_freelist(i);
-                    bFound = true;
-                    break;
-                }
-            }
-            PL_ASSERT(bFound);
-            break;
+            pl__job_run_batch(&tBatch, pThreadLocalData);
+        }
+        else if(bWorkStealing)
+        {
+            if(pl__job_find_batch(ptWorker, false, &uRandomState, &tBatch))
+                pl__job_run_batch(&tBatch, pThreadLocalData);
+        }
+        else
+        {
+            gptThreads->wake_condition_variable(gptJobCtx->ptConditionVariable);
+            if(pl__pop_batch_off_queue(false, &tBatch))
+                pl__job_run_batch(&tBatch, pThreadLocalData);
         }
     }
 
-    // unlock
-    gptAtomics->store(gptJobCtx->ptQueueLatch, 0);
+    // return counter to pool
+    pl__job_release_counter(ptCounter);
+
+    if(!pl__job_is_worker_thread())
+        pl__job_update_stats();
 }
 
 bool
@@ -471,6 +1251,12 @@ pl_job_is_shutting_down(void)
     return !gptJobCtx->bRunning;
 }
 
+size_t
+pl_job_get_shared_memory_size(void)
+{
+    return gptJobCtx->bRunning ? gptJobCtx->szSharedMemorySize : 0;
+}
+
 void
 pl_job_initialize(plJobSystemInit tInit)
 {
@@ -488,30 +1274,35 @@ pl_job_initialize(plJobSystemInit tInit)
     if(tInit.uThreadCount > uHardwareThreadCount)
         tInit.uThreadCount = uHardwareThreadCount - 1;
 
+    if(tInit.uThreadCount == 0)
+        tInit.uThreadCount = 1;
+
     gptJobCtx->szSharedMemorySize = tInit.szSharedMemorySize;
+    gptJobCtx->eFlags = tInit.eFlags;
 
     PL_ASSERT(tInit.uThreadCount < PL_MAX_JOB_THREADS);
     gptJobCtx->bRunning = true;
     gptJobCtx->uThreadCount = tInit.uThreadCount;
     gptAtomics->create_counter(0, &gptJobCtx->ptQueueLatch);
+    gptAtomics->create_counter(0, &gptJobCtx->ptSleepingCount);
     gptThreads->create_condition_variable(&gptJobCtx->ptConditionVariable);
     gptThreads->create_critical_section(&gptJobCtx->ptCriticalSection);
 
-    gptJobCtx->uBatchCapacity = 128;
-    pl_sb_resize(gptJobCtx->sbtNodes, gptJobCtx->uBatchCapacity);
-    pl_sb_resize(gptJobCtx->sbtBatches, gptJobCtx->uBatchCapacity);
-    for(uint32_t i = 0; i < gptJobCtx->uBatchCapacity; i++)
+    for(uint32_t i = 0; i < PL_JOB_PRIORITY_COUNT; i++)
     {
-        gptJobCtx->sbtBatches[i].task = NULL;
-        gptJobCtx->sbtBatches[i].pData = NULL;
-        gptJobCtx->sbtBatches[i].tInvocationData.uBatchIndex = UINT32_MAX;
-        gptJobCtx->sbtBatches[i].tInvocationData.uGlobalIndex = UINT32_MAX;
-        gptJobCtx->sbtBatches[i].tInvocationData.uBatchSize = UINT32_MAX;
-        gptJobCtx->sbtBatches[i].tInvocationData.szSharedMemorySize = tInit.szSharedMemorySize;
-        gptAtomics->create_counter(0, &gptJobCtx->sbtNodes[i].ptCounter);
-        gptJobCtx->sbtNodes[i].uNextNode = i + 1;
+        pl__job_init_queue(&gptJobCtx->atQueues[i]);
+        gptAtomics->create_counter(0, &gptJobCtx->aptLaneDepth[i]);
     }
-    gptJobCtx->uFreeList = 0;
+
+    // background work never occupies every worker
+    gptJobCtx->uMaxBackgroundThreads = tInit.uMaxBackgroundThreads;
+    if(gptJobCtx->uMaxBackgroundThreads == 0 || gptJobCtx->uMaxBackgroundThreads >= tInit.uThreadCount)
+        gptJobCtx->uMaxBackgroundThreads = tInit.uThreadCount > 1 ? tInit.uThreadCount / 2 : 1;
+    gptAtomics->create_counter(0, &gptJobCtx->ptActiveBackground);
+
+    // empty counter pool (index UINT32_MAX), first block allocated here
+    gptAtomics->create_counter((int64_t)UINT32_MAX, &gptJobCtx->ptFreeCounterHead);
+    pl__job_grow_counter_pool();
 
     // allocate thread local key if needed
     if(gptJobCtx->szSharedMemorySize > 0)
@@ -523,22 +1314,58 @@ pl_job_initialize(plJobSystemInit tInit)
         memset(gptJobCtx->pThreadLocalData, 0, gptJobCtx->szSharedMemorySize);
     }
 
+    // worker deques must exist before any thread starts stealing
     for(uint32_t i = 0; i < tInit.uThreadCount; i++)
     {
-        gptThreads->create_thread(pl__thread_procedure, NULL, &gptJobCtx->aptThreads[i]);
+        plJobWorker* ptWorker = &gptJobCtx->atWorkers[i];
+        ptWorker->uIndex = i;
+        ptWorker->uRandomState = 2654435761u * (i + 1);
+        if(gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING)
+        {
+            for(uint32_t j = 0; j < PL__JOB_DEQUE_LANE_COUNT; j++)
+            {
+                plJobDeque* ptDeque = &ptWorker->atDeques[j];
+                gptAtomics->create_counter(0, &ptDeque->ptTop);
+                gptAtomics->create_counter(0, &ptDeque->ptBottom);
+                ptDeque->atBatches = PL_ALLOC(sizeof(plSubmittedBatch) * PL_JOB_DEQUE_CAPACITY);
+                memset(ptDeque->atBatches, 0, sizeof(plSubmittedBatch) * PL_JOB_DEQUE_CAPACITY);
+            }
+        }
+    }
+
+    for(uint32_t i = 0; i < tInit.uThreadCount; i++)
+    {
+        gptThreads->create_thread(pl__thread_procedure, &gptJobCtx->atWorkers[i], &gptJobCtx->aptThreads[i]);
     }
 }
 
 void
 pl_job_cleanup(void)
 {
+    gptThreads->enter_critical_section(gptJobCtx->ptCriticalSection);
     gptJobCtx->bRunning = false;
     gptThreads->wake_all_condition_variable(gptJobCtx->ptConditionVariable);
+    gptThreads->leave_critical_section(gptJobCtx->ptCriticalSection);
     for(uint32_t i = 0; i < gptJobCtx->uThreadCount; i++)
     {
         gptThreads->destroy_thread(&gptJobCtx->aptThreads[i]);
     }
 
+    if(gptJobCtx->eFlags & PL_JOB_SYSTEM_FLAGS_WORK_STEALING)
+    {
+        for(uint32_t i = 0; i < gptJobCtx->uThreadCount; i++)
+        {
+            for(uint32_t j = 0; j < PL__JOB_DEQUE_LANE_COUNT; j++)
+            {
+                plJobDeque* ptDeque = &gptJobCtx->atWorkers[i].atDeques[j];
+                gptAtomics->destroy_counter(&ptDeque->ptTop);
+                gptAtomics->destroy_counter(&ptDeque->ptBottom);
+                PL_FREE(ptDeque->atBatches);
+                ptDeque->atBatches = NULL;
+            }
+        }
+    }
+
     if(gptJobCtx->szSharedMemorySize > 0)
         gptThreads->free_thread_local_data(gptJobCtx->ptThreadLocalKey, gptJobCtx->pThreadLocalData);
 
@@ -547,23 +1374,28 @@ pl_job_cleanup(void)
         gptThreads->free_thread_local_key(&gptJobCtx->ptThreadLocalKey);
 
     gptAtomics->destroy_counter(&gptJobCtx->ptQueueLatch);
+    gptAtomics->destroy_counter(&gptJobCtx->ptSleepingCount);
     gptThreads->destroy_condition_variable(&gptJobCtx->ptConditionVariable);
     gptThreads->destroy_critical_section(&gptJobCtx->ptCriticalSection);
 
-    for(uint32_t i = 0; i < gptJobCtx->uBatchCapacity; i++)
+    for(uint32_t i = 0; i < gptJobCtx->uCounterBlockCount; i++)
     {
-        gptJobCtx->sbtBatches[i].task = NULL;
-        gptJobCtx->sbtBatches[i].pData = NULL;
-        gptJobCtx->sbtBatches[i].tInvocationData.uGlobalIndex = UINT32_MAX;
+        plJobCounter* atCounters = gptJobCtx->aptCounterBlocks[i];
+        for(uint32_t j = 0; j < PL_JOB_COUNTER_BLOCK_SIZE; j++)
+            gptAtomics->destroy_counter(&atCounters[j].ptValue);
+        PL_FREE(atCounters);
     }
+    gptAtomics->destroy_counter(&gptJobCtx->ptFreeCounterHead);
 
-    for(uint32_t i = 0; i < pl_sb_size(gptJobCtx->sbtNodes); i++)
+    for(uint32_t i = 0; i < PL_JOB_PRIORITY_COUNT; i++)
     {
-        gptAtomics->destroy_counter(&gptJobCtx->sbtNodes[i].ptCounter);
+        pl_sb_free(gptJobCtx->atQueues[i].sbtBatches);
+        gptAtomics->destroy_counter(&gptJobCtx->aptLaneDepth[i]);
     }
+    gptAtomics->destroy_counter(&gptJobCtx->ptActiveBackground);
 
-    pl_sb_free(gptJobCtx->sbtBatches);
-    pl_sb_free(gptJobCtx->sbtNodes);
+    // allow reinitialization (i.e. with different settings)
+    memset(gptJobCtx, 0, sizeof(plJobContext));
 }
 
 //-----------------------------------------------------------------------------
@@ -574,12 +1406,20 @@ void
 pl_load_job_ext(plApiRegistryI* ptApiRegistry, bool bReload)
 {
     const plJobI tApi = {
-        .initialize       = pl_job_initialize,
-        .cleanup          = pl_job_cleanup,
-        .wait_for_counter = pl_job_wait_for_counter,
-        .dispatch_jobs    = pl_job_dispatch_jobs,
-        .dispatch_batch   = pl_job_dispatch_batch,
-        .is_shutting_down = pl_job_is_shutting_down,
+        .initialize             = pl_job_initialize,
+        .cleanup                = pl_job_cleanup,
+        .wait_for_counter       = pl_job_wait_for_counter,
+        .dispatch_jobs          = pl_job_dispatch_jobs,
+        .dispatch_batch         = pl_job_dispatch_batch,
+        .is_shutting_down       = pl_job_is_shutting_down,
+        .create_graph           = pl_job_create_graph,
+        .destroy_graph          = pl_job_destroy_graph,
+        .reset_graph            = pl_job_reset_graph,
+        .add_graph_jobs         = pl_job_add_graph_jobs,
+        .add_graph_batch        = pl_job_add_graph_batch,
+        .add_graph_edge         = pl_job_add_graph_edge,
+        .dispatch_graph         = pl_job_dispatch_graph,
+        .get_shared_memory_size = pl_job_get_shared_memory_size,
     };
     pl_set_api(ptApiRegistry, plJobI, &tApi);
 
@@ -587,6 +1427,7 @@ pl_load_job_ext(plApiRegistryI* ptApiRegistry, bool bReload)
         gptMemory = pl_get_api_latest(ptApiRegistry, plMemoryI);
         gptAtomics = pl_get_api_latest(ptApiRegistry, plAtomicsI);
         gptThreads = pl_get_api_latest(ptApiRegistry, plThreadsI);
+        gptStats   = pl_get_api_latest(ptApiRegistry, plStatsI);
     #endif
     const plDataRegistryI* ptDataRegistry = pl_get_api_latest(ptApiRegistry, plDataRegistryI);
 
@@ -607,7 +1448,7 @@ pl_unload_job_ext(plApiRegistryI* ptApiRegistry, bool bReload)
 {
     if(bReload)
         return;
-        
+
     const plJobI* ptApi = pl_get_api_latest(ptApiRegistry, plJobI);
     ptApiRegistry->remove_api(ptApi);
-}
\ No newline at end of file
+}
@@ -13,6 +13,7 @@ Index of this file:
 // [SECTION] public api
 // [SECTION] public api struct
 // [SECTION] structs
+// [SECTION] enums
 */
 
 //-----------------------------------------------------------------------------
@@ -27,6 +28,32 @@ Index of this file:
 
         * plAtomicsI (v1.x)
         * plThreadsI (v1.x)
+
+    Scheduling:
+        By default, all submitted batches go into a single shared queue and
+        every dispatch wakes all worker threads. Setting
+        PL_JOB_SYSTEM_FLAGS_WORK_STEALING in plJobSystemInit switches to a
+        work stealing scheduler:
+
+        * each worker owns a Chase-Lev deque
+        * dispatches from worker threads (i.e. jobs launching jobs) go into
+          the local deque of that worker
+        * dispatches from other threads go into the shared queue where workers
+          pull them in small chunks
+        * idle workers steal from random victims before going to sleep
+        * only as many sleeping workers are woken as there are new batches
+
+    Priorities:
+        Each plJobDesc has a priority lane (plJobPriority). Workers always look
+        for high priority work first, then normal, then background. Background
+        work is meant for long running tasks (texture compression, BVH
+        rebuilds, asset decoding, etc.):
+
+        * at most "uMaxBackgroundThreads" workers run background batches at
+          the same time so frame work always has workers available
+        * threads waiting on a counter never pick up unrelated background work
+        * queued batches per lane are reported through plStatsI
+          ("job queue depth (high|normal|background)")
 */
 
 //-----------------------------------------------------------------------------
@@ -53,7 +80,7 @@ extern "C" {
 // [SECTION] APIs
 //-----------------------------------------------------------------------------
 
-#define plJobI_version {2, 3, 0}
+#define plJobI_version {3, 2, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations
@@ -63,9 +90,12 @@ extern "C" {
 typedef struct _plJobSystemInit  plJobSystemInit;
 typedef struct _plJobDesc        plJobDesc;
 typedef struct _plInvocationData plInvocationData;
+typedef struct _plJobGraph       plJobGraph;   // opaque
+typedef struct _plJobCounter     plJobCounter; // opaque (pooled by job system)
 
-// external
-typedef struct _plAtomicCounter plAtomicCounter; // pl_os.h
+// enums/flags
+typedef int plJobSystemFlags; // -> enum _plJobSystemFlags // Flags:
+typedef int plJobPriority;    // -> enum _plJobPriority    // Enum:
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api
@@ -80,25 +110,48 @@ PL_API void pl_job_initialize(plJobSystemInit);
 PL_API void pl_job_cleanup   (void);
 
 // typical usage
-//   - submit an array of job descriptions and receive an atomic counter pointer
-//   - pass NULL for the atomic counter pointer if you don't need to wait (fire & forget)
+//   - submit an array of job descriptions and receive a counter handle
+//   - pass NULL for the counter pointer if you don't need to wait (fire & forget)
 //   - use "wait_for_counter" to wait on jobs to complete and return counter for reuse
-PL_API void pl_job_dispatch_jobs(uint32_t jobCount, plJobDesc*, plAtomicCounter**);
+PL_API void pl_job_dispatch_jobs(uint32_t jobCount, plJobDesc*, plJobCounter**);
 
 // batch usage
 //   Follows more of a compute shader design. All jobs use the same data which can be indexed
 //   using the job index. If the jobs are small, consider increasing the group size.
 //   - jobCount  : how many jobs to generate
 //   - groupSize : how many jobs to execute per thread serially (set 0 for optimal group size)
-//   - pass NULL for the atomic counter pointer if you don't need to wait (fire & forget)
-PL_API void pl_job_dispatch_batch(uint32_t jobCount, uint32_t groupSize, plJobDesc, plAtomicCounter**);
+//   - pass NULL for the counter pointer if you don't need to wait (fire & forget)
+PL_API void pl_job_dispatch_batch(uint32_t jobCount, uint32_t groupSize, plJobDesc, plJobCounter**);
 
 // waits for counter to reach 0 and returns the counter for reuse by subsequent dispatches
-PL_API void pl_job_wait_for_counter(plAtomicCounter*);
+//   - the waiting thread runs batches while waiting, preferring the ones of this counter
+//   - every counter received must be waited on exactly once
+PL_API void pl_job_wait_for_counter(plJobCounter*);
 
 // long running jobs should check this & exit themselves
 PL_API bool pl_job_is_shutting_down(void);
 
+// size of the per thread "groupSharedMemory" block passed to tasks (0 if none)
+PL_API size_t pl_job_get_shared_memory_size(void);
+
+// job graphs
+//   Declare jobs/batches as nodes & connect them with edges (predecessor -> successor).
+//   A node is submitted automatically once all its predecessors have completed so
+//   a whole frame's worth of work can be dispatched at once without the main thread
+//   waiting between stages.
+//   - graph must be acyclic
+//   - "add_graph_*" return the node index used for edges
+//   - a graph can be dispatched again (i.e. every frame) once the previous
+//     dispatch completed (use the counter from "dispatch_graph")
+//   - graph must not be modified or destroyed while dispatched
+PL_API plJobGraph* pl_job_create_graph   (void);
+PL_API void        pl_job_destroy_graph  (plJobGraph*);
+PL_API void        pl_job_reset_graph    (plJobGraph*); // removes all nodes & edges
+PL_API uint32_t    pl_job_add_graph_jobs (plJobGraph*, uint32_t jobCount, plJobDesc*);
+PL_API uint32_t    pl_job_add_graph_batch(plJobGraph*, uint32_t jobCount, uint32_t groupSize, plJobDesc);
+PL_API void        pl_job_add_graph_edge (plJobGraph*, uint32_t predecessorNode, uint32_t successorNode);
+PL_API void        pl_job_dispatch_graph (plJobGraph*, plJobCounter**); // counter reaches 0 when all nodes complete
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api struct
 //-----------------------------------------------------------------------------
@@ -107,10 +160,21 @@ typedef struct _plJobI
 {
     void (*initialize)      (plJobSystemInit); 
     void (*cleanup)         (void);
-    void (*dispatch_jobs)   (uint32_t jobCount, plJobDesc*, plAtomicCounter**);
-    void (*dispatch_batch)  (uint32_t jobCount, uint32_t groupSize, plJobDesc, plAtomicCounter**);
-    void (*wait_for_counter)(plAtomicCounter*);
+    void (*dispatch_jobs)   (uint32_t jobCount, plJobDesc*, plJobCounter**);
+    void (*dispatch_batch)  (uint32_t jobCount, uint32_t groupSize, plJobDesc, plJobCounter**);
+    void (*wait_for_counter)(plJobCounter*);
     bool (*is_shutting_down)(void);
+
+    // job graphs
+    plJobGraph* (*create_graph)   (void);
+    void        (*destroy_graph)  (plJobGraph*);
+    void        (*reset_graph)    (plJobGraph*);
+    uint32_t    (*add_graph_jobs) (plJobGraph*, uint32_t jobCount, plJobDesc*);
+    uint32_t    (*add_graph_batch)(plJobGraph*, uint32_t jobCount, uint32_t groupSize, plJobDesc);
+    void        (*add_graph_edge) (plJobGraph*, uint32_t predecessorNode, uint32_t successorNode);
+    void        (*dispatch_graph) (plJobGraph*, plJobCounter**);
+
+    size_t (*get_shared_memory_size)(void);
 } plJobI;
 
 //-----------------------------------------------------------------------------
@@ -119,8 +183,10 @@ typedef struct _plJobI
 
 typedef struct _plJobSystemInit
 {
-    uint32_t uThreadCount;       // set thread count to 0 to get optimal thread count
-    size_t   szSharedMemorySize; // default: 0
+    uint32_t         uThreadCount;          // set thread count to 0 to get optimal thread count
+    size_t           szSharedMemorySize;    // default: 0
+    plJobSystemFlags eFlags;
+    uint32_t         uMaxBackgroundThreads; // default: half of thread count (min 1)
 } plJobSystemInit;
 
 typedef struct _plInvocationData
@@ -136,8 +202,28 @@ typedef struct _plJobDesc
 {
     void (*task)(plInvocationData, void* data, void* groupSharedMemory); // NOTE: groupSharedMemory is not zeroed
     void* pData;
+    plJobPriority ePriority; // default: PL_JOB_PRIORITY_NORMAL
 } plJobDesc;
 
+//-----------------------------------------------------------------------------
+// [SECTION] enums
+//-----------------------------------------------------------------------------
+
+enum _plJobSystemFlags
+{
+    PL_JOB_SYSTEM_FLAGS_NONE          = 0,
+    PL_JOB_SYSTEM_FLAGS_WORK_STEALING = 1 << 0, // per worker deques + stealing instead of single shared queue
+};
+
+enum _plJobPriority
+{
+    PL_JOB_PRIORITY_NORMAL = 0,
+    PL_JOB_PRIORITY_HIGH,       // latency critical frame work (i.e. culling)
+    PL_JOB_PRIORITY_BACKGROUND, // long running work, never occupies all workers
+
+    PL_JOB_PRIORITY_COUNT
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,21 @@ Index of this file:
 
 #include "pl_ds.h"
 
+// stretchy buffers grow by the exact amount requested, so the mesh builder
+// reserves geometrically to keep appends amortized O(1)
+#define pl__mesh_sb_reserve(buf, n) \
+    do { \
+        const uint32_t _uRequired = pl_sb_size(buf) + (uint32_t)(n); \
+        const uint32_t _uCapacity = pl_sb_capacity(buf); \
+        if(_uRequired > _uCapacity) \
+        { \
+            uint32_t _uNewCapacity = _uCapacity < 16 ? 16 : _uCapacity * 2; \
+            if(_uNewCapacity < _uRequired) \
+                _uNewCapacity = _uRequired; \
+            pl_sb_reserve((buf), _uNewCapacity - pl_sb_size(buf)); \
+        } \
+    } while(0)
+
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
@@ -67,12 +82,21 @@ typedef struct _plMeshBuilderTriangle
     uint32_t uIndex2;
 } plMeshBuilderTriangle;
 
+typedef struct _plMeshBuilderGrid
+{
+    // vertices hashed by weld radius sized cell, chained through sbuNext
+    uint32_t* sbuBuckets; // power of 2 size, UINT32_MAX if empty
+    uint32_t* sbuNext;    // per vertex
+} plMeshBuilderGrid;
+
 typedef struct _plMeshBuilder
 {
     plMeshBuilderOptions   tOptions;
     plVec3*                sbtVertices;
     plVec3d*               sbtVerticesD;
     plMeshBuilderTriangle* sbtTriangles;
+    plMeshBuilderGrid      tGrid;  // sbtVertices
+    plMeshBuilderGrid      tGridD; // sbtVerticesD
 } plMeshBuilder;
 
 //-----------------------------------------------------------------------------
@@ -576,76 +600,204 @@ pl_mesh_builder_cleanup(plMeshBuilder* ptBuilder)
 {
     pl_sb_free(ptBuilder->sbtTriangles);
     pl_sb_free(ptBuilder->sbtVertices);
+    pl_sb_free(ptBuilder->sbtVerticesD);
+    pl_sb_free(ptBuilder->tGrid.sbuBuckets);
+    pl_sb_free(ptBuilder->tGrid.sbuNext);
+    pl_sb_free(ptBuilder->tGridD.sbuBuckets);
+    pl_sb_free(ptBuilder->tGridD.sbuNext);
     PL_FREE(ptBuilder);
 }
 
-void
-pl_mesh_builder_add_triangle(plMeshBuilder* ptBuilder, plVec3 tA, plVec3 tB, plVec3 tC)
+static inline uint32_t
+pl__mesh_builder_cell_hash(int64_t iX, int64_t iY, int64_t iZ)
 {
-    plMeshBuilderTriangle tTriangle;
-    tTriangle.uIndex0 = UINT32_MAX;
-    tTriangle.uIndex1 = UINT32_MAX;
-    tTriangle.uIndex2 = UINT32_MAX;
+    const uint64_t uHash = (uint64_t)iX * 73856093ull ^ (uint64_t)iY * 19349663ull ^ (uint64_t)iZ * 83492791ull;
+    return (uint32_t)(uHash ^ (uHash >> 32));
+}
 
-    const float fWeldRadiusSqr = ptBuilder->tOptions.fWeldRadius * ptBuilder->tOptions.fWeldRadius;
+static inline void
+pl__mesh_builder_cell(plVec3d tPoint, double dInvCellSize, int64_t* aiCellOut)
+{
+    aiCellOut[0] = (int64_t)floor(tPoint.x * dInvCellSize);
+    aiCellOut[1] = (int64_t)floor(tPoint.y * dInvCellSize);
+    aiCellOut[2] = (int64_t)floor(tPoint.z * dInvCellSize);
+}
 
-    const uint32_t uVertexCount = pl_sb_size(ptBuilder->sbtVertices);
+static void
+pl__mesh_builder_grid_insert(plMeshBuilderGrid* ptGrid, uint32_t uVertex, plVec3d tPoint, double dInvCellSize)
+{
+    int64_t aiCell[3];
+    pl__mesh_builder_cell(tPoint, dInvCellSize, aiCell);
+    const uint32_t uBucket = pl__mesh_builder_cell_hash(aiCell[0], aiCell[1], aiCell[2]) & (pl_sb_size(ptGrid->sbuBuckets) - 1);
+    ptGrid->sbuNext[uVertex] = ptGrid->sbuBuckets[uBucket];
+    ptGrid->sbuBuckets[uBucket] = uVertex;
+}
 
-    for(uint32_t i = 0; i < uVertexCount; i++)
+static void
+pl__mesh_builder_grid_reserve(plMeshBuilder* ptBuilder, plMeshBuilderGrid* ptGrid, uint32_t uVertexCount, bool bDouble)
+{
+    // keep at least one bucket per vertex (rehash on growth)
+    uint32_t uBucketCount = pl_sb_size(ptGrid->sbuBuckets);
+    if(uBucketCount >= uVertexCount && uBucketCount > 0)
+        return;
+
+    if(uBucketCount == 0)
+        uBucketCount = 1024;
+    while(uBucketCount < uVertexCount)
+        uBucketCount *= 2;
+
+    pl_sb_free(ptGrid->sbuBuckets); // exact size (stretchy buffers grow by the requested amount)
+    pl_sb_resize(ptGrid->sbuBuckets, uBucketCount);
+    memset(ptGrid->sbuBuckets, 0xFF, sizeof(uint32_t) * uBucketCount);
+
+    const double dInvCellSize = 1.0 / (double)ptBuilder->tOptions.fWeldRadius;
+    const uint32_t uExistingCount = pl_sb_size(ptGrid->sbuNext);
+    for(uint32_t i = 0; i < uExistingCount; i++)
     {
-        const plVec3* ptVertex = &ptBuilder->sbtVertices[i];
+        const plVec3d tPoint = bDouble ? ptBuilder->sbtVerticesD[i] : pl_create_vec3_d(ptBuilder->sbtVertices[i].x, ptBuilder->sbtVertices[i].y, ptBuilder->sbtVertices[i].z);
+        pl__mesh_builder_grid_insert(ptGrid, i, tPoint, dInvCellSize);
+    }
+}
 
-        if(tTriangle.uIndex0 == UINT32_MAX)
-        {
-            float fDist = pl_length_sqr_vec3(pl_sub_vec3(*ptVertex, tA));
+static uint32_t
+pl__mesh_builder_find_vertex(const plMeshBuilder* ptBuilder, const plMeshBuilderGrid* ptGrid, plVec3d tPoint, bool bDouble)
+{
+    // a vertex within the weld radius is at most one cell away on each axis;
+    // lowest index wins (same result as scanning all vertices in order)
+    if(pl_sb_size(ptGrid->sbuBuckets) == 0)
+        return UINT32_MAX;
 
-            if(fDist < fWeldRadiusSqr)
-                tTriangle.uIndex0 = i;
-        }
+    const double dInvCellSize = 1.0 / (double)ptBuilder->tOptions.fWeldRadius;
+    const uint32_t uBucketMask = pl_sb_size(ptGrid->sbuBuckets) - 1;
+    const float fWeldRadiusSqr = ptBuilder->tOptions.fWeldRadius * ptBuilder->tOptions.fWeldRadius;
+    const double dWeldRadiusSqr = (double)fWeldRadiusSqr;
+    const plVec3 tPointF = {(float)tPoint.x, (float)tPoint.y, (float)tPoint.z};
 
-        if(tTriangle.uIndex1 == UINT32_MAX)
-        {
-            float fDist = pl_length_sqr_vec3(pl_sub_vec3(*ptVertex, tB));
+    int64_t aiCell[3];
+    pl__mesh_builder_cell(tPoint, dInvCellSize, aiCell);
 
-            if(fDist < fWeldRadiusSqr)
-                tTriangle.uIndex1 = i;
-        }
+    uint32_t auVisited[27];
+    uint32_t uVisitedCount = 0;
 
-        if(tTriangle.uIndex2 == UINT32_MAX)
+    uint32_t uResult = UINT32_MAX;
+    for(int64_t iZ = aiCell[2] - 1; iZ <= aiCell[2] + 1; iZ++)
+    {
+        for(int64_t iY = aiCell[1] - 1; iY <= aiCell[1] + 1; iY++)
         {
-            float fDist = pl_length_sqr_vec3(pl_sub_vec3(*ptVertex, tC));
+            for(int64_t iX = aiCell[0] - 1; iX <= aiCell[0] + 1; iX++)
+            {
+                const uint32_t uBucket = pl__mesh_builder_cell_hash(iX, iY, iZ) & uBucketMask;
 
-            if(fDist < fWeldRadiusSqr)
-                tTriangle.uIndex2 = i;
-        }
+                // neighbouring cells may share a bucket
+                bool bVisited = false;
+                for(uint32_t i = 0; i < uVisitedCount; i++)
+                {
+                    if(auVisited[i] == uBucket)
+                    {
+                        bVisited = true;
+                        break;
+                    }
+                }
+                if(bVisited)
+                    continue;
+                auVisited[uVisitedCount++] = uBucket;
 
-        if(tTriangle.uIndex0 != UINT32_MAX &&
-           tTriangle.uIndex1 != UINT32_MAX &&
-           tTriangle.uIndex2 != UINT32_MAX)
-            break;
+                for(uint32_t uVertex = ptGrid->sbuBuckets[uBucket]; uVertex != UINT32_MAX; uVertex = ptGrid->sbuNext[uVertex])
+                {
+                    if(uVertex >= uResult)
+                        continue;
+
+                    if(bDouble)
+                    {
+                        if(pl_length_sqr_vec3_d(pl_sub_vec3_d(ptBuilder->sbtVerticesD[uVertex], tPoint)) < dWeldRadiusSqr)
+                            uResult = uVertex;
+                    }
+                    else
+                    {
+                        if(pl_length_sqr_vec3(pl_sub_vec3(ptBuilder->sbtVertices[uVertex], tPointF)) < fWeldRadiusSqr)
+                            uResult = uVertex;
+                    }
+                }
+            }
+        }
     }
+    return uResult;
+}
 
-    if(tTriangle.uIndex0 == UINT32_MAX)
-    {
-        tTriangle.uIndex0 = pl_sb_size(ptBuilder->sbtVertices);
-        pl_sb_push(ptBuilder->sbtVertices, tA);
-    }
+static void
+pl__mesh_builder_add_triangle(plMeshBuilder* ptBuilder, const plVec3d* atPoints, bool bDouble)
+{
+    plMeshBuilderGrid* ptGrid = bDouble ? &ptBuilder->tGridD : &ptBuilder->tGrid;
 
-    if(tTriangle.uIndex1 == UINT32_MAX)
-    {
-        tTriangle.uIndex1 = pl_sb_size(ptBuilder->sbtVertices);
-        pl_sb_push(ptBuilder->sbtVertices, tB);
-    }
+    // only weld against vertices from earlier triangles
+    uint32_t auIndices[3];
+    for(uint32_t i = 0; i < 3; i++)
+        auIndices[i] = pl__mesh_builder_find_vertex(ptBuilder, ptGrid, atPoints[i], bDouble);
 
-    if(tTriangle.uIndex2 == UINT32_MAX)
+    const double dInvCellSize = 1.0 / (double)ptBuilder->tOptions.fWeldRadius;
+    for(uint32_t i = 0; i < 3; i++)
     {
-        tTriangle.uIndex2 = pl_sb_size(ptBuilder->sbtVertices);
-        pl_sb_push(ptBuilder->sbtVertices, tC);
+        if(auIndices[i] != UINT32_MAX)
+            continue;
+
+        if(bDouble)
+        {
+            auIndices[i] = pl_sb_size(ptBuilder->sbtVerticesD);
+            pl__mesh_sb_reserve(ptBuilder->sbtVerticesD, 1);
+            pl_sb_push(ptBuilder->sbtVerticesD, atPoints[i]);
+        }
+        else
+        {
+            auIndices[i] = pl_sb_size(ptBuilder->sbtVertices);
+            pl__mesh_sb_reserve(ptBuilder->sbtVertices, 1);
+            pl_sb_push(ptBuilder->sbtVertices, pl_create_vec3((float)atPoints[i].x, (float)atPoints[i].y, (float)atPoints[i].z));
+        }
+        pl__mesh_builder_grid_reserve(ptBuilder, ptGrid, auIndices[i] + 1, bDouble); // rehashes existing vertices
+        pl__mesh_sb_reserve(ptGrid->sbuNext, 1);
+        pl_sb_push(ptGrid->sbuNext, UINT32_MAX);
+        pl__mesh_builder_grid_insert(ptGrid, auIndices[i], atPoints[i], dInvCellSize);
     }
 
+    const plMeshBuilderTriangle tTriangle = {
+        .uIndex0 = auIndices[0],
+        .uIndex1 = auIndices[1],
+        .uIndex2 = auIndices[2]
+    };
+    pl__mesh_sb_reserve(ptBuilder->sbtTriangles, 1);
     pl_sb_push(ptBuilder->sbtTriangles, tTriangle);
 }
 
+void
+pl_mesh_builder_add_triangle(plMeshBuilder* ptBuilder, plVec3 tA, plVec3 tB, plVec3 tC)
+{
+    const plVec3d atPoints[3] = {
+        pl_create_vec3_d(tA.x, tA.y, tA.z),
+        pl_create_vec3_d(tB.x, tB.y, tB.z),
+        pl_create_vec3_d(tC.x, tC.y, tC.z)
+    };
+    pl__mesh_builder_add_triangle(ptBuilder, atPoints, false);
+}
+
+void
+pl_mesh_builder_add_triangles(plMeshBuilder* ptBuilder, uint32_t uTriangleCount, const plVec3* atPositions)
+{
+    // worst case (nothing welds) reserved up front
+    pl__mesh_sb_reserve(ptBuilder->sbtTriangles, uTriangleCount);
+    pl__mesh_sb_reserve(ptBuilder->sbtVertices, uTriangleCount * 3);
+    pl__mesh_sb_reserve(ptBuilder->tGrid.sbuNext, uTriangleCount * 3);
+
+    for(uint32_t i = 0; i < uTriangleCount; i++)
+    {
+        const plVec3* ptTriangle = &atPositions[i * 3];
+        const plVec3d atPoints[3] = {
+            pl_create_vec3_d(ptTriangle[0].x, ptTriangle[0].y, ptTriangle[0].z),
+            pl_create_vec3_d(ptTriangle[1].x, ptTriangle[1].y, ptTriangle[1].z),
+            pl_create_vec3_d(ptTriangle[2].x, ptTriangle[2].y, ptTriangle[2].z)
+        };
+        pl__mesh_builder_add_triangle(ptBuilder, atPoints, false);
+    }
+}
+
 void
 pl_mesh_builder_commit(plMeshBuilder* ptBuilder, uint32_t* puIndexBuffer, plVec3* ptVertexBuffer, uint32_t* puIndexBufferCountOut, uint32_t* puVertexBufferCountOut)
 {
@@ -664,79 +816,28 @@ pl_mesh_builder_commit(plMeshBuilder* ptBuilder, uint32_t* puIndexBuffer, plVec3
         memcpy(ptVertexBuffer, ptBuilder->sbtVertices, uVertexCount * sizeof(plVec3));
         pl_sb_reset(ptBuilder->sbtTriangles);
         pl_sb_reset(ptBuilder->sbtVertices);
+        pl_sb_reset(ptBuilder->tGrid.sbuBuckets);
+        pl_sb_reset(ptBuilder->tGrid.sbuNext);
     }
 }
 
 void
 pl_mesh_builder_add_triangle_double(plMeshBuilder* ptBuilder, plVec3d tA, plVec3d tB, plVec3d tC)
 {
-    plMeshBuilderTriangle tTriangle;
-    tTriangle.uIndex0 = UINT32_MAX;
-    tTriangle.uIndex1 = UINT32_MAX;
-    tTriangle.uIndex2 = UINT32_MAX;
-
-    const double fWeldRadiusSqr = (double)(ptBuilder->tOptions.fWeldRadius * ptBuilder->tOptions.fWeldRadius);
-
-    const uint32_t uVertexCount = pl_sb_size(ptBuilder->sbtVerticesD);
-
-    for(uint32_t i = 0; i < uVertexCount; i++)
-    {
-        const plVec3d* ptVertex = &ptBuilder->sbtVerticesD[i];
-
-        double fDist = pl_length_sqr_vec3_d(pl_sub_vec3_d(*ptVertex, tA));
-
-        if(fDist < fWeldRadiusSqr)
-        {
-            tTriangle.uIndex0 = i;
-            break;
-        }
-    }
-
-    for(uint32_t i = 0; i < uVertexCount; i++)
-    {
-        const plVec3d* ptVertex = &ptBuilder->sbtVerticesD[i];
-
-        double fDist = pl_length_sqr_vec3_d(pl_sub_vec3_d(*ptVertex, tB));
-
-        if(fDist < fWeldRadiusSqr)
-        {
-            tTriangle.uIndex1 = i;
-            break;
-        }
-    }
-
-    for(uint32_t i = 0; i < uVertexCount; i++)
-    {
-        const plVec3d* ptVertex = &ptBuilder->sbtVerticesD[i];
-
-        double fDist = pl_length_sqr_vec3_d(pl_sub_vec3_d(*ptVertex, tC));
-
-        if(fDist < fWeldRadiusSqr)
-        {
-            tTriangle.uIndex2 = i;
-            break;
-        }
-    }
-
-    if(tTriangle.uIndex0 == UINT32_MAX)
-    {
-        tTriangle.uIndex0 = pl_sb_size(ptBuilder->sbtVerticesD);
-        pl_sb_push(ptBuilder->sbtVerticesD, tA);
-    }
-
-    if(tTriangle.uIndex1 == UINT32_MAX)
-    {
-        tTriangle.uIndex1 = pl_sb_size(ptBuilder->sbtVerticesD);
-        pl_sb_push(ptBuilder->sbtVerticesD, tB);
-    }
+    const plVec3d atPoints[3] = {tA, tB, tC};
+    pl__mesh_builder_add_triangle(ptBuilder, atPoints, true);
+}
 
-    if(tTriangle.uIndex2 == UINT32_MAX)
-    {
-        tTriangle.uIndex2 = pl_sb_size(ptBuilder->sbtVerticesD);
-        pl_sb_push(ptBuilder->sbtVerticesD, tC);
-    }
+void
+pl_mesh_builder_add_triangles_double(plMeshBuilder* ptBuilder, uint32_t uTriangleCount, const plVec3d* atPositions)
+{
+    // worst case (nothing welds) reserved up front
+    pl__mesh_sb_reserve(ptBuilder->sbtTriangles, uTriangleCount);
+    pl__mesh_sb_reserve(ptBuilder->sbtVerticesD, uTriangleCount * 3);
+    pl__mesh_sb_reserve(ptBuilder->tGridD.sbuNext, uTriangleCount * 3);
 
-    pl_sb_push(ptBuilder->sbtTriangles, tTriangle);
+    for(uint32_t i = 0; i < uTriangleCount; i++)
+        pl__mesh_builder_add_triangle(ptBuilder, &atPositions[i * 3], true);
 }
 
 void
@@ -757,6 +858,8 @@ pl_mesh_builder_commit_double(plMeshBuilder* ptBuilder, uint32_t* puIndexBuffer,
         memcpy(ptVertexBuffer, ptBuilder->sbtVerticesD, uVertexCount * sizeof(plVec3d));
         pl_sb_reset(ptBuilder->sbtTriangles);
         pl_sb_reset(ptBuilder->sbtVerticesD);
+        pl_sb_reset(ptBuilder->tGridD.sbuBuckets);
+        pl_sb_reset(ptBuilder->tGridD.sbuNext);
     }
 }
 
@@ -781,12 +884,14 @@ pl_load_mesh_ext(plApiRegistryI* ptApiRegistry, bool bReload)
     pl_set_api(ptApiRegistry, plMeshI, &tApi);
 
     const plMeshBuilderI tApi2 = {
-        .create              = pl_mesh_builder_create,
-        .cleanup             = pl_mesh_builder_cleanup,
-        .add_triangle        = pl_mesh_builder_add_triangle,
-        .add_triangle_double = pl_mesh_builder_add_triangle_double,
-        .commit              = pl_mesh_builder_commit,
-        .commit_double       = pl_mesh_builder_commit_double,
+        .create               = pl_mesh_builder_create,
+        .cleanup              = pl_mesh_builder_cleanup,
+        .add_triangle         = pl_mesh_builder_add_triangle,
+        .add_triangle_double  = pl_mesh_builder_add_triangle_double,
+        .add_triangles        = pl_mesh_builder_add_triangles,
+        .add_triangles_double = pl_mesh_builder_add_triangles_double,
+        .commit               = pl_mesh_builder_commit,
+        .commit_double        = pl_mesh_builder_commit_double,
     };
     pl_set_api(ptApiRegistry, plMeshBuilderI, &tApi2);
 
@@ -27,6 +27,11 @@ Index of this file:
 
         * plEcsI (v1.x) (only if using ECS integration)
         * plLogI (v1.x) (only if using ECS integration)
+
+    Mesh Builder:
+        Vertices are welded through a spatial hash with cells the size of
+        "fWeldRadius", so adding a triangle only checks vertices in the
+        neighbouring cells (expected O(1) instead of O(vertex count)).
 */
 
 //-----------------------------------------------------------------------------
@@ -45,7 +50,7 @@ extern "C" {
 //-----------------------------------------------------------------------------
 
 #define plMeshI_version {0, 1, 0}
-#define plMeshBuilderI_version {0, 1, 0}
+#define plMeshBuilderI_version {0, 2, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -106,8 +111,10 @@ PL_API plMeshBuilder* pl_mesh_builder_create(plMeshBuilderOptions);
 PL_API void           pl_mesh_builder_cleanup(plMeshBuilder*);
 
 // adding
-PL_API void pl_mesh_builder_add_triangle       (plMeshBuilder*, plVec3, plVec3, plVec3);
-PL_API void pl_mesh_builder_add_triangle_double(plMeshBuilder*, plVec3d, plVec3d, plVec3d);
+PL_API void pl_mesh_builder_add_triangle        (plMeshBuilder*, plVec3, plVec3, plVec3);
+PL_API void pl_mesh_builder_add_triangle_double (plMeshBuilder*, plVec3d, plVec3d, plVec3d);
+PL_API void pl_mesh_builder_add_triangles       (plMeshBuilder*, uint32_t triangleCount, const plVec3* positions); // 3 per triangle
+PL_API void pl_mesh_builder_add_triangles_double(plMeshBuilder*, uint32_t triangleCount, const plVec3d* positions); // 3 per triangle
 
 // commit
 PL_API void pl_mesh_builder_commit       (plMeshBuilder*, uint32_t* indexBuffer, plVec3* vertexBuffer, uint32_t* indexBufferCountOut, uint32_t* vertexBufferCountOut);
@@ -147,8 +154,10 @@ typedef struct _plMeshBuilderI
     void           (*cleanup)(plMeshBuilder*);
 
     // adding
-    void (*add_triangle)       (plMeshBuilder*, plVec3, plVec3, plVec3);
-    void (*add_triangle_double)(plMeshBuilder*, plVec3d, plVec3d, plVec3d);
+    void (*add_triangle)        (plMeshBuilder*, plVec3, plVec3, plVec3);
+    void (*add_triangle_double) (plMeshBuilder*, plVec3d, plVec3d, plVec3d);
+    void (*add_triangles)       (plMeshBuilder*, uint32_t triangleCount, const plVec3* positions); // 3 per triangle
+    void (*add_triangles_double)(plMeshBuilder*, uint32_t triangleCount, const plVec3d* positions); // 3 per triangle
 
     // commit
     void (*commit)       (plMeshBuilder*, uint32_t* indexBuffer, plVec3* vertexBuffer, uint32_t* indexBufferCountOut, uint32_t* vertexBufferCountOut);
@@ -7,6 +7,7 @@ Index of this file:
 // [SECTION] implementation notes
 // [SECTION] includes
 // [SECTION] internal structs
+// [SECTION] internal api
 // [SECTION] public api implementation
 // [SECTION] extension loading
 // [SECTION] unity build
@@ -22,6 +23,25 @@ Index of this file:
         The implementation is simple. The only caveats here are that we store
         the file entries so that they can be added at the end of the file at
         the end of packing.
+
+    Compression:
+        Compressed entries (version 2+) are split into PL_PAK_CHUNK_SIZE chunks
+        that decode independently. The entry data starts with a seek table of
+        "chunk count + 1" 64 bit offsets (relative to the entry) followed by
+        the chunks. A chunk whose stored size equals its uncompressed size is
+        stored as is. Compressed entries are queued while packing & their
+        chunks compressed in parallel (plJobI, if running) once
+        PL_PAK_MAX_PENDING_SIZE is reached or at "end_packing". Version 1
+        entries (single stream) are still readable.
+
+    Reading:
+        Loaded paks are memory mapped (read only) & the entry table is parsed
+        once. After loading, nothing in plPakFile is mutated so "read_file",
+        "get_file_view" & "open_file" can be called from any number of threads.
+        Each "open_file" returns its own plPakChildFile so stream positions
+        aren't shared. Compressed entries are decompressed straight from the
+        mapping (no staging buffer) & uncompressed entries are plain views.
+        Streams over chunked entries only decode the chunk being read.
 */
 
 //-----------------------------------------------------------------------------
@@ -30,12 +50,21 @@ Index of this file:
 
 #include <stdio.h>  // files
 #include <string.h> // memset
+#if defined(_WIN32)
+    #include <windows.h> // CreateFileMapping, MapViewOfFile
+#else
+    #include <fcntl.h>    // open
+    #include <sys/mman.h> // mmap, munmap
+    #include <sys/stat.h> // fstat
+    #include <unistd.h>   // close
+#endif
 #include "pl.h"
 #include "pl_pak_ext.h"
 
 // extensions
 #include "pl_compress_ext.h"
 #include "pl_vfs_ext.h"
+#include "pl_job_ext.h"
 
 // libs
 #include "pl_string.h"
@@ -48,6 +77,7 @@ Index of this file:
     static const plMemoryI* gptMemory = NULL;
     static const plCompressI* gptCompress = NULL;
     static const plVfsI* gptVfs = NULL;
+    static const plJobI* gptJob = NULL;
 
     #define PL_ALLOC(x)      gptMemory->tracked_realloc(NULL, (x), __FILE__, __LINE__)
     #define PL_REALLOC(x, y) gptMemory->tracked_realloc((x), (y), __FILE__, __LINE__)
@@ -63,7 +93,17 @@ Index of this file:
 #endif
 
 #define PL_PAK_MAX_PATH_LENGTH 255
-#define PL_PAK_VERSION 1
+#define PL_PAK_VERSION 2
+
+#ifndef PL_PAK_CHUNK_SIZE
+    #define PL_PAK_CHUNK_SIZE 65536 // uncompressed bytes per independently decodable chunk
+#endif
+
+#ifndef PL_PAK_MAX_PENDING_SIZE
+    #define PL_PAK_MAX_PENDING_SIZE 67108864 // compressed entries are queued up to this size before compressing
+#endif
+
+#define PL_PAK_MAX_COMPRESS_JOBS 32
 
 //-----------------------------------------------------------------------------
 // [SECTION] internal structs
@@ -78,29 +118,329 @@ typedef struct _plPakFileHeader
     uint32_t uNumEntries;     // number of directories/files
 } plPakFileHeader;
 
+typedef struct _plPakEntry
+{
+    char     acFilePath[PL_PAK_MAX_PATH_LENGTH]; // path to the file (relative to the pak directory)
+    bool     bCompressed;                        // true if compressed
+    uint64_t uUncompressedSize;                  // size before compression
+    uint64_t uCompressedSize;                    // size after compression
+    uint64_t uOffset;                            // offset pointing to start of binary data
+    uint64_t uChunkSize;                         // uncompressed bytes per chunk (0 for single stream, version 1)
+    uint64_t auReserved[2];                      // unused (keeps version 1 entry layout)
+} plPakEntry;
+
 typedef struct _plPakChildFile
 {
-    char       acFilePath[PL_PAK_MAX_PATH_LENGTH]; // path to the file (relative to the pak directory)
-    bool       bCompressed;                        // true if compressed
-    uint64_t   uUncompressedSize;                  // size before compression
-    uint64_t   uCompressedSize;                    // size after compression
-    uint64_t   uOffset;                            // offset pointing to start of binary data
-    size_t     szOffsetPointer;
-    uint8_t*   puCompressionStreamBuffer;
-    plPakFile* ptParentPak;
+    plPakFile*        ptParentPak;
+    const plPakEntry* ptEntry;
+    const uint8_t*    puData;          // view into mapping or decompressed data (not chunked)
+    uint8_t*          puDecompressed;  // owned (single stream compressed entries only)
+    size_t            szSize;
+    size_t            szOffsetPointer;
+
+    // chunked entries (decoded on demand)
+    uint8_t*       puChunkBuffer; // owned, one chunk
+    const uint8_t* puChunkData;   // current chunk (chunk buffer or view of stored chunk)
+    uint64_t       uChunkIndex;   // current chunk (UINT64_MAX if none)
 } plPakChildFile;
 
+typedef struct _plPakPendingEntry
+{
+    uint32_t        uEntryIndex;
+    plCompressCodec tCodec;
+    uint8_t*        puData; // owned
+    uint64_t        uSize;
+} plPakPendingEntry;
+
+typedef struct _plPakChunk
+{
+    const uint8_t*  puSrc;
+    uint32_t        uSize;
+    plCompressCodec tCodec;
+    uint8_t*        puDst;
+    uint32_t        uDstCapacity;
+    uint32_t        uStoredSize; // uSize if stored uncompressed
+} plPakChunk;
+
+typedef struct _plPakCompressJob
+{
+    plPakChunk* atChunks;
+    uint32_t    uChunkCount;
+    uint32_t    uJobCount;
+} plPakCompressJob;
+
 typedef struct _plPakFile
 {
-    FILE*           ptFile;
-    plPakChildFile* sbtEntries;
+    plPakEntry*     sbtEntries;
     plPakFileHeader tHeader;
     plPakEntryInfo* atEntries;
-    uint8_t*        puCompressionBuffer;
-    uint64_t        uCompressionBufferSize;
     plHashMap       tHashmap;
+
+    // unpacking only
+    const uint8_t* puMapping;
+    uint64_t       uMappingSize;
+
+    // packing only
+    FILE*              ptFile;
+    uint64_t           uWriteOffset;
+    uint8_t*           puCompressionBuffer;
+    uint64_t           uCompressionBufferSize;
+    plPakPendingEntry* sbtPending;
+    uint64_t           uPendingSize;
 } plPakFile;
 
+//-----------------------------------------------------------------------------
+// [SECTION] internal api
+//-----------------------------------------------------------------------------
+
+static const uint8_t*
+pl__pak_map_file(const char* pcFile, uint64_t* puSizeOut)
+{
+    *puSizeOut = 0;
+
+    #if defined(_WIN32)
+        HANDLE tFile = CreateFileA(pcFile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(tFile == INVALID_HANDLE_VALUE)
+            return NULL;
+
+        LARGE_INTEGER tSize = {0};
+        if(!GetFileSizeEx(tFile, &tSize) || tSize.QuadPart == 0)
+        {
+            CloseHandle(tFile);
+            return NULL;
+        }
+
+        // the view keeps the mapping (and file) alive once created
+        HANDLE tMapping = CreateFileMappingA(tFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(tFile);
+        if(tMapping == NULL)
+            return NULL;
+
+        const uint8_t* puMapping = MapViewOfFile(tMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(tMapping);
+        if(puMapping == NULL)
+            return NULL;
+        *puSizeOut = (uint64_t)tSize.QuadPart;
+    #else
+        int iFile = open(pcFile, O_RDONLY);
+        if(iFile < 0)
+            return NULL;
+
+        struct stat tStat = {0};
+        if(fstat(iFile, &tStat) != 0 || tStat.st_size <= 0)
+        {
+            close(iFile);
+            return NULL;
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        void* pMapping = mmap(NULL, (size_t)tStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+        close(iFile);
+        if(pMapping == MAP_FAILED)
+            return NULL;
+        const uint8_t* puMapping = pMapping;
+        *puSizeOut = (uint64_t)tStat.st_size;
+    #endif
+    return puMapping;
+}
+
+static void
+pl__pak_unmap_file(const uint8_t* puMapping, uint64_t uSize)
+{
+    #if defined(_WIN32)
+        UnmapViewOfFile(puMapping);
+    #else
+        munmap((void*)puMapping, (size_t)uSize);
+    #endif
+}
+
+static const plPakEntry*
+pl__pak_find_entry(const plPakFile* ptPak, const char* pcFile)
+{
+    uint64_t uIndex = 0;
+    if(!pl_hm_has_key_str_ex(&ptPak->tHashmap, pcFile, &uIndex))
+        return NULL;
+    const plPakEntry* ptEntry = &ptPak->sbtEntries[uIndex];
+    PL_ASSERT(pl_str_equal(ptEntry->acFilePath, pcFile));
+    return ptEntry;
+}
+
+static inline uint64_t
+pl__pak_chunk_count(const plPakEntry* ptEntry)
+{
+    return ptEntry->uUncompressedSize / ptEntry->uChunkSize + (ptEntry->uUncompressedSize % ptEntry->uChunkSize != 0 ? 1 : 0);
+}
+
+static bool
+pl__pak_decode_chunk(const plPakFile* ptPak, const plPakEntry* ptEntry, uint64_t uChunk, uint8_t* puBuffer, const uint8_t** ppuChunkOut)
+{
+    // chunked entries start with a seek table of "chunk count + 1" offsets
+    // (relative to entry start) followed by the chunks
+    const uint8_t* puBase = &ptPak->puMapping[ptEntry->uOffset];
+    const uint64_t uTableSize = (pl__pak_chunk_count(ptEntry) + 1) * sizeof(uint64_t);
+    uint64_t auRange[2] = {0};
+    memcpy(auRange, &puBase[uChunk * sizeof(uint64_t)], sizeof(auRange)); // table isn't aligned
+    if(auRange[0] < uTableSize || auRange[0] > auRange[1] || auRange[1] > ptEntry->uCompressedSize)
+        return false;
+
+    const uint64_t uChunkOffset = uChunk * ptEntry->uChunkSize;
+    const uint64_t uChunkSize = ptEntry->uUncompressedSize - uChunkOffset < ptEntry->uChunkSize ? ptEntry->uUncompressedSize - uChunkOffset : ptEntry->uChunkSize;
+    const uint64_t uStoredSize = auRange[1] - auRange[0];
+
+    // incompressible chunks are stored as is
+    if(uStoredSize == uChunkSize)
+    {
+        *ppuChunkOut = &puBase[auRange[0]];
+        return true;
+    }
+
+    // compress api isn't const correct but only reads the input
+    const uint32_t uDecompressedSize = gptCompress->decompress((uint8_t*)&puBase[auRange[0]], (uint32_t)uStoredSize, puBuffer, (uint32_t)uChunkSize);
+    *ppuChunkOut = puBuffer;
+    return uDecompressedSize == uChunkSize;
+}
+
+static bool
+pl__pak_decompress_entry(const plPakFile* ptPak, const plPakEntry* ptEntry, uint8_t* puBufferOut)
+{
+    if(ptEntry->uChunkSize == 0) // version 1 (single stream)
+    {
+        // compress api isn't const correct but only reads the input
+        const uint32_t uDecompressedSize = gptCompress->decompress((uint8_t*)&ptPak->puMapping[ptEntry->uOffset], (uint32_t)ptEntry->uCompressedSize, puBufferOut, (uint32_t)ptEntry->uUncompressedSize);
+        return uDecompressedSize == ptEntry->uUncompressedSize;
+    }
+
+    const uint64_t uChunkCount = pl__pak_chunk_count(ptEntry);
+    for(uint64_t i = 0; i < uChunkCount; i++)
+    {
+        uint8_t* puChunkOut = &puBufferOut[i * ptEntry->uChunkSize];
+        const uint8_t* puChunk = NULL;
+        if(!pl__pak_decode_chunk(ptPak, ptEntry, i, puChunkOut, &puChunk))
+            return false;
+        if(puChunk != puChunkOut)
+            memcpy(puChunkOut, puChunk, (size_t)(ptEntry->uUncompressedSize - i * ptEntry->uChunkSize < ptEntry->uChunkSize ? ptEntry->uUncompressedSize - i * ptEntry->uChunkSize : ptEntry->uChunkSize));
+    }
+    return true;
+}
+
+static void
+pl__pak_compress_chunks_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    // each job compresses a contiguous range of chunks with its own context
+    plPakCompressJob* ptJob = pData;
+    const uint32_t uStart = (uint32_t)((uint64_t)ptJob->uChunkCount * tInvoData.uGlobalIndex / ptJob->uJobCount);
+    const uint32_t uEnd = (uint32_t)((uint64_t)ptJob->uChunkCount * (tInvoData.uGlobalIndex + 1) / ptJob->uJobCount);
+
+    plCompressContext* ptContext = gptCompress->create_context();
+    for(uint32_t i = uStart; i < uEnd; i++)
+    {
+        plPakChunk* ptChunk = &ptJob->atChunks[i];
+        const uint32_t uCompressedSize = gptCompress->compress_ex(ptContext, ptChunk->tCodec, ptChunk->puSrc, ptChunk->uSize, ptChunk->puDst, ptChunk->uDstCapacity);
+        ptChunk->uStoredSize = (uCompressedSize > 0 && uCompressedSize < ptChunk->uSize) ? uCompressedSize : ptChunk->uSize;
+    }
+    gptCompress->cleanup_context(ptContext);
+}
+
+static void
+pl__pak_flush_pending(plPakFile* ptPak)
+{
+    const uint32_t uPendingCount = pl_sb_size(ptPak->sbtPending);
+    if(uPendingCount == 0)
+        return;
+
+    // split pending entries into chunks
+    uint64_t uChunkCount = 0;
+    for(uint32_t i = 0; i < uPendingCount; i++)
+        uChunkCount += ptPak->sbtPending[i].uSize / PL_PAK_CHUNK_SIZE + (ptPak->sbtPending[i].uSize % PL_PAK_CHUNK_SIZE != 0 ? 1 : 0);
+    PL_ASSERT(uChunkCount <= UINT32_MAX);
+
+    const uint32_t uDefaultBound = gptCompress->compress_bound(PL_COMPRESS_CODEC_DEFAULT, PL_PAK_CHUNK_SIZE);
+    const uint32_t uFastBound = gptCompress->compress_bound(PL_COMPRESS_CODEC_FAST, PL_PAK_CHUNK_SIZE);
+    const uint32_t uChunkBound = uDefaultBound > uFastBound ? uDefaultBound : uFastBound;
+    if(uChunkCount * uChunkBound > ptPak->uCompressionBufferSize)
+    {
+        if(ptPak->puCompressionBuffer)
+            PL_FREE(ptPak->puCompressionBuffer);
+        ptPak->uCompressionBufferSize = uChunkCount * uChunkBound;
+        ptPak->puCompressionBuffer = PL_ALLOC((size_t)ptPak->uCompressionBufferSize);
+    }
+
+    plPakChunk* atChunks = PL_ALLOC(sizeof(plPakChunk) * (size_t)(uChunkCount > 0 ? uChunkCount : 1));
+    uint32_t uCurrentChunk = 0;
+    for(uint32_t i = 0; i < uPendingCount; i++)
+    {
+        const plPakPendingEntry* ptPending = &ptPak->sbtPending[i];
+        for(uint64_t uOffset = 0; uOffset < ptPending->uSize; uOffset += PL_PAK_CHUNK_SIZE)
+        {
+            atChunks[uCurrentChunk] = (plPakChunk){
+                .puSrc        = &ptPending->puData[uOffset],
+                .uSize        = (uint32_t)(ptPending->uSize - uOffset < PL_PAK_CHUNK_SIZE ? ptPending->uSize - uOffset : PL_PAK_CHUNK_SIZE),
+                .tCodec       = ptPending->tCodec,
+                .puDst        = &ptPak->puCompressionBuffer[(uint64_t)uCurrentChunk * uChunkBound],
+                .uDstCapacity = uChunkBound
+            };
+            uCurrentChunk++;
+        }
+    }
+
+    // compress chunks (in parallel if the job system is running)
+    plPakCompressJob tJob = {
+        .atChunks    = atChunks,
+        .uChunkCount = (uint32_t)uChunkCount,
+        .uJobCount   = 1
+    };
+    if(gptJob && !gptJob->is_shutting_down() && uChunkCount > 1)
+    {
+        tJob.uJobCount = (uint32_t)(uChunkCount < PL_PAK_MAX_COMPRESS_JOBS ? uChunkCount : PL_PAK_MAX_COMPRESS_JOBS);
+        plJobDesc tJobDesc = {
+            .task  = pl__pak_compress_chunks_job,
+            .pData = &tJob
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(tJob.uJobCount, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else if(uChunkCount > 0)
+        pl__pak_compress_chunks_job((plInvocationData){.uBatchSize = 1}, &tJob, NULL);
+
+    // write seek table & chunks for each entry
+    uint64_t* sbuSeekTable = NULL;
+    uCurrentChunk = 0;
+    for(uint32_t i = 0; i < uPendingCount; i++)
+    {
+        plPakPendingEntry* ptPending = &ptPak->sbtPending[i];
+        plPakEntry* ptEntry = &ptPak->sbtEntries[ptPending->uEntryIndex];
+        const uint32_t uEntryChunkCount = (uint32_t)pl__pak_chunk_count(ptEntry);
+
+        pl_sb_resize(sbuSeekTable, uEntryChunkCount + 1);
+        uint64_t uOffset = (uEntryChunkCount + 1) * sizeof(uint64_t);
+        for(uint32_t j = 0; j < uEntryChunkCount; j++)
+        {
+            sbuSeekTable[j] = uOffset;
+            uOffset += atChunks[uCurrentChunk + j].uStoredSize;
+        }
+        sbuSeekTable[uEntryChunkCount] = uOffset;
+        fwrite(sbuSeekTable, sizeof(uint64_t), uEntryChunkCount + 1, ptPak->ptFile);
+
+        for(uint32_t j = 0; j < uEntryChunkCount; j++)
+        {
+            const plPakChunk* ptChunk = &atChunks[uCurrentChunk + j];
+            fwrite(ptChunk->uStoredSize == ptChunk->uSize ? ptChunk->puSrc : ptChunk->puDst, 1, ptChunk->uStoredSize, ptPak->ptFile);
+        }
+        uCurrentChunk += uEntryChunkCount;
+
+        ptEntry->uOffset = ptPak->uWriteOffset;
+        ptEntry->uCompressedSize = uOffset;
+        ptPak->uWriteOffset += uOffset;
+        PL_FREE(ptPending->puData);
+    }
+
+    pl_sb_free(sbuSeekTable);
+    PL_FREE(atChunks);
+    pl_sb_reset(ptPak->sbtPending);
+    ptPak->uPendingSize = 0;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
 //-----------------------------------------------------------------------------
@@ -123,21 +463,60 @@ pl_pak_begin_packing(const char* pcFile, uint32_t uVersion, plPakFile** pptPak)
         // going ahead a writing header to file, though we will rewrite
         // it at the end of packing to update the entry count
         fwrite(&ptPak->tHeader, 1, sizeof(plPakFileHeader), ptFile);
+        ptPak->uWriteOffset = sizeof(plPakFileHeader);
     }
     *pptPak = ptPak;
     return ptPak != NULL;
 }
 
+static void
+pl__pak_write_entry_data(plPakFile* ptPak, plPakEntry* ptEntry, uint8_t* puData, size_t szByteSize, plPakEntryFlags tFlags, bool bOwned)
+{
+    ptEntry->uUncompressedSize = (uint64_t)szByteSize;
+    ptEntry->uCompressedSize = (uint64_t)szByteSize;
+    ptEntry->bCompressed = (tFlags & (PL_PAK_ENTRY_FLAGS_COMPRESS | PL_PAK_ENTRY_FLAGS_COMPRESS_FAST)) != 0;
+
+    if(ptEntry->bCompressed)
+    {
+        // queued so chunks of many entries can be compressed in parallel
+        ptEntry->uChunkSize = PL_PAK_CHUNK_SIZE;
+        plPakPendingEntry tPending = {
+            .uEntryIndex = (uint32_t)(ptEntry - ptPak->sbtEntries),
+            .tCodec      = (tFlags & PL_PAK_ENTRY_FLAGS_COMPRESS_FAST) ? PL_COMPRESS_CODEC_FAST : PL_COMPRESS_CODEC_DEFAULT,
+            .puData      = puData,
+            .uSize       = (uint64_t)szByteSize
+        };
+        if(!bOwned)
+        {
+            tPending.puData = PL_ALLOC(szByteSize > 0 ? szByteSize : 1);
+            memcpy(tPending.puData, puData, szByteSize);
+        }
+        pl_sb_push(ptPak->sbtPending, tPending);
+        ptPak->uPendingSize += szByteSize;
+        if(ptPak->uPendingSize >= PL_PAK_MAX_PENDING_SIZE)
+            pl__pak_flush_pending(ptPak);
+    }
+    else
+    {
+        // mark offset in file, then write (tracked here since ftell is 32 bit on some platforms)
+        ptEntry->uOffset = ptPak->uWriteOffset;
+        fwrite(puData, 1, szByteSize, ptPak->ptFile);
+        ptPak->uWriteOffset += szByteSize;
+        if(bOwned)
+            PL_FREE(puData);
+    }
+}
+
 bool      
-pl_pak_add_from_disk(plPakFile* ptPak, const char* pcPakPath, const char* pcFilePath, bool bCompress)
+pl_pak_add_from_disk_ex(plPakFile* ptPak, const char* pcPakPath, const char* pcFilePath, plPakEntryFlags tFlags)
 {
 
     if(!gptVfs->does_file_exist(pcFilePath))
         return false;
 
     pl_sb_add(ptPak->sbtEntries);
-    plPakChildFile* ptEntry = &pl_sb_back(ptPak->sbtEntries);
-    ptEntry->bCompressed = bCompress;
+    plPakEntry* ptEntry = &pl_sb_back(ptPak->sbtEntries);
+    memset(ptEntry, 0, sizeof(plPakEntry));
     strncpy(ptEntry->acFilePath, pcPakPath, PL_PAK_MAX_PATH_LENGTH);
 
     // load file frome disk temporarily
@@ -148,88 +527,41 @@ pl_pak_add_from_disk(plPakFile* ptPak, const char* pcPakPath, const char* pcFile
     gptVfs->read_file(tHandle, puBuffer, &szFileSize);
     gptVfs->close_file(tHandle);
 
-    // mark offset in file, then write
-    ptEntry->uOffset = (uint32_t)ftell(ptPak->ptFile);
-    ptEntry->uUncompressedSize = (uint32_t)szFileSize;
-
-    if(bCompress)
-    {
-        if(szFileSize * 2 > ptPak->uCompressionBufferSize)
-        {
-
-            if(ptPak->puCompressionBuffer) // first allocation
-            {
-                PL_FREE(ptPak->puCompressionBuffer);
-                ptPak->puCompressionBuffer = NULL;
-            }
-            
-            ptPak->uCompressionBufferSize = (uint32_t)szFileSize * 2;
-            ptPak->puCompressionBuffer = PL_ALLOC(ptPak->uCompressionBufferSize);
-            memset(ptPak->puCompressionBuffer, 0, ptPak->uCompressionBufferSize);
-        }
-
-        uint64_t uCompressedSize = (uint64_t)gptCompress->compress(puBuffer, (uint32_t)szFileSize, ptPak->puCompressionBuffer, (uint32_t)ptPak->uCompressionBufferSize);
-        PL_ASSERT(uCompressedSize < ptPak->uCompressionBufferSize);
-        ptEntry->uCompressedSize = uCompressedSize;
-        fwrite(ptPak->puCompressionBuffer, 1, (size_t)uCompressedSize, ptPak->ptFile);
-    }
-    else
-    {
-        fwrite(puBuffer, 1, szFileSize, ptPak->ptFile);
-    }
-    PL_FREE(puBuffer);
+    pl__pak_write_entry_data(ptPak, ptEntry, puBuffer, szFileSize, tFlags, true);
 
     return true;
 }
 
-void      
-pl_pak_add_from_memory(plPakFile* ptPak, const char* pcPakPath, uint8_t* puFileData, size_t szFileByteSize, bool bCompress)
+bool      
+pl_pak_add_from_disk(plPakFile* ptPak, const char* pcPakPath, const char* pcFilePath, bool bCompress)
 {
+    return pl_pak_add_from_disk_ex(ptPak, pcPakPath, pcFilePath, bCompress ? PL_PAK_ENTRY_FLAGS_COMPRESS : PL_PAK_ENTRY_FLAGS_NONE);
+}
 
-    PL_ASSERT(bCompress == false && "compression not supported yet");
-
+void      
+pl_pak_add_from_memory_ex(plPakFile* ptPak, const char* pcPakPath, uint8_t* puFileData, size_t szFileByteSize, plPakEntryFlags tFlags)
+{
     pl_sb_add(ptPak->sbtEntries);
-    plPakChildFile* ptEntry = &pl_sb_back(ptPak->sbtEntries);
-    ptEntry->bCompressed = bCompress;
+    plPakEntry* ptEntry = &pl_sb_back(ptPak->sbtEntries);
+    memset(ptEntry, 0, sizeof(plPakEntry));
     strncpy(ptEntry->acFilePath, pcPakPath, PL_PAK_MAX_PATH_LENGTH);
+    pl__pak_write_entry_data(ptPak, ptEntry, puFileData, szFileByteSize, tFlags, false);
+}
 
-    // mark offset in file, then write
-    ptEntry->uOffset = (uint32_t)ftell(ptPak->ptFile);
-    ptEntry->uUncompressedSize = (uint32_t)szFileByteSize;
-
-    if(bCompress)
-    {
-
-        if(szFileByteSize * 2 > ptPak->uCompressionBufferSize)
-        {
-
-            if(ptPak->puCompressionBuffer) // first allocation
-            {
-                PL_FREE(ptPak->puCompressionBuffer);
-                ptPak->puCompressionBuffer = NULL;
-            }
-            
-            ptPak->uCompressionBufferSize = (uint32_t)szFileByteSize * 2;
-            ptPak->puCompressionBuffer = PL_ALLOC(ptPak->uCompressionBufferSize);
-            memset(ptPak->puCompressionBuffer, 0, ptPak->uCompressionBufferSize);
-        }
-
-        uint64_t uCompressedSize = gptCompress->compress(puFileData, (uint32_t)szFileByteSize, ptPak->puCompressionBuffer, (uint32_t)ptPak->uCompressionBufferSize);
-        PL_ASSERT(uCompressedSize < szFileByteSize * 2);
-        ptEntry->uCompressedSize = uCompressedSize;
-        fwrite(ptPak->puCompressionBuffer, 1, (size_t)uCompressedSize, ptPak->ptFile);
-    }
-    else
-    {
-        fwrite(puFileData, 1, szFileByteSize, ptPak->ptFile);
-    }
+void      
+pl_pak_add_from_memory(plPakFile* ptPak, const char* pcPakPath, uint8_t* puFileData, size_t szFileByteSize, bool bCompress)
+{
+    pl_pak_add_from_memory_ex(ptPak, pcPakPath, puFileData, szFileByteSize, bCompress ? PL_PAK_ENTRY_FLAGS_COMPRESS : PL_PAK_ENTRY_FLAGS_NONE);
 }
 
 void
 pl_pak_unload(plPakFile** pptPak)
 {
     plPakFile* ptPak = *pptPak;
-    fclose(ptPak->ptFile);
+    if(ptPak->ptFile)
+        fclose(ptPak->ptFile);
+    if(ptPak->puMapping)
+        pl__pak_unmap_file(ptPak->puMapping, ptPak->uMappingSize);
     pl_sb_free(ptPak->sbtEntries);
     pl_hm_free(&ptPak->tHashmap);
     if(ptPak->atEntries)
@@ -242,6 +574,10 @@ pl_pak_unload(plPakFile** pptPak)
     {
         PL_FREE(ptPak->puCompressionBuffer);
     }
+
+    for(uint32_t i = 0; i < pl_sb_size(ptPak->sbtPending); i++)
+        PL_FREE(ptPak->sbtPending[i].puData);
+    pl_sb_free(ptPak->sbtPending);
     
     PL_FREE(ptPak);
     *pptPak = NULL;
@@ -251,7 +587,9 @@ void
 pl_pak_end_packing(plPakFile** pptPak)
 {
     plPakFile* ptPak = *pptPak;
-    uint32_t uEndLocation = (uint32_t)ftell(ptPak->ptFile);
+
+    // compress & write remaining queued entries
+    pl__pak_flush_pending(ptPak);
 
     // jump back to beginning so we can update the entry count
     fseek(ptPak->ptFile, 0, SEEK_SET);
@@ -262,7 +600,7 @@ pl_pak_end_packing(plPakFile** pptPak)
     fseek(ptPak->ptFile, 0, SEEK_END); // back to end
 
     for(uint32_t i = 0; i < ptPak->tHeader.uNumEntries; i++)
-        fwrite(&ptPak->sbtEntries[i], 1, sizeof(plPakChildFile), ptPak->ptFile);
+        fwrite(&ptPak->sbtEntries[i], 1, sizeof(plPakEntry), ptPak->ptFile);
 
     pl_pak_unload(pptPak);
 }
@@ -280,199 +618,244 @@ pl_pak_load(const char* pcFile, plPakInfo* ptInfoOut, plPakFile** pptPak)
 
     plVfsFileHandle tHandle = gptVfs->register_file(pcFile, true);
     pcFile = gptVfs->get_real_path(tHandle);
-    plPakFile* ptPak = NULL;
-    FILE* ptFile = fopen(pcFile, "rb");
-    if(ptFile)
-    {
-        ptPak = PL_ALLOC(sizeof(plPakFile));
-        memset(ptPak, 0, sizeof(plPakFile));
-        ptPak->ptFile = ptFile;
 
-        // pull in header
-        fread(&ptPak->tHeader, sizeof(plPakFileHeader), 1, ptFile);
+    uint64_t uMappingSize = 0;
+    const uint8_t* puMapping = pl__pak_map_file(pcFile, &uMappingSize);
+    if(puMapping == NULL)
+    {
+        if(ptInfoOut)
+            memset(ptInfoOut, 0, sizeof(plPakInfo));
+        *pptPak = NULL;
+        return false;
+    }
 
-        // jump to start of file entries
-        fseek(ptPak->ptFile, -(long)sizeof(plPakChildFile) * (long)ptPak->tHeader.uNumEntries, SEEK_END); // back to end
+    // validate header & entry table before trusting any offsets
+    plPakFileHeader tHeader = {0};
+    bool bValid = uMappingSize >= sizeof(plPakFileHeader);
+    if(bValid)
+    {
+        memcpy(&tHeader, puMapping, sizeof(plPakFileHeader));
+        bValid = strncmp(tHeader.acID, "PAK", 4) == 0 && tHeader.uPakVersion >= 1 && tHeader.uPakVersion <= PL_PAK_VERSION;
+    }
+    const uint64_t uTableSize = (uint64_t)tHeader.uNumEntries * sizeof(plPakEntry);
+    bValid = bValid && uMappingSize - sizeof(plPakFileHeader) >= uTableSize;
+    const uint64_t uTableOffset = uMappingSize - uTableSize;
 
-        // load entries
-        pl_sb_resize(ptPak->sbtEntries, ptPak->tHeader.uNumEntries);
-        for(uint32_t i = 0; i < ptPak->tHeader.uNumEntries; i++)
+    plPakEntry* sbtEntries = NULL;
+    if(bValid)
+    {
+        pl_sb_resize(sbtEntries, tHeader.uNumEntries);
+        memcpy(sbtEntries, &puMapping[uTableOffset], (size_t)uTableSize);
+        for(uint32_t i = 0; i < tHeader.uNumEntries; i++)
         {
-            fread(&ptPak->sbtEntries[i], sizeof(plPakChildFile), 1, ptFile);
-            ptPak->sbtEntries[i].ptParentPak = ptPak;
-            pl_hm_insert_str(&ptPak->tHashmap, ptPak->sbtEntries[i].acFilePath, i);
+            plPakEntry* ptEntry = &sbtEntries[i];
+
+            // version 1 stored runtime state in the unused fields
+            if(tHeader.uPakVersion == 1 || !ptEntry->bCompressed)
+                ptEntry->uChunkSize = 0;
+
+            const uint64_t uStoredSize = ptEntry->bCompressed ? ptEntry->uCompressedSize : ptEntry->uUncompressedSize;
+            if(ptEntry->uOffset < sizeof(plPakFileHeader) || ptEntry->uOffset > uTableOffset || uStoredSize > uTableOffset - ptEntry->uOffset)
+            {
+                bValid = false;
+                break;
+            }
+
+            // chunk offsets are checked when decoded, only the seek table size here
+            if(ptEntry->uChunkSize > UINT32_MAX || (ptEntry->uChunkSize > 0 && pl__pak_chunk_count(ptEntry) >= uStoredSize / sizeof(uint64_t)))
+            {
+                bValid = false;
+                break;
+            }
         }
+    }
 
-        // update info if requested
+    if(!bValid)
+    {
+        pl_sb_free(sbtEntries);
+        pl__pak_unmap_file(puMapping, uMappingSize);
         if(ptInfoOut)
+            memset(ptInfoOut, 0, sizeof(plPakInfo));
+        *pptPak = NULL;
+        return false;
+    }
+
+    plPakFile* ptPak = PL_ALLOC(sizeof(plPakFile));
+    memset(ptPak, 0, sizeof(plPakFile));
+    ptPak->puMapping = puMapping;
+    ptPak->uMappingSize = uMappingSize;
+    ptPak->tHeader = tHeader;
+    ptPak->sbtEntries = sbtEntries;
+    for(uint32_t i = 0; i < tHeader.uNumEntries; i++)
+    {
+        ptPak->sbtEntries[i].acFilePath[PL_PAK_MAX_PATH_LENGTH - 1] = 0;
+        pl_hm_insert_str(&ptPak->tHashmap, ptPak->sbtEntries[i].acFilePath, i);
+    }
+
+    // update info if requested
+    if(ptInfoOut)
+    {
+        ptInfoOut->uContentVersion = ptPak->tHeader.uContentVersion;
+        ptInfoOut->uEntryCount = ptPak->tHeader.uNumEntries;
+        ptInfoOut->uPakVersion = ptPak->tHeader.uPakVersion;
+        ptPak->atEntries = PL_ALLOC(sizeof(plPakEntryInfo) * ptInfoOut->uEntryCount);
+        for(uint32_t i = 0; i < ptPak->tHeader.uNumEntries; i++)
         {
-            ptInfoOut->uContentVersion = ptPak->tHeader.uContentVersion;
-            ptInfoOut->uEntryCount = ptPak->tHeader.uNumEntries;
-            ptInfoOut->uPakVersion = ptPak->tHeader.uPakVersion;
-            ptPak->atEntries = PL_ALLOC(sizeof(plPakChildFile) * ptInfoOut->uEntryCount);
-            for(uint32_t i = 0; i < ptPak->tHeader.uNumEntries; i++)
-            {
-                ptPak->atEntries[i].pcFilePath = ptPak->sbtEntries[i].acFilePath;
-                ptPak->atEntries[i].szSize = ptPak->sbtEntries[i].uUncompressedSize;
-            }
-            ptInfoOut->atEntries = ptPak->atEntries;
+            ptPak->atEntries[i].pcFilePath = ptPak->sbtEntries[i].acFilePath;
+            ptPak->atEntries[i].szSize = (size_t)ptPak->sbtEntries[i].uUncompressedSize;
         }
+        ptInfoOut->atEntries = ptPak->atEntries;
     }
 
     *pptPak = ptPak;
-
-    return ptPak != NULL;
+    return true;
 }
 
 bool
 pl_pak_read_file(plPakFile* ptPak, const char* pcFile, uint8_t* puBufferOut, size_t* pSzFileByteSizeOut)
 {
-
-    plPakChildFile* ptEntry = NULL;
-
-    uint64_t uIndex = 0;
-    if(pl_hm_has_key_str_ex(&ptPak->tHashmap, pcFile, &uIndex))
-    {
-        ptEntry = &ptPak->sbtEntries[uIndex];
-        PL_ASSERT(pl_str_equal(ptEntry->acFilePath, pcFile));
-    }
-    else
+    const plPakEntry* ptEntry = pl__pak_find_entry(ptPak, pcFile);
+    if(ptEntry == NULL)
         return false;
 
     if(pSzFileByteSizeOut)
-        *pSzFileByteSizeOut = ptEntry->uUncompressedSize;
+        *pSzFileByteSizeOut = (size_t)ptEntry->uUncompressedSize;
     if(puBufferOut)
     {
-        fseek(ptPak->ptFile, (long)ptEntry->uOffset, SEEK_SET);
         if(ptEntry->bCompressed)
-        {
+            return pl__pak_decompress_entry(ptPak, ptEntry, puBufferOut);
+        memcpy(puBufferOut, &ptPak->puMapping[ptEntry->uOffset], (size_t)ptEntry->uUncompressedSize);
+    }
+    return true;
+}
 
-            if(ptEntry->uUncompressedSize > ptPak->uCompressionBufferSize)
-            {
+bool
+pl_pak_get_file_view(plPakFile* ptPak, const char* pcFile, const uint8_t** ppuDataOut, size_t* pSzFileByteSizeOut)
+{
+    const plPakEntry* ptEntry = pl__pak_find_entry(ptPak, pcFile);
+    if(ptEntry == NULL || ptEntry->bCompressed)
+        return false;
 
-                if(ptPak->puCompressionBuffer) // first allocation
-                {
-                    PL_FREE(ptPak->puCompressionBuffer);
-                    ptPak->puCompressionBuffer = NULL;
-                }
-                
-                ptPak->uCompressionBufferSize = ptEntry->uUncompressedSize;
-                ptPak->puCompressionBuffer = PL_ALLOC(ptPak->uCompressionBufferSize);
-                memset(ptPak->puCompressionBuffer, 0, ptPak->uCompressionBufferSize);
-            }
-            fread(ptPak->puCompressionBuffer, 1, ptEntry->uCompressedSize, ptPak->ptFile);
-            uint64_t uDecompressedSize = gptCompress->decompress(ptPak->puCompressionBuffer, (uint32_t)ptEntry->uCompressedSize, puBufferOut, (uint32_t)ptPak->uCompressionBufferSize);
-            return uDecompressedSize == ptEntry->uUncompressedSize;
-        }
-        else
-        {
-            fread(puBufferOut, 1, ptEntry->uUncompressedSize, ptPak->ptFile);
-        }
-    }
+    if(ppuDataOut)
+        *ppuDataOut = &ptPak->puMapping[ptEntry->uOffset];
+    if(pSzFileByteSizeOut)
+        *pSzFileByteSizeOut = (size_t)ptEntry->uUncompressedSize;
     return true;
 }
 
 plPakChildFile*
 pl_pak_open_file(plPakFile* ptPak, const char* pcFile)
 {
-    plPakChildFile* ptEntry = NULL;
-
-    uint64_t uIndex = 0;
-    if(pl_hm_has_key_str_ex(&ptPak->tHashmap, pcFile, &uIndex))
-    {
-        ptEntry = &ptPak->sbtEntries[uIndex];
-        PL_ASSERT(pl_str_equal(ptEntry->acFilePath, pcFile));
-    }
-    else
+    const plPakEntry* ptEntry = pl__pak_find_entry(ptPak, pcFile);
+    if(ptEntry == NULL)
         return NULL;
 
+    plPakChildFile* ptChild = PL_ALLOC(sizeof(plPakChildFile));
+    memset(ptChild, 0, sizeof(plPakChildFile));
+    ptChild->ptParentPak = ptPak;
+    ptChild->ptEntry = ptEntry;
+    ptChild->szSize = (size_t)ptEntry->uUncompressedSize;
+    ptChild->uChunkIndex = UINT64_MAX;
 
-    fseek(ptPak->ptFile, (long)ptEntry->uOffset, SEEK_SET);
-    if(ptEntry->bCompressed)
+    if(ptEntry->uChunkSize > 0)
     {
-
-        ptEntry->puCompressionStreamBuffer = PL_ALLOC(ptEntry->uUncompressedSize);
-        memset(ptEntry->puCompressionStreamBuffer, 0, ptEntry->uUncompressedSize);
-
-        if(ptEntry->uUncompressedSize > ptPak->uCompressionBufferSize)
+        // chunks are decoded as the stream touches them
+        ptChild->puChunkBuffer = PL_ALLOC((size_t)ptEntry->uChunkSize);
+    }
+    else if(ptEntry->bCompressed)
+    {
+        ptChild->puDecompressed = PL_ALLOC(ptChild->szSize);
+        if(!pl__pak_decompress_entry(ptPak, ptEntry, ptChild->puDecompressed))
         {
-
-            if(ptPak->puCompressionBuffer) // first allocation
-            {
-                PL_FREE(ptPak->puCompressionBuffer);
-                ptPak->puCompressionBuffer = NULL;
-            }
-            
-            ptPak->uCompressionBufferSize = ptEntry->uUncompressedSize;
-            ptPak->puCompressionBuffer = PL_ALLOC(ptPak->uCompressionBufferSize);
-            memset(ptPak->puCompressionBuffer, 0, ptPak->uCompressionBufferSize);
+            PL_FREE(ptChild->puDecompressed);
+            PL_FREE(ptChild);
+            return NULL;
         }
-        fread(ptPak->puCompressionBuffer, 1, ptEntry->uCompressedSize, ptPak->ptFile);
-        uint64_t uDecompressedSize = gptCompress->decompress(ptPak->puCompressionBuffer, (uint32_t)ptEntry->uCompressedSize, ptEntry->puCompressionStreamBuffer, (uint32_t)ptEntry->uUncompressedSize);
+        ptChild->puData = ptChild->puDecompressed;
     }
     else
-    {
-        fseek(ptPak->ptFile, (long)ptEntry->uOffset, SEEK_SET);
-    }
-    return ptEntry;
+        ptChild->puData = &ptPak->puMapping[ptEntry->uOffset];
+    return ptChild;
 }
 
 void
-pl_pak_close_file(plPakChildFile* ptEntry)
+pl_pak_close_file(plPakChildFile* ptChild)
 {
-    if(ptEntry->puCompressionStreamBuffer)
-    {
-        PL_FREE(ptEntry->puCompressionStreamBuffer);
-        ptEntry->puCompressionStreamBuffer = NULL;
-    }
-    ptEntry->szOffsetPointer = 0;
+    if(ptChild->puDecompressed)
+        PL_FREE(ptChild->puDecompressed);
+    if(ptChild->puChunkBuffer)
+        PL_FREE(ptChild->puChunkBuffer);
+    PL_FREE(ptChild);
 }
 
 size_t
-pl_pak_read_file_stream(plPakChildFile* ptEntry, size_t szElementSize, size_t szElementCount, void* pDataOut)
+pl_pak_read_file_stream(plPakChildFile* ptChild, size_t szElementSize, size_t szElementCount, void* pDataOut)
 {
-    if(pDataOut == NULL)
+    if(pDataOut == NULL || szElementSize == 0 || ptChild->szOffsetPointer >= ptChild->szSize)
         return 0;
 
-    fseek(ptEntry->ptParentPak->ptFile, (long)ptEntry->uOffset, SEEK_SET);
-    if(ptEntry->bCompressed)
+    // same semantics as fread (whole elements only)
+    const size_t szAvailableCount = (ptChild->szSize - ptChild->szOffsetPointer) / szElementSize;
+    if(szElementCount > szAvailableCount)
+        szElementCount = szAvailableCount;
+
+    const size_t szByteSize = szElementCount * szElementSize;
+    const plPakEntry* ptEntry = ptChild->ptEntry;
+    if(ptEntry->uChunkSize == 0)
     {
-        size_t szPotentialOffsetPointer = ptEntry->szOffsetPointer + szElementCount * szElementSize;
-        if(szPotentialOffsetPointer >= ptEntry->uUncompressedSize)
-            return 0;
-        memcpy(pDataOut, &ptEntry->puCompressionStreamBuffer[ptEntry->szOffsetPointer], szElementCount * szElementSize);
-        ptEntry->szOffsetPointer = szPotentialOffsetPointer;
-        return szElementCount * szElementSize;
+        memcpy(pDataOut, &ptChild->puData[ptChild->szOffsetPointer], szByteSize);
+        ptChild->szOffsetPointer += szByteSize;
+        return szElementCount;
     }
-    else
+
+    // only decode the chunks touched
+    uint8_t* puDataOut = pDataOut;
+    size_t szCopied = 0;
+    while(szCopied < szByteSize)
     {
-        fseek(ptEntry->ptParentPak->ptFile, (long)(ptEntry->uOffset + ptEntry->szOffsetPointer), SEEK_SET);
-        return fread(pDataOut, szElementSize, szElementCount, ptEntry->ptParentPak->ptFile);
+        const uint64_t uChunk = ptChild->szOffsetPointer / ptEntry->uChunkSize;
+        if(uChunk != ptChild->uChunkIndex)
+        {
+            if(!pl__pak_decode_chunk(ptChild->ptParentPak, ptEntry, uChunk, ptChild->puChunkBuffer, &ptChild->puChunkData))
+            {
+                ptChild->uChunkIndex = UINT64_MAX;
+                break;
+            }
+            ptChild->uChunkIndex = uChunk;
+        }
+        const uint64_t uChunkOffset = ptChild->szOffsetPointer - uChunk * ptEntry->uChunkSize;
+        const uint64_t uRemainingSize = ptEntry->uUncompressedSize - uChunk * ptEntry->uChunkSize;
+        const uint64_t uChunkSize = uRemainingSize < ptEntry->uChunkSize ? uRemainingSize : ptEntry->uChunkSize;
+        const size_t szCopySize = (size_t)(uChunkSize - uChunkOffset < szByteSize - szCopied ? uChunkSize - uChunkOffset : szByteSize - szCopied);
+        memcpy(&puDataOut[szCopied], &ptChild->puChunkData[uChunkOffset], szCopySize);
+        szCopied += szCopySize;
+        ptChild->szOffsetPointer += szCopySize;
     }
+    return szCopied / szElementSize;
 }
 
 size_t
-pl_pak_get_file_stream_position(plPakChildFile* ptEntry)
+pl_pak_get_file_stream_position(plPakChildFile* ptChild)
 {
-    return ptEntry->szOffsetPointer;
+    return ptChild->szOffsetPointer;
 }
 
 void
-pl_pak_reset_file_stream_position(plPakChildFile* ptEntry)
+pl_pak_reset_file_stream_position(plPakChildFile* ptChild)
 {
-    ptEntry->szOffsetPointer = 0;
+    ptChild->szOffsetPointer = 0;
 }
 
 void
-pl_pak_set_file_stream_position(plPakChildFile* ptEntry, size_t szOffset)
+pl_pak_set_file_stream_position(plPakChildFile* ptChild, size_t szOffset)
 {
-    ptEntry->szOffsetPointer = szOffset;
+    ptChild->szOffsetPointer = szOffset;
 }
 
 void
-pl_pak_increment_file_stream_position(plPakChildFile* ptEntry, size_t szDelta)
+pl_pak_increment_file_stream_position(plPakChildFile* ptChild, size_t szDelta)
 {
-    ptEntry->szOffsetPointer += szDelta;
+    ptChild->szOffsetPointer += szDelta;
 }
 
 //-----------------------------------------------------------------------------
@@ -486,12 +869,15 @@ pl_load_pak_ext(plApiRegistryI* ptApiRegistry, bool bReload)
         .begin_packing                  = pl_pak_begin_packing,
         .add_from_disk                  = pl_pak_add_from_disk,
         .add_from_memory                = pl_pak_add_from_memory,
+        .add_from_disk_ex               = pl_pak_add_from_disk_ex,
+        .add_from_memory_ex             = pl_pak_add_from_memory_ex,
         .end_packing                    = pl_pak_end_packing,
         .load                           = pl_pak_load,
         .unload                         = pl_pak_unload,
         .open_file                      = pl_pak_open_file,
         .close_file                     = pl_pak_close_file,
         .read_file                      = pl_pak_read_file,
+        .get_file_view                  = pl_pak_get_file_view,
         .read_file_stream               = pl_pak_read_file_stream,
         .get_file_stream_position       = pl_pak_get_file_stream_position,
         .reset_file_stream_position     = pl_pak_reset_file_stream_position,
@@ -508,6 +894,7 @@ pl_load_pak_ext(plApiRegistryI* ptApiRegistry, bool bReload)
         gptMemory   = pl_get_api_latest(ptApiRegistry, plMemoryI);
         gptVfs      = pl_get_api_latest(ptApiRegistry, plVfsI);
         gptCompress = pl_get_api_latest(ptApiRegistry, plCompressI);
+        gptJob      = pl_get_api_latest(ptApiRegistry, plJobI);
     #endif
 }
 
@@ -13,6 +13,7 @@ Index of this file:
 // [SECTION] public api
 // [SECTION] public api struct
 // [SECTION] structs
+// [SECTION] enums
 */
 
 //-----------------------------------------------------------------------------
@@ -26,7 +27,25 @@ Index of this file:
         APIs being available:
 
         * plVfsI      (v2.x)
-        * plCompressI (v1.x)
+        * plCompressI (v1.2+)
+        * plJobI      (v3.x, optional: parallel compression when packing)
+
+    Compression:
+        Entries can be compressed with either plCompressI codec. The codec is
+        stored in the compressed stream so readers don't need to know it.
+        PL_PAK_ENTRY_FLAGS_COMPRESS favors size, PL_PAK_ENTRY_FLAGS_COMPRESS_FAST
+        favors load time. Compressed entries are stored as independent 64KB
+        chunks so streams ("open_file") only decompress the chunks they read
+        (seeking is cheap). Compression happens in parallel during packing
+        when plJobI is initialized, so compressed data added from memory is
+        copied until then.
+
+    Reading:
+        Loaded paks are memory mapped. Once loaded, "read_file", "get_file_view"
+        & "open_file" are safe to call from multiple threads (each child file
+        has its own stream position, don't share one between threads).
+        "get_file_view" returns a pointer directly into the mapping for
+        uncompressed entries (valid until "unload"). Offsets & sizes are 64 bit.
 */
 
 //-----------------------------------------------------------------------------
@@ -44,7 +63,7 @@ extern "C" {
 // [SECTION] APIs
 //-----------------------------------------------------------------------------
 
-#define plPakI_version {1, 2, 0}
+#define plPakI_version {2, 0, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -65,6 +84,9 @@ typedef struct _plPakInfo      plPakInfo;
 typedef struct _plPakEntryInfo plPakEntryInfo;
 typedef struct _plPakChildFile plPakChildFile;
 
+// enums/flags
+typedef int plPakEntryFlags; // -> enum _plPakEntryFlags // Flags:
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api
 //-----------------------------------------------------------------------------
@@ -77,14 +99,19 @@ PL_API void pl_unload_pak_ext(plApiRegistryI*, bool reload);
 PL_API bool            pl_pak_begin_packing  (const char* file, uint32_t contentVersion, plPakFile**);
 PL_API bool            pl_pak_add_from_disk  (plPakFile*, const char* pakPath, const char* filePath, bool compress);
 PL_API void            pl_pak_add_from_memory(plPakFile*, const char* pakPath, uint8_t* fileData, size_t fileByteSize, bool compress);
+PL_API bool            pl_pak_add_from_disk_ex  (plPakFile*, const char* pakPath, const char* filePath, plPakEntryFlags);
+PL_API void            pl_pak_add_from_memory_ex(plPakFile*, const char* pakPath, uint8_t* fileData, size_t fileByteSize, plPakEntryFlags);
 PL_API void            pl_pak_end_packing    (plPakFile**);
 
 // unpacking
 PL_API bool            pl_pak_load     (const char* file, plPakInfo*, plPakFile**);
 PL_API void            pl_pak_unload   (plPakFile**);
 PL_API bool            pl_pak_read_file(plPakFile*, const char* file, uint8_t* bufferOut, size_t* fileByteSizeOut);
+PL_API bool            pl_pak_get_file_view(plPakFile*, const char* file, const uint8_t** dataOut, size_t* fileByteSizeOut);
 
 // streaming usage
+//   - each "open_file" returns a new child file, "close_file" releases it (invalid afterwards)
+//   - "read_file_stream" behaves like fread (returns elements read & advances the position)
 PL_API plPakChildFile* pl_pak_open_file                     (plPakFile*, const char* file);
 PL_API void            pl_pak_close_file                    (plPakChildFile*);
 PL_API size_t          pl_pak_read_file_stream              (plPakChildFile*, size_t elementSize, size_t elementCount, void* bufferOut);
@@ -125,7 +152,22 @@ typedef struct _plPakI
 
     bool (*get_file)(plPakFile*, const char* file, uint8_t* bufferOut, size_t* fileByteSizeOut);
     
+    #else
+    
+    void* _pObsolete0; // keeps layout of members below
+    
     #endif // PL_DISABLE_OBSOLETE
+
+    //-----------------------------v1.3.0------------------------------------------
+
+    // packing (per entry codec)
+    bool (*add_from_disk_ex)  (plPakFile*, const char* pakPath, const char* filePath, plPakEntryFlags);
+    void (*add_from_memory_ex)(plPakFile*, const char* pakPath, uint8_t* fileData, size_t fileByteSize, plPakEntryFlags);
+
+    //-----------------------------v2.0.0------------------------------------------
+
+    // unpacking (zero copy)
+    bool (*get_file_view)(plPakFile*, const char* file, const uint8_t** dataOut, size_t* fileByteSizeOut); // uncompressed entries only (returns false otherwise)
 } plPakI;
 
 //-----------------------------------------------------------------------------
@@ -146,6 +188,17 @@ typedef struct _plPakInfo
     plPakEntryInfo* atEntries;
 } plPakInfo;
 
+//-----------------------------------------------------------------------------
+// [SECTION] enums
+//-----------------------------------------------------------------------------
+
+enum _plPakEntryFlags
+{
+    PL_PAK_ENTRY_FLAGS_NONE          = 0,
+    PL_PAK_ENTRY_FLAGS_COMPRESS      = 1 << 0, // default codec (smaller)
+    PL_PAK_ENTRY_FLAGS_COMPRESS_FAST = 1 << 1, // fast codec (faster decompression)
+};
+
 #ifdef __cplusplus
 }
 #endif
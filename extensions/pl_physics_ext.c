@@ -16,6 +16,8 @@ Index of this file:
 // [SECTION] misc. helpers
 // [SECTION] public api implementation
 // [SECTION] internal api implementation
+// [SECTION] broad phase
+// [SECTION] islands
 // [SECTION] extension loading
 */
 
@@ -45,8 +47,20 @@ Index of this file:
     * Many of the function currently use the context implicitly. I'd like
       to make the functions rely only on arguments.
 
-    * Currently we are not doing a broad pass but we need to immediately
-      start work on this with a BVH system.
+    * The broad phase is sweep-and-prune over primitive AABBs. The sort
+      order along the sweep axis persists between steps and is repaired with
+      insertion sort (nearly sorted from frame to frame). The sweep axis is
+      re-chosen by center variance with some hysteresis. Candidate pairs are
+      emitted in (lower index, higher index) order so narrow phase contact
+      order is deterministic.
+
+    * Contacts are partitioned into islands (union-find over dynamic bodies;
+      static & kinematic bodies don't join islands since the solver never
+      moves them). Islands are solved independently using plJobI (serially
+      if the job system isn't running). Contacts keep their detection order
+      within an island so results only depend on the partition, not on
+      thread scheduling. Islands where every dynamic body is asleep (and no
+      kinematic body is moving into them) are skipped.
 */
 
 //-----------------------------------------------------------------------------
@@ -54,6 +68,8 @@ Index of this file:
 //-----------------------------------------------------------------------------
 
 #include <float.h>
+#include <stdlib.h> // qsort
+#include <string.h> // memset
 #include <stdbool.h>
 #include "pl.h"
 #include "pl_physics_ext.h"
@@ -68,6 +84,7 @@ Index of this file:
 #include "pl_ecs_ext.h"
 #include "pl_animation_ext.h"
 #include "pl_collision_ext.h"
+#include "pl_job_ext.h"
 
 #define PL_MATH_INCLUDE_FUNCTIONS
 #include "pl_math.h"
@@ -93,6 +110,7 @@ Index of this file:
     static const plLogI*       gptLog       = NULL;
     static const plStatsI*     gptStats     = NULL;
     static const plCollisionI* gptCollision = NULL;
+    static const plJobI*       gptJob       = NULL;
 #endif
 
 #include "pl_ds.h"
@@ -107,6 +125,10 @@ typedef struct _plRigidBody          plRigidBody;
 typedef struct _plContact            plContact;
 typedef struct _plContactResolver    plContactResolver;
 typedef struct _plCollisionPrimitive plCollisionPrimitive;
+typedef struct _plBroadPhaseProxy    plBroadPhaseProxy;
+typedef struct _plBroadPhasePair     plBroadPhasePair;
+typedef struct _plPhysicsIsland      plPhysicsIsland;
+typedef struct _plPhysicsIslandJobData plPhysicsIslandJobData;
 
 // enums
 typedef int plCollisionPrimitiveType;
@@ -198,6 +220,34 @@ typedef struct _plCollisionPrimitive
     float  fOffset;
 } plCollisionPrimitive;
 
+typedef struct _plBroadPhaseProxy
+{
+    plVec3 tMin;
+    plVec3 tMax;
+} plBroadPhaseProxy;
+
+typedef struct _plBroadPhasePair
+{
+    uint32_t uPrimitive0; // always lower index
+    uint32_t uPrimitive1;
+} plBroadPhasePair;
+
+typedef struct _plPhysicsIsland
+{
+    uint32_t uContactStart; // into sbtContactArray (after partitioning)
+    uint32_t uContactCount;
+    bool     bAwake; // any dynamic body awake (or kinematic body moving)
+
+    // results
+    uint32_t uPositionIterations;
+    uint32_t uVelocityIterations;
+} plPhysicsIsland;
+
+typedef struct _plPhysicsIslandJobData
+{
+    float fDeltaTime;
+} plPhysicsIslandJobData;
+
 typedef struct _plPhysicsContext
 {
     // admin data
@@ -211,6 +261,19 @@ typedef struct _plPhysicsContext
     plCollisionPrimitive* sbtPrimitives;
     plContact*            sbtContactArray;
 
+    // broad phase
+    plBroadPhaseProxy* sbtProxies;      // aligned with sbtPrimitives
+    uint32_t*          sbuSortedProxies; // persistent sweep order
+    uint32_t           uSweepAxis;
+    plBroadPhasePair*  sbtPairs;
+
+    // islands
+    uint32_t*        sbuIslandParents; // union-find (per rigid body)
+    uint32_t*        sbuBodyIslands;    // island per union-find root
+    uint32_t*        sbuContactIslands; // island per contact
+    plPhysicsIsland* sbtIslands;
+    plContact*       sbtContactScratch;
+
     // ecs
     plEcsTypeKey tRigidBodyPhysicsComponentType;
     plEcsTypeKey tForceFieldComponentType;
@@ -227,7 +290,10 @@ static plPhysicsContext* gptPhysicsCtx = NULL;
 //-----------------------------------------------------------------------------
 
 static void pl__detect_collisions(float fDeltaTime, plComponentLibrary*);
+static void pl__broad_phase(void);
 static void pl__resolve_contacts(float fDeltaTime);
+static void pl__build_islands(void);
+static void pl__solve_island_job(plInvocationData, void* pData, void* pGroupSharedMemory);
 static void pl__physics_integrate(float fDeltaTime, plRigidBody* atBodies, uint32_t uBodyCount);
 
 static void pl__physics_update_force_fields(float fDeltaTime, plComponentLibrary*);
@@ -255,9 +321,9 @@ static void   pl__contact_apply_position_change           (plContact*, plVec3 at
 static plVec3 pl__contact_calculate_frictionless_impulse  (plContact*, plMat3* ptInverseInertiaTensor);
 static plVec3 pl__contact_calculate_friction_impulse      (plContact*, plMat3* ptInverseInertiaTensor);
 
-// contact resolver
-static void  pl__contact_adjust_positions (float fDeltaTime);
-static void  pl__contact_adjust_velocities(float fDeltaTime);
+// contact resolver (operate on a single island's contacts, return iterations used)
+static uint32_t pl__contact_adjust_positions (plContact*, uint32_t uContactCount);
+static uint32_t pl__contact_adjust_velocities(plContact*, uint32_t uContactCount, float fDeltaTime);
 
 //-----------------------------------------------------------------------------
 // [SECTION] misc. helpers
@@ -391,6 +457,14 @@ pl_physics_cleanup(void)
     pl_sb_free(gptPhysicsCtx->sbtRigidBodies);
     pl_sb_free(gptPhysicsCtx->sbtContactArray);
     pl_sb_free(gptPhysicsCtx->sbtPrimitives);
+    pl_sb_free(gptPhysicsCtx->sbtProxies);
+    pl_sb_free(gptPhysicsCtx->sbuSortedProxies);
+    pl_sb_free(gptPhysicsCtx->sbtPairs);
+    pl_sb_free(gptPhysicsCtx->sbuIslandParents);
+    pl_sb_free(gptPhysicsCtx->sbuBodyIslands);
+    pl_sb_free(gptPhysicsCtx->sbuContactIslands);
+    pl_sb_free(gptPhysicsCtx->sbtIslands);
+    pl_sb_free(gptPhysicsCtx->sbtContactScratch);
 }
 
 void
@@ -1142,25 +1216,27 @@ pl__detect_collisions(float fDeltaTime, plComponentLibrary* ptLibrary)
         }
     }
 
-    // very nasty hack but checking collision between all objects (we need to add
-    // a broad pass ASAP)
-    for(uint32_t i = 0; i < uRigidBodyCount - 1; i++)
+    // broad phase (candidate pairs with overlapping AABBs & at least one awake body)
+    pl__broad_phase();
+
+    // narrow phase
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, "Narrow Phase");
+    const uint32_t uPairCount = pl_sb_size(gptPhysicsCtx->sbtPairs);
+    for(uint32_t uPair = 0; uPair < uPairCount; uPair++)
     {
-        for(uint32_t j = i + 1; j < uRigidBodyCount; j++)
-        {
-            if(gptPhysicsCtx->sbtRigidBodies[gptPhysicsCtx->sbtPrimitives[i].uBodyIndex].bIsAwake || gptPhysicsCtx->sbtRigidBodies[gptPhysicsCtx->sbtPrimitives[j].uBodyIndex].bIsAwake)
-            {
-                if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX)
-                    pl__collision_box_box(&gptPhysicsCtx->sbtPrimitives[i], &gptPhysicsCtx->sbtPrimitives[j]);
-                else if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE)
-                    pl__collision_box_sphere(&gptPhysicsCtx->sbtPrimitives[i], &gptPhysicsCtx->sbtPrimitives[j]);
-                else if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX)
-                    pl__collision_box_sphere(&gptPhysicsCtx->sbtPrimitives[j], &gptPhysicsCtx->sbtPrimitives[i]);
-                else if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE)
-                    pl__collision_sphere_sphere(&gptPhysicsCtx->sbtPrimitives[i], &gptPhysicsCtx->sbtPrimitives[j]);
-            }
-        }
+        const uint32_t i = gptPhysicsCtx->sbtPairs[uPair].uPrimitive0;
+        const uint32_t j = gptPhysicsCtx->sbtPairs[uPair].uPrimitive1;
+
+        if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX)
+            pl__collision_box_box(&gptPhysicsCtx->sbtPrimitives[i], &gptPhysicsCtx->sbtPrimitives[j]);
+        else if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE)
+            pl__collision_box_sphere(&gptPhysicsCtx->sbtPrimitives[i], &gptPhysicsCtx->sbtPrimitives[j]);
+        else if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_BOX)
+            pl__collision_box_sphere(&gptPhysicsCtx->sbtPrimitives[j], &gptPhysicsCtx->sbtPrimitives[i]);
+        else if(gptPhysicsCtx->sbtPrimitives[i].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE && gptPhysicsCtx->sbtPrimitives[j].tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE)
+            pl__collision_sphere_sphere(&gptPhysicsCtx->sbtPrimitives[i], &gptPhysicsCtx->sbtPrimitives[j]);
     }
+    PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
 
     PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
 }
@@ -1507,21 +1583,23 @@ pl__contact_match_awake_state(plContact* ptContact)
     bool bBody0Awake = ptBody0->bIsAwake;
     bool bBody1Awake = ptBody1->bIsAwake;
     
-    // wake up only sleeping one
+    // wake up only sleeping one (non-dynamic bodies are shared between
+    // islands & are never woken by contacts)
     if(bBody0Awake ^ bBody1Awake)
     {
         if(bBody0Awake)
-            pl__set_awake(ptBody1, true);
-        else
+        {
+            if(ptBody1->tMotionType == PL_RIGID_BODY_MOTION_TYPE_DYNAMIC)
+                pl__set_awake(ptBody1, true);
+        }
+        else if(ptBody0->tMotionType == PL_RIGID_BODY_MOTION_TYPE_DYNAMIC)
             pl__set_awake(ptBody0, true);
     }
 }
 
-static void
-pl__contact_adjust_positions(float fDeltaTime)
+static uint32_t
+pl__contact_adjust_positions(plContact* atContacts, uint32_t uContactCount)
 {
-    const uint32_t uContactCount = pl_sb_size(gptPhysicsCtx->sbtContactArray);
-
     plVec3 atLinearChange[2] = {0};
     plVec3 atAngularChange[2] = {0};
     plVec3 tDeltaPosition = {0};
@@ -1537,9 +1615,9 @@ pl__contact_adjust_positions(float fDeltaTime)
         uIndex = uContactCount;
         for(uint32_t i = 0; i < uContactCount; i++)
         {
-            if(gptPhysicsCtx->sbtContactArray[i].fPenetration > fMax)
+            if(atContacts[i].fPenetration > fMax)
             {
-                fMax = gptPhysicsCtx->sbtContactArray[i].fPenetration;
+                fMax = atContacts[i].fPenetration;
                 uIndex = i;
             }
         }
@@ -1548,10 +1626,10 @@ pl__contact_adjust_positions(float fDeltaTime)
             break;
         
         // match awake state at contact
-        pl__contact_match_awake_state(&gptPhysicsCtx->sbtContactArray[uIndex]);
+        pl__contact_match_awake_state(&atContacts[uIndex]);
 
         // resolve penetration
-        pl__contact_apply_position_change(&gptPhysicsCtx->sbtContactArray[uIndex], atLinearChange, atAngularChange, fMax);
+        pl__contact_apply_position_change(&atContacts[uIndex], atLinearChange, atAngularChange, fMax);
 
         // Again this action may have changed the penetration of other
         // bodies, so we update contacts.
@@ -1561,10 +1639,10 @@ pl__contact_adjust_positions(float fDeltaTime)
             for (uint32_t b = 0; b < 2; b++)
             {
 
-                if(gptPhysicsCtx->sbtContactArray[i].atBodyIndices[b] == UINT32_MAX)
+                if(atContacts[i].atBodyIndices[b] == UINT32_MAX)
                     continue;
 
-                plRigidBody* ptBody = &gptPhysicsCtx->sbtRigidBodies[gptPhysicsCtx->sbtContactArray[i].atBodyIndices[b]];
+                plRigidBody* ptBody = &gptPhysicsCtx->sbtRigidBodies[atContacts[i].atBodyIndices[b]];
 
                 if(ptBody->tMotionType != PL_RIGID_BODY_MOTION_TYPE_DYNAMIC)
                     continue;
@@ -1573,34 +1651,28 @@ pl__contact_adjust_positions(float fDeltaTime)
                 // resolved contact
                 for (uint32_t d = 0; d < 2; d++)
                 {
-                    if (gptPhysicsCtx->sbtContactArray[i].atBodyIndices[b] == gptPhysicsCtx->sbtContactArray[uIndex].atBodyIndices[d])
+                    if (atContacts[i].atBodyIndices[b] == atContacts[uIndex].atBodyIndices[d])
                     {
-                        tDeltaPosition = pl_cross_vec3(atAngularChange[d], gptPhysicsCtx->sbtContactArray[i].atRelativeContactPositions[b]);
+                        tDeltaPosition = pl_cross_vec3(atAngularChange[d], atContacts[i].atRelativeContactPositions[b]);
                         tDeltaPosition = pl_add_vec3(tDeltaPosition, atLinearChange[d]);
 
                         // The sign of the change is positive if we're
                         // dealing with the second body in a contact
                         // and negative otherwise (because we're
                         // subtracting the resolution).
-                        gptPhysicsCtx->sbtContactArray[i].fPenetration += pl_dot_vec3(tDeltaPosition, gptPhysicsCtx->sbtContactArray[i].tContactNormal) * (b ? 1.0f : -1.0f);
+                        atContacts[i].fPenetration += pl_dot_vec3(tDeltaPosition, atContacts[i].tContactNormal) * (b ? 1.0f : -1.0f);
                     }
                 }
             }
         }
         uPositionIterationsUsed++;
     }
-
-    static double* pdPosCount = NULL;
-    if(!pdPosCount)
-        pdPosCount = gptStats->get_counter("physics position its.");
-    *pdPosCount = (double)uPositionIterationsUsed;
+    return uPositionIterationsUsed;
 }
 
-static void
-pl__contact_adjust_velocities(float fDeltaTime)
+static uint32_t
+pl__contact_adjust_velocities(plContact* atContacts, uint32_t uContactCount, float fDeltaTime)
 {
-    const uint32_t uContactCount = pl_sb_size(gptPhysicsCtx->sbtContactArray);
-
     plVec3 atVelocityChange[2] = {0};
     plVec3 atRotationChange[2] = {0};
     plVec3 tDeltaVelocity = {0};
@@ -1616,9 +1688,9 @@ pl__contact_adjust_velocities(float fDeltaTime)
         uIndex = uContactCount;
         for (uint32_t i = 0; i < uContactCount; i++)
         {
-            if (gptPhysicsCtx->sbtContactArray[i].fDesiredDeltaVelocity > fMax)
+            if (atContacts[i].fDesiredDeltaVelocity > fMax)
             {
-                fMax = gptPhysicsCtx->sbtContactArray[i].fDesiredDeltaVelocity;
+                fMax = atContacts[i].fDesiredDeltaVelocity;
                 uIndex = i;
             }
         }
@@ -1626,10 +1698,10 @@ pl__contact_adjust_velocities(float fDeltaTime)
             break;
 
         // match awake state at contact
-        pl__contact_match_awake_state(&gptPhysicsCtx->sbtContactArray[uIndex]);
+        pl__contact_match_awake_state(&atContacts[uIndex]);
 
         // Do the resolution on the contact that came out top.
-        pl__contact_apply_velocity_change(&gptPhysicsCtx->sbtContactArray[uIndex], atVelocityChange, atRotationChange);
+        pl__contact_apply_velocity_change(&atContacts[uIndex], atVelocityChange, atRotationChange);
 
         // With the change in velocity of the two bodies, the update of
         // contact velocities means that some of the relative closing
@@ -1639,10 +1711,10 @@ pl__contact_adjust_velocities(float fDeltaTime)
             // Check each body in the contact
             for (uint32_t b = 0; b < 2; b++)
             {
-                if(gptPhysicsCtx->sbtContactArray[i].atBodyIndices[b] == UINT32_MAX)
+                if(atContacts[i].atBodyIndices[b] == UINT32_MAX)
                     continue;
 
-                plRigidBody* ptBody = &gptPhysicsCtx->sbtRigidBodies[gptPhysicsCtx->sbtContactArray[i].atBodyIndices[b]];
+                plRigidBody* ptBody = &gptPhysicsCtx->sbtRigidBodies[atContacts[i].atBodyIndices[b]];
 
                 if(ptBody->tMotionType != PL_RIGID_BODY_MOTION_TYPE_DYNAMIC)
                     continue;
@@ -1651,33 +1723,29 @@ pl__contact_adjust_velocities(float fDeltaTime)
                 // resolved contact
                 for (uint32_t d = 0; d < 2; d++)
                 {
-                    if (gptPhysicsCtx->sbtContactArray[i].atBodyIndices[b] == gptPhysicsCtx->sbtContactArray[uIndex].atBodyIndices[d])
+                    if (atContacts[i].atBodyIndices[b] == atContacts[uIndex].atBodyIndices[d])
                     {
-                        tDeltaVelocity = pl_cross_vec3(atRotationChange[d], gptPhysicsCtx->sbtContactArray[i].atRelativeContactPositions[b]);
+                        tDeltaVelocity = pl_cross_vec3(atRotationChange[d], atContacts[i].atRelativeContactPositions[b]);
                         tDeltaVelocity = pl_add_vec3(tDeltaVelocity, atVelocityChange[d]);
 
                         // The sign of the change is negative if we're dealing
                         // with the second body in a contact.
-                        plMat3 tContactToWorldTranspose = pl_mat3_invert(&gptPhysicsCtx->sbtContactArray[i].tContactToWorld);
+                        plMat3 tContactToWorldTranspose = pl_mat3_invert(&atContacts[i].tContactToWorld);
                         plVec3 tAdjustedVelocity = pl_mul_vec3_scalarf(pl_mul_mat3_vec3(&tContactToWorldTranspose, tDeltaVelocity), (b ? -1.0f : 1.0f));
 
-                        gptPhysicsCtx->sbtContactArray[i].tContactVelocity = pl_add_vec3(
-                            gptPhysicsCtx->sbtContactArray[i].tContactVelocity,
+                        atContacts[i].tContactVelocity = pl_add_vec3(
+                            atContacts[i].tContactVelocity,
                             tAdjustedVelocity
                         );
 
-                        pl__contact_calculate_desired_delta_velocity(&gptPhysicsCtx->sbtContactArray[i], fDeltaTime);
+                        pl__contact_calculate_desired_delta_velocity(&atContacts[i], fDeltaTime);
                     }
                 }
             }
         }
         uVelocityIterationsUsed++;
     }
-
-    static double* pdVelCount = NULL;
-    if(!pdVelCount)
-        pdVelCount = gptStats->get_counter("physics velocity its");
-    *pdVelCount = (double)uVelocityIterationsUsed;
+    return uVelocityIterationsUsed;
 }
 
 static void
@@ -1692,18 +1760,51 @@ pl__resolve_contacts(float fDeltaTime)
         pdContactCount = gptStats->get_counter("physics contacts");
     *pdContactCount = (double)uContactCount;
 
-    // prepare contacts for processing
-    for(uint32_t i = 0; i < uContactCount; i++)
+    // partition contacts into independent islands
+    pl__build_islands();
+
+    const uint32_t uIslandCount = pl_sb_size(gptPhysicsCtx->sbtIslands);
+    plPhysicsIslandJobData tJobData = {
+        .fDeltaTime = fDeltaTime
+    };
+
+    if(gptJob && !gptJob->is_shutting_down() && uIslandCount > 1)
     {
-        plContact* ptContact = &gptPhysicsCtx->sbtContactArray[i];
-        pl__contact_calculate_internals(ptContact, fDeltaTime);
+        plJobDesc tJobDesc = {
+            .task  = pl__solve_island_job,
+            .pData = &tJobData
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(uIslandCount, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+    }
+    else // single island (not worth a dispatch) or no job system
+    {
+        for(uint32_t i = 0; i < uIslandCount; i++)
+            pl__solve_island_job((plInvocationData){.uGlobalIndex = i}, &tJobData, NULL);
     }
 
-    // resolve the interpenetration problems with the contacts.
-    pl__contact_adjust_positions(fDeltaTime);
+    // gather results in island order
+    uint32_t uPositionIterationsUsed = 0;
+    uint32_t uVelocityIterationsUsed = 0;
+    for(uint32_t i = 0; i < uIslandCount; i++)
+    {
+        uPositionIterationsUsed += gptPhysicsCtx->sbtIslands[i].uPositionIterations;
+        uVelocityIterationsUsed += gptPhysicsCtx->sbtIslands[i].uVelocityIterations;
+    }
 
-    // resolve the velocity problems with the contacts.
-    pl__contact_adjust_velocities(fDeltaTime);
+    static double* pdIslandCount = NULL;
+    static double* pdPosCount = NULL;
+    static double* pdVelCount = NULL;
+    if(!pdIslandCount)
+    {
+        pdIslandCount = gptStats->get_counter("physics islands");
+        pdPosCount = gptStats->get_counter("physics position its.");
+        pdVelCount = gptStats->get_counter("physics velocity its");
+    }
+    *pdIslandCount = (double)uIslandCount;
+    *pdPosCount = (double)uPositionIterationsUsed;
+    *pdVelCount = (double)uVelocityIterationsUsed;
 
     PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
 }
@@ -2058,6 +2159,352 @@ pl__contact_calculate_contact_basis(plContact* ptContact)
     ptContact->tContactToWorld.col[2] = atContactTangent[1];
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] broad phase
+//-----------------------------------------------------------------------------
+
+static void
+pl__broad_phase_compute_proxy(const plCollisionPrimitive* ptPrimitive, plBroadPhaseProxy* ptProxyOut)
+{
+    const plVec3 tCenter = ptPrimitive->tTransform.col[3].xyz;
+    plVec3 tExtent = {0};
+    if(ptPrimitive->tType == PL_COLLISION_PRIMITIVE_TYPE_BOX)
+    {
+        // project rotated half size onto world axes
+        const plMat4* ptM = &ptPrimitive->tTransform;
+        const plVec3 tH = ptPrimitive->tHalfSize;
+        tExtent.x = fabsf(ptM->col[0].x) * tH.x + fabsf(ptM->col[1].x) * tH.y + fabsf(ptM->col[2].x) * tH.z;
+        tExtent.y = fabsf(ptM->col[0].y) * tH.x + fabsf(ptM->col[1].y) * tH.y + fabsf(ptM->col[2].y) * tH.z;
+        tExtent.z = fabsf(ptM->col[0].z) * tH.x + fabsf(ptM->col[1].z) * tH.y + fabsf(ptM->col[2].z) * tH.z;
+    }
+    else if(ptPrimitive->tType == PL_COLLISION_PRIMITIVE_TYPE_SPHERE)
+        tExtent = pl_create_vec3(ptPrimitive->fRadius, ptPrimitive->fRadius, ptPrimitive->fRadius);
+    else // planes are unbounded
+        tExtent = pl_create_vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+
+    ptProxyOut->tMin = pl_sub_vec3(tCenter, tExtent);
+    ptProxyOut->tMax = pl_add_vec3(tCenter, tExtent);
+}
+
+static uint32_t guSweepSortAxis = 0; // only used by qsort comparator
+
+static int
+pl__broad_phase_compare_proxies(const void* pA, const void* pB)
+{
+    const float fA = gptPhysicsCtx->sbtProxies[*(const uint32_t*)pA].tMin.d[guSweepSortAxis];
+    const float fB = gptPhysicsCtx->sbtProxies[*(const uint32_t*)pB].tMin.d[guSweepSortAxis];
+    if(fA < fB) return -1;
+    if(fA > fB) return 1;
+    return (int)*(const uint32_t*)pA - (int)*(const uint32_t*)pB;
+}
+
+static int
+pl__broad_phase_compare_pairs(const void* pA, const void* pB)
+{
+    const plBroadPhasePair* ptA = pA;
+    const plBroadPhasePair* ptB = pB;
+    if(ptA->uPrimitive0 != ptB->uPrimitive0) return ptA->uPrimitive0 < ptB->uPrimitive0 ? -1 : 1;
+    if(ptA->uPrimitive1 != ptB->uPrimitive1) return ptA->uPrimitive1 < ptB->uPrimitive1 ? -1 : 1;
+    return 0;
+}
+
+static void
+pl__broad_phase(void)
+{
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, "Broad Phase");
+
+    const uint32_t uPrimitiveCount = pl_sb_size(gptPhysicsCtx->sbtPrimitives);
+    pl_sb_reset(gptPhysicsCtx->sbtPairs);
+
+    // update bounds & pick sweep axis (largest center variance)
+    pl_sb_resize(gptPhysicsCtx->sbtProxies, uPrimitiveCount);
+    plVec3 tSum = {0};
+    plVec3 tSumSq = {0};
+    for(uint32_t i = 0; i < uPrimitiveCount; i++)
+    {
+        plBroadPhaseProxy* ptProxy = &gptPhysicsCtx->sbtProxies[i];
+        pl__broad_phase_compute_proxy(&gptPhysicsCtx->sbtPrimitives[i], ptProxy);
+        const plVec3 tCenter = gptPhysicsCtx->sbtPrimitives[i].tTransform.col[3].xyz;
+        tSum = pl_add_vec3(tSum, tCenter);
+        tSumSq = pl_add_vec3(tSumSq, pl_mul_vec3(tCenter, tCenter));
+    }
+
+    bool bFullSort = false;
+    if(pl_sb_size(gptPhysicsCtx->sbuSortedProxies) != uPrimitiveCount)
+    {
+        // primitive set changed, start from identity order
+        pl_sb_resize(gptPhysicsCtx->sbuSortedProxies, uPrimitiveCount);
+        for(uint32_t i = 0; i < uPrimitiveCount; i++)
+            gptPhysicsCtx->sbuSortedProxies[i] = i;
+        bFullSort = true;
+    }
+
+    if(uPrimitiveCount > 1)
+    {
+        const float fInvCount = 1.0f / (float)uPrimitiveCount;
+        float afVariance[3] = {0};
+        for(uint32_t uAxis = 0; uAxis < 3; uAxis++)
+        {
+            const float fMean = tSum.d[uAxis] * fInvCount;
+            afVariance[uAxis] = tSumSq.d[uAxis] * fInvCount - fMean * fMean;
+        }
+        uint32_t uBestAxis = gptPhysicsCtx->uSweepAxis;
+        for(uint32_t uAxis = 0; uAxis < 3; uAxis++)
+        {
+            if(afVariance[uAxis] > afVariance[uBestAxis])
+                uBestAxis = uAxis;
+        }
+
+        // hysteresis avoids resorting from scratch when variances are close
+        if(uBestAxis != gptPhysicsCtx->uSweepAxis && afVariance[uBestAxis] > 1.5f * afVariance[gptPhysicsCtx->uSweepAxis])
+        {
+            gptPhysicsCtx->uSweepAxis = uBestAxis;
+            bFullSort = true;
+        }
+    }
+
+    const uint32_t uAxis = gptPhysicsCtx->uSweepAxis;
+    uint32_t* auSorted = gptPhysicsCtx->sbuSortedProxies;
+    const plBroadPhaseProxy* atProxies = gptPhysicsCtx->sbtProxies;
+
+    if(bFullSort)
+    {
+        guSweepSortAxis = uAxis;
+        qsort(auSorted, uPrimitiveCount, sizeof(uint32_t), pl__broad_phase_compare_proxies);
+    }
+    else
+    {
+        // insertion sort (order is nearly sorted from last step)
+        for(uint32_t i = 1; i < uPrimitiveCount; i++)
+        {
+            const uint32_t uProxy = auSorted[i];
+            const float fMin = atProxies[uProxy].tMin.d[uAxis];
+            uint32_t j = i;
+            while(j > 0 && atProxies[auSorted[j - 1]].tMin.d[uAxis] > fMin)
+            {
+                auSorted[j] = auSorted[j - 1];
+                j--;
+            }
+            auSorted[j] = uProxy;
+        }
+    }
+
+    // sweep
+    const uint32_t uOtherAxis0 = (uAxis + 1) % 3;
+    const uint32_t uOtherAxis1 = (uAxis + 2) % 3;
+    for(uint32_t i = 0; i < uPrimitiveCount; i++)
+    {
+        const uint32_t uProxy0 = auSorted[i];
+        const plBroadPhaseProxy* ptProxy0 = &atProxies[uProxy0];
+        const bool bAwake0 = gptPhysicsCtx->sbtRigidBodies[gptPhysicsCtx->sbtPrimitives[uProxy0].uBodyIndex].bIsAwake;
+
+        for(uint32_t j = i + 1; j < uPrimitiveCount; j++)
+        {
+            const uint32_t uProxy1 = auSorted[j];
+            const plBroadPhaseProxy* ptProxy1 = &atProxies[uProxy1];
+            if(ptProxy1->tMin.d[uAxis] > ptProxy0->tMax.d[uAxis])
+                break;
+
+            if(ptProxy1->tMin.d[uOtherAxis0] > ptProxy0->tMax.d[uOtherAxis0] || ptProxy0->tMin.d[uOtherAxis0] > ptProxy1->tMax.d[uOtherAxis0] ||
+               ptProxy1->tMin.d[uOtherAxis1] > ptProxy0->tMax.d[uOtherAxis1] || ptProxy0->tMin.d[uOtherAxis1] > ptProxy1->tMax.d[uOtherAxis1])
+                continue;
+
+            // sleeping pairs can't generate new contacts
+            if(!bAwake0 && !gptPhysicsCtx->sbtRigidBodies[gptPhysicsCtx->sbtPrimitives[uProxy1].uBodyIndex].bIsAwake)
+                continue;
+
+            const plBroadPhasePair tPair = {
+                .uPrimitive0 = uProxy0 < uProxy1 ? uProxy0 : uProxy1,
+                .uPrimitive1 = uProxy0 < uProxy1 ? uProxy1 : uProxy0
+            };
+            if(pl_sb_size(gptPhysicsCtx->sbtPairs) == pl_sb_capacity(gptPhysicsCtx->sbtPairs))
+                pl_sb_reserve(gptPhysicsCtx->sbtPairs, pl_sb_capacity(gptPhysicsCtx->sbtPairs) + 64);
+            pl_sb_push(gptPhysicsCtx->sbtPairs, tPair);
+        }
+    }
+
+    // deterministic narrow phase order (matches all-pairs order)
+    qsort(gptPhysicsCtx->sbtPairs, pl_sb_size(gptPhysicsCtx->sbtPairs), sizeof(plBroadPhasePair), pl__broad_phase_compare_pairs);
+
+    static double* pdPairCount = NULL;
+    if(!pdPairCount)
+        pdPairCount = gptStats->get_counter("physics broad phase pairs");
+    *pdPairCount = (double)pl_sb_size(gptPhysicsCtx->sbtPairs);
+
+    PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] islands
+//-----------------------------------------------------------------------------
+
+static void
+pl__solve_island_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    const plPhysicsIslandJobData* ptData = pData;
+    plPhysicsIsland* ptIsland = &gptPhysicsCtx->sbtIslands[tInvoData.uGlobalIndex];
+    plContact* atContacts = &gptPhysicsCtx->sbtContactArray[ptIsland->uContactStart];
+
+    // prepare contacts for processing
+    for(uint32_t i = 0; i < ptIsland->uContactCount; i++)
+        pl__contact_calculate_internals(&atContacts[i], ptData->fDeltaTime);
+
+    // resolve the interpenetration problems with the contacts.
+    ptIsland->uPositionIterations = pl__contact_adjust_positions(atContacts, ptIsland->uContactCount);
+
+    // resolve the velocity problems with the contacts.
+    ptIsland->uVelocityIterations = pl__contact_adjust_velocities(atContacts, ptIsland->uContactCount, ptData->fDeltaTime);
+}
+
+static inline uint32_t
+pl__island_find(uint32_t* auParents, uint32_t uBody)
+{
+    // path halving
+    while(auParents[uBody] != uBody)
+    {
+        auParents[uBody] = auParents[auParents[uBody]];
+        uBody = auParents[uBody];
+    }
+    return uBody;
+}
+
+static inline void
+pl__island_union(uint32_t* auParents, uint32_t uBody0, uint32_t uBody1)
+{
+    uBody0 = pl__island_find(auParents, uBody0);
+    uBody1 = pl__island_find(auParents, uBody1);
+
+    // lower index always becomes root (deterministic)
+    if(uBody0 < uBody1)
+        auParents[uBody1] = uBody0;
+    else if(uBody1 < uBody0)
+        auParents[uBody0] = uBody1;
+}
+
+static inline bool
+pl__island_body_is_dynamic(uint32_t uBody)
+{
+    return uBody != UINT32_MAX && gptPhysicsCtx->sbtRigidBodies[uBody].tMotionType == PL_RIGID_BODY_MOTION_TYPE_DYNAMIC;
+}
+
+// static & kinematic bodies are always awake so they only keep an island
+// awake if they are moving into it
+static inline bool
+pl__island_body_wakes_island(uint32_t uBody)
+{
+    if(uBody == UINT32_MAX)
+        return false;
+    const plRigidBody* ptBody = &gptPhysicsCtx->sbtRigidBodies[uBody];
+    if(ptBody->tMotionType == PL_RIGID_BODY_MOTION_TYPE_DYNAMIC)
+        return ptBody->bIsAwake;
+    if(ptBody->tMotionType == PL_RIGID_BODY_MOTION_TYPE_KINEMATIC)
+        return pl_length_sqr_vec3(ptBody->tLinearVelocity) > 0.0f || pl_length_sqr_vec3(ptBody->tAnglularVelocity) > 0.0f;
+    return false;
+}
+
+static void
+pl__build_islands(void)
+{
+    PL_PROFILE_BEGIN_SAMPLE_API(gptProfile, 0, "Build Islands");
+
+    const uint32_t uBodyCount = pl_sb_size(gptPhysicsCtx->sbtRigidBodies);
+    const uint32_t uContactCount = pl_sb_size(gptPhysicsCtx->sbtContactArray);
+    plContact* atContacts = gptPhysicsCtx->sbtContactArray;
+
+    pl_sb_reset(gptPhysicsCtx->sbtIslands);
+    pl_sb_reserve(gptPhysicsCtx->sbtIslands, uContactCount);
+
+    pl_sb_resize(gptPhysicsCtx->sbuIslandParents, uBodyCount);
+    uint32_t* auParents = gptPhysicsCtx->sbuIslandParents;
+    for(uint32_t i = 0; i < uBodyCount; i++)
+        auParents[i] = i;
+
+    // join dynamic bodies sharing a contact
+    for(uint32_t i = 0; i < uContactCount; i++)
+    {
+        const uint32_t uBody0 = atContacts[i].atBodyIndices[0];
+        const uint32_t uBody1 = atContacts[i].atBodyIndices[1];
+        if(pl__island_body_is_dynamic(uBody0) && pl__island_body_is_dynamic(uBody1))
+            pl__island_union(auParents, uBody0, uBody1);
+    }
+
+    // assign islands in order of first appearance
+    pl_sb_resize(gptPhysicsCtx->sbuBodyIslands, uBodyCount);
+    pl_sb_resize(gptPhysicsCtx->sbuContactIslands, uContactCount);
+    uint32_t* auBodyIslands = gptPhysicsCtx->sbuBodyIslands;
+    uint32_t* auContactIslands = gptPhysicsCtx->sbuContactIslands;
+    memset(auBodyIslands, 0xFF, sizeof(uint32_t) * uBodyCount);
+    for(uint32_t i = 0; i < uContactCount; i++)
+    {
+        const uint32_t uBody0 = atContacts[i].atBodyIndices[0];
+        const uint32_t uBody1 = atContacts[i].atBodyIndices[1];
+
+        // contacts without dynamic bodies can't be resolved
+        uint32_t uBody = UINT32_MAX;
+        if(pl__island_body_is_dynamic(uBody0))
+            uBody = uBody0;
+        else if(pl__island_body_is_dynamic(uBody1))
+            uBody = uBody1;
+        if(uBody == UINT32_MAX)
+        {
+            auContactIslands[i] = UINT32_MAX;
+            continue;
+        }
+
+        const uint32_t uRoot = pl__island_find(auParents, uBody);
+        if(auBodyIslands[uRoot] == UINT32_MAX)
+        {
+            auBodyIslands[uRoot] = pl_sb_size(gptPhysicsCtx->sbtIslands);
+            pl_sb_push(gptPhysicsCtx->sbtIslands, (plPhysicsIsland){0});
+        }
+
+        plPhysicsIsland* ptIsland = &gptPhysicsCtx->sbtIslands[auBodyIslands[uRoot]];
+        auContactIslands[i] = auBodyIslands[uRoot];
+        ptIsland->uContactCount++;
+        if(pl__island_body_wakes_island(uBody0) || pl__island_body_wakes_island(uBody1))
+            ptIsland->bAwake = true;
+    }
+
+    // contiguous contact ranges per island (unsolvable contacts at the end)
+    const uint32_t uIslandCount = pl_sb_size(gptPhysicsCtx->sbtIslands);
+    uint32_t uContactOffset = 0;
+    for(uint32_t i = 0; i < uIslandCount; i++)
+    {
+        gptPhysicsCtx->sbtIslands[i].uContactStart = uContactOffset;
+        uContactOffset += gptPhysicsCtx->sbtIslands[i].uContactCount;
+        gptPhysicsCtx->sbtIslands[i].uContactCount = 0; // recounted below
+    }
+
+    // stable scatter keeps detection order within each island
+    pl_sb_resize(gptPhysicsCtx->sbtContactScratch, uContactCount);
+    for(uint32_t i = 0; i < uContactCount; i++)
+    {
+        uint32_t uDestination = 0;
+        if(auContactIslands[i] == UINT32_MAX)
+            uDestination = uContactOffset++;
+        else
+        {
+            plPhysicsIsland* ptIsland = &gptPhysicsCtx->sbtIslands[auContactIslands[i]];
+            uDestination = ptIsland->uContactStart + ptIsland->uContactCount++;
+        }
+        gptPhysicsCtx->sbtContactScratch[uDestination] = atContacts[i];
+    }
+    plContact* sbtSwap = gptPhysicsCtx->sbtContactArray;
+    gptPhysicsCtx->sbtContactArray = gptPhysicsCtx->sbtContactScratch;
+    gptPhysicsCtx->sbtContactScratch = sbtSwap;
+
+    // drop sleeping islands (order preserved)
+    uint32_t uAwakeIslandCount = 0;
+    for(uint32_t i = 0; i < uIslandCount; i++)
+    {
+        if(gptPhysicsCtx->sbtIslands[i].bAwake)
+            gptPhysicsCtx->sbtIslands[uAwakeIslandCount++] = gptPhysicsCtx->sbtIslands[i];
+    }
+    pl_sb_resize(gptPhysicsCtx->sbtIslands, uAwakeIslandCount);
+
+    PL_PROFILE_END_SAMPLE_API(gptProfile, 0);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] extension loading
 //-----------------------------------------------------------------------------
@@ -2096,6 +2543,7 @@ pl_load_physics_ext(plApiRegistryI* ptApiRegistry, bool bReload)
 
     #ifndef PL_UNITY_BUILD
         gptMemory    = pl_get_api_latest(ptApiRegistry, plMemoryI);
+        gptJob       = pl_get_api_latest(ptApiRegistry, plJobI);
         gptECS       = pl_get_api_latest(ptApiRegistry, plEcsI);
         gptDraw      = pl_get_api_latest(ptApiRegistry, plDrawI);
         gptProfile   = pl_get_api_latest(ptApiRegistry, plProfileI);
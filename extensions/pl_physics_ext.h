@@ -48,7 +48,7 @@ extern "C" {
 // [SECTION] APIs
 //-----------------------------------------------------------------------------
 
-#define plPhysicsI_version {0, 2, 0}
+#define plPhysicsI_version {0, 2, 2}
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
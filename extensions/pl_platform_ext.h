@@ -40,7 +40,7 @@ extern "C" {
 //-----------------------------------------------------------------------------
 
 #define plTimerI_version         {1, 0, 0}
-#define plAtomicsI_version       {2, 0, 0}
+#define plAtomicsI_version       {2, 0, 1}
 #define plFileI_version          {2, 0, 0}
 #define plNetworkI_version       {1, 0, 0}
 #define plThreadsI_version       {1, 0, 1}
@@ -172,8 +172,8 @@ PL_API void            pl_atomics_destroy_counter (plAtomicCounter**);
 PL_API void            pl_atomics_store           (plAtomicCounter*, int64_t value);
 PL_API int64_t         pl_atomics_load            (plAtomicCounter*);
 PL_API bool            pl_atomics_compare_exchange(plAtomicCounter*, int64_t expectedValue, int64_t desiredValue);
-PL_API int64_t         pl_atomics_increment       (plAtomicCounter*);
-PL_API int64_t         pl_atomics_decrement       (plAtomicCounter*);
+PL_API int64_t         pl_atomics_increment       (plAtomicCounter*); // returns previous value
+PL_API int64_t         pl_atomics_decrement       (plAtomicCounter*); // returns previous value
 
 //-----------------------------threads api-------------------------------------
 
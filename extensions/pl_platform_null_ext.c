@@ -469,7 +469,7 @@ int64_t
 pl_atomics_increment(plAtomicCounter* ptCounter)
 {
     #ifdef PL_PLATFORM_WINDOWS
-        return InterlockedIncrement64(&ptCounter->ilValue);
+        return InterlockedIncrement64(&ptCounter->ilValue) - 1; // match posix (previous value)
     #else
         return atomic_fetch_add(&ptCounter->ilValue, 1);
     #endif
@@ -479,7 +479,7 @@ int64_t
 pl_atomics_decrement(plAtomicCounter* ptCounter)
 {
     #ifdef PL_PLATFORM_WINDOWS
-        return InterlockedDecrement64(&ptCounter->ilValue);
+        return InterlockedDecrement64(&ptCounter->ilValue) + 1; // match posix (previous value)
     #else
         return atomic_fetch_sub(&ptCounter->ilValue, 1);
     #endif
@@ -1030,13 +1030,13 @@ pl_atomics_compare_exchange(plAtomicCounter* ptCounter, int64_t ilExpectedValue,
 int64_t
 pl_atomics_increment(plAtomicCounter* ptCounter)
 {
-    return InterlockedIncrement64(&ptCounter->ilValue);
+    return InterlockedIncrement64(&ptCounter->ilValue) - 1; // match posix (previous value)
 }
 
 int64_t
 pl_atomics_decrement(plAtomicCounter* ptCounter)
 {
-    return InterlockedDecrement64(&ptCounter->ilValue);
+    return InterlockedDecrement64(&ptCounter->ilValue) + 1; // match posix (previous value)
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+/*
+   pl_renderer_culling.c
+     - drawable bounds (SoA) & culling jobs (kernels in pl_renderer_culling.inl)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] bounds update
+// [SECTION] job system tasks
+// [SECTION] culling
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_renderer_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] bounds update
+//-----------------------------------------------------------------------------
+
+static void
+pl__renderer_cull_bounds_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plScene* ptScene = pData;
+    plCullBounds* ptBounds = &ptScene->tCullBounds;
+
+    const uint32_t uStart = tInvoData.uGlobalIndex * PL_CULL_BLOCK_SIZE;
+    const uint32_t uEnd = pl_min(uStart + PL_CULL_BLOCK_SIZE, ptBounds->uCount);
+    for(uint32_t i = uStart; i < uEnd; i++)
+    {
+        const plDrawable* ptDrawable = &ptScene->sbtDrawables[i];
+        const plObjectComponent* ptObject = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, ptDrawable->tEntity);
+
+        uint32_t uFlags = PL_CULL_BOUNDS_FLAG_NONE;
+        if(ptObject->tFlags & PL_OBJECT_FLAGS_RENDERABLE)
+            uFlags |= PL_CULL_BOUNDS_FLAG_RENDERABLE;
+        if(ptDrawable->uInstanceCount != 1) // instances are not culled individually
+            uFlags |= PL_CULL_BOUNDS_FLAG_ALWAYS_VISIBLE;
+        ptBounds->sbuFlags[i] = uFlags;
+
+        ptBounds->sbfCenterX[i] = 0.5f * (ptObject->tAABB.tMax.x + ptObject->tAABB.tMin.x);
+        ptBounds->sbfCenterY[i] = 0.5f * (ptObject->tAABB.tMax.y + ptObject->tAABB.tMin.y);
+        ptBounds->sbfCenterZ[i] = 0.5f * (ptObject->tAABB.tMax.z + ptObject->tAABB.tMin.z);
+        ptBounds->sbfExtentX[i] = 0.5f * (ptObject->tAABB.tMax.x - ptObject->tAABB.tMin.x);
+        ptBounds->sbfExtentY[i] = 0.5f * (ptObject->tAABB.tMax.y - ptObject->tAABB.tMin.y);
+        ptBounds->sbfExtentZ[i] = 0.5f * (ptObject->tAABB.tMax.z - ptObject->tAABB.tMin.z);
+    }
+}
+
+static void
+pl__renderer_update_cull_bounds(plScene* ptScene)
+{
+    plCullBounds* ptBounds = &ptScene->tCullBounds;
+    const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
+    const uint32_t uBlockCount = (uDrawableCount + PL_CULL_BLOCK_SIZE - 1) / PL_CULL_BLOCK_SIZE;
+    const uint32_t uPaddedCount = uBlockCount * PL_CULL_BLOCK_SIZE;
+
+    // padding is never renderable so kernels don't handle partial blocks
+    ptBounds->uCount = uDrawableCount;
+    pl_sb_resize(ptBounds->sbfCenterX, uPaddedCount);
+    pl_sb_resize(ptBounds->sbfCenterY, uPaddedCount);
+    pl_sb_resize(ptBounds->sbfCenterZ, uPaddedCount);
+    pl_sb_resize(ptBounds->sbfExtentX, uPaddedCount);
+    pl_sb_resize(ptBounds->sbfExtentY, uPaddedCount);
+    pl_sb_resize(ptBounds->sbfExtentZ, uPaddedCount);
+    pl_sb_resize(ptBounds->sbuFlags, uPaddedCount);
+    pl_sb_resize(ptBounds->sbuVisible, uPaddedCount);
+    pl_sb_resize(ptBounds->sbuBlockVisibleCounts, uBlockCount);
+    const uint32_t uPadding = uPaddedCount - uDrawableCount;
+    memset(&ptBounds->sbfCenterX[uDrawableCount], 0, uPadding * sizeof(float));
+    memset(&ptBounds->sbfCenterY[uDrawableCount], 0, uPadding * sizeof(float));
+    memset(&ptBounds->sbfCenterZ[uDrawableCount], 0, uPadding * sizeof(float));
+    memset(&ptBounds->sbfExtentX[uDrawableCount], 0, uPadding * sizeof(float));
+    memset(&ptBounds->sbfExtentY[uDrawableCount], 0, uPadding * sizeof(float));
+    memset(&ptBounds->sbfExtentZ[uDrawableCount], 0, uPadding * sizeof(float));
+    memset(&ptBounds->sbuFlags[uDrawableCount], 0, uPadding * sizeof(uint32_t));
+
+    if(uBlockCount == 0)
+        return;
+
+    plJobDesc tJobDesc = {
+        .task  = pl__renderer_cull_bounds_job,
+        .pData = ptScene
+    };
+    plJobCounter* ptCounter = NULL;
+    gptJob->dispatch_batch(uBlockCount, 0, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+}
+
+static void
+pl__renderer_cleanup_cull_bounds(plScene* ptScene)
+{
+    plCullBounds* ptBounds = &ptScene->tCullBounds;
+    pl_sb_free(ptBounds->sbfCenterX);
+    pl_sb_free(ptBounds->sbfCenterY);
+    pl_sb_free(ptBounds->sbfCenterZ);
+    pl_sb_free(ptBounds->sbfExtentX);
+    pl_sb_free(ptBounds->sbfExtentY);
+    pl_sb_free(ptBounds->sbfExtentZ);
+    pl_sb_free(ptBounds->sbuFlags);
+    pl_sb_free(ptBounds->sbuVisible);
+    pl_sb_free(ptBounds->sbuBlockVisibleCounts);
+    ptBounds->uCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] job system tasks
+//-----------------------------------------------------------------------------
+
+// one block of PL_CULL_BLOCK_SIZE drawables per job, each writing its visible
+// drawables to its own slice of plCullBounds::sbuVisible
+
+static void
+pl__renderer_cull_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plCullData* ptCullData = pData;
+    plCullBounds* ptBounds = &ptCullData->ptScene->tCullBounds;
+    const uint32_t uStart = tInvoData.uGlobalIndex * PL_CULL_BLOCK_SIZE;
+    ptBounds->sbuBlockVisibleCounts[tInvoData.uGlobalIndex] = pl__cull_frustum_kernel(ptBounds, uStart, &ptCullData->tFrustum, &ptBounds->sbuVisible[uStart]);
+}
+
+static void
+pl__renderer_cull_point_light_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plCullData* ptCullData = pData;
+    plCullBounds* ptBounds = &ptCullData->ptScene->tCullBounds;
+    const uint32_t uStart = tInvoData.uGlobalIndex * PL_CULL_BLOCK_SIZE;
+    ptBounds->sbuBlockVisibleCounts[tInvoData.uGlobalIndex] = pl__cull_sphere_kernel(ptBounds, uStart, &ptCullData->tSphere, &ptBounds->sbuVisible[uStart]);
+}
+
+static void
+pl__renderer_cull_spot_light_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plCullData* ptCullData = pData;
+    plCullBounds* ptBounds = &ptCullData->ptScene->tCullBounds;
+    const uint32_t uStart = tInvoData.uGlobalIndex * PL_CULL_BLOCK_SIZE;
+    ptBounds->sbuBlockVisibleCounts[tInvoData.uGlobalIndex] = pl__cull_cone_kernel(ptBounds, uStart, &ptCullData->tCone, &ptBounds->sbuVisible[uStart]);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] culling
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__renderer_cull_drawables(plCullData* ptCullData, plJobDesc tJobDesc, const uint32_t** pauVisibleOut)
+{
+    // runs the cull task over all blocks then packs the per block lists
+    plCullBounds* ptBounds = &ptCullData->ptScene->tCullBounds;
+    if(ptBounds->uCount != pl_sb_size(ptCullData->ptScene->sbtDrawables)) // drawables changed since prepare
+        pl__renderer_update_cull_bounds(ptCullData->ptScene);
+    const uint32_t uBlockCount = pl_sb_size(ptBounds->sbuBlockVisibleCounts);
+    *pauVisibleOut = ptBounds->sbuVisible;
+    if(uBlockCount == 0)
+        return 0;
+
+    tJobDesc.pData = ptCullData;
+    plJobCounter* ptCounter = NULL;
+    gptJob->dispatch_batch(uBlockCount, 0, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
+    uint32_t uVisibleCount = ptBounds->sbuBlockVisibleCounts[0];
+    for(uint32_t i = 1; i < uBlockCount; i++)
+    {
+        memmove(&ptBounds->sbuVisible[uVisibleCount], &ptBounds->sbuVisible[i * PL_CULL_BLOCK_SIZE], ptBounds->sbuBlockVisibleCounts[i] * sizeof(uint32_t));
+        uVisibleCount += ptBounds->sbuBlockVisibleCounts[i];
+    }
+    return uVisibleCount;
+}
@@ -0,0 +1,266 @@
+/*
+   pl_renderer_culling.inl
+     - SoA drawable bounds & simd visibility kernels (frustum, sphere, cone)
+     - kept free of renderer state so the kernels can be tested directly
+     - requires pl_math.h functions (PL_MATH_INCLUDE_FUNCTIONS)
+*/
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] simd lanes
+// [SECTION] enums
+// [SECTION] structs
+// [SECTION] kernels
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_RENDERER_CULLING_INL
+#define PL_RENDERER_CULLING_INL
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>       // uint32_t
+#include <math.h>         // fabsf, sqrtf
+#include "pl_math.h"      // plPlane, plSphere, plCone
+#include "pl_gjk_ext.h"   // plFrustum
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+// drawables culled per job (multiple of the widest simd lane count)
+#define PL_CULL_BLOCK_SIZE 1024
+
+//-----------------------------------------------------------------------------
+// [SECTION] simd lanes
+//-----------------------------------------------------------------------------
+
+// kernels are written once against these (scalar fallback is 1 lane wide)
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define PL_CULL_LANES 8
+    typedef __m256 plCullLane;
+    #define pl__cull_load(p)      _mm256_loadu_ps(p)
+    #define pl__cull_set1(f)      _mm256_set1_ps(f)
+    #define pl__cull_add(a, b)    _mm256_add_ps((a), (b))
+    #define pl__cull_sub(a, b)    _mm256_sub_ps((a), (b))
+    #define pl__cull_mul(a, b)    _mm256_mul_ps((a), (b))
+    #define pl__cull_min(a, b)    _mm256_min_ps((a), (b))
+    #define pl__cull_max(a, b)    _mm256_max_ps((a), (b))
+    #define pl__cull_sqrt(a)      _mm256_sqrt_ps(a)
+    #define pl__cull_abs(a)       _mm256_andnot_ps(_mm256_set1_ps(-0.0f), (a))
+    #define pl__cull_le_mask(a, b) (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps((a), (b), _CMP_LE_OQ))
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PL_CULL_LANES 4
+    typedef __m128 plCullLane;
+    #define pl__cull_load(p)      _mm_loadu_ps(p)
+    #define pl__cull_set1(f)      _mm_set1_ps(f)
+    #define pl__cull_add(a, b)    _mm_add_ps((a), (b))
+    #define pl__cull_sub(a, b)    _mm_sub_ps((a), (b))
+    #define pl__cull_mul(a, b)    _mm_mul_ps((a), (b))
+    #define pl__cull_min(a, b)    _mm_min_ps((a), (b))
+    #define pl__cull_max(a, b)    _mm_max_ps((a), (b))
+    #define pl__cull_sqrt(a)      _mm_sqrt_ps(a)
+    #define pl__cull_abs(a)       _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+    #define pl__cull_le_mask(a, b) (uint32_t)_mm_movemask_ps(_mm_cmple_ps((a), (b)))
+#else
+    #define PL_CULL_LANES 1
+    typedef float plCullLane;
+    #define pl__cull_load(p)      (*(p))
+    #define pl__cull_set1(f)      (f)
+    #define pl__cull_add(a, b)    ((a) + (b))
+    #define pl__cull_sub(a, b)    ((a) - (b))
+    #define pl__cull_mul(a, b)    ((a) * (b))
+    #define pl__cull_min(a, b)    ((a) < (b) ? (a) : (b))
+    #define pl__cull_max(a, b)    ((a) > (b) ? (a) : (b))
+    #define pl__cull_sqrt(a)      sqrtf(a)
+    #define pl__cull_abs(a)       fabsf(a)
+    #define pl__cull_le_mask(a, b) (uint32_t)((a) <= (b))
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] enums
+//-----------------------------------------------------------------------------
+
+typedef int plCullBoundsFlags;
+
+enum _plCullBoundsFlags // bit positions relied on by pl__cull_compact
+{
+    PL_CULL_BOUNDS_FLAG_NONE           = 0,
+    PL_CULL_BOUNDS_FLAG_RENDERABLE     = 1 << 0,
+    PL_CULL_BOUNDS_FLAG_ALWAYS_VISIBLE = 1 << 1, // instanced
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plCullBounds
+{
+    // world space drawable AABBs (center & half extents) refreshed once per
+    // frame, padded to PL_CULL_BLOCK_SIZE w/ drawables that are never visible
+    float*    sbfCenterX;
+    float*    sbfCenterY;
+    float*    sbfCenterZ;
+    float*    sbfExtentX;
+    float*    sbfExtentY;
+    float*    sbfExtentZ;
+    uint32_t* sbuFlags; // plCullBoundsFlags
+    uint32_t  uCount;   // drawables (not padded)
+
+    // results of the last cull (visible drawable indices)
+    uint32_t* sbuVisible;
+    uint32_t* sbuBlockVisibleCounts;
+} plCullBounds;
+
+//-----------------------------------------------------------------------------
+// [SECTION] kernels
+//-----------------------------------------------------------------------------
+
+static inline uint32_t
+pl__cull_compact(const plCullBounds* ptBounds, uint32_t uFirst, uint32_t uInsideMask, uint32_t* auVisibleOut, uint32_t uVisibleCount)
+{
+    uint32_t uVisibleMask = 0;
+    for(uint32_t uLane = 0; uLane < PL_CULL_LANES; uLane++)
+    {
+        const uint32_t uFlags = ptBounds->sbuFlags[uFirst + uLane];
+        const uint32_t uVisible = ((uInsideMask >> uLane) | (uFlags >> 1)) & uFlags & 1; // renderable & (inside | always visible)
+        uVisibleMask |= uVisible << uLane;
+    }
+
+    // most lane groups are fully culled, otherwise branchless in order append
+    if(uVisibleMask == 0)
+        return uVisibleCount;
+    for(uint32_t uLane = 0; uLane < PL_CULL_LANES; uLane++)
+    {
+        auVisibleOut[uVisibleCount] = uFirst + uLane;
+        uVisibleCount += (uVisibleMask >> uLane) & 1;
+    }
+    return uVisibleCount;
+}
+
+static uint32_t
+pl__cull_frustum_kernel(const plCullBounds* ptBounds, uint32_t uStart, const plFrustum* ptFrustum, uint32_t* auVisibleOut)
+{
+    // box is outside when fully behind any plane (inside: dot(n, p) - offset >= 0),
+    // i.e. when the most positive vertex along the normal is behind it
+    plCullLane atNormalX[6];
+    plCullLane atNormalY[6];
+    plCullLane atNormalZ[6];
+    plCullLane atAbsNormalX[6];
+    plCullLane atAbsNormalY[6];
+    plCullLane atAbsNormalZ[6];
+    plCullLane atOffset[6];
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        const plPlane* ptPlane = &ptFrustum->atPlanes[i];
+        atNormalX[i] = pl__cull_set1(ptPlane->tDirection.x);
+        atNormalY[i] = pl__cull_set1(ptPlane->tDirection.y);
+        atNormalZ[i] = pl__cull_set1(ptPlane->tDirection.z);
+        atAbsNormalX[i] = pl__cull_set1(fabsf(ptPlane->tDirection.x));
+        atAbsNormalY[i] = pl__cull_set1(fabsf(ptPlane->tDirection.y));
+        atAbsNormalZ[i] = pl__cull_set1(fabsf(ptPlane->tDirection.z));
+        atOffset[i] = pl__cull_set1(ptPlane->fOffset);
+    }
+
+    uint32_t uVisibleCount = 0;
+    for(uint32_t i = uStart; i < uStart + PL_CULL_BLOCK_SIZE; i += PL_CULL_LANES)
+    {
+        const plCullLane tCenterX = pl__cull_load(&ptBounds->sbfCenterX[i]);
+        const plCullLane tCenterY = pl__cull_load(&ptBounds->sbfCenterY[i]);
+        const plCullLane tCenterZ = pl__cull_load(&ptBounds->sbfCenterZ[i]);
+        const plCullLane tExtentX = pl__cull_load(&ptBounds->sbfExtentX[i]);
+        const plCullLane tExtentY = pl__cull_load(&ptBounds->sbfExtentY[i]);
+        const plCullLane tExtentZ = pl__cull_load(&ptBounds->sbfExtentZ[i]);
+
+        uint32_t uInsideMask = (1u << PL_CULL_LANES) - 1;
+        for(uint32_t j = 0; j < 6; j++)
+        {
+            const plCullLane tDistance = pl__cull_add(pl__cull_add(pl__cull_mul(atNormalX[j], tCenterX), pl__cull_mul(atNormalY[j], tCenterY)), pl__cull_mul(atNormalZ[j], tCenterZ));
+            const plCullLane tRadius = pl__cull_add(pl__cull_add(pl__cull_mul(atAbsNormalX[j], tExtentX), pl__cull_mul(atAbsNormalY[j], tExtentY)), pl__cull_mul(atAbsNormalZ[j], tExtentZ));
+            uInsideMask &= pl__cull_le_mask(atOffset[j], pl__cull_add(tDistance, tRadius));
+        }
+        uVisibleCount = pl__cull_compact(ptBounds, i, uInsideMask, auVisibleOut, uVisibleCount);
+    }
+    return uVisibleCount;
+}
+
+static uint32_t
+pl__cull_sphere_kernel(const plCullBounds* ptBounds, uint32_t uStart, const plSphere* ptSphere, uint32_t* auVisibleOut)
+{
+    // exact: squared distance from the sphere center to the box
+    const plCullLane tSphereX = pl__cull_set1(ptSphere->tCenter.x);
+    const plCullLane tSphereY = pl__cull_set1(ptSphere->tCenter.y);
+    const plCullLane tSphereZ = pl__cull_set1(ptSphere->tCenter.z);
+    const plCullLane tRadiusSq = pl__cull_set1(ptSphere->fRadius * ptSphere->fRadius);
+    const plCullLane tZero = pl__cull_set1(0.0f);
+
+    uint32_t uVisibleCount = 0;
+    for(uint32_t i = uStart; i < uStart + PL_CULL_BLOCK_SIZE; i += PL_CULL_LANES)
+    {
+        const plCullLane tDistanceX = pl__cull_max(pl__cull_sub(pl__cull_abs(pl__cull_sub(tSphereX, pl__cull_load(&ptBounds->sbfCenterX[i]))), pl__cull_load(&ptBounds->sbfExtentX[i])), tZero);
+        const plCullLane tDistanceY = pl__cull_max(pl__cull_sub(pl__cull_abs(pl__cull_sub(tSphereY, pl__cull_load(&ptBounds->sbfCenterY[i]))), pl__cull_load(&ptBounds->sbfExtentY[i])), tZero);
+        const plCullLane tDistanceZ = pl__cull_max(pl__cull_sub(pl__cull_abs(pl__cull_sub(tSphereZ, pl__cull_load(&ptBounds->sbfCenterZ[i]))), pl__cull_load(&ptBounds->sbfExtentZ[i])), tZero);
+        const plCullLane tDistanceSq = pl__cull_add(pl__cull_add(pl__cull_mul(tDistanceX, tDistanceX), pl__cull_mul(tDistanceY, tDistanceY)), pl__cull_mul(tDistanceZ, tDistanceZ));
+        uVisibleCount = pl__cull_compact(ptBounds, i, pl__cull_le_mask(tDistanceSq, tRadiusSq), auVisibleOut, uVisibleCount);
+    }
+    return uVisibleCount;
+}
+
+static uint32_t
+pl__cull_cone_kernel(const plCullBounds* ptBounds, uint32_t uStart, const plCone* ptCone, uint32_t* auVisibleOut)
+{
+    // conservative: bounding sphere of the box against the cone (tip, axis,
+    // length & half angle), rejected when outside the lateral surface or
+    // beyond either end
+    const plVec3 tAxis = pl_sub_vec3(ptCone->tBasePos, ptCone->tTipPos);
+    const float fLength = pl_length_vec3(tAxis);
+    const plVec3 tAxisNorm = pl_mul_vec3_scalarf(tAxis, 1.0f / fLength);
+    const float fSlant = sqrtf(fLength * fLength + ptCone->fRadius * ptCone->fRadius);
+
+    const plCullLane tTipX = pl__cull_set1(ptCone->tTipPos.x);
+    const plCullLane tTipY = pl__cull_set1(ptCone->tTipPos.y);
+    const plCullLane tTipZ = pl__cull_set1(ptCone->tTipPos.z);
+    const plCullLane tAxisX = pl__cull_set1(tAxisNorm.x);
+    const plCullLane tAxisY = pl__cull_set1(tAxisNorm.y);
+    const plCullLane tAxisZ = pl__cull_set1(tAxisNorm.z);
+    const plCullLane tCos = pl__cull_set1(fLength / fSlant);
+    const plCullLane tSin = pl__cull_set1(ptCone->fRadius / fSlant);
+    const plCullLane tLength = pl__cull_set1(fLength);
+    const plCullLane tZero = pl__cull_set1(0.0f);
+
+    uint32_t uVisibleCount = 0;
+    for(uint32_t i = uStart; i < uStart + PL_CULL_BLOCK_SIZE; i += PL_CULL_LANES)
+    {
+        const plCullLane tExtentX = pl__cull_load(&ptBounds->sbfExtentX[i]);
+        const plCullLane tExtentY = pl__cull_load(&ptBounds->sbfExtentY[i]);
+        const plCullLane tExtentZ = pl__cull_load(&ptBounds->sbfExtentZ[i]);
+        const plCullLane tRadius = pl__cull_sqrt(pl__cull_add(pl__cull_add(pl__cull_mul(tExtentX, tExtentX), pl__cull_mul(tExtentY, tExtentY)), pl__cull_mul(tExtentZ, tExtentZ)));
+
+        const plCullLane tToCenterX = pl__cull_sub(pl__cull_load(&ptBounds->sbfCenterX[i]), tTipX);
+        const plCullLane tToCenterY = pl__cull_sub(pl__cull_load(&ptBounds->sbfCenterY[i]), tTipY);
+        const plCullLane tToCenterZ = pl__cull_sub(pl__cull_load(&ptBounds->sbfCenterZ[i]), tTipZ);
+        const plCullLane tLengthSq = pl__cull_add(pl__cull_add(pl__cull_mul(tToCenterX, tToCenterX), pl__cull_mul(tToCenterY, tToCenterY)), pl__cull_mul(tToCenterZ, tToCenterZ));
+        const plCullLane tAlongAxis = pl__cull_add(pl__cull_add(pl__cull_mul(tToCenterX, tAxisX), pl__cull_mul(tToCenterY, tAxisY)), pl__cull_mul(tToCenterZ, tAxisZ));
+        const plCullLane tFromAxis = pl__cull_sqrt(pl__cull_max(pl__cull_sub(tLengthSq, pl__cull_mul(tAlongAxis, tAlongAxis)), tZero));
+
+        // signed distance to the lateral surface
+        const plCullLane tSurfaceDistance = pl__cull_sub(pl__cull_mul(tCos, tFromAxis), pl__cull_mul(tSin, tAlongAxis));
+        uint32_t uInsideMask = pl__cull_le_mask(tSurfaceDistance, tRadius);
+        uInsideMask &= pl__cull_le_mask(tAlongAxis, pl__cull_add(tLength, tRadius));
+        uInsideMask &= pl__cull_le_mask(pl__cull_sub(tZero, tRadius), tAlongAxis);
+        uVisibleCount = pl__cull_compact(ptBounds, i, uInsideMask, auVisibleOut, uVisibleCount);
+    }
+    return uVisibleCount;
+}
+
+#endif // PL_RENDERER_CULLING_INL
@@ -16,6 +16,7 @@ Index of this file:
 
 #include "pl_renderer_internal.h"
 #include "pl_renderer_terrain.c"
+#include "pl_renderer_culling.c"
 #include "pl_renderer_internal.c"
 #include "pl_json.h"
 
@@ -436,6 +437,7 @@ pl_renderer_create_scene(const plSceneDesc* ptInit)
     pl_sb_push(gptData->sbptScenes, ptScene);
 
     ptScene->tInit = tInit;
+    ptScene->bBvhDirty = true;
 
     // TODO: make this an option
     ptScene->uSunShadowAtlasResolution = 4096 * 4;
@@ -788,6 +790,7 @@ pl_renderer_destroy_scene(plScene* ptScene)
     gptResource->clear();
 
     gptBvh->cleanup(&ptScene->tBvh);
+    pl__renderer_cleanup_cull_bounds(ptScene);
     pl_sb_free(ptScene->sbtVisibleDrawables0);
     pl_sb_free(ptScene->sbtVisibleDrawables1);
     pl_sb_free(ptScene->sbtRegularShaders);
@@ -797,6 +800,7 @@ pl_renderer_destroy_scene(plScene* ptScene)
     pl_sb_free(ptScene->sbtOutlineShaders);
     pl_sb_free(ptScene->sbtBvhAABBs);
     pl_sb_free(ptScene->sbtNodeStack);
+    pl_sb_free(ptScene->sbuBvhTransformIndices);
     pl_sb_free(ptScene->sbtGPUProbeData);
     pl_sb_free(ptScene->sbtProbeData);
     pl_sb_free(ptScene->sbtShadowRects);
@@ -1467,6 +1471,9 @@ pl_renderer_prepare_scene(plScene* ptScene, const plCamera** atCameras, uint32_t
     if(ptScene->ptTerrain)
         pl_prepare_terrain(ptScene->ptTerrain);
 
+    // drawable bounds shared by every cull this frame (views, shadows & probes)
+    pl__renderer_update_cull_bounds(ptScene);
+
     // for convience
     const uint32_t uFrameIdx = gptGfx->get_current_frame_index();
     plCommandPool* ptCmdPool = gptStarter->get_current_command_pool();
@@ -2263,12 +2270,12 @@ pl_renderer_render_view(plView* ptView, const plRenderViewDesc* ptViewDesc)
     
     const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
 
-    plAtomicCounter* ptCullCounter = NULL;
+    const uint32_t* auVisibleDrawables = NULL;
+    uint32_t uVisibleCount = 0;
     
     plCullData tCullData = {
         .ptScene      = ptScene,
-        .ptCullCamera = ptCullCamera,
-        .atDrawables  = ptScene->sbtDrawables
+        .ptCullCamera = ptCullCamera
     };
     if(ptCullCamera && ptCullCamera->eProjectionType == PL_CAMERA_PROJECTION_TYPE_PERSPECTIVE)
         pl__camera_build_perspective_frustum(ptCullCamera, &tCullData.tFrustum);
@@ -2278,11 +2285,11 @@ pl_renderer_render_view(plView* ptView, const plRenderViewDesc* ptViewDesc)
     if(ptCullCamera)
     {
         plJobDesc tJobDesc = {
-            .task  = pl__renderer_cull_job,
-            .pData = &tCullData
+            .task      = pl__renderer_cull_job,
+            .ePriority = PL_JOB_PRIORITY_HIGH
         };
 
-        gptJob->dispatch_batch(uDrawableCount, 0, tJobDesc, &ptCullCounter);
+        uVisibleCount = pl__renderer_cull_drawables(&tCullData, tJobDesc, &auVisibleDrawables);
     }
     else // no culling, just copy drawables over
     {
@@ -2293,7 +2300,6 @@ pl_renderer_render_view(plView* ptView, const plRenderViewDesc* ptViewDesc)
                 ptScene->sbtVisibleDrawables[i] = i;
         }
     }
-    gptJob->wait_for_counter(ptCullCounter);
     PL_PROFILE_END_SAMPLE_API(gptProfile, 0); // culling
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~binning based on pass type~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -2307,35 +2313,32 @@ pl_renderer_render_view(plView* ptView, const plRenderViewDesc* ptViewDesc)
         pl_sb_reset(ptScene->sbuVisibleTransmissionEntities);
         pl_sb_reset(ptScene->sbtVisibleDrawables);
 
-        for(uint32_t uDrawableIndex = 0; uDrawableIndex < uDrawableCount; uDrawableIndex++)
+        for(uint32_t i = 0; i < uVisibleCount; i++)
         {
+            const uint32_t uDrawableIndex = auVisibleDrawables[i];
             const plDrawable tDrawable = ptScene->sbtDrawables[uDrawableIndex];
-            if(!tDrawable.bCulled)
+            if(tDrawable.tFlags & PL_DRAWABLE_FLAG_DEFERRED)
             {
-                if(tDrawable.tFlags & PL_DRAWABLE_FLAG_DEFERRED)
-                {
-                    pl_sb_push(ptScene->sbuVisibleDeferredEntities, uDrawableIndex);
-                    pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
-                }
-                else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE)
-                {
-                    if(ptScene->tDebugOptions.bShowProbes)
-                    {
-                        pl_sb_push(ptScene->sbuVisibleForwardEntities, uDrawableIndex);
-                        pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
-                    }
-                }
-                else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_FORWARD)
+                pl_sb_push(ptScene->sbuVisibleDeferredEntities, uDrawableIndex);
+                pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
+            }
+            else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE)
+            {
+                if(ptScene->tDebugOptions.bShowProbes)
                 {
                     pl_sb_push(ptScene->sbuVisibleForwardEntities, uDrawableIndex);
                     pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
                 }
-                else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_TRANSMISSION)
-                {
-                    pl_sb_push(ptScene->sbuVisibleTransmissionEntities, uDrawableIndex);
-                    pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
-                }
-                
+            }
+            else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_FORWARD)
+            {
+                pl_sb_push(ptScene->sbuVisibleForwardEntities, uDrawableIndex);
+                pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
+            }
+            else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_TRANSMISSION)
+            {
+                pl_sb_push(ptScene->sbuVisibleTransmissionEntities, uDrawableIndex);
+                pl_sb_push(ptScene->sbtVisibleDrawables, uDrawableIndex);
             }
         }
     }
@@ -2955,33 +2958,26 @@ pl_renderer_begin_frame(void)
         {
             ptScene->tInternalFlags &= ~PL_SCENE_INTERNAL_FLAG_OBJECT_COUNT_DIRTY;
             const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
-            const plEcsTypeKey tMeshComponentType = gptMesh->get_ecs_type_key_mesh();
 
-            // sort drawables by mesh to prepare for instancing (consecutive drawables with same mesh will be instanced together)
-            for (uint32_t i = 0; i < uDrawableCount; i++)
+            // drawables were sorted when added, so consecutive drawables with the
+            // same cached sort key (same mesh) are instanced together
+            uint32_t uRunStart = 0;
+            while(uRunStart < uDrawableCount)
             {
-                ptScene->sbtDrawables[i].uInstanceCount = 1;
-                ptScene->sbtDrawables[i].uTransformIndex = ptScene->uNextTransformIndex++;
-                plObjectComponent* ptObjectA = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, ptScene->sbtDrawables[i].tEntity);
-                for (uint32_t j = i; j < uDrawableCount - 1; j++)
+                const uint64_t ulSortKey = ptScene->sbtDrawables[uRunStart].ulSortKey;
+                uint32_t uRunEnd = uRunStart + 1;
+                while(uRunEnd < uDrawableCount && ptScene->sbtDrawables[uRunEnd].ulSortKey == ulSortKey)
+                    uRunEnd++;
+
+                // first drawable renders the whole run, duplicates are set to 0
+                // so they won't be rendered separately
+                for(uint32_t i = uRunStart; i < uRunEnd; i++)
                 {
-                    plObjectComponent* ptObjectB = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, ptScene->sbtDrawables[j + 1].tEntity);
-                    if(ptObjectA->tMesh.uIndex == ptObjectB->tMesh.uIndex)
-                    {
-                        // increment instance count of first drawable
-                        ptScene->sbtDrawables[i].uInstanceCount++;
-
-                        // set instance count of duplicate drawable to 0 so it won't be rendered separately
-                        ptScene->sbtDrawables[j + 1].uInstanceCount = 0;
-                        ptScene->sbtDrawables[j + 1].uTransformIndex = ptScene->uNextTransformIndex++;
-                    }
-                    else // found end of duplicates
-                        break;
-                    
+                    ptScene->sbtDrawables[i].uInstanceCount = 0;
+                    ptScene->sbtDrawables[i].uTransformIndex = ptScene->uNextTransformIndex++;
                 }
-                i += ptScene->sbtDrawables[i].uInstanceCount;
-                i--;
-
+                ptScene->sbtDrawables[uRunStart].uInstanceCount = uRunEnd - uRunStart;
+                uRunStart = uRunEnd;
             }
 
             // free CPU buffers (keep drawable list since it contains per-drawable metadata like material index and mesh info)
@@ -3079,34 +3075,28 @@ pl_renderer_ecs_add_drawable_objects_to_scene(plScene* ptScene, uint32_t uObject
     const plEcsTypeKey tMaterialComponentType = gptMaterial->get_ecs_type_key();
 
     for(uint32_t i = 0; i < uObjectCount; i++)
-    {
-        ptScene->sbtDrawables[uStart + i].tEntity = atObjects[i];
         ptScene->sbtDrawables[uStart + i].uSkinIndex = UINT32_MAX;
+
+    // sort new drawables by material then mesh so drawables sharing a mesh are
+    // consecutive (instanced together) & material changes are minimized
+    uint64_t* auSortKeys    = PL_ALLOC(sizeof(uint64_t) * uObjectCount);
+    uint32_t* auSortIndices = PL_ALLOC(sizeof(uint32_t) * uObjectCount);
+    for(uint32_t i = 0; i < uObjectCount; i++)
+    {
+        plObjectComponent* ptObject = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, atObjects[i]);
+        plMeshComponent*   ptMesh   = gptECS->get_component(ptScene->ptComponentLibrary, tMeshComponentType, ptObject->tMesh);
+        auSortKeys[i] = ((uint64_t)ptMesh->tMaterial.uIndex << 32) | (uint64_t)ptObject->tMesh.uIndex;
+        auSortIndices[i] = i;
     }
+    pl__renderer_radix_sort_keys(uObjectCount, auSortKeys, auSortIndices);
 
-    // sort to group entities for instances (slow bubble sort, improve later)
-    bool bSwapped = false;
-    for (uint32_t i = 0; i < uObjectCount - 1; i++)
+    for(uint32_t i = 0; i < uObjectCount; i++)
     {
-        bSwapped = false;
-        for (uint32_t j = 0; j < uObjectCount - i - 1; j++)
-        {
-            plObjectComponent* ptObjectA = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, ptScene->sbtDrawables[uStart + j].tEntity);
-            plObjectComponent* ptObjectB = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, ptScene->sbtDrawables[uStart + j + 1].tEntity);
-            if (ptObjectA->tMesh.uIndex > ptObjectB->tMesh.uIndex)
-            {
-                plEntity tA = ptScene->sbtDrawables[uStart + j].tEntity;
-                plEntity tB = ptScene->sbtDrawables[uStart + j + 1].tEntity;
-                ptScene->sbtDrawables[uStart + j].tEntity = tB;
-                ptScene->sbtDrawables[uStart + j + 1].tEntity = tA;
-                bSwapped = true;
-            }
-        }
-      
-        // if no two elements were swapped, then break
-        if (!bSwapped)
-            break;
+        ptScene->sbtDrawables[uStart + i].tEntity = atObjects[auSortIndices[i]];
+        ptScene->sbtDrawables[uStart + i].ulSortKey = auSortKeys[i];
     }
+    PL_FREE(auSortKeys);
+    PL_FREE(auSortIndices);
 
     for(uint32_t i = 0; i < uObjectCount; i++)
     {
@@ -3616,22 +3606,60 @@ void
 pl_renderer_editor_rebuild_scene_bvh(plScene* ptScene)
 {
     plComponentLibrary* ptLibrary = ptScene->ptComponentLibrary;
+    const plEcsTypeKey tTransformComponentType = gptECS->get_ecs_type_key_transform();
 
     plObjectComponent* ptComponents = NULL;
-    const uint32_t uObjectCount = gptECS->get_components(ptScene->ptComponentLibrary, gptData->tObjectComponentType, (void**)&ptComponents, NULL);
+    const uint32_t uObjectCount = gptECS->get_components(ptLibrary, gptData->tObjectComponentType, (void**)&ptComponents, NULL);
 
     pl_sb_resize(ptScene->sbtBvhAABBs, uObjectCount);
+    pl_sb_resize(ptScene->sbuBvhTransformIndices, uObjectCount);
     for(uint32_t j = 0; j < uObjectCount; j++)
     {
         plObjectComponent* ptObject = &ptComponents[j];
         ptScene->sbtBvhAABBs[j] = ptObject->tAABB;
+        const size_t szTransformIndex = gptECS->get_index(ptLibrary, tTransformComponentType, ptObject->tTransform);
+        ptScene->sbuBvhTransformIndices[j] = szTransformIndex == UINT64_MAX ? UINT32_MAX : (uint32_t)szTransformIndex;
     }
 
-    gptBvh->build(&ptScene->tBvh, ptScene->sbtBvhAABBs, uObjectCount);
+    gptBvh->build_ex(&ptScene->tBvh, ptScene->sbtBvhAABBs, uObjectCount, PL_BVH_BUILD_FLAGS_PARALLEL);
+
+    ptScene->bBvhDirty = false;
+    ptScene->uBvhObjectGeneration = gptECS->get_component_generation(ptLibrary, gptData->tObjectComponentType);
+    ptScene->uBvhTransformGeneration = gptECS->get_component_generation(ptLibrary, tTransformComponentType);
 
     pl_sb_reset(ptScene->sbtBvhAABBs); 
 }
 
+void
+pl_renderer_editor_update_scene_bvh(plScene* ptScene)
+{
+    plComponentLibrary* ptLibrary = ptScene->ptComponentLibrary;
+    const plEcsTypeKey tTransformComponentType = gptECS->get_ecs_type_key_transform();
+
+    // object indices (or cached transform indices) are no longer valid
+    if(ptScene->bBvhDirty ||
+        gptECS->get_component_generation(ptLibrary, gptData->tObjectComponentType) != ptScene->uBvhObjectGeneration ||
+        gptECS->get_component_generation(ptLibrary, tTransformComponentType) != ptScene->uBvhTransformGeneration)
+    {
+        pl_renderer_editor_rebuild_scene_bvh(ptScene);
+        return;
+    }
+
+    plObjectComponent* ptComponents = NULL;
+    const uint32_t uObjectCount = gptECS->get_components(ptLibrary, gptData->tObjectComponentType, (void**)&ptComponents, NULL);
+
+    plTransformComponent* ptTransforms = NULL;
+    gptECS->get_components(ptLibrary, tTransformComponentType, (void**)&ptTransforms, NULL);
+
+    // refit objects moved by the last transform/hierarchy update
+    for(uint32_t j = 0; j < uObjectCount; j++)
+    {
+        const uint32_t uTransformIndex = ptScene->sbuBvhTransformIndices[j];
+        if(uTransformIndex != UINT32_MAX && (ptTransforms[uTransformIndex].eFlags & PL_TRANSFORM_FLAGS_UPDATED))
+            gptBvh->update(&ptScene->tBvh, j, ptComponents[j].tAABB);
+    }
+}
+
 static void
 pl__object_update_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
 {
@@ -3749,7 +3777,7 @@ pl_renderer_ecs_run_object_update_system(plComponentLibrary* ptLibrary)
     plObjectComponent* ptComponents = NULL;
     const uint32_t uComponentCount = gptECS->get_components(ptLibrary, gptData->tObjectComponentType, (void**)&ptComponents, NULL);
 
-    plAtomicCounter* ptCounter = NULL;
+    plJobCounter* ptCounter = NULL;
     plJobDesc tJobDesc = {
         .task = pl__object_update_job,
         .pData = ptLibrary
@@ -4503,6 +4531,7 @@ pl_load_renderer_ext(plApiRegistryI* ptApiRegistry, bool bReload)
     tApi4.outline_entities      = pl_renderer_editor_outline_entities;
     tApi4.get_gizmo_drawlist    = pl_renderer_editor_get_gizmo_drawlist;
     tApi4.rebuild_scene_bvh     = pl_renderer_editor_rebuild_scene_bvh;
+    tApi4.update_scene_bvh      = pl_renderer_editor_update_scene_bvh;
     tApi4.set_scene_options     = pl_renderer_editor_set_scene_options;
     tApi4.get_scene_options     = pl_renderer_editor_get_scene_options;
     tApi4.set_view_options      = pl_renderer_editor_set_view_options;
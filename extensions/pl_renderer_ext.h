@@ -70,7 +70,7 @@ extern "C" {
 #define plRendererTerrainI_version {0, 1, 0}
 #define plRendererEcsI_version     {0, 1, 0}
 #define plRendererDebugI_version   {0, 1, 0}
-#define plRendererEditorI_version  {0, 1, 0}
+#define plRendererEditorI_version  {0, 2, 0}
 
 //-----------------------------------------------------------------------------
 // [SECTION] defines
@@ -227,6 +227,7 @@ PL_API void pl_renderer_set_tonemap_options(plView*, const plRendererTonemapOpti
 PL_API void          pl_renderer_editor_reload_scene_shaders(plScene*);
 PL_API plDrawList3D* pl_renderer_editor_get_gizmo_drawlist  (plView*);
 PL_API void          pl_renderer_editor_rebuild_scene_bvh(plScene*);
+PL_API void          pl_renderer_editor_update_scene_bvh (plScene*); // only refits moved objects (rebuilds if objects/transforms were added or removed)
 
 // selection & highlighting
 PL_API void pl_renderer_editor_update_hovered_entity(plView*, plVec2 offset, plVec2 windowScale);
@@ -420,6 +421,7 @@ typedef struct _plRendererEditorI
     void          (*reload_scene_shaders) (plScene*);
     plDrawList3D* (*get_gizmo_drawlist)   (plView*);
     void          (*rebuild_scene_bvh)    (plScene*);
+    void          (*update_scene_bvh)     (plScene*);
 
     // scene options
     void (*get_scene_options)  (plScene*, plRendererEditorSceneOptions* out);
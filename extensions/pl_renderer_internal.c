@@ -5,7 +5,7 @@
 /*
 Index of this file:
 // [SECTION] includes
-// [SECTION] job system tasks
+// [SECTION] camera helpers
 // [SECTION] scene render helpers
 */
 
@@ -16,7 +16,7 @@ Index of this file:
 #include "pl_renderer_internal.h"
 
 //-----------------------------------------------------------------------------
-// [SECTION] job system tasks
+// [SECTION] camera helpers
 //-----------------------------------------------------------------------------
 
 static inline plVec3d
@@ -124,81 +124,6 @@ pl__camera_build_perspective_frustum(const plCamera* ptCamera, plFrustum* ptFrus
     ptFrustum->atPlanes[5] = pl_make_plane_from_point_normal(FarPoint,  NFar);
 }
 
-static void
-pl__renderer_cull_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
-{
-    plCullData* ptCullData = pData;
-    plScene* ptScene = ptCullData->ptScene;
-    plDrawable tDrawable = ptCullData->atDrawables[tInvoData.uGlobalIndex];
-    plObjectComponent* ptObject = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, tDrawable.tEntity);
-    ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = true;
-
-    if(ptObject->tFlags & PL_OBJECT_FLAGS_RENDERABLE)
-    {
-        if(ptCullData->atDrawables[tInvoData.uGlobalIndex].uInstanceCount == 1) // ignore instanced
-        {
-            if(gptGjk->pen(pl_gjk_support_aabb, &ptObject->tAABB, pl_gjk_support_frustum, &ptCullData->tFrustum, NULL))
-            {
-                ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = false;
-            }
-        }
-        else
-        {
-            ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = false;
-        }
-    }
-}
-
-static void
-pl__renderer_cull_point_light_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
-{
-    plCullData* ptCullData = pData;
-    plScene* ptScene = ptCullData->ptScene;
-    plDrawable tDrawable = ptCullData->atDrawables[tInvoData.uGlobalIndex];
-    plObjectComponent* ptObject = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, tDrawable.tEntity);
-    ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = true;
-
-    if(ptObject->tFlags & PL_OBJECT_FLAGS_RENDERABLE)
-    {
-        if(ptCullData->atDrawables[tInvoData.uGlobalIndex].uInstanceCount == 1) // ignore instanced
-        {
-            if(gptGjk->pen(pl_gjk_support_aabb, &ptObject->tAABB, pl_gjk_support_sphere, &ptCullData->tSphere, NULL))
-            {
-                ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = false;
-            }
-        }
-        else
-        {
-            ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = false;
-        }
-    }
-}
-
-static void
-pl__renderer_cull_spot_light_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
-{
-    plCullData* ptCullData = pData;
-    plScene* ptScene = ptCullData->ptScene;
-    plDrawable tDrawable = ptCullData->atDrawables[tInvoData.uGlobalIndex];
-    plObjectComponent* ptObject = gptECS->get_component(ptScene->ptComponentLibrary, gptData->tObjectComponentType, tDrawable.tEntity);
-    ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = true;
-
-    if(ptObject->tFlags & PL_OBJECT_FLAGS_RENDERABLE)
-    {
-        if(ptCullData->atDrawables[tInvoData.uGlobalIndex].uInstanceCount == 1) // ignore instanced
-        {
-            if(gptGjk->pen(pl_gjk_support_aabb, &ptObject->tAABB, pl_gjk_support_cone, &ptCullData->tCone, NULL))
-            {
-                ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = false;
-            }
-        }
-        else
-        {
-            ptCullData->atDrawables[tInvoData.uGlobalIndex].bCulled = false;
-        }
-    }
-}
-
 //-----------------------------------------------------------------------------
 // [SECTION] scene render helpers
 //-----------------------------------------------------------------------------
@@ -507,7 +432,6 @@ pl__renderer_generate_shadow_maps(plCommandBuffer* ptCommandBuffer, plScene* ptS
     }
 
     const plEcsTypeKey tTransformComponentType = gptECS->get_ecs_type_key_transform();
-    const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
 
     // uint32_t uCameraBufferIndex = 0;
     for(uint32_t uLightIndex = 0; uLightIndex < uLightCount; uLightIndex++)
@@ -574,13 +498,11 @@ pl__renderer_generate_shadow_maps(plCommandBuffer* ptCommandBuffer, plScene* ptS
         if(!bVisibleToAnyCamera)
             continue;
 
-        plAtomicCounter* ptCullCounter = NULL;
         pl_sb_reset(ptScene->sbtVisibleDrawables0);
         pl_sb_reset(ptScene->sbtVisibleDrawables1);
 
         plCullData tCullData = {
             .ptScene      = ptScene,
-            .atDrawables  = ptScene->sbtDrawables,
             .tSphere      = {
                 .fRadius = ptLight->fRange,
                 .tCenter = ptLight->tPosition
@@ -600,27 +522,25 @@ pl__renderer_generate_shadow_maps(plCommandBuffer* ptCommandBuffer, plScene* ptS
         else if(ptLight->tType == PL_LIGHT_TYPE_SPOT)
             tJobDesc.task = pl__renderer_cull_spot_light_job;
 
-        gptJob->dispatch_batch(uDrawableCount, 0, tJobDesc, &ptCullCounter);
-        gptJob->wait_for_counter(ptCullCounter);
+        const uint32_t* auVisibleDrawables = NULL;
+        const uint32_t uVisibleCount = pl__renderer_cull_drawables(&tCullData, tJobDesc, &auVisibleDrawables);
 
-        pl_sb_reserve(ptScene->sbtVisibleDrawables0, uDrawableCount);
-        pl_sb_reserve(ptScene->sbtVisibleDrawables1, uDrawableCount);
-        for(uint32_t uDrawableIndex = 0; uDrawableIndex < uDrawableCount; uDrawableIndex++)
+        pl_sb_reserve(ptScene->sbtVisibleDrawables0, uVisibleCount);
+        pl_sb_reserve(ptScene->sbtVisibleDrawables1, uVisibleCount);
+        for(uint32_t i = 0; i < uVisibleCount; i++)
         {
+            const uint32_t uDrawableIndex = auVisibleDrawables[i];
             const plDrawable tDrawable = ptScene->sbtDrawables[uDrawableIndex];
-            if(!tDrawable.bCulled)
+            plVisibleDrawable tVisibleDrawable = {
+                .uDrawableIndex = uDrawableIndex
+            };
+            if(tDrawable.tFlags & PL_DRAWABLE_FLAG_HAS_ALPHA)
             {
-                plVisibleDrawable tVisibleDrawable = {
-                    .uDrawableIndex = uDrawableIndex
-                };
-                if(tDrawable.tFlags & PL_DRAWABLE_FLAG_HAS_ALPHA)
-                {
-                    pl_sb_push(ptScene->sbtVisibleDrawables1, tVisibleDrawable);
-                }
-                else if(!(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE))
-                {
-                    pl_sb_push(ptScene->sbtVisibleDrawables0, tVisibleDrawable);
-                }
+                pl_sb_push(ptScene->sbtVisibleDrawables1, tVisibleDrawable);
+            }
+            else if(!(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE))
+            {
+                pl_sb_push(ptScene->sbtVisibleDrawables0, tVisibleDrawable);
             }
         }
 
@@ -1337,8 +1257,6 @@ pl__renderer_generate_direction_view_map(plCommandBuffer* ptCommandBuffer, plSce
         memcpy(&ptDShadowDataBuffer->tMemoryAllocation.pHostMapped[iShadowIndex * sizeof(plGpuDirectionLightShadow)], ptShadowData, sizeof(plGpuDirectionLightShadow));
     }
 
-    const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
-
     const plEcsTypeKey tTransformComponentType = gptECS->get_ecs_type_key_transform();
 
     for(uint32_t uRectIndex = 1; uRectIndex < uAtlasRectCount; uRectIndex++)
@@ -1350,12 +1268,10 @@ pl__renderer_generate_direction_view_map(plCommandBuffer* ptCommandBuffer, plSce
 
         int iShadowIndex = ptScene->sbtDirectionLightData[ptRect->iId].iShadowIndex;
 
-        plAtomicCounter* ptCullCounter = NULL;
         pl_sb_reset(ptScene->sbtVisibleDrawables0);
         pl_sb_reset(ptScene->sbtVisibleDrawables1);
         plCullData tCullData = {
             .ptScene      = ptScene,
-            .atDrawables  = ptScene->sbtDrawables,
             .tSphere = {
                 .fRadius = ptSceneCamera->fFarZ - ptSceneCamera->fNearZ,
                 .tCenter = pl_add_vec3(pl_mul_vec3_scalarf(ptSceneCamera->tForwardVec, 0.6f * (ptSceneCamera->fFarZ - ptSceneCamera->fNearZ)), ptSceneCamera->tPositionF),
@@ -1367,28 +1283,26 @@ pl__renderer_generate_direction_view_map(plCommandBuffer* ptCommandBuffer, plSce
             .task = pl__renderer_cull_point_light_job,
         };
 
-        gptJob->dispatch_batch(uDrawableCount, 0, tJobDesc, &ptCullCounter);
-        gptJob->wait_for_counter(ptCullCounter);
+        const uint32_t* auVisibleDrawables = NULL;
+        const uint32_t uVisibleCount = pl__renderer_cull_drawables(&tCullData, tJobDesc, &auVisibleDrawables);
 
-        pl_sb_reserve(ptScene->sbtVisibleDrawables0, uDrawableCount);
-        pl_sb_reserve(ptScene->sbtVisibleDrawables1, uDrawableCount);
+        pl_sb_reserve(ptScene->sbtVisibleDrawables0, uVisibleCount);
+        pl_sb_reserve(ptScene->sbtVisibleDrawables1, uVisibleCount);
 
-        for(uint32_t uDrawableIndex = 0; uDrawableIndex < uDrawableCount; uDrawableIndex++)
+        for(uint32_t i = 0; i < uVisibleCount; i++)
         {
+            const uint32_t uDrawableIndex = auVisibleDrawables[i];
             const plDrawable tDrawable = ptScene->sbtDrawables[uDrawableIndex];
-            if(!tDrawable.bCulled)
+            plVisibleDrawable tVisibleDrawable = {
+                .uDrawableIndex = uDrawableIndex
+            };
+            if(tDrawable.tFlags & PL_DRAWABLE_FLAG_HAS_ALPHA)
             {
-                plVisibleDrawable tVisibleDrawable = {
-                    .uDrawableIndex = uDrawableIndex
-                };
-                if(tDrawable.tFlags & PL_DRAWABLE_FLAG_HAS_ALPHA)
-                {
-                    pl_sb_push(ptScene->sbtVisibleDrawables1, tVisibleDrawable);
-                }
-                else if(!(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE))
-                {
-                    pl_sb_push(ptScene->sbtVisibleDrawables0, tVisibleDrawable);
-                }
+                pl_sb_push(ptScene->sbtVisibleDrawables1, tVisibleDrawable);
+            }
+            else if(!(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE))
+            {
+                pl_sb_push(ptScene->sbtVisibleDrawables0, tVisibleDrawable);
             }
         }
 
@@ -1819,18 +1733,14 @@ pl__renderer_generate_sun_shadow_map(plCommandBuffer* ptCommandBuffer, plScene*
     plBuffer* ptViewBuffer = gptGfx->get_buffer(ptDevice, tViewBuffer);
     memcpy(ptViewBuffer->tMemoryAllocation.pHostMapped, ptViewData, sizeof(plGpuViewData));
 
-    const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
-
     const plEcsTypeKey tTransformComponentType = gptECS->get_ecs_type_key_transform();
 
     {
 
-        plAtomicCounter* ptCullCounter = NULL;
         pl_sb_reset(ptScene->sbtVisibleDrawables0);
         pl_sb_reset(ptScene->sbtVisibleDrawables1);
         plCullData tCullData = {
             .ptScene      = ptScene,
-            .atDrawables  = ptScene->sbtDrawables,
             .tSphere = {
                 .fRadius = ptSceneCamera->fFarZ - ptSceneCamera->fNearZ,
                 .tCenter = pl_add_vec3(pl_mul_vec3_scalarf(ptSceneCamera->tForwardVec, 0.6f * (ptSceneCamera->fFarZ - ptSceneCamera->fNearZ)), ptSceneCamera->tPositionF),
@@ -1842,28 +1752,26 @@ pl__renderer_generate_sun_shadow_map(plCommandBuffer* ptCommandBuffer, plScene*
             .task = pl__renderer_cull_point_light_job,
         };
 
-        gptJob->dispatch_batch(uDrawableCount, 0, tJobDesc, &ptCullCounter);
-        gptJob->wait_for_counter(ptCullCounter);
+        const uint32_t* auVisibleDrawables = NULL;
+        const uint32_t uVisibleCount = pl__renderer_cull_drawables(&tCullData, tJobDesc, &auVisibleDrawables);
 
-        pl_sb_reserve(ptScene->sbtVisibleDrawables0, uDrawableCount);
-        pl_sb_reserve(ptScene->sbtVisibleDrawables1, uDrawableCount);
+        pl_sb_reserve(ptScene->sbtVisibleDrawables0, uVisibleCount);
+        pl_sb_reserve(ptScene->sbtVisibleDrawables1, uVisibleCount);
 
-        for(uint32_t uDrawableIndex = 0; uDrawableIndex < uDrawableCount; uDrawableIndex++)
+        for(uint32_t i = 0; i < uVisibleCount; i++)
         {
+            const uint32_t uDrawableIndex = auVisibleDrawables[i];
             const plDrawable tDrawable = ptScene->sbtDrawables[uDrawableIndex];
-            if(!tDrawable.bCulled)
+            plVisibleDrawable tVisibleDrawable = {
+                .uDrawableIndex = uDrawableIndex
+            };
+            if(tDrawable.tFlags & PL_DRAWABLE_FLAG_HAS_ALPHA)
             {
-                plVisibleDrawable tVisibleDrawable = {
-                    .uDrawableIndex = uDrawableIndex
-                };
-                if(tDrawable.tFlags & PL_DRAWABLE_FLAG_HAS_ALPHA)
-                {
-                    pl_sb_push(ptScene->sbtVisibleDrawables1, tVisibleDrawable);
-                }
-                else if(!(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE))
-                {
-                    pl_sb_push(ptScene->sbtVisibleDrawables0, tVisibleDrawable);
-                }
+                pl_sb_push(ptScene->sbtVisibleDrawables1, tVisibleDrawable);
+            }
+            else if(!(tDrawable.tFlags & PL_DRAWABLE_FLAG_PROBE))
+            {
+                pl_sb_push(ptScene->sbtVisibleDrawables0, tVisibleDrawable);
             }
         }
 
@@ -2314,6 +2222,65 @@ pl__renderer_probe_data_pack_index(plScene* ptScene, uint32_t uResolution)
     return pl_sb_size(ptScene->sbtProbeDataPacks) - 1;
 }
 
+static void
+pl__renderer_radix_sort_keys(uint32_t uCount, uint64_t* auKeys, uint32_t* auIndices)
+{
+    // stable LSD radix sort (8 bit digits) of keys & their payload indices;
+    // digits shared by every key are skipped so narrow keys only pay for the
+    // bytes that actually differ
+    if(uCount < 2)
+        return;
+
+    uint64_t* auKeysScratch    = PL_ALLOC(sizeof(uint64_t) * uCount);
+    uint32_t* auIndicesScratch = PL_ALLOC(sizeof(uint32_t) * uCount);
+
+    uint64_t* auSrcKeys    = auKeys;
+    uint32_t* auSrcIndices = auIndices;
+    uint64_t* auDstKeys    = auKeysScratch;
+    uint32_t* auDstIndices = auIndicesScratch;
+
+    for(uint32_t uShift = 0; uShift < 64; uShift += 8)
+    {
+        uint32_t auOffsets[256] = {0};
+        for(uint32_t i = 0; i < uCount; i++)
+            auOffsets[(auSrcKeys[i] >> uShift) & 0xFF]++;
+
+        if(auOffsets[(auSrcKeys[0] >> uShift) & 0xFF] == uCount)
+            continue;
+
+        uint32_t uSum = 0;
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            const uint32_t uDigitCount = auOffsets[i];
+            auOffsets[i] = uSum;
+            uSum += uDigitCount;
+        }
+
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const uint32_t uDst = auOffsets[(auSrcKeys[i] >> uShift) & 0xFF]++;
+            auDstKeys[uDst] = auSrcKeys[i];
+            auDstIndices[uDst] = auSrcIndices[i];
+        }
+
+        uint64_t* auTempKeys = auSrcKeys;
+        uint32_t* auTempIndices = auSrcIndices;
+        auSrcKeys = auDstKeys;
+        auSrcIndices = auDstIndices;
+        auDstKeys = auTempKeys;
+        auDstIndices = auTempIndices;
+    }
+
+    if(auSrcKeys != auKeys)
+    {
+        memcpy(auKeys, auSrcKeys, sizeof(uint64_t) * uCount);
+        memcpy(auIndices, auSrcIndices, sizeof(uint32_t) * uCount);
+    }
+
+    PL_FREE(auKeysScratch);
+    PL_FREE(auIndicesScratch);
+}
+
 static uint64_t
 pl__renderer_add_material_to_scene(plScene* ptScene, plEntity tMaterial)
 {
@@ -4998,8 +4965,6 @@ pl__renderer_probe_update_all(plScene* ptScene)
         ptProbe->tViewData.fCameraNearZ  = 0.26f;
         ptProbe->tViewData.fAspectRatio  = 1.0f;
 
-        const uint32_t uDrawableCount = pl_sb_size(ptScene->sbtDrawables);
-
         //~~~~~~~~~~~~~~~~~~~~~~~~~~~~probe face pre-calc~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
         plDrawArea tArea = {
@@ -5229,8 +5194,7 @@ pl__renderer_probe_update_all(plScene* ptScene)
 
             plCullData tCullData = {
                 .ptScene      = ptScene,
-                .ptCullCamera = &atEnvironmentCamera[uFace],
-                .atDrawables  = ptScene->sbtDrawables
+                .ptCullCamera = &atEnvironmentCamera[uFace]
             };
             pl__camera_build_perspective_frustum(&atEnvironmentCamera[uFace], &tCullData.tFrustum);
             
@@ -5239,24 +5203,21 @@ pl__renderer_probe_update_all(plScene* ptScene)
                 .pData = &tCullData
             };
 
-            plAtomicCounter* ptCullCounter = NULL;
-            gptJob->dispatch_batch(uDrawableCount, 0, tJobDesc, &ptCullCounter);
-            gptJob->wait_for_counter(ptCullCounter);
+            const uint32_t* auVisibleDrawables = NULL;
+            const uint32_t uVisibleCount = pl__renderer_cull_drawables(&tCullData, tJobDesc, &auVisibleDrawables);
             pl_sb_reset(ptScene->sbuVisibleDeferredEntities);
             pl_sb_reset(ptScene->sbuVisibleForwardEntities);
             pl_sb_reset(ptScene->sbuVisibleTransmissionEntities);
-            for(uint32_t uDrawableIndex = 0; uDrawableIndex < uDrawableCount; uDrawableIndex++)
+            for(uint32_t i = 0; i < uVisibleCount; i++)
             {
+                const uint32_t uDrawableIndex = auVisibleDrawables[i];
                 const plDrawable tDrawable = ptScene->sbtDrawables[uDrawableIndex];
-                if(!tDrawable.bCulled)
-                {
-                    if(tDrawable.tFlags & PL_DRAWABLE_FLAG_DEFERRED)
-                        pl_sb_push(ptScene->sbuVisibleDeferredEntities, uDrawableIndex);
-                    else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_FORWARD)
-                        pl_sb_push(ptScene->sbuVisibleForwardEntities, uDrawableIndex);
-                    else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_TRANSMISSION)
-                        pl_sb_push(ptScene->sbuVisibleTransmissionEntities, uDrawableIndex);
-                }
+                if(tDrawable.tFlags & PL_DRAWABLE_FLAG_DEFERRED)
+                    pl_sb_push(ptScene->sbuVisibleDeferredEntities, uDrawableIndex);
+                else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_FORWARD)
+                    pl_sb_push(ptScene->sbuVisibleForwardEntities, uDrawableIndex);
+                else if(tDrawable.tFlags & PL_DRAWABLE_FLAG_TRANSMISSION)
+                    pl_sb_push(ptScene->sbuVisibleTransmissionEntities, uDrawableIndex);
             }
 
             //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~update bind groups~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -67,6 +67,7 @@ Index of this file:
 #include "pl_shader_variant_ext.h"
 #include "pl_model_loader_ext.h"
 #include "pl_gjk_ext.h"
+#include "pl_renderer_culling.inl" // plCullBounds & kernels
 #include "pl_script_ext.h"
 #include "pl_material_ext.h"
 
@@ -245,7 +246,7 @@ typedef struct _plDrawable
     uint32_t        uIndexCount;
     uint32_t        uInstanceIndex;
     uint32_t        uSkinIndex;
-    bool            bCulled;
+    uint64_t        ulSortKey; // material (high 32 bits) | mesh (low 32 bits)
 } plDrawable;
 
 typedef struct _plDrawableResources
@@ -524,6 +525,10 @@ typedef struct _plScene
     plBVH       tBvh;
     plAABB*     sbtBvhAABBs;
     plBVHNode** sbtNodeStack;
+    bool        bBvhDirty;                // full rebuild required (set at creation & when objects/transforms are added or removed)
+    uint32_t    uBvhObjectGeneration;     // object component generation at last build
+    uint32_t    uBvhTransformGeneration;  // transform component generation at last build
+    uint32_t*   sbuBvhTransformIndices;   // object index -> transform component index (cached at build)
 
     // outlines
     plEntity* sbtOutlinedEntities;
@@ -556,6 +561,7 @@ typedef struct _plScene
     plRendererSkyOptions         tSkyOptions;
 
     // culling
+    plCullBounds       tCullBounds;
     plVisibleDrawable* sbtVisibleDrawables0;
     plVisibleDrawable* sbtVisibleDrawables1;
 } plScene;
@@ -633,7 +639,6 @@ typedef struct _plCullData
 {
     plScene*        ptScene;
     const plCamera* ptCullCamera;
-    plDrawable*     atDrawables;
     plFrustum       tFrustum;
     plSphere        tSphere;
     plCone          tCone;
@@ -668,12 +673,18 @@ static plRefRendererData* gptData = NULL;
 // misc.
 static inline plDynamicBinding pl__allocate_dynamic_data(plDevice* ptDevice, uint32_t uSize){ return pl_allocate_dynamic_data(gptGfx, gptData->ptDevice, &gptData->tCurrentDynamicDataBlock, uSize);}
 static bool pl__renderer_add_drawable_data_to_global_buffer(plScene*, uint32_t uDrawableIndex);
+static void pl__renderer_radix_sort_keys(uint32_t count, uint64_t* keys, uint32_t* indices);
 
 // job system tasks
 static void pl__renderer_cull_job            (plInvocationData, void*, void*);
 static void pl__renderer_cull_point_light_job(plInvocationData, void*, void*);
 static void pl__renderer_cull_spot_light_job (plInvocationData, void*, void*);
 
+// culling helpers
+static void     pl__renderer_update_cull_bounds (plScene*);
+static void     pl__renderer_cleanup_cull_bounds(plScene*);
+static uint32_t pl__renderer_cull_drawables     (plCullData*, plJobDesc, const uint32_t** visibleOut);
+
 // camera helpers
 static void pl__camera_build_perspective_frustum(const plCamera*, plFrustum*);
 static void pl__camera_build_orthographic_frustum(const plCamera*, plFrustum*);
@@ -27,7 +27,7 @@ Index of this file:
         APIs being available:
 
         * plFileI (v1.x)
-        * plPakI  (v1.x)
+        * plPakI  (v2.x)
     
     Limitations:
         Currently, pak files can't be written to. This is a limitation for the
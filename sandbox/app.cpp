@@ -953,8 +953,10 @@ pl__show_editor_window(plAppData* ptAppData)
                 }
 
                 ImGui::Checkbox("Dynamic BVH", &ptAppData->bContinuousBVH);
-                if((ImGui::Button("Build BVH") || ptAppData->bContinuousBVH))
+                if(ImGui::Button("Build BVH"))
                     gptRendererEditor->rebuild_scene_bvh(ptAppData->tTestWorld.ptScene);
+                else if(ptAppData->bContinuousBVH)
+                    gptRendererEditor->update_scene_bvh(ptAppData->tTestWorld.ptScene);
             }
 
             if(ImGui::CollapsingHeader(ICON_FA_DICE_D6 " Renderer"))
@@ -722,7 +722,10 @@ with pl.project("pilotlight"):
     shaders = [
         'pl_draw_2d_frag',
         'pl_draw_2d_sdf_frag',
-        'pl_draw_2d_vert'
+        'pl_draw_2d_vert',
+        'pl_draw_3d_frag',
+        'pl_draw_3d_line_vert',
+        'pl_draw_3d_vert'
     ]
 
     for shader in shaders:
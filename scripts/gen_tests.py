@@ -213,6 +213,68 @@ with pl.project("pilotlight_lib_tests"):
                     pl.add_compiler_flags("-std=c99", "-fmodules", "-fPIC")
                     pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
 
+    #-----------------------------------------------------------------------------
+    # [SECTION] c benchmarks app
+    #-----------------------------------------------------------------------------
+
+    with pl.target("benchmarks", pl.TargetType.DYNAMIC_LIBRARY):
+
+        pl.set_output_binary("benchmarks")
+        pl.add_source_files("app_benchmarks.c")
+
+        with pl.configuration("debug"):
+
+            pl.add_definitions("PL_CONFIG_DEBUG", "_DEBUG")
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_linker_flags("-incremental:no", "-noimplib", "-noexp")
+                    pl.add_compiler_flags("-Od", "-MDd", "-Zi", "-Zc:preprocessor", "-nologo", "-std:c11", "-W4",
+                                          "-WX", "-wd4201", "-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105",
+                                          "-wd4115", "-permissive-")
+            
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_linker_flags("-ldl", "-lm")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC", "--debug", "-g")
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+
+            # mac os
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("--debug", "-g", "-std=c99", "-fmodules", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+
+        # release
+        with pl.configuration("release"):
+
+            pl.add_definitions("PL_CONFIG_RELEASE", "NDEBUG")
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_linker_flags("-incremental:no", "-noimplib", "-noexp")
+                    pl.add_compiler_flags("-O2", "-MD", "-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX",
+                                          "-wd4201", "-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115",
+                                          "-permissive-")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_linker_flags("-ldl", "-lm")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC")
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+
+            # mac os
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "-fmodules", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+
     #-----------------------------------------------------------------------------
     # [SECTION] c++ app
     #-----------------------------------------------------------------------------
@@ -18,7 +18,7 @@ struct PL_DYNAMIC_DATA{
     plVec2 uTranslate;
 };
 
-PL_EXPORT plVec2
+PL_EXPORT plVec4
 main_vert(plVertexShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets, const void* pVertexDataIn, plVaryingData* ptVaryingDataOut) 
 {
     const char* pcVertexDataIn = (const char*)pVertexDataIn;
@@ -41,5 +41,7 @@ main_vert(plVertexShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets, c
 
     return {
         tPos.x * tObjectInfo->uScale.x + tObjectInfo->uTranslate.x,
-        tPos.y * tObjectInfo->uScale.y + tObjectInfo->uTranslate.y};
+        tPos.y * tObjectInfo->uScale.y + tObjectInfo->uTranslate.y,
+        0.0f,
+        1.0f};
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include "pl.inc"
+#include  <cstddef>
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl_math.h"
+#include "pl_graphics_ext.h"
+#include "pl_shader_interop_cpu.h"
+
+PL_EXPORT plVec4
+main_frag(plPixelShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets, const plVaryingData* ptVaryingDataIn)
+{
+    const plVec4* ptColor = (plVec4*)pl_shading_get_varying(0, ptVaryingDataIn);
+    return {ptColor->b, ptColor->g, ptColor->r, ptColor->a};
+}
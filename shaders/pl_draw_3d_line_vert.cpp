@@ -0,0 +1,65 @@
+#include "pl.inc"
+#include  <cstddef>
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl_math.h"
+#include "pl_graphics_ext.h"
+#include "pl_shader_interop_cpu.h"
+
+void unpackUnorm4x8(uint32_t packed, float out[4]) {
+    // Extract each byte and normalize to [0.0, 1.0]
+    out[0] = ((packed >> 0)  & 0xFF) / 255.0f;  // R
+    out[1] = ((packed >> 8)  & 0xFF) / 255.0f;  // G
+    out[2] = ((packed >> 16) & 0xFF) / 255.0f;  // B
+    out[3] = ((packed >> 24) & 0xFF) / 255.0f;  // A
+}
+
+struct PL_DYNAMIC_DATA{
+    plMat4 tMVP;
+    float fAspect;
+};
+
+PL_EXPORT plVec4
+main_vert(plVertexShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets, const void* pVertexDataIn, plVaryingData* ptVaryingDataOut) 
+{
+    plVec3 tPos = *(plVec3*)pl_shading_get_vertex_attrib(pVertexDataIn, tBuiltIns.atLayouts, 0, 0);
+    plVec3 tInfo = *(plVec3*)pl_shading_get_vertex_attrib(pVertexDataIn, tBuiltIns.atLayouts, 0, 1);
+    plVec3 tPosOther = *(plVec3*)pl_shading_get_vertex_attrib(pVertexDataIn, tBuiltIns.atLayouts, 0, 2);
+    uint32_t uColor = *(uint32_t*)pl_shading_get_vertex_attrib(pVertexDataIn, tBuiltIns.atLayouts, 0, 3);
+
+    plVec4 tColor;
+    unpackUnorm4x8(uColor, tColor.d);
+
+    // set varyings (outputs)
+    plVec4* ptColor = (plVec4*)pl_shading_set_varying(PL_VARYING_TYPE_VEC4, ptVaryingDataOut);  
+    *ptColor = tColor;
+
+    plDescriptor tDynamicBuffer = atDescriptorSets[3].atDescriptors[0];
+    PL_DYNAMIC_DATA* tObjectInfo = (PL_DYNAMIC_DATA*)tDynamicBuffer.puData;
+
+    // clip space
+    plVec4 tCurrentProj = pl_mul_mat4_vec4(&tObjectInfo->tMVP, {tPos.x, tPos.y, tPos.z, 1.0f});
+    plVec4 tOtherProj   = pl_mul_mat4_vec4(&tObjectInfo->tMVP, {tPosOther.x, tPosOther.y, tPosOther.z, 1.0f});
+
+    // NDC space
+    plVec2 tCurrentNDC = {tCurrentProj.x / tCurrentProj.w, tCurrentProj.y / tCurrentProj.w};
+    plVec2 tOtherNDC = {tOtherProj.x / tOtherProj.w, tOtherProj.y / tOtherProj.w};
+
+    // correct for aspect
+    tCurrentNDC.x *= tObjectInfo->fAspect;
+    tOtherNDC.x *= tObjectInfo->fAspect;
+
+    // normal of line (B - A)
+    plVec2 tDir = pl_mul_vec2_scalarf(pl_norm_vec2(pl_sub_vec2(tOtherNDC, tCurrentNDC)), tInfo.z);
+    plVec2 tNormal = {-tDir.y, tDir.x};
+
+    // extrude from center & correct aspect ratio
+    tNormal = pl_mul_vec2_scalarf(tNormal, tInfo.y / 2.0f);
+    tNormal.x /= tObjectInfo->fAspect;
+
+    // offset by the direction of this point in the pair (-1 or 1)
+    return {
+        tCurrentProj.x + tNormal.x * tInfo.x,
+        tCurrentProj.y + tNormal.y * tInfo.x,
+        tCurrentProj.z,
+        tCurrentProj.w};
+}
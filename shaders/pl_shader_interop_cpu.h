@@ -6,6 +6,14 @@
 #include "pl_math.h"
 // #include "pl_graphics_ext.h"
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+// group shared memory for workgroups run on the submitting thread (matches the
+// common vulkan maxComputeSharedMemorySize)
+#define PL_CPU_COMPUTE_SHARED_MEMORY_SIZE 32768
+
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations
 //-----------------------------------------------------------------------------
@@ -17,6 +25,7 @@ typedef struct _plFrameBufferData plFrameBufferData;
 typedef struct _plVaryingData          plVaryingData;
 typedef struct _plPixelShaderBuiltIns  plPixelShaderBuiltIns;
 typedef struct _plVertexShaderBuiltIns plVertexShaderBuiltIns;
+typedef struct _plComputeShaderBuiltIns plComputeShaderBuiltIns;
 typedef struct _plDescriptorSet        plDescriptorSet;
 typedef struct _plDescriptor           plDescriptor;
 
@@ -26,7 +35,8 @@ typedef int plDescriptorType;
 
 // function pointers
 typedef plVec4 (*plPixelShader) (plPixelShaderBuiltIns, plDescriptorSet*, const plVaryingData*);
-typedef plVec2 (*plVertexShader)(plVertexShaderBuiltIns, plDescriptorSet*, const void*, plVaryingData*);
+typedef plVec4 (*plVertexShader)(plVertexShaderBuiltIns, plDescriptorSet*, const void*, plVaryingData*); // returns clip space position
+typedef void   (*plComputeKernel)(plComputeShaderBuiltIns, plDescriptorSet*); // called once per workgroup
 
 typedef struct _plVertexBufferLayout     plVertexBufferLayout;
 
@@ -63,6 +73,22 @@ typedef struct _plVertexShaderBuiltIns
     const plVertexBufferLayout* atLayouts;
 } plVertexShaderBuiltIns;
 
+typedef struct _plComputeShaderBuiltIns
+{
+    // kernels loop over the invocations of their workgroup themselves, so a
+    // barrier() becomes the boundary between two such loops
+    uint32_t    gl_WorkGroupID[3];
+    uint32_t    gl_NumWorkGroups[3];
+    uint32_t    gl_WorkGroupSize[3];
+
+    // group shared memory (plJobSystemInit::szSharedMemorySize when workgroups
+    // run through the job system, PL_CPU_COMPUTE_SHARED_MEMORY_SIZE otherwise)
+    void*       pGroupSharedMemory;
+    size_t      szGroupSharedMemorySize;
+
+    const void* pSpecializationData; // plComputeShaderDesc::pTempConstantData (NULL if no constants)
+} plComputeShaderBuiltIns;
+
 typedef struct _plDescriptor
 {
     plDescriptorType eType;
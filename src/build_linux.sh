@@ -605,6 +605,174 @@ fi
 # hot reload skip
 fi
 
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_frag | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_frag.so" ] || [ -n "$(find "../out/libpl_draw_3d_frag.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_frag.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC --debug -g "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_frag.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_frag.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_frag.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_line_vert | debug ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_line_vert.so" ] || [ -n "$(find "../out/libpl_draw_3d_line_vert.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_line_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC --debug -g "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_line_vert.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_line_vert.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_line_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_vert | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_vert.so" ] || [ -n "$(find "../out/libpl_draw_3d_vert.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC --debug -g "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_vert.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_vert.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
 #~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ imgui | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 # skip during hot reload
@@ -1320,6 +1488,174 @@ fi
 # hot reload skip
 fi
 
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_frag | test ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_frag.so" ] || [ -n "$(find "../out/libpl_draw_3d_frag.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_frag.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC --debug -g "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_frag.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_frag.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_frag.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_line_vert | test ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_line_vert.so" ] || [ -n "$(find "../out/libpl_draw_3d_line_vert.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_line_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC --debug -g "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_line_vert.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_line_vert.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_line_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_vert | test ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_vert.so" ] || [ -n "$(find "../out/libpl_draw_3d_vert.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC --debug -g "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_vert.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_vert.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
 #~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ imgui | test ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 # skip during hot reload
@@ -2035,6 +2371,174 @@ fi
 # hot reload skip
 fi
 
+#~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_frag | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_frag.so" ] || [ -n "$(find "../out/libpl_draw_3d_frag.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_frag.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_frag.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_frag.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_frag.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_frag${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
+#~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_line_vert | release ~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_line_vert.so" ] || [ -n "$(find "../out/libpl_draw_3d_line_vert.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_line_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_line_vert.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_line_vert.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_line_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_line_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_vert | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+# skip during hot reload
+if [ $PL_HOT_RELOAD_STATUS -ne 1 ]; then
+
+# only build once
+if [ ! -e "../out/libpl_draw_3d_vert.so" ] || [ -n "$(find "../out/libpl_draw_3d_vert.so" -mmin +10 -print -quit)" ]; then
+
+if [ -e "../out/libpl_draw_3d_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${RED}Expired${NC}
+fi
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+PL_DEFINES="-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE "
+PL_INCLUDE_DIRECTORIES="-I../sandbox -I../src -I../shaders -I../libs -I../extensions -I../out -I../thirdparty/stb -I../thirdparty/cgltf -I../thirdparty/imgui -I../src -I../shaders -I../libs -I../extensions "
+PL_LINK_DIRECTORIES="-L../out -Wl,-rpath,../out "
+PL_COMPILER_FLAGS="-std=c++14 -fPIC "
+PL_LINKER_FLAGS="-lstdc++ -ldl -lm "
+PL_STATIC_LINK_LIBRARIES=""
+PL_DYNAMIC_LINK_LIBRARIES=""
+PL_SOURCES="../shaders/pl_draw_3d_vert.cpp "
+
+# run compiler (and linker)
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo ${CYAN}Compiling and Linking...${NC}
+gcc -shared $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_INCLUDE_DIRECTORIES $PL_LINK_DIRECTORIES $PL_STATIC_LINK_LIBRARIES $PL_DYNAMIC_LINK_LIBRARIES $PL_LINKER_FLAGS -o "./../out/libpl_draw_3d_vert.so"
+
+# check build status
+if [ $? -ne 0 ]
+then
+    PL_RESULT=${BOLD}${RED}Failed.${NC}
+    PL_BUILD_STATUS=1
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+popd >/dev/null
+exit 1
+fi
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+echo ${CYAN}~~~~~~~~~~~~~~~~~~~~~~${NC}
+
+# only build once check
+elif [ -e "../out/libpl_draw_3d_vert.so" ]; then
+echo
+echo ${YELLOW}Target: pl_draw_3d_vert${NC}
+echo ${YELLOW}~~~~~~~~~~~~~~~~~~~${NC}
+echo Cache: ${GREEN}Valid${NC}
+fi
+# hot reload skip
+fi
+
 #~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ imgui | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 # skip during hot reload
@@ -619,6 +619,180 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 
 @del "..\out\*.obj"  > nul 2> nul
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_frag | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_frag
+
+:: only build once
+@if exist "..\out\pl_draw_3d_frag.dll" goto CacheCheck_pl_draw_3d_frag
+@if not exist "..\out\pl_draw_3d_frag.dll" goto Build_pl_draw_3d_frag
+
+:CacheCheck_pl_draw_3d_frag
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_frag.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_frag[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_frag
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_frag[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_frag
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_frag.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_frag[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_frag.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_frag_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_frag
+
+@del "..\out\*.obj"  > nul 2> nul
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_line_vert | debug ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_line_vert
+
+:: only build once
+@if exist "..\out\pl_draw_3d_line_vert.dll" goto CacheCheck_pl_draw_3d_line_vert
+@if not exist "..\out\pl_draw_3d_line_vert.dll" goto Build_pl_draw_3d_line_vert
+
+:CacheCheck_pl_draw_3d_line_vert
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_line_vert.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_line_vert
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_line_vert
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_line_vert.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_line_vert.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_line_vert_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_line_vert
+
+@del "..\out\*.obj"  > nul 2> nul
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_vert | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_vert
+
+:: only build once
+@if exist "..\out\pl_draw_3d_vert.dll" goto CacheCheck_pl_draw_3d_vert
+@if not exist "..\out\pl_draw_3d_vert.dll" goto Build_pl_draw_3d_vert
+
+:CacheCheck_pl_draw_3d_vert
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_vert.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_vert[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_vert
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_vert
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_vert.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_vert.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_vert_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_vert
+
+@del "..\out\*.obj"  > nul 2> nul
+
 ::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ imgui | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 :: skip during hot reload
@@ -1358,6 +1532,180 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 
 @del "..\out\*.obj"  > nul 2> nul
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_frag | test ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_frag
+
+:: only build once
+@if exist "..\out\pl_draw_3d_frag.dll" goto CacheCheck_pl_draw_3d_frag
+@if not exist "..\out\pl_draw_3d_frag.dll" goto Build_pl_draw_3d_frag
+
+:CacheCheck_pl_draw_3d_frag
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_frag.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_frag[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_frag
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_frag[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_frag
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_frag.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_frag[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_frag.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_frag_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuptest
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_frag
+
+@del "..\out\*.obj"  > nul 2> nul
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_line_vert | test ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_line_vert
+
+:: only build once
+@if exist "..\out\pl_draw_3d_line_vert.dll" goto CacheCheck_pl_draw_3d_line_vert
+@if not exist "..\out\pl_draw_3d_line_vert.dll" goto Build_pl_draw_3d_line_vert
+
+:CacheCheck_pl_draw_3d_line_vert
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_line_vert.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_line_vert
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_line_vert
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_line_vert.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_line_vert.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_line_vert_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuptest
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_line_vert
+
+@del "..\out\*.obj"  > nul 2> nul
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_vert | test ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_vert
+
+:: only build once
+@if exist "..\out\pl_draw_3d_vert.dll" goto CacheCheck_pl_draw_3d_vert
+@if not exist "..\out\pl_draw_3d_vert.dll" goto Build_pl_draw_3d_vert
+
+:CacheCheck_pl_draw_3d_vert
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_vert.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_vert[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_vert
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_vert
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_vert.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_vert.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_vert_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuptest
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_vert
+
+@del "..\out\*.obj"  > nul 2> nul
+
 ::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ imgui | test ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 :: skip during hot reload
@@ -2099,6 +2447,180 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 
 @del "..\out\*.obj"  > nul 2> nul
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_frag | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_frag
+
+:: only build once
+@if exist "..\out\pl_draw_3d_frag.dll" goto CacheCheck_pl_draw_3d_frag
+@if not exist "..\out\pl_draw_3d_frag.dll" goto Build_pl_draw_3d_frag
+
+:CacheCheck_pl_draw_3d_frag
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_frag.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_frag[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_frag
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_frag[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_frag
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_frag.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_frag[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_frag.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_frag_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_frag
+
+@del "..\out\*.obj"  > nul 2> nul
+
+::~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_line_vert | release ~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_line_vert
+
+:: only build once
+@if exist "..\out\pl_draw_3d_line_vert.dll" goto CacheCheck_pl_draw_3d_line_vert
+@if not exist "..\out\pl_draw_3d_line_vert.dll" goto Build_pl_draw_3d_line_vert
+
+:CacheCheck_pl_draw_3d_line_vert
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_line_vert.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_line_vert
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_line_vert
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_line_vert.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_line_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_line_vert.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_line_vert_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_line_vert
+
+@del "..\out\*.obj"  > nul 2> nul
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_draw_3d_vert | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_draw_3d_vert
+
+:: only build once
+@if exist "..\out\pl_draw_3d_vert.dll" goto CacheCheck_pl_draw_3d_vert
+@if not exist "..\out\pl_draw_3d_vert.dll" goto Build_pl_draw_3d_vert
+
+:CacheCheck_pl_draw_3d_vert
+powershell -NoProfile -Command ^ "if ((Get-Date) - (Get-Item '"..\out\pl_draw_3d_vert.dll"').LastWriteTime -gt [TimeSpan]::FromMinutes(10)) { exit 0 } else { exit 1 }"
+
+if %ERRORLEVEL% NEQ 0 (
+@echo.
+    @echo [1m[93mTarget: pl_draw_3d_vert[0m
+    @echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+    @echo [1mCache: [92mValid[0m
+    goto Exit_pl_draw_3d_vert
+)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1mCache: [91mExpired[0m
+@echo.
+
+:Build_pl_draw_3d_vert
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_CPU_BACKEND -DPL_SHADER_CODE 
+@set PL_INCLUDE_DIRECTORIES=-I"../sandbox" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" -I"../thirdparty/cgltf" -I"../thirdparty/imgui" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c++14 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD -Zi -TP 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="../shaders/pl_draw_3d_vert.cpp" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: pl_draw_3d_vert[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_draw_3d_vert.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/pl_draw_3d_vert_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_draw_3d_vert
+
+@del "..\out\*.obj"  > nul 2> nul
+
 ::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ imgui | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 :: skip during hot reload
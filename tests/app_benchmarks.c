@@ -0,0 +1,1212 @@
+/*
+   app_benchmarks.c
+     - simple performance benchmarks for extensions
+     - run with "pilot_light -a benchmarks" (preferably release builds)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] global apis
+// [SECTION] structs
+// [SECTION] benchmark declarations
+// [SECTION] pl_app_load
+// [SECTION] pl_app_shutdown
+// [SECTION] pl_app_resize
+// [SECTION] pl_app_update
+// [SECTION] helpers
+// [SECTION] job benchmarks
+// [SECTION] bvh benchmarks
+// [SECTION] compress benchmarks
+// [SECTION] cpu rasterizer benchmarks
+// [SECTION] mesh builder benchmarks
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl.h"
+
+// extensions
+#include "pl_platform_ext.h"
+#include "pl_job_ext.h"
+#include "pl_bvh_ext.h"
+#include "pl_compress_ext.h"
+#include "pl_mesh_ext.h"
+#include "pl_graphics_ext.h"
+#include "pl_shader_interop_cpu.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] global apis
+//-----------------------------------------------------------------------------
+
+const plIOI*       gptIO       = NULL;
+const plMemoryI*   gptMemory   = NULL;
+const plTimerI*    gptTimer    = NULL;
+const plJobI*      gptJob      = NULL;
+const plAtomicsI*  gptAtomics  = NULL;
+const plBVHI*      gptBvh      = NULL;
+const plCompressI* gptCompress = NULL;
+const plThreadsI*  gptThreads  = NULL;
+const plGraphicsI* gptGfx      = NULL;
+
+const plMeshBuilderI* gptMeshBuilder = NULL;
+
+#define PL_ALLOC(x)      gptMemory->tracked_realloc(NULL, (x), __FILE__, __LINE__)
+#define PL_REALLOC(x, y) gptMemory->tracked_realloc((x), (y), __FILE__, __LINE__)
+#define PL_FREE(x)       gptMemory->tracked_realloc((x), 0, __FILE__, __LINE__)
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plBenchmark
+{
+    const char* pcName;
+    uint32_t    uIterations;
+    double      dTotalTime;
+    double      dMinTime;
+} plBenchmark;
+
+//-----------------------------------------------------------------------------
+// [SECTION] benchmark declarations
+//-----------------------------------------------------------------------------
+
+void job_benchmarks(void);
+void bvh_benchmarks(void);
+void compress_benchmarks(void);
+void raster_benchmarks(void);
+void mesh_builder_benchmarks(void);
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_load
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void*
+pl_app_load(plApiRegistryI* ptApiRegistry, void* pAppData)
+{
+    const plExtensionRegistryI* ptExtensionRegistry = pl_get_api_latest(ptApiRegistry, plExtensionRegistryI);
+    ptExtensionRegistry->load("pl_unity_ext", NULL, NULL, false);
+    ptExtensionRegistry->load("pl_platform_ext", "pl_load_platform_ext", "pl_unload_platform_ext", false);
+    ptExtensionRegistry->load("pl_graphics_cpu_ext", "pl_load_graphics_ext", "pl_unload_graphics_ext", false);
+
+    gptIO       = pl_get_api_latest(ptApiRegistry, plIOI);
+    gptMemory   = pl_get_api_latest(ptApiRegistry, plMemoryI);
+    gptTimer    = pl_get_api_latest(ptApiRegistry, plTimerI);
+    gptJob      = pl_get_api_latest(ptApiRegistry, plJobI);
+    gptAtomics  = pl_get_api_latest(ptApiRegistry, plAtomicsI);
+    gptBvh      = pl_get_api_latest(ptApiRegistry, plBVHI);
+    gptCompress = pl_get_api_latest(ptApiRegistry, plCompressI);
+    gptThreads  = pl_get_api_latest(ptApiRegistry, plThreadsI);
+    gptGfx      = pl_get_api_latest(ptApiRegistry, plGraphicsI);
+
+    gptMeshBuilder = pl_get_api_latest(ptApiRegistry, plMeshBuilderI);
+
+    job_benchmarks();
+    bvh_benchmarks();
+    compress_benchmarks();
+    raster_benchmarks();
+    mesh_builder_benchmarks();
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_shutdown
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_shutdown(void* pAppData)
+{
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_resize
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_resize(plWindow* ptWindow, void* pAppData)
+{
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_update
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_update(void* pAppData)
+{
+    gptIO->new_frame();
+    gptIO->get_io()->bRunning = false;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] helpers
+//-----------------------------------------------------------------------------
+
+static void
+pl__benchmark_begin_suite(const char* pcName)
+{
+    printf("\n------%s------\n\n", pcName);
+    printf("%-48s %10s %12s %12s\n", "benchmark", "iterations", "avg (ms)", "min (ms)");
+}
+
+static void
+pl__benchmark_report(const plBenchmark* ptBenchmark)
+{
+    printf("%-48s %10u %12.4f %12.4f\n",
+        ptBenchmark->pcName,
+        ptBenchmark->uIterations,
+        ptBenchmark->dTotalTime * 1000.0 / (double)ptBenchmark->uIterations,
+        ptBenchmark->dMinTime * 1000.0);
+}
+
+static void
+pl__benchmark_add_sample(plBenchmark* ptBenchmark, double dTime)
+{
+    if(ptBenchmark->uIterations == 0 || dTime < ptBenchmark->dMinTime)
+        ptBenchmark->dMinTime = dTime;
+    ptBenchmark->dTotalTime += dTime;
+    ptBenchmark->uIterations++;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] job benchmarks
+//-----------------------------------------------------------------------------
+
+typedef struct _plJobBenchmarkData
+{
+    float*   afValues;
+    uint32_t uChildJobCount;
+    uint32_t uChildGroupSize;
+} plJobBenchmarkData;
+
+static void
+pl__job_benchmark_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobBenchmarkData* ptData = pData;
+
+    // tiny amount of work so scheduling overhead dominates
+    float fValue = (float)tInvoData.uGlobalIndex;
+    for(uint32_t i = 0; i < 16; i++)
+        fValue = fValue * 0.5f + 1.0f;
+    ptData->afValues[tInvoData.uGlobalIndex] = fValue;
+}
+
+static void
+pl__job_benchmark_parent_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobBenchmarkData* ptData = pData;
+
+    plJobBenchmarkData tChildData = *ptData;
+    tChildData.afValues = &ptData->afValues[tInvoData.uGlobalIndex * ptData->uChildJobCount];
+
+    plJobDesc tJobDesc = {
+        .task  = pl__job_benchmark_task,
+        .pData = &tChildData
+    };
+    plJobCounter* ptCounter = NULL;
+    gptJob->dispatch_batch(ptData->uChildJobCount, ptData->uChildGroupSize, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+}
+
+void
+job_benchmarks(void)
+{
+    pl__benchmark_begin_suite("pl_job_ext.h");
+
+    const uint32_t uIterations = 100;
+    const uint32_t uJobCount = 1 << 16;
+    float* afValues = PL_ALLOC(sizeof(float) * uJobCount);
+
+    const struct {
+        const char*      pcName;
+        plJobSystemFlags eFlags;
+    } atModes[] = {
+        {"shared queue",  PL_JOB_SYSTEM_FLAGS_NONE},
+        {"work stealing", PL_JOB_SYSTEM_FLAGS_WORK_STEALING},
+    };
+
+    const uint32_t auGroupSizes[] = {1, 16, 256};
+
+    char acName[128] = {0};
+    for(uint32_t uMode = 0; uMode < 2; uMode++)
+    {
+        gptJob->initialize((plJobSystemInit){.eFlags = atModes[uMode].eFlags});
+
+        // flat fine grained batches submitted from the main thread
+        for(uint32_t uGroup = 0; uGroup < 3; uGroup++)
+        {
+            snprintf(acName, 128, "%s: batch %u (group %u)", atModes[uMode].pcName, uJobCount, auGroupSizes[uGroup]);
+            plBenchmark tBenchmark = {.pcName = acName};
+
+            plJobBenchmarkData tData = {.afValues = afValues};
+            plJobDesc tJobDesc = {
+                .task  = pl__job_benchmark_task,
+                .pData = &tData
+            };
+
+            for(uint32_t i = 0; i < uIterations; i++)
+            {
+                const double dStart = gptTimer->get_time();
+                plJobCounter* ptCounter = NULL;
+                gptJob->dispatch_batch(uJobCount, auGroupSizes[uGroup], tJobDesc, &ptCounter);
+                gptJob->wait_for_counter(ptCounter);
+                pl__benchmark_add_sample(&tBenchmark, gptTimer->get_time() - dStart);
+            }
+            pl__benchmark_report(&tBenchmark);
+        }
+
+        // nested batches submitted from workers
+        {
+            snprintf(acName, 128, "%s: nested 64 x 1024 (group 4)", atModes[uMode].pcName);
+            plBenchmark tBenchmark = {.pcName = acName};
+
+            plJobBenchmarkData tData = {
+                .afValues        = afValues,
+                .uChildJobCount  = 1024,
+                .uChildGroupSize = 4
+            };
+            plJobDesc tJobDesc = {
+                .task  = pl__job_benchmark_parent_task,
+                .pData = &tData
+            };
+
+            for(uint32_t i = 0; i < uIterations; i++)
+            {
+                const double dStart = gptTimer->get_time();
+                plJobCounter* ptCounter = NULL;
+                gptJob->dispatch_batch(64, 1, tJobDesc, &ptCounter);
+                gptJob->wait_for_counter(ptCounter);
+                pl__benchmark_add_sample(&tBenchmark, gptTimer->get_time() - dStart);
+            }
+            pl__benchmark_report(&tBenchmark);
+        }
+
+        gptJob->cleanup();
+    }
+
+    PL_FREE(afValues);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] bvh benchmarks
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__bvh_benchmark_random(uint32_t* puSeed)
+{
+    *puSeed = *puSeed * 1664525u + 1013904223u;
+    return *puSeed >> 8;
+}
+
+static float
+pl__bvh_benchmark_randomf(uint32_t* puSeed, float fMax)
+{
+    return (float)pl__bvh_benchmark_random(puSeed) / (float)(1 << 24) * fMax;
+}
+
+static bool
+pl__bvh_benchmark_callback(uint32_t uIndex, void* pUserData)
+{
+    (*(uint32_t*)pUserData)++;
+    return false;
+}
+
+void
+bvh_benchmarks(void)
+{
+    pl__benchmark_begin_suite("pl_bvh_ext.h");
+
+    // clustered boxes (more like real scenes than uniform noise)
+    const uint32_t uBoxCount = 200000;
+    const uint32_t uQueryCount = 10000;
+    plAABB* atBoxes = PL_ALLOC(sizeof(plAABB) * uBoxCount);
+    plAABB* atQueries = PL_ALLOC(sizeof(plAABB) * uQueryCount);
+    plRay*  atRays = PL_ALLOC(sizeof(plRay) * uQueryCount);
+
+    uint32_t uSeed = 7;
+    plVec3 tCluster = {0};
+    for(uint32_t i = 0; i < uBoxCount; i++)
+    {
+        if(i % 1000 == 0)
+            tCluster = (plVec3){pl__bvh_benchmark_randomf(&uSeed, 1000.0f), pl__bvh_benchmark_randomf(&uSeed, 50.0f), pl__bvh_benchmark_randomf(&uSeed, 1000.0f)};
+        const plVec3 tCenter = {
+            tCluster.x + pl__bvh_benchmark_randomf(&uSeed, 40.0f),
+            tCluster.y + pl__bvh_benchmark_randomf(&uSeed, 10.0f),
+            tCluster.z + pl__bvh_benchmark_randomf(&uSeed, 40.0f)
+        };
+        const float fHalf = 0.1f + pl__bvh_benchmark_randomf(&uSeed, 1.0f);
+        atBoxes[i].tMin = (plVec3){tCenter.x - fHalf, tCenter.y - fHalf, tCenter.z - fHalf};
+        atBoxes[i].tMax = (plVec3){tCenter.x + fHalf, tCenter.y + fHalf, tCenter.z + fHalf};
+    }
+
+    for(uint32_t i = 0; i < uQueryCount; i++)
+    {
+        const plVec3 tCenter = {pl__bvh_benchmark_randomf(&uSeed, 1000.0f), pl__bvh_benchmark_randomf(&uSeed, 60.0f), pl__bvh_benchmark_randomf(&uSeed, 1000.0f)};
+        atQueries[i].tMin = (plVec3){tCenter.x - 5.0f, tCenter.y - 5.0f, tCenter.z - 5.0f};
+        atQueries[i].tMax = (plVec3){tCenter.x + 5.0f, tCenter.y + 5.0f, tCenter.z + 5.0f};
+
+        atRays[i].tOrigin = (plVec3){pl__bvh_benchmark_randomf(&uSeed, 1000.0f), 100.0f, pl__bvh_benchmark_randomf(&uSeed, 1000.0f)};
+        atRays[i].tDirection = (plVec3){pl__bvh_benchmark_randomf(&uSeed, 2.0f) - 1.0f, -1.0f, pl__bvh_benchmark_randomf(&uSeed, 2.0f) - 1.0f};
+    }
+
+    gptJob->initialize((plJobSystemInit){0});
+
+    const struct {
+        const char*     pcName;
+        plBVHBuildFlags tFlags;
+    } atModes[] = {
+        {"midpoint",     PL_BVH_BUILD_FLAGS_MIDPOINT},
+        {"sah",          PL_BVH_BUILD_FLAGS_NONE},
+        {"sah parallel", PL_BVH_BUILD_FLAGS_PARALLEL},
+    };
+
+    char acName[128] = {0};
+    for(uint32_t uMode = 0; uMode < 3; uMode++)
+    {
+        plBVH tBvh = {0};
+
+        snprintf(acName, 128, "%s: build %u", atModes[uMode].pcName, uBoxCount);
+        plBenchmark tBuild = {.pcName = acName};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            const double dStart = gptTimer->get_time();
+            gptBvh->build_ex(&tBvh, atBoxes, uBoxCount, atModes[uMode].tFlags);
+            pl__benchmark_add_sample(&tBuild, gptTimer->get_time() - dStart);
+        }
+        pl__benchmark_report(&tBuild);
+
+        if(atModes[uMode].tFlags & PL_BVH_BUILD_FLAGS_PARALLEL) // same tree as serial
+        {
+            gptBvh->cleanup(&tBvh);
+            continue;
+        }
+
+        uint32_t uCallbacks = 0;
+
+        snprintf(acName, 128, "%s: %u aabb queries", atModes[uMode].pcName, uQueryCount);
+        plBenchmark tAABBQueries = {.pcName = acName};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            const double dStart = gptTimer->get_time();
+            for(uint32_t j = 0; j < uQueryCount; j++)
+                gptBvh->intersects_aabb(&tBvh, atQueries[j], pl__bvh_benchmark_callback, &uCallbacks);
+            pl__benchmark_add_sample(&tAABBQueries, gptTimer->get_time() - dStart);
+        }
+        pl__benchmark_report(&tAABBQueries);
+
+        snprintf(acName, 128, "%s: %u ray queries", atModes[uMode].pcName, uQueryCount);
+        plBenchmark tRayQueries = {.pcName = acName};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            const double dStart = gptTimer->get_time();
+            for(uint32_t j = 0; j < uQueryCount; j++)
+                gptBvh->intersects_ray(&tBvh, atRays[j], pl__bvh_benchmark_callback, &uCallbacks);
+            pl__benchmark_add_sample(&tRayQueries, gptTimer->get_time() - dStart);
+        }
+        pl__benchmark_report(&tRayQueries);
+
+        gptBvh->cleanup(&tBvh);
+    }
+
+    // mostly static scene: 1% of boxes move each frame
+    {
+        const uint32_t uMovedCount = uBoxCount / 100;
+        plBVH tBvh = {0};
+        gptBvh->build(&tBvh, atBoxes, uBoxCount);
+
+        snprintf(acName, 128, "sah: update %u moved", uMovedCount);
+        plBenchmark tUpdate = {.pcName = acName};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            for(uint32_t j = 0; j < uMovedCount; j++)
+            {
+                plAABB* ptBox = &atBoxes[(j * 97 + i * 13) % uBoxCount];
+                ptBox->tMin.x += 2.0f;
+                ptBox->tMax.x += 2.0f;
+            }
+
+            const double dStart = gptTimer->get_time();
+            for(uint32_t j = 0; j < uMovedCount; j++)
+            {
+                const uint32_t uIndex = (j * 97 + i * 13) % uBoxCount;
+                gptBvh->update(&tBvh, uIndex, atBoxes[uIndex]);
+            }
+            pl__benchmark_add_sample(&tUpdate, gptTimer->get_time() - dStart);
+        }
+        pl__benchmark_report(&tUpdate);
+
+        snprintf(acName, 128, "sah: refit %u", uBoxCount);
+        plBenchmark tRefit = {.pcName = acName};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            const double dStart = gptTimer->get_time();
+            gptBvh->refit(&tBvh, atBoxes, uBoxCount);
+            pl__benchmark_add_sample(&tRefit, gptTimer->get_time() - dStart);
+        }
+        pl__benchmark_report(&tRefit);
+
+        uint32_t uCallbacks = 0;
+        snprintf(acName, 128, "sah: %u aabb queries after updates", uQueryCount);
+        plBenchmark tAABBQueries = {.pcName = acName};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            const double dStart = gptTimer->get_time();
+            for(uint32_t j = 0; j < uQueryCount; j++)
+                gptBvh->intersects_aabb(&tBvh, atQueries[j], pl__bvh_benchmark_callback, &uCallbacks);
+            pl__benchmark_add_sample(&tAABBQueries, gptTimer->get_time() - dStart);
+        }
+        pl__benchmark_report(&tAABBQueries);
+
+        gptBvh->cleanup(&tBvh);
+    }
+
+    gptJob->cleanup();
+
+    PL_FREE(atRays);
+    PL_FREE(atQueries);
+    PL_FREE(atBoxes);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] compress benchmarks
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__compress_benchmark_fill_json(uint8_t* puData, uint32_t uSize)
+{
+    uint32_t uOffset = 0;
+    uint32_t uIndex = 0;
+    while(uOffset + 256 < uSize)
+    {
+        uOffset += (uint32_t)snprintf((char*)&puData[uOffset], 256,
+            "{\"name\": \"entity_%u\", \"mesh\": %u, \"translation\": [%.3f, %.3f, %.3f], \"scale\": [1.0, 1.0, 1.0]},\n",
+            uIndex, uIndex % 37, (float)(uIndex % 101) * 0.25f, (float)(uIndex % 13), (float)uIndex * 0.125f);
+        uIndex++;
+    }
+    return uOffset;
+}
+
+static uint32_t
+pl__compress_benchmark_fill_vertices(uint8_t* puData, uint32_t uSize)
+{
+    // grid mesh: position, normal, uv
+    float* pfData = (float*)puData;
+    const uint32_t uVertexCount = uSize / (8 * sizeof(float));
+    const uint32_t uWidth = 256;
+    uint32_t uSeed = 7;
+    for(uint32_t i = 0; i < uVertexCount; i++)
+    {
+        uSeed = uSeed * 1664525u + 1013904223u;
+        const float fX = (float)(i % uWidth);
+        const float fZ = (float)(i / uWidth);
+        float* pfVertex = &pfData[i * 8];
+        pfVertex[0] = fX;
+        pfVertex[1] = (float)(uSeed >> 16) / 65536.0f;
+        pfVertex[2] = fZ;
+        pfVertex[3] = 0.0f;
+        pfVertex[4] = 1.0f;
+        pfVertex[5] = 0.0f;
+        pfVertex[6] = fX / (float)uWidth;
+        pfVertex[7] = fZ / (float)uWidth;
+    }
+    return uVertexCount * 8 * sizeof(float);
+}
+
+static uint32_t
+pl__compress_benchmark_fill_indices(uint8_t* puData, uint32_t uSize)
+{
+    uint32_t* puIndices = (uint32_t*)puData;
+    const uint32_t uWidth = 256;
+    const uint32_t uQuadCount = uSize / (6 * sizeof(uint32_t));
+    for(uint32_t i = 0; i < uQuadCount; i++)
+    {
+        const uint32_t uBase = (i / (uWidth - 1)) * uWidth + i % (uWidth - 1);
+        puIndices[i * 6 + 0] = uBase;
+        puIndices[i * 6 + 1] = uBase + uWidth;
+        puIndices[i * 6 + 2] = uBase + 1;
+        puIndices[i * 6 + 3] = uBase + 1;
+        puIndices[i * 6 + 4] = uBase + uWidth;
+        puIndices[i * 6 + 5] = uBase + uWidth + 1;
+    }
+    return uQuadCount * 6 * sizeof(uint32_t);
+}
+
+static uint32_t
+pl__compress_benchmark_fill_texture(uint8_t* puData, uint32_t uSize)
+{
+    // RGBA8 gradient with low amplitude noise
+    const uint32_t uWidth = 512;
+    const uint32_t uPixelCount = uSize / 4;
+    uint32_t uSeed = 3;
+    for(uint32_t i = 0; i < uPixelCount; i++)
+    {
+        uSeed = uSeed * 1664525u + 1013904223u;
+        const uint32_t uNoise = (uSeed >> 28) & 0x3;
+        puData[i * 4 + 0] = (uint8_t)((i % uWidth) / 2 + uNoise);
+        puData[i * 4 + 1] = (uint8_t)((i / uWidth) / 2 + uNoise);
+        puData[i * 4 + 2] = 128;
+        puData[i * 4 + 3] = 255;
+    }
+    return uPixelCount * 4;
+}
+
+void
+compress_benchmarks(void)
+{
+    pl__benchmark_begin_suite("pl_compress_ext.h");
+
+    const uint32_t uAssetSize = 1 << 20;
+    const char* apcAssetNames[] = {"json", "vertices", "indices", "texture"};
+    uint32_t (*atFill[])(uint8_t*, uint32_t) = {
+        pl__compress_benchmark_fill_json,
+        pl__compress_benchmark_fill_vertices,
+        pl__compress_benchmark_fill_indices,
+        pl__compress_benchmark_fill_texture
+    };
+
+    const struct {
+        const char*     pcName;
+        plCompressCodec tCodec;
+    } atCodecs[] = {
+        {"default", PL_COMPRESS_CODEC_DEFAULT},
+        {"fast",    PL_COMPRESS_CODEC_FAST}
+    };
+
+    uint8_t* puData = PL_ALLOC(uAssetSize);
+    uint8_t* puDecompressed = PL_ALLOC(uAssetSize);
+    uint8_t* puCompressed = PL_ALLOC(gptCompress->compress_bound(PL_COMPRESS_CODEC_DEFAULT, uAssetSize) + gptCompress->compress_bound(PL_COMPRESS_CODEC_FAST, uAssetSize));
+    plCompressContext* ptContext = gptCompress->create_context();
+
+    char acName[64] = {0};
+    for(uint32_t uAsset = 0; uAsset < 4; uAsset++)
+    {
+        const uint32_t uSize = atFill[uAsset](puData, uAssetSize);
+        for(uint32_t uCodec = 0; uCodec < 2; uCodec++)
+        {
+            const uint32_t uBound = gptCompress->compress_bound(atCodecs[uCodec].tCodec, uSize);
+            uint32_t uCompressedSize = 0;
+
+            snprintf(acName, 64, "compress %s (%s)", apcAssetNames[uAsset], atCodecs[uCodec].pcName);
+            plBenchmark tCompress = {.pcName = acName};
+            for(uint32_t i = 0; i < 3; i++)
+            {
+                const double dStart = gptTimer->get_time();
+                uCompressedSize = gptCompress->compress_ex(ptContext, atCodecs[uCodec].tCodec, puData, uSize, puCompressed, uBound);
+                pl__benchmark_add_sample(&tCompress, gptTimer->get_time() - dStart);
+            }
+            pl__benchmark_report(&tCompress);
+            const double dCompressRate = (double)uSize / (1024.0 * 1024.0) / tCompress.dMinTime;
+
+            snprintf(acName, 64, "decompress %s (%s)", apcAssetNames[uAsset], atCodecs[uCodec].pcName);
+            plBenchmark tDecompress = {.pcName = acName};
+            bool bMatch = true;
+            for(uint32_t i = 0; i < 10; i++)
+            {
+                const double dStart = gptTimer->get_time();
+                const uint32_t uDecompressedSize = gptCompress->decompress(puCompressed, uCompressedSize, puDecompressed, uAssetSize);
+                pl__benchmark_add_sample(&tDecompress, gptTimer->get_time() - dStart);
+                bMatch = bMatch && uDecompressedSize == uSize;
+            }
+            pl__benchmark_report(&tDecompress);
+            const double dDecompressRate = (double)uSize / (1024.0 * 1024.0) / tDecompress.dMinTime;
+            bMatch = bMatch && memcmp(puData, puDecompressed, uSize) == 0;
+
+            printf("    ratio %.2f, compress %.1f MB/s, decompress %.1f MB/s%s\n",
+                (double)uSize / (double)uCompressedSize, dCompressRate, dDecompressRate, bMatch ? "" : " (MISMATCH)");
+        }
+    }
+
+    gptCompress->cleanup_context(ptContext);
+    PL_FREE(puCompressed);
+    PL_FREE(puDecompressed);
+    PL_FREE(puData);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] cpu rasterizer benchmarks
+//-----------------------------------------------------------------------------
+
+typedef struct _plRasterBenchmarkVertex
+{
+    plVec4 tPosition; // clip space
+    plVec4 tColor;
+} plRasterBenchmarkVertex;
+
+typedef struct _plRasterBenchmarkScene
+{
+    uint32_t                 uWidth;
+    uint32_t                 uHeight;
+    plRasterBenchmarkVertex* atVertices;
+    uint32_t                 uVertexCount;
+    uint32_t*                auIndices;
+    uint32_t                 uIndexCount;
+    uint32_t                 uDrawCount; // index range split evenly (all share the vertex buffer)
+} plRasterBenchmarkScene;
+
+static plVec4
+pl__raster_benchmark_vertex_shader(plVertexShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets, const void* pVertex, plVaryingData* ptVaryings)
+{
+    const plRasterBenchmarkVertex* ptVertex = pVertex;
+    ptVaryings->atTypes[0] = PL_VARYING_TYPE_VEC4;
+    ptVaryings->_auOffset[0] = 0;
+    memcpy(ptVaryings->acVaryingData, &ptVertex->tColor, sizeof(plVec4));
+    return ptVertex->tPosition;
+}
+
+static plVec4
+pl__raster_benchmark_pixel_shader(plPixelShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets, const plVaryingData* ptVaryings)
+{
+    plVec4 tColor;
+    memcpy(&tColor, ptVaryings->acVaryingData, sizeof(plVec4));
+    return tColor;
+}
+
+static double
+pl__raster_benchmark_run(const plRasterBenchmarkScene* ptScene, bool bDepth, uint32_t uThreadCount, uint32_t uTileSize, uint32_t uIterations, uint8_t* puPixelsOut)
+{
+    const plDeviceInit tDeviceInit = {
+        .uCpuThreadCount = uThreadCount,
+        .uCpuTileSize    = uTileSize
+    };
+    plDevice* ptDevice = gptGfx->create_device(&tDeviceInit);
+
+    // render target
+    const plTextureDesc tTextureDesc = {
+        .tDimensions = {(float)ptScene->uWidth, (float)ptScene->uHeight, 1.0f},
+        .uLayers     = 1,
+        .uMips       = 1,
+        .eFormat     = PL_FORMAT_R8G8B8A8_UNORM,
+        .eType       = PL_TEXTURE_TYPE_2D,
+        .eUsage      = PL_TEXTURE_USAGE_COLOR_ATTACHMENT
+    };
+    plTexture* ptTexture = NULL;
+    const plTextureHandle tTexture = gptGfx->create_texture(ptDevice, &tTextureDesc, &ptTexture);
+    plDeviceMemoryAllocation tTextureMemory = gptGfx->allocate_memory(ptDevice, ptTexture->tMemoryRequirements.ulSize, PL_MEMORY_FLAGS_HOST_VISIBLE, 0, "raster target");
+    gptGfx->bind_texture_to_memory(ptDevice, tTexture, &tTextureMemory);
+
+    // depth target (optional)
+    const plTextureDesc tDepthTextureDesc = {
+        .tDimensions = {(float)ptScene->uWidth, (float)ptScene->uHeight, 1.0f},
+        .uLayers     = 1,
+        .uMips       = 1,
+        .eFormat     = PL_FORMAT_D32_FLOAT,
+        .eType       = PL_TEXTURE_TYPE_2D,
+        .eUsage      = PL_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT
+    };
+    plTexture* ptDepthTexture = NULL;
+    const plTextureHandle tDepthTexture = gptGfx->create_texture(ptDevice, &tDepthTextureDesc, &ptDepthTexture);
+    plDeviceMemoryAllocation tDepthMemory = gptGfx->allocate_memory(ptDevice, ptDepthTexture->tMemoryRequirements.ulSize, PL_MEMORY_FLAGS_HOST_VISIBLE, 0, "raster depth");
+    gptGfx->bind_texture_to_memory(ptDevice, tDepthTexture, &tDepthMemory);
+
+    // geometry
+    const plBufferDesc tVertexBufferDesc = {
+        .eUsage     = PL_BUFFER_USAGE_VERTEX,
+        .szByteSize = ptScene->uVertexCount * sizeof(plRasterBenchmarkVertex)
+    };
+    const plBufferHandle tVertexBuffer = gptGfx->create_buffer(ptDevice, &tVertexBufferDesc, NULL);
+    plDeviceMemoryAllocation tVertexMemory = gptGfx->allocate_memory(ptDevice, tVertexBufferDesc.szByteSize, PL_MEMORY_FLAGS_HOST_VISIBLE, 0, "raster vertices");
+    gptGfx->bind_buffer_to_memory(ptDevice, tVertexBuffer, &tVertexMemory);
+    memcpy(tVertexMemory.pHostMapped, ptScene->atVertices, tVertexBufferDesc.szByteSize);
+
+    const plBufferDesc tIndexBufferDesc = {
+        .eUsage     = PL_BUFFER_USAGE_INDEX,
+        .szByteSize = ptScene->uIndexCount * sizeof(uint32_t)
+    };
+    const plBufferHandle tIndexBuffer = gptGfx->create_buffer(ptDevice, &tIndexBufferDesc, NULL);
+    plDeviceMemoryAllocation tIndexMemory = gptGfx->allocate_memory(ptDevice, tIndexBufferDesc.szByteSize, PL_MEMORY_FLAGS_HOST_VISIBLE, 0, "raster indices");
+    gptGfx->bind_buffer_to_memory(ptDevice, tIndexBuffer, &tIndexMemory);
+    memcpy(tIndexMemory.pHostMapped, ptScene->auIndices, tIndexBufferDesc.szByteSize);
+
+    const plShaderDesc tShaderDesc = {
+        .tVertexShader   = {.puCode = (uint8_t*)pl__raster_benchmark_vertex_shader},
+        .tFragmentShader = {.puCode = (uint8_t*)pl__raster_benchmark_pixel_shader},
+        .tGraphicsState = {
+            .eDepthMode         = bDepth ? PL_COMPARE_MODE_LESS : PL_COMPARE_MODE_ALWAYS,
+            .bDepthWriteEnabled = bDepth
+        },
+        .atBlendStates = {
+            {.bBlendEnabled = !bDepth} // depth tested triangles are opaque
+        },
+        .atVertexBufferLayouts = {
+            {
+                .atAttributes = {
+                    {.eFormat = PL_VERTEX_FORMAT_FLOAT4},
+                    {.eFormat = PL_VERTEX_FORMAT_FLOAT4}
+                }
+            }
+        }
+    };
+    const plShaderHandle tShader = gptGfx->create_shader(ptDevice, &tShaderDesc);
+
+    // several draws so ordering across draws within tiles is exercised
+    const uint32_t uDrawCount = ptScene->uDrawCount;
+    plDrawIndex* atDraws = PL_ALLOC(uDrawCount * sizeof(plDrawIndex));
+    memset(atDraws, 0, uDrawCount * sizeof(plDrawIndex));
+    const uint32_t uTrianglesPerDraw = ptScene->uIndexCount / 3 / uDrawCount;
+    for(uint32_t i = 0; i < uDrawCount; i++)
+    {
+        atDraws[i].uIndexStart    = i * uTrianglesPerDraw * 3;
+        atDraws[i].uIndexCount    = i == uDrawCount - 1 ? ptScene->uIndexCount - atDraws[i].uIndexStart : uTrianglesPerDraw * 3;
+        atDraws[i].uInstanceCount = 1;
+        atDraws[i].tIndexBuffer   = tIndexBuffer;
+    }
+
+    plRenderInfo tRenderInfo = {
+        .tRenderArea        = {.tMax = {(float)ptScene->uWidth, (float)ptScene->uHeight}},
+        .atColorAttachments = {{.tTexture = tTexture}}
+    };
+    if(bDepth)
+    {
+        tRenderInfo.tDepthAttachment.tTexture = tDepthTexture;
+        tRenderInfo.tDepthAttachment.eLoadOp  = PL_LOAD_OP_CLEAR;
+        tRenderInfo.tDepthAttachment.fClearZ  = 1.0f;
+    }
+
+    plCommandPool* ptPool = gptGfx->create_command_pool(ptDevice, NULL);
+    double dMinTime = 0.0;
+    for(uint32_t i = 0; i < uIterations; i++)
+    {
+        const double dStart = gptTimer->get_time();
+        plCommandBuffer* ptCommandBuffer = gptGfx->request_command_buffer(ptPool, "raster benchmark");
+        gptGfx->begin_command_recording(ptCommandBuffer);
+        gptGfx->begin_render_pass(ptCommandBuffer, &tRenderInfo, NULL);
+        gptGfx->bind_shader(ptCommandBuffer, tShader);
+        gptGfx->bind_vertex_buffer(ptCommandBuffer, tVertexBuffer);
+        gptGfx->draw_indexed(ptCommandBuffer, uDrawCount, atDraws);
+        gptGfx->end_render_pass(ptCommandBuffer);
+        gptGfx->end_command_recording(ptCommandBuffer);
+        gptGfx->submit_command_buffer(ptCommandBuffer, NULL);
+        gptGfx->return_command_buffer(ptCommandBuffer);
+        const double dTime = gptTimer->get_time() - dStart;
+        if(i == 0 || dTime < dMinTime)
+            dMinTime = dTime;
+    }
+
+    if(puPixelsOut)
+        memcpy(puPixelsOut, tTextureMemory.pHostMapped, ptScene->uWidth * ptScene->uHeight * 4);
+
+    PL_FREE(atDraws);
+    gptGfx->cleanup_command_pool(ptPool);
+    gptGfx->free_memory(ptDevice, &tIndexMemory);
+    gptGfx->free_memory(ptDevice, &tVertexMemory);
+    gptGfx->free_memory(ptDevice, &tDepthMemory);
+    gptGfx->free_memory(ptDevice, &tTextureMemory);
+    gptGfx->cleanup_device(ptDevice);
+    return dMinTime;
+}
+
+#define PL_COMPUTE_BENCHMARK_GROUP_SIZE 256
+
+static void
+pl__compute_benchmark_kernel(plComputeShaderBuiltIns tBuiltIns, plDescriptorSet* atDescriptorSets)
+{
+    // scale & rotate a block of points, then reduce their squared lengths
+    // through group shared memory (one partial sum per workgroup)
+    const plVec4* atInput = (const plVec4*)atDescriptorSets[0].atDescriptors[0].puData;
+    plVec4* atOutput = (plVec4*)atDescriptorSets[0].atDescriptors[1].puData;
+    float* afSums = (float*)atDescriptorSets[0].atDescriptors[2].puData;
+    const float fScale = *(const float*)tBuiltIns.pSpecializationData;
+    float* afShared = tBuiltIns.pGroupSharedMemory;
+
+    const uint32_t uFirst = tBuiltIns.gl_WorkGroupID[0] * tBuiltIns.gl_WorkGroupSize[0];
+    for(uint32_t i = 0; i < tBuiltIns.gl_WorkGroupSize[0]; i++)
+    {
+        const plVec4 tIn = atInput[uFirst + i];
+        const plVec4 tOut = {
+            fScale * (0.8f * tIn.x - 0.6f * tIn.y),
+            fScale * (0.6f * tIn.x + 0.8f * tIn.y),
+            fScale * tIn.z,
+            tIn.w
+        };
+        atOutput[uFirst + i] = tOut;
+        afShared[i] = tOut.x * tOut.x + tOut.y * tOut.y + tOut.z * tOut.z;
+    }
+
+    // barrier()
+    for(uint32_t uStride = tBuiltIns.gl_WorkGroupSize[0] / 2; uStride > 0; uStride /= 2)
+    {
+        for(uint32_t i = 0; i < uStride; i++)
+            afShared[i] += afShared[i + uStride];
+    }
+    afSums[tBuiltIns.gl_WorkGroupID[0]] = afShared[0];
+}
+
+static double
+pl__compute_benchmark_run(const plVec4* atPoints, uint32_t uPointCount, uint32_t uThreadCount, uint32_t uIterations, float* afSumsOut)
+{
+    const plDeviceInit tDeviceInit = {
+        .uCpuThreadCount = uThreadCount,
+    };
+    plDevice* ptDevice = gptGfx->create_device(&tDeviceInit);
+
+    const uint32_t uGroupCount = uPointCount / PL_COMPUTE_BENCHMARK_GROUP_SIZE;
+    const size_t aszSizes[] = {uPointCount * sizeof(plVec4), uPointCount * sizeof(plVec4), uGroupCount * sizeof(float)};
+    plBufferHandle atBuffers[3] = {0};
+    plDeviceMemoryAllocation atMemory[3] = {0};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        const plBufferDesc tBufferDesc = {
+            .eUsage      = PL_BUFFER_USAGE_STORAGE,
+            .szByteSize  = aszSizes[i],
+            .pcDebugName = "compute benchmark"
+        };
+        atBuffers[i] = gptGfx->create_buffer(ptDevice, &tBufferDesc, NULL);
+        atMemory[i] = gptGfx->allocate_memory(ptDevice, aszSizes[i], PL_MEMORY_FLAGS_HOST_VISIBLE, 0, "compute benchmark");
+        gptGfx->bind_buffer_to_memory(ptDevice, atBuffers[i], &atMemory[i]);
+    }
+    memcpy(atMemory[0].pHostMapped, atPoints, aszSizes[0]);
+
+    const plBindGroupLayoutDesc tLayoutDesc = {
+        .atBufferBindings = {
+            {.uSlot = 0, .eType = PL_BUFFER_BINDING_TYPE_STORAGE, .eStages = PL_SHADER_STAGE_COMPUTE},
+            {.uSlot = 1, .eType = PL_BUFFER_BINDING_TYPE_STORAGE, .eStages = PL_SHADER_STAGE_COMPUTE},
+            {.uSlot = 2, .eType = PL_BUFFER_BINDING_TYPE_STORAGE, .eStages = PL_SHADER_STAGE_COMPUTE}
+        }
+    };
+    const plBindGroupLayoutHandle tLayout = gptGfx->create_bind_group_layout(ptDevice, &tLayoutDesc);
+    const plBindGroupDesc tBindGroupDesc = {.tLayout = tLayout};
+    const plBindGroupHandle tBindGroup = gptGfx->create_bind_group(ptDevice, &tBindGroupDesc);
+    const plBindGroupUpdateData tUpdateData = {
+        .atBufferBindings = {
+            {.tBuffer = atBuffers[0], .uSlot = 0, .szBufferRange = aszSizes[0]},
+            {.tBuffer = atBuffers[1], .uSlot = 1, .szBufferRange = aszSizes[1]},
+            {.tBuffer = atBuffers[2], .uSlot = 2, .szBufferRange = aszSizes[2]}
+        }
+    };
+    gptGfx->update_bind_group(ptDevice, tBindGroup, &tUpdateData);
+
+    const float fScale = 1.5f;
+    const plComputeShaderDesc tShaderDesc = {
+        .tShader           = {.puCode = (uint8_t*)pl__compute_benchmark_kernel},
+        .atConstants       = {{.eType = PL_DATA_TYPE_FLOAT}},
+        .pTempConstantData = &fScale,
+        .pcDebugName       = "compute benchmark"
+    };
+    const plComputeShaderHandle tShader = gptGfx->create_compute_shader(ptDevice, &tShaderDesc);
+
+    const plDispatch tDispatch = {
+        .uThreadPerGroupX = PL_COMPUTE_BENCHMARK_GROUP_SIZE,
+        .uThreadPerGroupY = 1,
+        .uThreadPerGroupZ = 1,
+        .uGroupCountX     = uGroupCount,
+        .uGroupCountY     = 1,
+        .uGroupCountZ     = 1
+    };
+
+    plCommandPool* ptPool = gptGfx->create_command_pool(ptDevice, NULL);
+    double dMinTime = 0.0;
+    for(uint32_t i = 0; i < uIterations; i++)
+    {
+        const double dStart = gptTimer->get_time();
+        plCommandBuffer* ptCommandBuffer = gptGfx->request_command_buffer(ptPool, "compute benchmark");
+        gptGfx->begin_command_recording(ptCommandBuffer);
+        gptGfx->bind_compute_shader(ptCommandBuffer, tShader);
+        gptGfx->bind_compute_bind_groups(ptCommandBuffer, tShader, 0, 1, &tBindGroup, 0, NULL);
+        gptGfx->dispatch(ptCommandBuffer, 1, &tDispatch);
+        gptGfx->end_command_recording(ptCommandBuffer);
+        gptGfx->submit_command_buffer(ptCommandBuffer, NULL);
+        gptGfx->return_command_buffer(ptCommandBuffer);
+        const double dTime = gptTimer->get_time() - dStart;
+        if(i == 0 || dTime < dMinTime)
+            dMinTime = dTime;
+    }
+
+    if(afSumsOut)
+        memcpy(afSumsOut, atMemory[2].pHostMapped, aszSizes[2]);
+
+    gptGfx->cleanup_command_pool(ptPool);
+    for(uint32_t i = 0; i < 3; i++)
+        gptGfx->free_memory(ptDevice, &atMemory[i]);
+    gptGfx->cleanup_device(ptDevice);
+    return dMinTime;
+}
+
+void
+raster_benchmarks(void)
+{
+    pl__benchmark_begin_suite("pl_graphics_ext.h (cpu backend)");
+
+    // overlapping translucent triangles of varying size
+    plRasterBenchmarkScene tScene = {
+        .uWidth       = 1280,
+        .uHeight      = 720,
+        .uVertexCount = 3 * 8000,
+        .uIndexCount  = 3 * 8000,
+        .uDrawCount   = 4
+    };
+    tScene.atVertices = PL_ALLOC(tScene.uVertexCount * sizeof(plRasterBenchmarkVertex));
+    tScene.auIndices = PL_ALLOC(tScene.uIndexCount * sizeof(uint32_t));
+    uint32_t uSeed = 11;
+    for(uint32_t i = 0; i < tScene.uVertexCount; i += 3)
+    {
+        const float fSize = 8.0f + pl__bvh_benchmark_randomf(&uSeed, 56.0f);
+        const float fX = pl__bvh_benchmark_randomf(&uSeed, (float)tScene.uWidth);
+        const float fY = pl__bvh_benchmark_randomf(&uSeed, (float)tScene.uHeight);
+        const plVec4 tColor = {
+            pl__bvh_benchmark_randomf(&uSeed, 1.0f),
+            pl__bvh_benchmark_randomf(&uSeed, 1.0f),
+            pl__bvh_benchmark_randomf(&uSeed, 1.0f),
+            0.5f
+        };
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            const float fAngle = (float)j * 2.0943951f + fSize;
+            tScene.atVertices[i + j].tPosition.x = (fX + cosf(fAngle) * fSize) / (float)tScene.uWidth * 2.0f - 1.0f;
+            tScene.atVertices[i + j].tPosition.y = (fY + sinf(fAngle) * fSize) / (float)tScene.uHeight * 2.0f - 1.0f;
+            tScene.atVertices[i + j].tPosition.z = 0.0f;
+            tScene.atVertices[i + j].tPosition.w = 1.0f;
+            tScene.atVertices[i + j].tColor = tColor;
+            tScene.auIndices[i + j] = i + j;
+        }
+    }
+
+    gptGfx->initialize(&(plGraphicsInit){0});
+    gptJob->initialize((plJobSystemInit){.szSharedMemorySize = PL_CPU_COMPUTE_SHARED_MEMORY_SIZE});
+
+    const size_t szImageSize = tScene.uWidth * tScene.uHeight * 4;
+    uint8_t* puReference = PL_ALLOC(szImageSize);
+    uint8_t* puPixels = PL_ALLOC(szImageSize);
+    char acName[64] = {0};
+
+    // thread scaling (1 thread rasterizes on the submitting thread)
+    const uint32_t uMaxThreadCount = pl_max(gptThreads->get_hardware_thread_count(), 4);
+    double dSingleThreadTime = 0.0;
+    for(uint32_t uThreadCount = 1; uThreadCount <= uMaxThreadCount; uThreadCount *= 2)
+    {
+        plBenchmark tBenchmark = {.pcName = acName};
+        const double dTime = pl__raster_benchmark_run(&tScene, false, uThreadCount, 64, 3, uThreadCount == 1 ? puReference : puPixels);
+        if(uThreadCount == 1)
+            dSingleThreadTime = dTime;
+        snprintf(acName, 64, "8k triangles (%u threads, 64px tiles)", uThreadCount);
+        pl__benchmark_add_sample(&tBenchmark, dTime);
+        pl__benchmark_report(&tBenchmark);
+        printf("    speedup %.2fx%s\n", dSingleThreadTime / dTime, uThreadCount == 1 || memcmp(puReference, puPixels, szImageSize) == 0 ? "" : " (MISMATCH)");
+    }
+
+    // tile size
+    const uint32_t auTileSizes[] = {16, 32, 64, 128};
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        plBenchmark tBenchmark = {.pcName = acName};
+        const double dTime = pl__raster_benchmark_run(&tScene, false, uMaxThreadCount, auTileSizes[i], 3, puPixels);
+        snprintf(acName, 64, "8k triangles (%u threads, %upx tiles)", uMaxThreadCount, auTileSizes[i]);
+        pl__benchmark_add_sample(&tBenchmark, dTime);
+        pl__benchmark_report(&tBenchmark);
+        printf("    speedup %.2fx%s\n", dSingleThreadTime / dTime, memcmp(puReference, puPixels, szImageSize) == 0 ? "" : " (MISMATCH)");
+    }
+
+    // depth testing: opaque triangles, each closer than the ones before it, so
+    // back-to-front passes every test (painter's order) and front-to-back must
+    // produce the same image while rejecting most of the fragments early
+    for(uint32_t i = 0; i < tScene.uVertexCount; i++)
+        tScene.atVertices[i].tPosition.z = 1.0f - (float)(i / 3 + 1) / (float)(tScene.uVertexCount / 3 + 1);
+
+    const char* apcDepthOrders[] = {"back-to-front", "front-to-back"};
+    double dBackToFrontTime = 0.0;
+    for(uint32_t i = 0; i < 2; i++)
+    {
+        if(i == 1) // reverse submission order
+        {
+            for(uint32_t j = 0; j < tScene.uIndexCount / 2; j += 3)
+            {
+                for(uint32_t k = 0; k < 3; k++)
+                {
+                    const uint32_t uTemp = tScene.auIndices[j + k];
+                    tScene.auIndices[j + k] = tScene.auIndices[tScene.uIndexCount - 3 - j + k];
+                    tScene.auIndices[tScene.uIndexCount - 3 - j + k] = uTemp;
+                }
+            }
+        }
+        plBenchmark tBenchmark = {.pcName = acName};
+        const double dTime = pl__raster_benchmark_run(&tScene, true, uMaxThreadCount, 64, 3, i == 0 ? puReference : puPixels);
+        if(i == 0)
+            dBackToFrontTime = dTime;
+        snprintf(acName, 64, "8k opaque triangles, depth tested (%s)", apcDepthOrders[i]);
+        pl__benchmark_add_sample(&tBenchmark, dTime);
+        pl__benchmark_report(&tBenchmark);
+        printf("    speedup %.2fx%s\n", dBackToFrontTime / dTime, i == 0 || memcmp(puReference, puPixels, szImageSize) == 0 ? "" : " (MISMATCH)");
+    }
+
+    // many small draws sharing one large vertex buffer (per draw vertex stage overhead)
+    {
+        tScene.uDrawCount = 2000;
+        plBenchmark tBenchmark = {.pcName = acName};
+        const double dTime = pl__raster_benchmark_run(&tScene, true, uMaxThreadCount, 64, 3, puPixels);
+        snprintf(acName, 64, "8k opaque triangles, depth tested (%u draws)", tScene.uDrawCount);
+        pl__benchmark_add_sample(&tBenchmark, dTime);
+        pl__benchmark_report(&tBenchmark);
+        printf("    speedup %.2fx%s\n", dBackToFrontTime / dTime, memcmp(puReference, puPixels, szImageSize) == 0 ? "" : " (MISMATCH)");
+        tScene.uDrawCount = 4;
+    }
+
+    // perspective: ground plane extending behind the camera, so triangles are
+    // clipped against the near plane & varyings need perspective correction
+    const uint32_t uFloorQuads = 64;
+    plRasterBenchmarkScene tFloor = {
+        .uWidth       = tScene.uWidth,
+        .uHeight      = tScene.uHeight,
+        .uVertexCount = (uFloorQuads + 1) * (uFloorQuads + 1),
+        .uIndexCount  = uFloorQuads * uFloorQuads * 6,
+        .uDrawCount   = 4
+    };
+    tFloor.atVertices = PL_ALLOC(tFloor.uVertexCount * sizeof(plRasterBenchmarkVertex));
+    tFloor.auIndices = PL_ALLOC(tFloor.uIndexCount * sizeof(uint32_t));
+    const float fFocal = 1.0f / tanf(0.5236f); // 60 degree vertical fov
+    const float fAspect = (float)tFloor.uWidth / (float)tFloor.uHeight;
+    const float fNear = 0.1f;
+    const float fFar = 100.0f;
+    for(uint32_t uRow = 0; uRow <= uFloorQuads; uRow++)
+    {
+        for(uint32_t uColumn = 0; uColumn <= uFloorQuads; uColumn++)
+        {
+            const float fU = (float)uColumn / (float)uFloorQuads;
+            const float fV = (float)uRow / (float)uFloorQuads;
+            const float fX = -30.0f + 60.0f * fU;
+            const float fDistance = -4.0f + 64.0f * fV; // view space depth (camera 1 unit above the floor)
+            plRasterBenchmarkVertex* ptVertex = &tFloor.atVertices[uRow * (uFloorQuads + 1) + uColumn];
+            ptVertex->tPosition.x = fFocal / fAspect * fX;
+            ptVertex->tPosition.y = fFocal * 1.0f;
+            ptVertex->tPosition.z = fFar / (fFar - fNear) * (fDistance - fNear);
+            ptVertex->tPosition.w = fDistance;
+            ptVertex->tColor = (plVec4){fU, fV, (uRow + uColumn) % 2 ? 1.0f : 0.0f, 1.0f};
+        }
+    }
+    for(uint32_t uRow = 0; uRow < uFloorQuads; uRow++)
+    {
+        for(uint32_t uColumn = 0; uColumn < uFloorQuads; uColumn++)
+        {
+            const uint32_t uCorner = uRow * (uFloorQuads + 1) + uColumn;
+            uint32_t* auQuad = &tFloor.auIndices[(uRow * uFloorQuads + uColumn) * 6];
+            auQuad[0] = uCorner;
+            auQuad[1] = uCorner + 1;
+            auQuad[2] = uCorner + uFloorQuads + 1;
+            auQuad[3] = uCorner + 1;
+            auQuad[4] = uCorner + uFloorQuads + 2;
+            auQuad[5] = uCorner + uFloorQuads + 1;
+        }
+    }
+
+    for(uint32_t i = 0; i < 2; i++)
+    {
+        const uint32_t uThreadCount = i == 0 ? 1 : uMaxThreadCount;
+        plBenchmark tBenchmark = {.pcName = acName};
+        const double dTime = pl__raster_benchmark_run(&tFloor, true, uThreadCount, 64, 3, uThreadCount == 1 ? puReference : puPixels);
+        if(uThreadCount == 1)
+            dSingleThreadTime = dTime;
+        snprintf(acName, 64, "8k triangle perspective floor (%u threads)", uThreadCount);
+        pl__benchmark_add_sample(&tBenchmark, dTime);
+        pl__benchmark_report(&tBenchmark);
+        printf("    speedup %.2fx%s\n", dSingleThreadTime / dTime, uThreadCount == 1 || memcmp(puReference, puPixels, szImageSize) == 0 ? "" : " (MISMATCH)");
+    }
+
+    // compute: 1M points in 256 wide workgroups (one job per workgroup)
+    const uint32_t uPointCount = 1 << 20;
+    plVec4* atPoints = PL_ALLOC(uPointCount * sizeof(plVec4));
+    for(uint32_t i = 0; i < uPointCount; i++)
+    {
+        atPoints[i] = (plVec4){
+            pl__bvh_benchmark_randomf(&uSeed, 2.0f) - 1.0f,
+            pl__bvh_benchmark_randomf(&uSeed, 2.0f) - 1.0f,
+            pl__bvh_benchmark_randomf(&uSeed, 2.0f) - 1.0f,
+            1.0f
+        };
+    }
+    const size_t szSumsSize = (uPointCount / PL_COMPUTE_BENCHMARK_GROUP_SIZE) * sizeof(float);
+    float* afReferenceSums = PL_ALLOC(szSumsSize);
+    float* afSums = PL_ALLOC(szSumsSize);
+    for(uint32_t uThreadCount = 1; uThreadCount <= uMaxThreadCount; uThreadCount *= 2)
+    {
+        plBenchmark tBenchmark = {.pcName = acName};
+        const double dTime = pl__compute_benchmark_run(atPoints, uPointCount, uThreadCount, 5, uThreadCount == 1 ? afReferenceSums : afSums);
+        if(uThreadCount == 1)
+            dSingleThreadTime = dTime;
+        snprintf(acName, 64, "compute dispatch, 4k workgroups (%u threads)", uThreadCount);
+        pl__benchmark_add_sample(&tBenchmark, dTime);
+        pl__benchmark_report(&tBenchmark);
+        printf("    speedup %.2fx%s\n", dSingleThreadTime / dTime, uThreadCount == 1 || memcmp(afReferenceSums, afSums, szSumsSize) == 0 ? "" : " (MISMATCH)");
+    }
+    PL_FREE(afSums);
+    PL_FREE(afReferenceSums);
+    PL_FREE(atPoints);
+
+    gptJob->cleanup();
+    gptGfx->cleanup();
+
+    PL_FREE(puPixels);
+    PL_FREE(puReference);
+    PL_FREE(tFloor.auIndices);
+    PL_FREE(tFloor.atVertices);
+    PL_FREE(tScene.auIndices);
+    PL_FREE(tScene.atVertices);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] mesh builder benchmarks
+//-----------------------------------------------------------------------------
+
+void
+mesh_builder_benchmarks(void)
+{
+    pl__benchmark_begin_suite("mesh builder");
+
+    // terrain like grid, every interior vertex shared by 6 triangles
+    const uint32_t uGridSize = 512;
+    const uint32_t uTriangleCount = uGridSize * uGridSize * 2;
+    plVec3* atPositions = PL_ALLOC(sizeof(plVec3) * uTriangleCount * 3);
+    uint32_t uCurrentPosition = 0;
+    for(uint32_t uY = 0; uY < uGridSize; uY++)
+    {
+        for(uint32_t uX = 0; uX < uGridSize; uX++)
+        {
+            const plVec3 tA = {(float)uX,        (float)uY,        0.0f};
+            const plVec3 tB = {(float)(uX + 1),  (float)uY,        0.0f};
+            const plVec3 tC = {(float)(uX + 1),  (float)(uY + 1),  0.0f};
+            const plVec3 tD = {(float)uX,        (float)(uY + 1),  0.0f};
+            atPositions[uCurrentPosition++] = tA;
+            atPositions[uCurrentPosition++] = tB;
+            atPositions[uCurrentPosition++] = tC;
+            atPositions[uCurrentPosition++] = tA;
+            atPositions[uCurrentPosition++] = tC;
+            atPositions[uCurrentPosition++] = tD;
+        }
+    }
+
+    const plMeshBuilderOptions tOptions = {.fWeldRadius = 0.01f};
+    uint32_t uVertexCount = 0;
+
+    plBenchmark tSingle = {.pcName = "add_triangle, 512k triangles (welded)"};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        plMeshBuilder* ptBuilder = gptMeshBuilder->create(tOptions);
+        const double dStart = gptTimer->get_time();
+        for(uint32_t j = 0; j < uTriangleCount; j++)
+            gptMeshBuilder->add_triangle(ptBuilder, atPositions[j * 3], atPositions[j * 3 + 1], atPositions[j * 3 + 2]);
+        pl__benchmark_add_sample(&tSingle, gptTimer->get_time() - dStart);
+        gptMeshBuilder->commit(ptBuilder, NULL, NULL, NULL, &uVertexCount);
+        gptMeshBuilder->cleanup(ptBuilder);
+    }
+    pl__benchmark_report(&tSingle);
+
+    plBenchmark tBulk = {.pcName = "add_triangles, 512k triangles (welded)"};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        plMeshBuilder* ptBuilder = gptMeshBuilder->create(tOptions);
+        const double dStart = gptTimer->get_time();
+        gptMeshBuilder->add_triangles(ptBuilder, uTriangleCount, atPositions);
+        pl__benchmark_add_sample(&tBulk, gptTimer->get_time() - dStart);
+        gptMeshBuilder->commit(ptBuilder, NULL, NULL, NULL, &uVertexCount);
+        gptMeshBuilder->cleanup(ptBuilder);
+    }
+    pl__benchmark_report(&tBulk);
+
+    const uint32_t uExpectedVertexCount = (uGridSize + 1) * (uGridSize + 1);
+    printf("    %u vertices%s\n", uVertexCount, uVertexCount == uExpectedVertexCount ? "" : " (MISMATCH)");
+
+    PL_FREE(atPositions);
+}
@@ -18,6 +18,7 @@ Index of this file:
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <float.h>
 #include "pl.h"
 
 // libs
@@ -36,23 +37,40 @@ Index of this file:
 #include "pl_pak_ext.h"
 #include "pl_vfs_ext.h"
 #include "pl_string_intern_ext.h"
+#include "pl_job_ext.h"
+#include "pl_ecs_ext.h"
 
 // unstable extensions
 #include "pl_collision_ext.h"
+#include "pl_bvh_ext.h"
+#include "pl_animation_ext.h"
+#include "pl_gjk_ext.h"
+#include "pl_mesh_ext.h"
+
+// internal
+#include "pl_renderer_culling.inl"
 
 //-----------------------------------------------------------------------------
 // [SECTION] global apis
 //-----------------------------------------------------------------------------
 
-const plIOI*           gptIO        = NULL;
-const plMemoryI*       gptMemory    = NULL;
-const plCollisionI*    gptCollision = NULL;
-const plDateTimeI*     gptDateTime  = NULL;
-const plVfsI*          gptVfs       = NULL;
-const plPakI*          gptPak       = NULL;
-const plCompressI*     gptCompress  = NULL;
-const plFileI*         gptFile      = NULL;
-const plStringInternI* gptString    = NULL;
+const plIOI*           gptIO          = NULL;
+const plMemoryI*       gptMemory      = NULL;
+const plCollisionI*    gptCollision   = NULL;
+const plDateTimeI*     gptDateTime    = NULL;
+const plVfsI*          gptVfs         = NULL;
+const plPakI*          gptPak         = NULL;
+const plCompressI*     gptCompress    = NULL;
+const plFileI*         gptFile        = NULL;
+const plStringInternI* gptString      = NULL;
+const plJobI*          gptJob         = NULL;
+const plAtomicsI*      gptAtomics     = NULL;
+const plThreadsI*      gptThreads     = NULL;
+const plEcsI*          gptEcs         = NULL;
+const plBVHI*          gptBvh         = NULL;
+const plAnimationI*    gptAnimation   = NULL;
+const plGjkI*          gptGjk         = NULL;
+const plMeshBuilderI*  gptMeshBuilder = NULL;
 
 #define PL_ALLOC(x)      gptMemory->tracked_realloc(NULL, (x), __FILE__, __LINE__)
 #define PL_REALLOC(x, y) gptMemory->tracked_realloc((x), (y), __FILE__, __LINE__)
@@ -79,8 +97,18 @@ typedef struct _plAppData
 void collision_only_tests_0(void*);
 void datetime_tests_0(void*);
 void vfs_tests_0(void*);
+void compress_tests_0(void*);
+void pak_tests_0(void*);
+void pak_tests_1(void*);
 void file_tests_0(void*);
 void string_intern_tests_0(void*);
+void job_tests_0(void*);
+void ecs_tests_0(void*);
+void bvh_tests_0(void*);
+void bvh_tests_1(void*);
+void animation_tests_0(void*);
+void culling_tests_0(void*);
+void mesh_builder_tests_0(void*);
 
 //-----------------------------------------------------------------------------
 // [SECTION] pl_app_info
@@ -174,15 +202,23 @@ pl_app_load(plApiRegistryI* ptApiRegistry, plAppData* ptAppData)
     
 
     // retrieve the IO API required to use plIO for "talking" with runtime)
-    gptIO        = pl_get_api_latest(ptApiRegistry, plIOI);
-    gptMemory    = pl_get_api_latest(ptApiRegistry, plMemoryI);
-    gptCollision = pl_get_api_latest(ptApiRegistry, plCollisionI);
-    gptDateTime  = pl_get_api_latest(ptApiRegistry, plDateTimeI);
-    gptVfs       = pl_get_api_latest(ptApiRegistry, plVfsI);
-    gptPak       = pl_get_api_latest(ptApiRegistry, plPakI);
-    gptCompress  = pl_get_api_latest(ptApiRegistry, plCompressI);
-    gptFile      = pl_get_api_latest(ptApiRegistry, plFileI);
-    gptString    = pl_get_api_latest(ptApiRegistry, plStringInternI);
+    gptIO          = pl_get_api_latest(ptApiRegistry, plIOI);
+    gptMemory      = pl_get_api_latest(ptApiRegistry, plMemoryI);
+    gptCollision   = pl_get_api_latest(ptApiRegistry, plCollisionI);
+    gptDateTime    = pl_get_api_latest(ptApiRegistry, plDateTimeI);
+    gptVfs         = pl_get_api_latest(ptApiRegistry, plVfsI);
+    gptPak         = pl_get_api_latest(ptApiRegistry, plPakI);
+    gptCompress    = pl_get_api_latest(ptApiRegistry, plCompressI);
+    gptFile        = pl_get_api_latest(ptApiRegistry, plFileI);
+    gptString      = pl_get_api_latest(ptApiRegistry, plStringInternI);
+    gptJob         = pl_get_api_latest(ptApiRegistry, plJobI);
+    gptAtomics     = pl_get_api_latest(ptApiRegistry, plAtomicsI);
+    gptThreads     = pl_get_api_latest(ptApiRegistry, plThreadsI);
+    gptEcs         = pl_get_api_latest(ptApiRegistry, plEcsI);
+    gptBvh         = pl_get_api_latest(ptApiRegistry, plBVHI);
+    gptAnimation   = pl_get_api_latest(ptApiRegistry, plAnimationI);
+    gptGjk         = pl_get_api_latest(ptApiRegistry, plGjkI);
+    gptMeshBuilder = pl_get_api_latest(ptApiRegistry, plMeshBuilderI);
 
     // this path is taken only during first load, so we
     // allocate app memory here
@@ -200,6 +236,7 @@ pl_app_load(plApiRegistryI* ptApiRegistry, plAppData* ptAppData)
     gptPak->begin_packing("../out/testing.pak", 1, &ptPak);
     gptPak->add_from_disk(ptPak, "testing_compressed.json", "/testing/testing.json", true);
     gptPak->add_from_disk(ptPak, "testing_uncompressed.json", "/testing/testing.json", false);
+    gptPak->add_from_disk_ex(ptPak, "testing_compressed_fast.json", "/testing/testing.json", PL_PAK_ENTRY_FLAGS_COMPRESS_FAST);
     int iSpartan = 117;
     gptPak->add_from_memory(ptPak, "spartan.bin", (uint8_t*)&iSpartan, sizeof(int), false);
     gptPak->end_packing(&ptPak);
@@ -235,12 +272,38 @@ pl_app_load(plApiRegistryI* ptApiRegistry, plAppData* ptAppData)
     pl_test_register_test(vfs_tests_0, ptAppData);
     pl_test_run_suite("pl_vfs_ext.h");
 
+    pl_test_register_test(compress_tests_0, ptAppData);
+    pl_test_run_suite("pl_compress_ext.h");
+
+    pl_test_register_test(pak_tests_0, ptAppData);
+    pl_test_register_test(pak_tests_1, ptAppData);
+    pl_test_run_suite("pl_pak_ext.h");
+
     pl_test_register_test(file_tests_0, ptAppData);
     pl_test_run_suite("pl_platform_ext.h (plFileI)"); 
 
     pl_test_register_test(string_intern_tests_0, ptAppData);
     pl_test_run_suite("pl_string_intern.h");
 
+    pl_test_register_test(job_tests_0, ptAppData);
+    pl_test_run_suite("pl_job_ext.h");
+
+    pl_test_register_test(ecs_tests_0, ptAppData);
+    pl_test_run_suite("pl_ecs_ext.h");
+
+    pl_test_register_test(bvh_tests_0, ptAppData);
+    pl_test_register_test(bvh_tests_1, ptAppData);
+    pl_test_run_suite("pl_bvh_ext.h");
+
+    pl_test_register_test(animation_tests_0, ptAppData);
+    pl_test_run_suite("pl_animation_ext.h");
+
+    pl_test_register_test(culling_tests_0, ptAppData);
+    pl_test_run_suite("pl_renderer_culling.inl");
+
+    pl_test_register_test(mesh_builder_tests_0, ptAppData);
+    pl_test_run_suite("pl_mesh_ext.h (plMeshBuilderI)");
+
     return ptAppData;
 }
 
@@ -406,10 +469,11 @@ vfs_tests_0(void* pAppData)
         "/ram/testing_compressed.json",
         "/data/testing_compressed.json",
         "/data/testing_uncompressed.json",
+        "/data/testing_compressed_fast.json",
         "/testing_compressed.json",
     };
 
-    for(uint32_t i = 0; i < 4; i++)
+    for(uint32_t i = 0; i < 5; i++)
     {
 
         size_t szFileSize = gptVfs->get_file_size_str(acFiles[i]);
@@ -521,6 +585,299 @@ vfs_tests_0(void* pAppData)
     }
 }
 
+typedef struct _plCompressTestJob
+{
+    const uint8_t* puData;
+    uint32_t       uSize;
+    bool           bMatch;
+} plCompressTestJob;
+
+static void
+compress_test_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    // each job uses its own context, alternating codecs
+    plCompressTestJob* ptJob = &((plCompressTestJob*)pData)[tInvoData.uGlobalIndex];
+    const plCompressCodec tCodec = tInvoData.uGlobalIndex % 2 == 0 ? PL_COMPRESS_CODEC_DEFAULT : PL_COMPRESS_CODEC_FAST;
+    plCompressContext* ptContext = gptCompress->create_context();
+    const uint32_t uBound = gptCompress->compress_bound(tCodec, ptJob->uSize);
+    uint8_t* puCompressed = PL_ALLOC(uBound);
+    uint8_t* puDecompressed = PL_ALLOC(ptJob->uSize);
+
+    ptJob->bMatch = true;
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const uint32_t uCompressedSize = gptCompress->compress_ex(ptContext, tCodec, ptJob->puData, ptJob->uSize, puCompressed, uBound);
+        const uint32_t uDecompressedSize = gptCompress->decompress(puCompressed, uCompressedSize, puDecompressed, ptJob->uSize);
+        ptJob->bMatch = ptJob->bMatch && uDecompressedSize == ptJob->uSize && memcmp(puDecompressed, ptJob->puData, ptJob->uSize) == 0;
+    }
+
+    PL_FREE(puDecompressed);
+    PL_FREE(puCompressed);
+    gptCompress->cleanup_context(ptContext);
+}
+
+void
+compress_tests_0(void* pAppData)
+{
+    // mixed data: text, repeated structs, runs & noise
+    const uint32_t uSize = 300000;
+    uint8_t* puData = PL_ALLOC(uSize);
+    uint32_t uSeed = 1;
+    for(uint32_t i = 0; i < uSize; i++)
+    {
+        uSeed = uSeed * 1664525u + 1013904223u;
+        if(i < 100000)
+            puData[i] = (uint8_t)"{\"name\": \"entity\", \"position\": [1.0, 2.0, 3.0]},\n"[i % 52];
+        else if(i < 150000)
+            puData[i] = (uint8_t)((i / 12) * 7 + (i % 12));
+        else if(i < 200000)
+            puData[i] = 0;
+        else
+            puData[i] = (uint8_t)(uSeed >> 24);
+    }
+
+    uint8_t* puDecompressed = PL_ALLOC(uSize);
+    const plCompressCodec atCodecs[] = {PL_COMPRESS_CODEC_DEFAULT, PL_COMPRESS_CODEC_FAST};
+    for(uint32_t uCodec = 0; uCodec < 2; uCodec++)
+    {
+        const plCompressCodec tCodec = atCodecs[uCodec];
+        const uint32_t uBound = gptCompress->compress_bound(tCodec, uSize);
+        uint8_t* puCompressed = PL_ALLOC(uBound);
+
+        // round trip (including small sizes around the codec's end limits)
+        bool bRoundTrip = true;
+        const uint32_t auSizes[] = {0, 1, 5, 12, 13, 17, 64, 1000, 100000, uSize};
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            const uint32_t uCompressedSize = gptCompress->compress_ex(NULL, tCodec, puData, auSizes[i], puCompressed, uBound);
+            bRoundTrip = bRoundTrip && uCompressedSize <= gptCompress->compress_bound(tCodec, auSizes[i]);
+            bRoundTrip = bRoundTrip && gptCompress->decompress(puCompressed, uCompressedSize, NULL, 0) == auSizes[i];
+            memset(puDecompressed, 0, uSize);
+            const uint32_t uDecompressedSize = gptCompress->decompress(puCompressed, uCompressedSize, puDecompressed, uSize);
+            bRoundTrip = bRoundTrip && uDecompressedSize == auSizes[i] && memcmp(puDecompressed, puData, auSizes[i]) == 0;
+        }
+        pl_test_expect_true(bRoundTrip, "round trip");
+
+        // compressible data shrinks
+        const uint32_t uCompressedSize = gptCompress->compress_ex(NULL, tCodec, puData, 200000, puCompressed, uBound);
+        pl_test_expect_true(uCompressedSize < 200000 / 4, "ratio");
+
+        // small output buffer reports the full size without overflowing
+        memset(puCompressed, 0xAB, uBound);
+        const uint32_t uRequiredSize = gptCompress->compress_ex(NULL, tCodec, puData, 1000, puCompressed, 16);
+        pl_test_expect_true(uRequiredSize > 16 && puCompressed[16] == 0xAB, "small output buffer");
+
+        PL_FREE(puCompressed);
+    }
+
+    // truncated fast stream is rejected
+    {
+        const uint32_t uBound = gptCompress->compress_bound(PL_COMPRESS_CODEC_FAST, uSize);
+        uint8_t* puCompressed = PL_ALLOC(uBound);
+        const uint32_t uCompressedSize = gptCompress->compress_ex(NULL, PL_COMPRESS_CODEC_FAST, puData, uSize, puCompressed, uBound);
+        pl_test_expect_uint32_equal(gptCompress->decompress(puCompressed, uCompressedSize / 2, puDecompressed, uSize), 0, "truncated stream");
+        PL_FREE(puCompressed);
+    }
+
+    // concurrent compression
+    gptJob->initialize((plJobSystemInit){.uThreadCount = 4});
+    plCompressTestJob atJobs[8] = {0};
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        atJobs[i].puData = &puData[i * 1000];
+        atJobs[i].uSize = uSize - i * 1000;
+    }
+    plJobDesc tJobDesc = {
+        .task  = compress_test_job,
+        .pData = atJobs
+    };
+    plJobCounter* ptCounter = NULL;
+    gptJob->dispatch_batch(8, 1, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+    gptJob->cleanup();
+
+    bool bAllMatch = true;
+    for(uint32_t i = 0; i < 8; i++)
+        bAllMatch = bAllMatch && atJobs[i].bMatch;
+    pl_test_expect_true(bAllMatch, "concurrent compression");
+
+    PL_FREE(puDecompressed);
+    PL_FREE(puData);
+}
+
+typedef struct _plPakTestJob
+{
+    plPakFile*     ptPak;
+    const uint8_t* puExpected;
+    size_t         szSize;
+    bool           bMatch;
+} plPakTestJob;
+
+static void
+pak_test_job(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    // every job reads the same entries through the shared pak
+    plPakTestJob* ptJob = &((plPakTestJob*)pData)[tInvoData.uGlobalIndex];
+    const char* apcFiles[] = {"testing_compressed.json", "testing_compressed_fast.json", "testing_uncompressed.json"};
+    uint8_t* puBuffer = PL_ALLOC(ptJob->szSize);
+
+    ptJob->bMatch = true;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        memset(puBuffer, 0, ptJob->szSize);
+        size_t szSize = 0;
+        ptJob->bMatch = ptJob->bMatch && gptPak->read_file(ptJob->ptPak, apcFiles[i], puBuffer, &szSize);
+        ptJob->bMatch = ptJob->bMatch && szSize == ptJob->szSize && memcmp(puBuffer, ptJob->puExpected, szSize) == 0;
+
+        memset(puBuffer, 0, ptJob->szSize);
+        plPakChildFile* ptChild = gptPak->open_file(ptJob->ptPak, apcFiles[(i + tInvoData.uGlobalIndex) % 3]);
+        size_t szRead = 0;
+        size_t szChunk = 0;
+        while((szChunk = gptPak->read_file_stream(ptChild, 1, 7, &puBuffer[szRead])) > 0)
+            szRead += szChunk;
+        gptPak->close_file(ptChild);
+        ptJob->bMatch = ptJob->bMatch && szRead == ptJob->szSize && memcmp(puBuffer, ptJob->puExpected, szRead) == 0;
+    }
+    PL_FREE(puBuffer);
+}
+
+void
+pak_tests_0(void* pAppData)
+{
+    plPakInfo tInfo = {0};
+    plPakFile* ptPak = NULL;
+    pl_test_expect_true(gptPak->load("/testing/testing.pak", &tInfo, &ptPak), "load");
+    if(ptPak == NULL)
+        return;
+    pl_test_expect_uint32_equal(tInfo.uEntryCount, 4, "entry count");
+
+    // zero copy views (uncompressed only)
+    const uint8_t* puView = NULL;
+    size_t szViewSize = 0;
+    pl_test_expect_true(gptPak->get_file_view(ptPak, "spartan.bin", &puView, &szViewSize), "view");
+    int iSpartan = 0;
+    if(puView)
+        memcpy(&iSpartan, puView, sizeof(int));
+    pl_test_expect_true(szViewSize == sizeof(int), "view size");
+    pl_test_expect_int_equal(iSpartan, 117, "view data");
+    pl_test_expect_false(gptPak->get_file_view(ptPak, "testing_compressed.json", &puView, &szViewSize), "compressed view");
+    pl_test_expect_false(gptPak->get_file_view(ptPak, "missing.bin", &puView, &szViewSize), "missing view");
+
+    // streams behave like fread & don't share positions
+    plPakChildFile* ptChild0 = gptPak->open_file(ptPak, "spartan.bin");
+    plPakChildFile* ptChild1 = gptPak->open_file(ptPak, "spartan.bin");
+    uint16_t auHalves[3] = {0};
+    pl_test_expect_true(gptPak->read_file_stream(ptChild0, 2, 1, &auHalves[0]) == 1, "stream read 0");
+    pl_test_expect_true(gptPak->read_file_stream(ptChild0, 2, 2, &auHalves[1]) == 1, "stream read 1 (partial)");
+    pl_test_expect_true(gptPak->read_file_stream(ptChild0, 2, 1, &auHalves[2]) == 0, "stream read 2 (end)");
+    pl_test_expect_true(gptPak->get_file_stream_position(ptChild0) == sizeof(int), "stream position");
+    pl_test_expect_true(gptPak->get_file_stream_position(ptChild1) == 0, "independent stream position");
+    memcpy(&iSpartan, auHalves, sizeof(int));
+    pl_test_expect_int_equal(iSpartan, 117, "stream data");
+    gptPak->close_file(ptChild0);
+    gptPak->close_file(ptChild1);
+
+    // concurrent reads
+    const uint8_t* puExpected = NULL;
+    size_t szExpectedSize = 0;
+    gptPak->get_file_view(ptPak, "testing_uncompressed.json", &puExpected, &szExpectedSize);
+
+    gptJob->initialize((plJobSystemInit){.uThreadCount = 4});
+    plPakTestJob atJobs[8] = {0};
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        atJobs[i].ptPak = ptPak;
+        atJobs[i].puExpected = puExpected;
+        atJobs[i].szSize = szExpectedSize;
+    }
+    plJobDesc tJobDesc = {
+        .task  = pak_test_job,
+        .pData = atJobs
+    };
+    plJobCounter* ptCounter = NULL;
+    gptJob->dispatch_batch(8, 1, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+    gptJob->cleanup();
+
+    bool bAllMatch = szExpectedSize > 0;
+    for(uint32_t i = 0; i < 8; i++)
+        bAllMatch = bAllMatch && atJobs[i].bMatch;
+    pl_test_expect_true(bAllMatch, "concurrent reads");
+
+    gptPak->unload(&ptPak);
+}
+
+void
+pak_tests_1(void* pAppData)
+{
+    // multi chunk entries: text, runs & noise (incompressible chunks)
+    const size_t szSize = 1000000;
+    uint8_t* puData = PL_ALLOC(szSize);
+    uint32_t uSeed = 7;
+    for(size_t i = 0; i < szSize; i++)
+    {
+        uSeed = uSeed * 1664525u + 1013904223u;
+        if(i < 400000)
+            puData[i] = (uint8_t)"{\"tile\": [0, 1, 2, 3], \"lod\": 2},\n"[i % 36];
+        else if(i < 600000)
+            puData[i] = 0;
+        else
+            puData[i] = (uint8_t)(uSeed >> 24);
+    }
+
+    // parallel compression when packing
+    gptJob->initialize((plJobSystemInit){.uThreadCount = 4});
+    plPakFile* ptPak = NULL;
+    gptPak->begin_packing("../out/testing_chunked.pak", 1, &ptPak);
+    gptPak->add_from_memory_ex(ptPak, "default.bin", puData, szSize, PL_PAK_ENTRY_FLAGS_COMPRESS);
+    gptPak->add_from_memory_ex(ptPak, "fast.bin", puData, szSize, PL_PAK_ENTRY_FLAGS_COMPRESS_FAST);
+    gptPak->add_from_memory_ex(ptPak, "empty.bin", puData, 0, PL_PAK_ENTRY_FLAGS_COMPRESS);
+    gptPak->add_from_memory_ex(ptPak, "raw.bin", puData, szSize, PL_PAK_ENTRY_FLAGS_NONE);
+    gptPak->end_packing(&ptPak);
+    gptJob->cleanup();
+
+    plPakInfo tInfo = {0};
+    pl_test_expect_true(gptPak->load("/testing/testing_chunked.pak", &tInfo, &ptPak), "load");
+    if(ptPak == NULL)
+    {
+        PL_FREE(puData);
+        return;
+    }
+    pl_test_expect_uint32_equal(tInfo.uEntryCount, 4, "entry count");
+
+    uint8_t* puBuffer = PL_ALLOC(szSize);
+    const char* apcFiles[] = {"default.bin", "fast.bin", "raw.bin"};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        // whole file
+        memset(puBuffer, 0, szSize);
+        size_t szFileSize = 0;
+        pl_test_expect_true(gptPak->read_file(ptPak, apcFiles[i], puBuffer, &szFileSize), apcFiles[i]);
+        pl_test_expect_true(szFileSize == szSize && memcmp(puBuffer, puData, szSize) == 0, "read file");
+
+        // random access (reads across chunk boundaries & past the end)
+        plPakChildFile* ptChild = gptPak->open_file(ptPak, apcFiles[i]);
+        const size_t aszOffsets[] = {900000, 65530, 0, 131072, 999990, 500000};
+        bool bMatch = true;
+        for(uint32_t j = 0; j < 6; j++)
+        {
+            gptPak->set_file_stream_position(ptChild, aszOffsets[j]);
+            const size_t szExpected = pl_min(szSize - aszOffsets[j], 70000);
+            bMatch = bMatch && gptPak->read_file_stream(ptChild, 1, 70000, puBuffer) == szExpected;
+            bMatch = bMatch && memcmp(puBuffer, &puData[aszOffsets[j]], szExpected) == 0;
+        }
+        pl_test_expect_true(bMatch, "stream seek");
+        gptPak->close_file(ptChild);
+    }
+
+    size_t szEmptySize = 1;
+    pl_test_expect_true(gptPak->read_file(ptPak, "empty.bin", puBuffer, &szEmptySize) && szEmptySize == 0, "empty entry");
+
+    gptPak->unload(&ptPak);
+    PL_FREE(puBuffer);
+    PL_FREE(puData);
+}
+
 void
 string_intern_tests_0(void* pAppData)
 {
@@ -580,6 +937,1137 @@ file_tests_0(void* pAppData)
     pl_test_expect_false(gptFile->directory_exists("../libs-offset"), NULL);
 }
 
+typedef struct _plJobTestData
+{
+    uint32_t*        auValues;
+    plAtomicCounter* ptSum;
+    uint32_t         uChildJobCount;
+} plJobTestData;
+
+static void
+job_test_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobTestData* ptData = (plJobTestData*)pData;
+    ptData->auValues[tInvoData.uGlobalIndex] = tInvoData.uGlobalIndex * 2;
+}
+
+static void
+job_test_child_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobTestData* ptData = (plJobTestData*)pData;
+    gptAtomics->increment(ptData->ptSum);
+}
+
+static void
+job_test_parent_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobTestData* ptData = (plJobTestData*)pData;
+
+    // jobs launching jobs (goes into worker deque in work stealing mode)
+    plJobDesc tJobDesc = {
+        .task  = job_test_child_task,
+        .pData = ptData
+    };
+    plJobCounter* ptCounter = NULL;
+    gptJob->dispatch_batch(ptData->uChildJobCount, 1, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+}
+
+typedef struct _plJobGraphTestData
+{
+    uint32_t auA[256];
+    uint32_t auB[256];
+    uint32_t auC[256];
+    uint32_t uResult;
+} plJobGraphTestData;
+
+static void
+job_graph_test_a(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobGraphTestData* ptData = (plJobGraphTestData*)pData;
+    ptData->auA[tInvoData.uGlobalIndex] = tInvoData.uGlobalIndex;
+}
+
+static void
+job_graph_test_b(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobGraphTestData* ptData = (plJobGraphTestData*)pData;
+    ptData->auB[tInvoData.uGlobalIndex] = ptData->auA[tInvoData.uGlobalIndex] * 2;
+}
+
+static void
+job_graph_test_c(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobGraphTestData* ptData = (plJobGraphTestData*)pData;
+    ptData->auC[tInvoData.uGlobalIndex] = ptData->auA[tInvoData.uGlobalIndex] * 3;
+}
+
+static void
+job_graph_test_d(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobGraphTestData* ptData = (plJobGraphTestData*)pData;
+    ptData->uResult = 0;
+    for(uint32_t i = 0; i < 256; i++)
+        ptData->uResult += ptData->auB[i] + ptData->auC[i];
+}
+
+typedef struct _plJobPriorityTestData
+{
+    plAtomicCounter* ptActive;    // background batches currently running
+    plAtomicCounter* ptMaxActive;
+    plAtomicCounter* ptRelease;   // background batches block until set
+} plJobPriorityTestData;
+
+static void
+job_test_background_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plJobPriorityTestData* ptData = (plJobPriorityTestData*)pData;
+    const int64_t ilActive = gptAtomics->increment(ptData->ptActive) + 1;
+    int64_t ilMax = gptAtomics->load(ptData->ptMaxActive);
+    while(ilActive > ilMax && !gptAtomics->compare_exchange(ptData->ptMaxActive, ilMax, ilActive))
+        ilMax = gptAtomics->load(ptData->ptMaxActive);
+
+    while(gptAtomics->load(ptData->ptRelease) == 0)
+        gptThreads->sleep_thread(1);
+    gptAtomics->decrement(ptData->ptActive);
+}
+
+void
+job_tests_0(void* pAppData)
+{
+    const plJobSystemFlags aeFlags[] = {
+        PL_JOB_SYSTEM_FLAGS_NONE,
+        PL_JOB_SYSTEM_FLAGS_WORK_STEALING
+    };
+
+    const uint32_t uJobCount = 10000;
+    uint32_t* auValues = (uint32_t*)PL_ALLOC(sizeof(uint32_t) * uJobCount);
+
+    for(uint32_t uMode = 0; uMode < 2; uMode++)
+    {
+        gptJob->initialize((plJobSystemInit){.uThreadCount = 4, .eFlags = aeFlags[uMode], .uMaxBackgroundThreads = 1});
+
+        plJobTestData tData = {
+            .auValues       = auValues,
+            .uChildJobCount = 64
+        };
+        gptAtomics->create_counter(0, &tData.ptSum);
+
+        // simple batch
+        memset(auValues, 0, sizeof(uint32_t) * uJobCount);
+        plJobDesc tJobDesc = {
+            .task  = job_test_task,
+            .pData = &tData
+        };
+        plJobCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(uJobCount, 7, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+
+        bool bAllSet = true;
+        for(uint32_t i = 0; i < uJobCount; i++)
+        {
+            if(auValues[i] != i * 2)
+                bAllSet = false;
+        }
+        pl_test_expect_true(bAllSet, "batch results");
+
+        // nested
+        tJobDesc.task = job_test_parent_task;
+        gptJob->dispatch_batch(32, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+        pl_test_expect_int_equal((int)gptAtomics->load(tData.ptSum), 32 * 64, "nested dispatch");
+
+        // many outstanding counters (grows counter pool)
+        plJobCounter* aptCounters[600] = {0};
+        gptAtomics->store(tData.ptSum, 0);
+        tJobDesc.task = job_test_child_task;
+        for(uint32_t i = 0; i < 600; i++)
+            gptJob->dispatch_batch(4, 1, tJobDesc, &aptCounters[i]);
+        for(uint32_t i = 0; i < 600; i++)
+            gptJob->wait_for_counter(aptCounters[600 - i - 1]);
+        pl_test_expect_int_equal((int)gptAtomics->load(tData.ptSum), 600 * 4, "outstanding counters");
+
+        // graph (diamond: a -> b,c -> empty -> d)
+        plJobGraphTestData* ptGraphData = (plJobGraphTestData*)PL_ALLOC(sizeof(plJobGraphTestData));
+        plJobGraph* ptGraph = gptJob->create_graph();
+        const uint32_t uNodeA = gptJob->add_graph_batch(ptGraph, 256, 8, (plJobDesc){.task = job_graph_test_a, .pData = ptGraphData});
+        const uint32_t uNodeB = gptJob->add_graph_batch(ptGraph, 256, 0, (plJobDesc){.task = job_graph_test_b, .pData = ptGraphData});
+        const uint32_t uNodeC = gptJob->add_graph_batch(ptGraph, 256, 1, (plJobDesc){.task = job_graph_test_c, .pData = ptGraphData});
+        const uint32_t uNodeE = gptJob->add_graph_jobs(ptGraph, 0, NULL);
+        plJobDesc tGraphJobDesc = {.task = job_graph_test_d, .pData = ptGraphData};
+        const uint32_t uNodeD = gptJob->add_graph_jobs(ptGraph, 1, &tGraphJobDesc);
+        gptJob->add_graph_edge(ptGraph, uNodeA, uNodeB);
+        gptJob->add_graph_edge(ptGraph, uNodeA, uNodeC);
+        gptJob->add_graph_edge(ptGraph, uNodeB, uNodeE);
+        gptJob->add_graph_edge(ptGraph, uNodeC, uNodeE);
+        gptJob->add_graph_edge(ptGraph, uNodeE, uNodeD);
+
+        // dispatch multiple times to ensure graph is reusable
+        bool bGraphCorrect = true;
+        for(uint32_t i = 0; i < 4; i++)
+        {
+            memset(ptGraphData, 0, sizeof(plJobGraphTestData));
+            gptJob->dispatch_graph(ptGraph, &ptCounter);
+            gptJob->wait_for_counter(ptCounter);
+            if(ptGraphData->uResult != 5 * (255 * 256 / 2))
+                bGraphCorrect = false;
+        }
+        pl_test_expect_true(bGraphCorrect, "graph dependencies");
+        gptJob->destroy_graph(ptGraph);
+        PL_FREE(ptGraphData);
+
+        // long running background work must not block frame work
+        plJobPriorityTestData tPriorityData = {0};
+        gptAtomics->create_counter(0, &tPriorityData.ptActive);
+        gptAtomics->create_counter(0, &tPriorityData.ptMaxActive);
+        gptAtomics->create_counter(0, &tPriorityData.ptRelease);
+        plJobDesc tBackgroundJobDesc = {
+            .task      = job_test_background_task,
+            .pData     = &tPriorityData,
+            .ePriority = PL_JOB_PRIORITY_BACKGROUND
+        };
+        plJobCounter* ptBackgroundCounter = NULL;
+        gptJob->dispatch_batch(8, 1, tBackgroundJobDesc, &ptBackgroundCounter);
+
+        memset(auValues, 0, sizeof(uint32_t) * uJobCount);
+        tJobDesc.task = job_test_task;
+        tJobDesc.ePriority = PL_JOB_PRIORITY_HIGH;
+        gptJob->dispatch_batch(uJobCount, 64, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+        pl_test_expect_uint32_equal(auValues[uJobCount - 1], (uJobCount - 1) * 2, "high priority with background work");
+
+        gptThreads->sleep_thread(10);
+        pl_test_expect_int_equal((int)gptAtomics->load(tPriorityData.ptMaxActive), 1, "background thread cap");
+        gptAtomics->store(tPriorityData.ptRelease, 1);
+        gptJob->wait_for_counter(ptBackgroundCounter);
+        pl_test_expect_int_equal((int)gptAtomics->load(tPriorityData.ptActive), 0, "background complete");
+        gptAtomics->destroy_counter(&tPriorityData.ptActive);
+        gptAtomics->destroy_counter(&tPriorityData.ptMaxActive);
+        gptAtomics->destroy_counter(&tPriorityData.ptRelease);
+
+        gptAtomics->destroy_counter(&tData.ptSum);
+        gptJob->cleanup();
+    }
+
+    PL_FREE(auValues);
+}
+
+typedef struct _plEcsTestComponent
+{
+    uint32_t uValue;
+} plEcsTestComponent;
+
+typedef struct _plEcsCommandTestData
+{
+    plEcsCommandBuffer** aptBuffers;
+    plEcsTypeKey         tTypeA;
+    plEcsTypeKey         tTypeB;
+    const plEntity*      atRemove;
+} plEcsCommandTestData;
+
+static void
+ecs_test_record_task(plInvocationData tInvoData, void* pData, void* pGroupSharedMemory)
+{
+    plEcsCommandTestData* ptData = pData;
+    plEcsCommandBuffer* ptBuffer = ptData->aptBuffers[tInvoData.uGlobalIndex];
+    for(uint32_t i = 0; i < 100; i++)
+    {
+        const plEntity tEntity = gptEcs->record_create_entity(ptBuffer);
+        plEcsTestComponent* ptComponent = gptEcs->record_add_component(ptBuffer, ptData->tTypeA, tEntity);
+        ptComponent->uValue = 7;
+        gptEcs->record_add_component(ptBuffer, ptData->tTypeB, tEntity);
+    }
+    gptEcs->record_remove_entity(ptBuffer, ptData->atRemove[tInvoData.uGlobalIndex]);
+    gptEcs->record_remove_entity(ptBuffer, ptData->atRemove[0]); // duplicates are ignored
+}
+
+static uint32_t
+ecs_test_query_sum(plComponentLibrary* ptLibrary, uint32_t uTypeCount, const plEcsTypeKey* atTypes, bool* pbContiguous)
+{
+    uint32_t uSum = 0;
+    plEcsQueryIterator* ptIter = (plEcsQueryIterator*)PL_ALLOC(sizeof(plEcsQueryIterator));
+    gptEcs->query_begin(ptLibrary, uTypeCount, atTypes, ptIter);
+    *pbContiguous = true;
+    while(gptEcs->query_next(ptIter))
+    {
+        if(ptIter->apuIndices[0] != NULL)
+            *pbContiguous = false;
+        for(uint32_t i = 0; i < ptIter->uCount; i++)
+        {
+            for(uint32_t j = 0; j < uTypeCount; j++)
+            {
+                const plEcsTestComponent* ptComponent = pl_ecs_query_component(ptIter, j, i);
+                if(ptComponent->uValue != ptIter->ptEntities[i].uIndex)
+                    uSum = UINT32_MAX / 2; // poison result
+            }
+            uSum += ptIter->ptEntities[i].uIndex;
+        }
+    }
+    PL_FREE(ptIter);
+    return uSum;
+}
+
+void
+ecs_tests_0(void* pAppData)
+{
+    gptEcs->initialize((plEcsInit){0});
+    const plEcsTypeKey tTypeA = gptEcs->register_type((plComponentDesc){.pcName = "Test A", .szSize = sizeof(plEcsTestComponent)}, NULL);
+    const plEcsTypeKey tTypeB = gptEcs->register_type((plComponentDesc){.pcName = "Test B", .szSize = sizeof(plEcsTestComponent)}, NULL);
+    const plEcsTypeKey tTypeC = gptEcs->register_type((plComponentDesc){.pcName = "Test C", .szSize = sizeof(plEcsTestComponent)}, NULL);
+    gptEcs->finalize();
+
+    plComponentLibrary* ptLibrary = gptEcs->get_default_library();
+
+    // every entity has A, even B, multiple of 3 C
+    const uint32_t uEntityCount = 1000;
+    plEntity* atEntities = (plEntity*)PL_ALLOC(sizeof(plEntity) * uEntityCount);
+    for(uint32_t i = 0; i < uEntityCount; i++)
+    {
+        atEntities[i] = gptEcs->create_entity(ptLibrary, NULL);
+        const plEcsTypeKey atTypes[] = {tTypeA, tTypeB, tTypeC};
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            if(j == 1 && i % 2 != 0) continue;
+            if(j == 2 && i % 3 != 0) continue;
+            plEcsTestComponent* ptComponent = gptEcs->add_component(ptLibrary, atTypes[j], atEntities[i]);
+            ptComponent->uValue = atEntities[i].uIndex;
+        }
+    }
+
+    pl_test_expect_true(gptEcs->has_component(ptLibrary, tTypeB, atEntities[10]), "has component");
+    pl_test_expect_false(gptEcs->has_component(ptLibrary, tTypeB, atEntities[11]), "missing component");
+    pl_test_expect_true(gptEcs->get_index(ptLibrary, tTypeC, atEntities[11]) == UINT64_MAX, "missing index");
+
+    // reference sums
+    uint32_t uSumAB = 0;
+    uint32_t uSumABC = 0;
+    for(uint32_t i = 0; i < uEntityCount; i++)
+    {
+        if(i % 2 == 0) uSumAB += atEntities[i].uIndex;
+        if(i % 6 == 0) uSumABC += atEntities[i].uIndex;
+    }
+
+    bool bContiguous = false;
+    const plEcsTypeKey atQueryAB[] = {tTypeA, tTypeB};
+    const plEcsTypeKey atQueryABC[] = {tTypeA, tTypeB, tTypeC};
+    pl_test_expect_uint32_equal(ecs_test_query_sum(ptLibrary, 2, atQueryAB, &bContiguous), uSumAB, "query (ungrouped)");
+    pl_test_expect_false(bContiguous, "ungrouped query uses indices");
+
+    // group existing entities
+    pl_test_expect_true(gptEcs->create_group(ptLibrary, 2, atQueryAB), "create group");
+    pl_test_expect_uint32_equal(ecs_test_query_sum(ptLibrary, 2, atQueryAB, &bContiguous), uSumAB, "query (grouped)");
+    pl_test_expect_true(bContiguous, "grouped query is contiguous");
+    pl_test_expect_uint32_equal(ecs_test_query_sum(ptLibrary, 3, atQueryABC, &bContiguous), uSumABC, "query (mixed)");
+
+    // remove every 4th entity & keep groups consistent
+    for(uint32_t i = 0; i < uEntityCount; i += 4)
+    {
+        gptEcs->remove_entity(ptLibrary, atEntities[i]);
+        uSumAB -= atEntities[i].uIndex;
+        if(i % 6 == 0) uSumABC -= atEntities[i].uIndex;
+    }
+    pl_test_expect_uint32_equal(ecs_test_query_sum(ptLibrary, 2, atQueryAB, &bContiguous), uSumAB, "query after remove");
+    pl_test_expect_uint32_equal(ecs_test_query_sum(ptLibrary, 3, atQueryABC, &bContiguous), uSumABC, "mixed query after remove");
+
+    bool bLookupsCorrect = true;
+    for(uint32_t i = 1; i < uEntityCount; i += 4)
+    {
+        plEcsTestComponent* ptComponent = gptEcs->get_component(ptLibrary, tTypeA, atEntities[i]);
+        if(ptComponent == NULL || ptComponent->uValue != atEntities[i].uIndex)
+            bLookupsCorrect = false;
+    }
+    pl_test_expect_true(bLookupsCorrect, "lookups after remove");
+
+    // late additions join group
+    for(uint32_t i = 1; i < uEntityCount; i += 2)
+    {
+        plEcsTestComponent* ptComponent = gptEcs->add_component(ptLibrary, tTypeB, atEntities[i]);
+        ptComponent->uValue = atEntities[i].uIndex;
+        uSumAB += atEntities[i].uIndex;
+    }
+    pl_test_expect_uint32_equal(ecs_test_query_sum(ptLibrary, 2, atQueryAB, &bContiguous), uSumAB, "query after late add");
+    pl_test_expect_true(bContiguous, "late add stays contiguous");
+
+    PL_FREE(atEntities);
+
+    // hierarchy (large enough levels to use jobs)
+    gptJob->initialize((plJobSystemInit){.uThreadCount = 4});
+    const plEcsTypeKey tTransformType = gptEcs->get_ecs_type_key_transform();
+    const uint32_t uChildCount = 3000;
+    plEntity* atChildren = (plEntity*)PL_ALLOC(sizeof(plEntity) * uChildCount * 2);
+    plEntity* atGrandChildren = &atChildren[uChildCount];
+
+    plTransformComponent* ptTransform = NULL;
+    const plEntity tRoot = gptEcs->create_transform(ptLibrary, "root", &ptTransform);
+    ptTransform->tTranslation = pl_create_vec3(1.0f, 0.0f, 0.0f);
+    for(uint32_t i = 0; i < uChildCount; i++)
+    {
+        atChildren[i] = gptEcs->create_transform(ptLibrary, NULL, &ptTransform);
+        ptTransform->tTranslation = pl_create_vec3(0.0f, 1.0f, 0.0f);
+        atGrandChildren[i] = gptEcs->create_transform(ptLibrary, NULL, &ptTransform);
+        ptTransform->tTranslation = pl_create_vec3(0.0f, 0.0f, 1.0f);
+
+        // attach bottom up (forces reorder)
+        gptEcs->attach_component(ptLibrary, atGrandChildren[i], atChildren[i]);
+    }
+    for(uint32_t i = 0; i < uChildCount; i++)
+        gptEcs->attach_component(ptLibrary, atChildren[i], tRoot);
+
+    gptEcs->run_transform_update_system(ptLibrary);
+    gptEcs->run_hierarchy_update_system(ptLibrary);
+
+    bool bHierarchyCorrect = true;
+    for(uint32_t i = 0; i < uChildCount; i++)
+    {
+        ptTransform = gptEcs->get_component(ptLibrary, tTransformType, atGrandChildren[i]);
+        if(ptTransform->tWorld.col[3].x != 1.0f || ptTransform->tWorld.col[3].y != 1.0f || ptTransform->tWorld.col[3].z != 1.0f)
+            bHierarchyCorrect = false;
+    }
+    pl_test_expect_true(bHierarchyCorrect, "hierarchy propagation");
+
+    // clean frame touches nothing
+    gptEcs->run_transform_update_system(ptLibrary);
+    gptEcs->run_hierarchy_update_system(ptLibrary);
+    ptTransform = gptEcs->get_component(ptLibrary, tTransformType, atGrandChildren[7]);
+    pl_test_expect_false(ptTransform->eFlags & PL_TRANSFORM_FLAGS_UPDATED, "clean hierarchy skipped");
+
+    // moving root updates subtree
+    ptTransform = gptEcs->get_component(ptLibrary, tTransformType, tRoot);
+    ptTransform->tTranslation = pl_create_vec3(2.0f, 0.0f, 0.0f);
+    ptTransform->eFlags |= PL_TRANSFORM_FLAGS_DIRTY;
+    gptEcs->run_transform_update_system(ptLibrary);
+    gptEcs->run_hierarchy_update_system(ptLibrary);
+    ptTransform = gptEcs->get_component(ptLibrary, tTransformType, atGrandChildren[uChildCount - 1]);
+    pl_test_expect_true(ptTransform->tWorld.col[3].x == 2.0f && ptTransform->tWorld.col[3].z == 1.0f, "dirty root propagation");
+
+    // reparent grandchild directly under root
+    gptEcs->attach_component(ptLibrary, atGrandChildren[0], tRoot);
+    gptEcs->remove_entity(ptLibrary, atChildren[1]);
+    gptEcs->run_transform_update_system(ptLibrary);
+    gptEcs->run_hierarchy_update_system(ptLibrary);
+    ptTransform = gptEcs->get_component(ptLibrary, tTransformType, atGrandChildren[0]);
+    pl_test_expect_true(ptTransform->tWorld.col[3].x == 2.0f && ptTransform->tWorld.col[3].y == 0.0f, "reparent");
+
+    // command buffers recorded from jobs
+    plComponentLibrary* ptCmdLibrary = NULL;
+    gptEcs->create_library(&ptCmdLibrary);
+    plEntity atBulk[8] = {0};
+    gptEcs->create_entities(ptCmdLibrary, 8, atBulk);
+    gptEcs->add_components(ptCmdLibrary, tTypeC, 8, atBulk);
+    pl_test_expect_uint32_equal(gptEcs->get_components(ptCmdLibrary, tTypeC, NULL, NULL), 8, "bulk add");
+
+    plEcsCommandBuffer* aptBuffers[4] = {0};
+    for(uint32_t i = 0; i < 4; i++)
+        aptBuffers[i] = gptEcs->create_command_buffer(ptCmdLibrary);
+    plEcsCommandTestData tCmdData = {
+        .aptBuffers = aptBuffers,
+        .tTypeA     = tTypeA,
+        .tTypeB     = tTypeB,
+        .atRemove   = atBulk
+    };
+    plJobCounter* ptCmdCounter = NULL;
+    gptJob->dispatch_batch(4, 1, (plJobDesc){.task = ecs_test_record_task, .pData = &tCmdData}, &ptCmdCounter);
+    gptJob->wait_for_counter(ptCmdCounter);
+    gptEcs->record_remove_component(aptBuffers[0], tTypeC, atBulk[5]);
+    gptEcs->playback_command_buffers(4, aptBuffers);
+
+    plEcsTestComponent* ptCmdComponents = NULL;
+    const uint32_t uCmdCountA = gptEcs->get_components(ptCmdLibrary, tTypeA, (void**)&ptCmdComponents, NULL);
+    bool bPayloadCopied = uCmdCountA > 0;
+    for(uint32_t i = 0; i < uCmdCountA; i++)
+        bPayloadCopied = bPayloadCopied && ptCmdComponents[i].uValue == 7;
+    pl_test_expect_uint32_equal(uCmdCountA, 400, "deferred create & add");
+    pl_test_expect_uint32_equal(gptEcs->get_components(ptCmdLibrary, tTypeB, NULL, NULL), 400, "deferred add (second type)");
+    pl_test_expect_true(bPayloadCopied, "deferred component data");
+    pl_test_expect_uint32_equal(gptEcs->get_components(ptCmdLibrary, tTypeC, NULL, NULL), 3, "deferred removals");
+    pl_test_expect_false(gptEcs->is_entity_valid(ptCmdLibrary, atBulk[3]), "deferred entity removal");
+
+    // commands on the same entity apply in recording order
+    const plEntity tOrderEntity0 = gptEcs->create_entity(ptCmdLibrary, "order 0");
+    const plEntity tOrderEntity1 = gptEcs->create_entity(ptCmdLibrary, "order 1");
+    gptEcs->add_component(ptCmdLibrary, tTypeB, tOrderEntity1);
+    gptEcs->record_add_component(aptBuffers[0], tTypeA, tOrderEntity0);
+    gptEcs->record_remove_component(aptBuffers[0], tTypeA, tOrderEntity0);
+    gptEcs->record_remove_component(aptBuffers[1], tTypeB, tOrderEntity1);
+    gptEcs->record_add_component(aptBuffers[1], tTypeB, tOrderEntity1);
+    gptEcs->playback_command_buffers(4, aptBuffers);
+    pl_test_expect_false(gptEcs->has_component(ptCmdLibrary, tTypeA, tOrderEntity0), "add then remove");
+    pl_test_expect_true(gptEcs->has_component(ptCmdLibrary, tTypeB, tOrderEntity1), "remove then add");
+
+    // structural changes keeping the count must still change the generation
+    const uint32_t uTypeCCount = gptEcs->get_components(ptCmdLibrary, tTypeC, NULL, NULL);
+    const uint32_t uTypeCGeneration = gptEcs->get_component_generation(ptCmdLibrary, tTypeC);
+    gptEcs->remove_component(ptCmdLibrary, tTypeC, atBulk[4]);
+    gptEcs->add_component(ptCmdLibrary, tTypeC, tOrderEntity0);
+    pl_test_expect_uint32_equal(gptEcs->get_components(ptCmdLibrary, tTypeC, NULL, NULL), uTypeCCount, "remove & add keeps count");
+    pl_test_expect_true(gptEcs->get_component_generation(ptCmdLibrary, tTypeC) != uTypeCGeneration, "remove & add changes generation");
+
+    // recorded hierarchy & tags are linked into the depth order & name map
+    plTransformComponent* ptCmdTransform = NULL;
+    gptEcs->create_transform(ptCmdLibrary, "cmd parent", &ptCmdTransform);
+    ptCmdTransform->tTranslation = pl_create_vec3(1.0f, 0.0f, 0.0f);
+    const plEntity tCmdParent = gptEcs->get_entity_by_name(ptCmdLibrary, "cmd parent");
+    const plEntity tCmdChild = gptEcs->record_create_entity(aptBuffers[2]);
+    const plEntity tCmdGrandChild = gptEcs->record_create_entity(aptBuffers[2]);
+    ptCmdTransform = gptEcs->record_add_component(aptBuffers[2], tTransformType, tCmdChild);
+    ptCmdTransform->tTranslation = pl_create_vec3(0.0f, 2.0f, 0.0f);
+    ptCmdTransform = gptEcs->record_add_component(aptBuffers[2], tTransformType, tCmdGrandChild);
+    ptCmdTransform->tTranslation = pl_create_vec3(0.0f, 0.0f, 3.0f);
+    ((plHierarchyComponent*)gptEcs->record_add_component(aptBuffers[2], gptEcs->get_ecs_type_key_hierarchy(), tCmdGrandChild))->tParent = tCmdChild;
+    ((plHierarchyComponent*)gptEcs->record_add_component(aptBuffers[2], gptEcs->get_ecs_type_key_hierarchy(), tCmdChild))->tParent = tCmdParent;
+    strncpy(((plTagComponent*)gptEcs->record_add_component(aptBuffers[2], gptEcs->get_ecs_type_key_tag(), tCmdGrandChild))->acName, "cmd grandchild", 128);
+    gptEcs->playback_command_buffers(4, aptBuffers);
+    gptEcs->run_transform_update_system(ptCmdLibrary);
+    gptEcs->run_hierarchy_update_system(ptCmdLibrary);
+    const plEntity tPlayedGrandChild = gptEcs->get_entity_by_name(ptCmdLibrary, "cmd grandchild");
+    pl_test_expect_true(gptEcs->is_entity_valid(ptCmdLibrary, tPlayedGrandChild), "deferred tag in name map");
+    ptCmdTransform = gptEcs->get_component(ptCmdLibrary, tTransformType, tPlayedGrandChild);
+    pl_test_expect_true(ptCmdTransform && ptCmdTransform->tWorld.col[3].x == 1.0f && ptCmdTransform->tWorld.col[3].y == 2.0f && ptCmdTransform->tWorld.col[3].z == 3.0f, "deferred hierarchy propagation");
+
+    for(uint32_t i = 0; i < 4; i++)
+        gptEcs->cleanup_command_buffer(&aptBuffers[i]);
+    gptEcs->cleanup_library(&ptCmdLibrary);
+
+    gptJob->cleanup();
+
+    // large levels fall back to serial updates without a running job system
+    ptTransform = gptEcs->get_component(ptLibrary, tTransformType, tRoot);
+    ptTransform->tTranslation = pl_create_vec3(3.0f, 0.0f, 0.0f);
+    ptTransform->eFlags |= PL_TRANSFORM_FLAGS_DIRTY;
+    gptEcs->run_transform_update_system(ptLibrary);
+    gptEcs->run_hierarchy_update_system(ptLibrary);
+    ptTransform = gptEcs->get_component(ptLibrary, tTransformType, atGrandChildren[uChildCount - 1]);
+    pl_test_expect_true(ptTransform->tWorld.col[3].x == 3.0f && ptTransform->tWorld.col[3].z == 1.0f, "serial propagation without jobs");
+
+    PL_FREE(atChildren);
+    gptEcs->cleanup();
+}
+
+typedef struct _plBvhTestData
+{
+    uint8_t* auHits; // per primitive
+    uint32_t uCallbackCount;
+} plBvhTestData;
+
+static bool
+bvh_test_callback(uint32_t uIndex, void* pUserData)
+{
+    plBvhTestData* ptData = pUserData;
+    ptData->auHits[uIndex]++;
+    ptData->uCallbackCount++;
+    return false;
+}
+
+static bool
+bvh_test_ray_aabb(plRay tRay, const plAABB* ptAABB)
+{
+    float fNear = 0.0f;
+    float fFar = FLT_MAX;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        if(tRay.tDirection.d[i] == 0.0f)
+        {
+            if(tRay.tOrigin.d[i] < ptAABB->tMin.d[i] || tRay.tOrigin.d[i] > ptAABB->tMax.d[i])
+                return false;
+            continue;
+        }
+        float fT0 = (ptAABB->tMin.d[i] - tRay.tOrigin.d[i]) / tRay.tDirection.d[i];
+        float fT1 = (ptAABB->tMax.d[i] - tRay.tOrigin.d[i]) / tRay.tDirection.d[i];
+        if(fT0 > fT1) { float fTemp = fT0; fT0 = fT1; fT1 = fTemp; }
+        if(fT0 > fNear) fNear = fT0;
+        if(fT1 < fFar) fFar = fT1;
+        if(fNear > fFar)
+            return false;
+    }
+    return true;
+}
+
+static void
+bvh_test_random_boxes(plAABB* atBoxes, uint32_t uCount, uint32_t uSeed)
+{
+    // random boxes in a 100^3 volume
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plVec3 tCenter = {0};
+        plVec3 tHalf = {0};
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            uSeed = uSeed * 1664525u + 1013904223u;
+            tCenter.d[j] = (float)(uSeed >> 8) / (float)(1 << 24) * 100.0f;
+            uSeed = uSeed * 1664525u + 1013904223u;
+            tHalf.d[j] = 0.05f + (float)(uSeed >> 8) / (float)(1 << 24) * 0.5f;
+        }
+        atBoxes[i].tMin = pl_sub_vec3(tCenter, tHalf);
+        atBoxes[i].tMax = pl_add_vec3(tCenter, tHalf);
+    }
+}
+
+static bool
+bvh_test_check_tree(plBVH* ptBvh, const plAABB* atBoxes, const bool* abActive, uint32_t uBoxCount, plBvhTestData* ptData)
+{
+    // every active primitive is in exactly one leaf
+    memset(ptData->auHits, 0, uBoxCount);
+    plBVHNode* ptNode = NULL;
+    uint32_t uLeafIndex = UINT32_MAX;
+    while(gptBvh->traverse(ptBvh, &ptNode, &uLeafIndex))
+    {
+        if(uLeafIndex != UINT32_MAX)
+        {
+            if(uLeafIndex >= uBoxCount)
+                return false;
+            ptData->auHits[uLeafIndex]++;
+        }
+    }
+    for(uint32_t i = 0; i < uBoxCount; i++)
+    {
+        if(ptData->auHits[i] != (abActive[i] ? 1 : 0))
+            return false;
+    }
+
+    // queries report every overlapping active box & no inactive ones
+    for(uint32_t uQuery = 0; uQuery < 16; uQuery++)
+    {
+        const plVec3 tMin = {(float)(uQuery * 5), (float)(uQuery * 3), 100.0f - (float)(uQuery * 6)};
+        const plAABB tQuery = {
+            .tMin = tMin,
+            .tMax = pl_add_vec3(tMin, pl_create_vec3(10.0f, 10.0f, 10.0f))
+        };
+        memset(ptData->auHits, 0, uBoxCount);
+        gptBvh->intersects_aabb(ptBvh, tQuery, bvh_test_callback, ptData);
+        for(uint32_t i = 0; i < uBoxCount; i++)
+        {
+            if(ptData->auHits[i] > 0 && !abActive[i])
+                return false;
+            if(abActive[i] && ptData->auHits[i] == 0 && gptCollision->aabb_aabb(&atBoxes[i], &tQuery))
+                return false;
+        }
+    }
+    return true;
+}
+
+void
+bvh_tests_0(void* pData)
+{
+    const uint32_t uBoxCount = 20000;
+    plAABB* atBoxes = PL_ALLOC(sizeof(plAABB) * uBoxCount);
+    bvh_test_random_boxes(atBoxes, uBoxCount, 12345);
+
+    gptJob->initialize((plJobSystemInit){.uThreadCount = 4});
+
+    plBvhTestData tData = {
+        .auHits = PL_ALLOC(uBoxCount)
+    };
+
+    const plBVHBuildFlags atFlags[] = {
+        PL_BVH_BUILD_FLAGS_NONE,
+        PL_BVH_BUILD_FLAGS_MIDPOINT,
+        PL_BVH_BUILD_FLAGS_PARALLEL
+    };
+
+    const plAABB tQuery = {
+        .tMin = {20.0f, 30.0f, 40.0f},
+        .tMax = {35.0f, 45.0f, 50.0f}
+    };
+
+    // rays from outside the volume through its center
+    plRay atRays[64] = {0};
+    for(uint32_t i = 0; i < 64; i++)
+    {
+        const float fAngle = (float)i * 0.3f;
+        atRays[i].tOrigin = pl_create_vec3(50.0f + 80.0f * cosf(fAngle), 50.0f + (float)i - 32.0f, 50.0f + 80.0f * sinf(fAngle));
+        atRays[i].tDirection = pl_sub_vec3(pl_create_vec3(50.0f, 50.0f, 50.0f), atRays[i].tOrigin);
+    }
+    atRays[0].tDirection = pl_create_vec3(0.0f, 0.0f, -1.0f); // axis aligned
+
+    for(uint32_t uMode = 0; uMode < 3; uMode++)
+    {
+        plBVH tBvh = {0};
+        gptBvh->build_ex(&tBvh, atBoxes, uBoxCount, atFlags[uMode]);
+
+        // every primitive is in exactly one leaf
+        memset(tData.auHits, 0, uBoxCount);
+        plBVHNode* ptNode = NULL;
+        uint32_t uLeafIndex = UINT32_MAX;
+        uint32_t uLeafCount = 0;
+        while(gptBvh->traverse(&tBvh, &ptNode, &uLeafIndex))
+        {
+            if(uLeafIndex != UINT32_MAX)
+            {
+                tData.auHits[uLeafIndex]++;
+                uLeafCount++;
+            }
+        }
+        bool bAllOnce = uLeafCount == uBoxCount;
+        for(uint32_t i = 0; i < uBoxCount; i++)
+            bAllOnce = bAllOnce && tData.auHits[i] == 1;
+        pl_test_expect_true(bAllOnce, "bvh contains every primitive once");
+
+        // aabb query reports at least every overlapping box
+        memset(tData.auHits, 0, uBoxCount);
+        gptBvh->intersects_aabb(&tBvh, tQuery, bvh_test_callback, &tData);
+        bool bMissed = false;
+        uint32_t uExpected = 0;
+        for(uint32_t i = 0; i < uBoxCount; i++)
+        {
+            if(gptCollision->aabb_aabb(&atBoxes[i], &tQuery))
+            {
+                uExpected++;
+                if(tData.auHits[i] == 0)
+                    bMissed = true;
+            }
+        }
+        pl_test_expect_true(uExpected > 0 && !bMissed, "aabb query");
+
+        // ray query reports at least every hit box
+        bMissed = false;
+        uExpected = 0;
+        for(uint32_t uRay = 0; uRay < 64; uRay++)
+        {
+            memset(tData.auHits, 0, uBoxCount);
+            gptBvh->intersects_ray(&tBvh, atRays[uRay], bvh_test_callback, &tData);
+            for(uint32_t i = 0; i < uBoxCount; i++)
+            {
+                if(bvh_test_ray_aabb(atRays[uRay], &atBoxes[i]))
+                {
+                    uExpected++;
+                    if(tData.auHits[i] == 0)
+                        bMissed = true;
+                }
+            }
+        }
+        pl_test_expect_true(uExpected > 0 && !bMissed, "ray query");
+
+        gptBvh->cleanup(&tBvh);
+    }
+
+    // degenerate input (all boxes identical) still builds a valid tree
+    for(uint32_t i = 0; i < uBoxCount; i++)
+        atBoxes[i] = atBoxes[0];
+    {
+        plBVH tBvh = {0};
+        gptBvh->build(&tBvh, atBoxes, uBoxCount);
+        tData.uCallbackCount = 0;
+        gptBvh->intersects_aabb(&tBvh, atBoxes[0], bvh_test_callback, &tData);
+        pl_test_expect_uint32_equal(tData.uCallbackCount, uBoxCount, "degenerate input");
+        gptBvh->cleanup(&tBvh);
+    }
+
+    PL_FREE(tData.auHits);
+    PL_FREE(atBoxes);
+    gptJob->cleanup();
+}
+
+void
+bvh_tests_1(void* pData)
+{
+    // extra room for inserted primitives
+    const uint32_t uBuildCount = 20000;
+    const uint32_t uBoxCount = 22000;
+    plAABB* atBoxes = PL_ALLOC(sizeof(plAABB) * uBoxCount);
+    bool* abActive = PL_ALLOC(sizeof(bool) * uBoxCount);
+    bvh_test_random_boxes(atBoxes, uBoxCount, 12345);
+    for(uint32_t i = 0; i < uBoxCount; i++)
+        abActive[i] = i < uBuildCount;
+
+    plBvhTestData tData = {
+        .auHits = PL_ALLOC(uBoxCount)
+    };
+
+    plBVH tBvh = {0};
+    gptBvh->build(&tBvh, atBoxes, uBuildCount);
+
+    // refit after moving everything
+    for(uint32_t i = 0; i < uBuildCount; i++)
+    {
+        const plVec3 tOffset = {(float)(i % 7), -(float)(i % 5), (float)(i % 3)};
+        atBoxes[i].tMin = pl_add_vec3(atBoxes[i].tMin, tOffset);
+        atBoxes[i].tMax = pl_add_vec3(atBoxes[i].tMax, tOffset);
+    }
+    gptBvh->refit(&tBvh, atBoxes, uBuildCount);
+    pl_test_expect_true(bvh_test_check_tree(&tBvh, atBoxes, abActive, uBoxCount, &tData), "refit");
+
+    // move a few primitives far away
+    for(uint32_t i = 0; i < 2000; i += 3)
+    {
+        atBoxes[i].tMin = pl_add_vec3(atBoxes[i].tMin, pl_create_vec3(-40.0f, 25.0f, 10.0f));
+        atBoxes[i].tMax = pl_add_vec3(atBoxes[i].tMax, pl_create_vec3(-40.0f, 25.0f, 10.0f));
+        gptBvh->update(&tBvh, i, atBoxes[i]);
+    }
+    pl_test_expect_true(bvh_test_check_tree(&tBvh, atBoxes, abActive, uBoxCount, &tData), "update");
+
+    // remove some (including moved ones) & insert new ones
+    for(uint32_t i = 1000; i < 4000; i += 2)
+    {
+        gptBvh->remove(&tBvh, i);
+        abActive[i] = false;
+    }
+    for(uint32_t i = uBuildCount; i < uBoxCount; i++)
+    {
+        gptBvh->insert(&tBvh, i, atBoxes[i]);
+        abActive[i] = true;
+    }
+    pl_test_expect_true(bvh_test_check_tree(&tBvh, atBoxes, abActive, uBoxCount, &tData), "insert & remove");
+
+    // removed primitives can be inserted again
+    for(uint32_t i = 1000; i < 4000; i += 2)
+    {
+        gptBvh->insert(&tBvh, i, atBoxes[i]);
+        abActive[i] = true;
+    }
+    pl_test_expect_true(bvh_test_check_tree(&tBvh, atBoxes, abActive, uBoxCount, &tData), "reinsert");
+
+    // remove everything then build from inserts only
+    for(uint32_t i = 0; i < uBoxCount; i++)
+    {
+        gptBvh->remove(&tBvh, i);
+        abActive[i] = false;
+    }
+    pl_test_expect_true(bvh_test_check_tree(&tBvh, atBoxes, abActive, uBoxCount, &tData), "remove all");
+
+    for(uint32_t i = 0; i < uBoxCount; i++)
+    {
+        gptBvh->insert(&tBvh, uBoxCount - i - 1, atBoxes[uBoxCount - i - 1]);
+        abActive[i] = true;
+    }
+    pl_test_expect_true(bvh_test_check_tree(&tBvh, atBoxes, abActive, uBoxCount, &tData), "insert only");
+
+    gptBvh->cleanup(&tBvh);
+    PL_FREE(tData.auHits);
+    PL_FREE(abActive);
+    PL_FREE(atBoxes);
+}
+
+static plEntity
+animation_test_create(plComponentLibrary* ptLibrary, plEntity tTarget, const plEntity* atData)
+{
+    plAnimationComponent* ptAnimation = NULL;
+    plEntity tAnimation = gptAnimation->create(ptLibrary, NULL, 3, &ptAnimation);
+    ptAnimation->tFlags = PL_ANIMATION_FLAG_PLAYING;
+    ptAnimation->fEnd = 2.0f;
+    const plAnimationPath atPaths[] = {PL_ANIMATION_PATH_TRANSLATION, PL_ANIMATION_PATH_ROTATION, PL_ANIMATION_PATH_SCALE};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        ptAnimation->atChannels[i] = (plAnimationChannel){.tPath = atPaths[i], .tTarget = tTarget, .uSamplerIndex = i};
+        ptAnimation->atSamplers[i] = (plAnimationSampler){.tMode = PL_ANIMATION_MODE_LINEAR, .tData = atData[i]};
+    }
+    return tAnimation;
+}
+
+static void
+animation_test_create_data(plComponentLibrary* ptLibrary, uint32_t uKeyFrameCount, plEntity* atDataOut)
+{
+    // translation & rotation are quantized, scale x range is too large to quantize within error
+    const int aiStrides[] = {3, 4, 3};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        plAnimationDataComponent* ptData = NULL;
+        atDataOut[i] = gptAnimation->create_data(ptLibrary, NULL, uKeyFrameCount, sizeof(float) * aiStrides[i] * uKeyFrameCount, &ptData);
+        float* afValues = ptData->pKeyFrameData;
+        for(uint32_t j = 0; j < uKeyFrameCount; j++)
+        {
+            const float fTime = 2.0f * (float)j / (float)(uKeyFrameCount - 1);
+            ptData->afKeyFrameTimes[j] = fTime;
+            float* afKey = &afValues[j * aiStrides[i]];
+            if(i == 0)
+            {
+                afKey[0] = 2.0f * sinf(3.0f * fTime);
+                afKey[1] = cosf(2.0f * fTime);
+                afKey[2] = fTime;
+            }
+            else if(i == 1)
+            {
+                const plVec4 tQuat = pl_quat_rotation_vec3(2.5f * fTime, pl_norm_vec3((plVec3){0.3f, 0.8f, 0.5f}));
+                memcpy(afKey, tQuat.d, sizeof(float) * 4);
+            }
+            else
+            {
+                afKey[0] = 1.0f + 99.5f * fTime;
+                afKey[1] = 1.0f + 0.5f * sinf(fTime);
+                afKey[2] = 2.0f;
+            }
+        }
+    }
+}
+
+static bool
+animation_test_within(plVec4 tA, plVec4 tB, int iCount, float fMaxError)
+{
+    if(iCount == 4 && pl_dot_vec4(tA, tB) < 0.0f)
+        tB = pl_mul_vec4_scalarf(tB, -1.0f);
+    for(int k = 0; k < iCount; k++)
+    {
+        if(fabsf(tA.d[k] - tB.d[k]) > fMaxError)
+            return false;
+    }
+    return true;
+}
+
+void
+animation_tests_0(void* pAppData)
+{
+    gptEcs->initialize((plEcsInit){0});
+    gptAnimation->register_ecs_system();
+    gptEcs->finalize();
+
+    plComponentLibrary* ptLibrary = gptEcs->get_default_library();
+    const plEcsTypeKey tTransformType = gptEcs->get_ecs_type_key_transform();
+    const plEcsTypeKey tDataType = gptAnimation->get_ecs_type_key_animation_data();
+
+    // identical reference & compressed animations
+    const plEntity tReferenceTarget = gptEcs->create_transform(ptLibrary, "reference", NULL);
+    const plEntity tCompressedTarget = gptEcs->create_transform(ptLibrary, "compressed", NULL);
+    plEntity atReferenceData[3] = {0};
+    plEntity atCompressedData[3] = {0};
+    animation_test_create_data(ptLibrary, 121, atReferenceData);
+    animation_test_create_data(ptLibrary, 121, atCompressedData);
+    animation_test_create(ptLibrary, tReferenceTarget, atReferenceData);
+    const plEntity tCompressed = animation_test_create(ptLibrary, tCompressedTarget, atCompressedData);
+
+    const plAnimationCompressInfo tInfo = {
+        .fMaxTranslationError = 0.001f,
+        .fMaxRotationError    = 0.0005f,
+        .fMaxScaleError       = 0.001f
+    };
+    gptAnimation->compress(ptLibrary, tCompressed, &tInfo);
+
+    const plAnimationDataComponent* ptTranslationData = gptEcs->get_component(ptLibrary, tDataType, atCompressedData[0]);
+    const plAnimationDataComponent* ptRotationData = gptEcs->get_component(ptLibrary, tDataType, atCompressedData[1]);
+    const plAnimationDataComponent* ptScaleData = gptEcs->get_component(ptLibrary, tDataType, atCompressedData[2]);
+    pl_test_expect_true(ptTranslationData->tFlags & PL_ANIMATION_DATA_FLAG_COMPRESSED, "translation quantized");
+    pl_test_expect_true(ptRotationData->tFlags & PL_ANIMATION_DATA_FLAG_COMPRESSED, "rotation quantized");
+    pl_test_expect_false(ptScaleData->tFlags & PL_ANIMATION_DATA_FLAG_COMPRESSED, "scale step exceeds error (float keys)");
+    pl_test_expect_true(ptTranslationData->uKeyFrameCount < 121, "keys reduced");
+
+    // sample both between & at keys (small slack for float math)
+    bool abWithin[3] = {true, true, true};
+    for(uint32_t i = 0; i < 150; i++)
+    {
+        gptAnimation->run_animation_update_system(ptLibrary, 1.0f / 75.0f);
+        const plTransformComponent* ptReference = gptEcs->get_component(ptLibrary, tTransformType, tReferenceTarget);
+        const plTransformComponent* ptResult = gptEcs->get_component(ptLibrary, tTransformType, tCompressedTarget);
+        abWithin[0] &= animation_test_within((plVec4){.xyz = ptReference->tTranslation}, (plVec4){.xyz = ptResult->tTranslation}, 3, tInfo.fMaxTranslationError * 1.05f);
+        abWithin[1] &= animation_test_within(ptReference->tRotation, ptResult->tRotation, 4, tInfo.fMaxRotationError * 1.05f);
+        abWithin[2] &= animation_test_within((plVec4){.xyz = ptReference->tScale}, (plVec4){.xyz = ptResult->tScale}, 3, tInfo.fMaxScaleError * 1.05f);
+    }
+    pl_test_expect_true(abWithin[0], "translation round trip within error");
+    pl_test_expect_true(abWithin[1], "rotation round trip within error");
+    pl_test_expect_true(abWithin[2], "scale round trip within error");
+
+    gptEcs->cleanup();
+}
+
+static plPlane
+culling_test_plane(plVec3 tPoint, plVec3 tNormal, plVec3 tInside)
+{
+    // normal flipped to face the inside point
+    tNormal = pl_norm_vec3(tNormal);
+    if(pl_dot_vec3(tNormal, pl_sub_vec3(tInside, tPoint)) < 0.0f)
+        tNormal = pl_mul_vec3_scalarf(tNormal, -1.0f);
+    return (plPlane){.tDirection = tNormal, .fOffset = pl_dot_vec3(tNormal, tPoint)};
+}
+
+static void
+culling_test_compare(const plCullBounds* ptBounds, const plAABB* atBoxes, uint32_t uKernel, const void* pShape, plGjkSupportFunc tSupport, const char* pcName)
+{
+    // kernels must keep everything the old per drawable GJK test kept (may keep a few more)
+    static uint32_t auVisible[PL_CULL_BLOCK_SIZE];
+    uint32_t uMissed = 0;
+    uint32_t uExtra = 0;
+    uint32_t uVisibleCount = 0;
+    for(uint32_t uStart = 0; uStart < ptBounds->uCount; uStart += PL_CULL_BLOCK_SIZE)
+    {
+        uint32_t uBlockVisibleCount = 0;
+        if(uKernel == 0)      uBlockVisibleCount = pl__cull_frustum_kernel(ptBounds, uStart, pShape, auVisible);
+        else if(uKernel == 1) uBlockVisibleCount = pl__cull_sphere_kernel(ptBounds, uStart, pShape, auVisible);
+        else                  uBlockVisibleCount = pl__cull_cone_kernel(ptBounds, uStart, pShape, auVisible);
+        uVisibleCount += uBlockVisibleCount;
+
+        uint32_t uNext = 0; // visible indices are in order
+        for(uint32_t i = uStart; i < uStart + PL_CULL_BLOCK_SIZE; i++)
+        {
+            const bool bKernelVisible = uNext < uBlockVisibleCount && auVisible[uNext] == i;
+            if(bKernelVisible)
+                uNext++;
+
+            const uint32_t uFlags = ptBounds->sbuFlags[i];
+            bool bVisible = false;
+            if(uFlags & PL_CULL_BOUNDS_FLAG_RENDERABLE)
+                bVisible = (uFlags & PL_CULL_BOUNDS_FLAG_ALWAYS_VISIBLE) || gptGjk->pen(pl_gjk_support_aabb, &atBoxes[i], tSupport, pShape, NULL);
+            if(bVisible && !bKernelVisible) uMissed++;
+            if(!bVisible && bKernelVisible) uExtra++;
+        }
+    }
+
+    char acBuffer[128] = {0};
+    snprintf(acBuffer, 128, "%s: no missed drawables", pcName);
+    pl_test_expect_uint32_equal(uMissed, 0, acBuffer);
+    snprintf(acBuffer, 128, "%s: conservative extras < 1%%", pcName);
+    pl_test_expect_true(uExtra * 100 < uVisibleCount, acBuffer);
+    snprintf(acBuffer, 128, "%s: culls some", pcName);
+    pl_test_expect_true(uVisibleCount > 0 && uVisibleCount < ptBounds->uCount, acBuffer);
+}
+
+void
+culling_tests_0(void* pAppData)
+{
+    // 3 full blocks + partial block (padding is never visible)
+    const uint32_t uBoxCount = 3 * PL_CULL_BLOCK_SIZE + 100;
+    const uint32_t uPaddedCount = 4 * PL_CULL_BLOCK_SIZE;
+    plAABB* atBoxes = PL_ALLOC(sizeof(plAABB) * uPaddedCount);
+    memset(atBoxes, 0, sizeof(plAABB) * uPaddedCount);
+    bvh_test_random_boxes(atBoxes, uBoxCount, 11);
+
+    float* afBounds = PL_ALLOC(sizeof(float) * 6 * uPaddedCount);
+    memset(afBounds, 0, sizeof(float) * 6 * uPaddedCount);
+    plCullBounds tBounds = {
+        .sbfCenterX = &afBounds[0 * uPaddedCount],
+        .sbfCenterY = &afBounds[1 * uPaddedCount],
+        .sbfCenterZ = &afBounds[2 * uPaddedCount],
+        .sbfExtentX = &afBounds[3 * uPaddedCount],
+        .sbfExtentY = &afBounds[4 * uPaddedCount],
+        .sbfExtentZ = &afBounds[5 * uPaddedCount],
+        .sbuFlags   = PL_ALLOC(sizeof(uint32_t) * uPaddedCount),
+        .uCount     = uPaddedCount
+    };
+    memset(tBounds.sbuFlags, 0, sizeof(uint32_t) * uPaddedCount);
+    for(uint32_t i = 0; i < uBoxCount; i++)
+    {
+        tBounds.sbfCenterX[i] = 0.5f * (atBoxes[i].tMax.x + atBoxes[i].tMin.x);
+        tBounds.sbfCenterY[i] = 0.5f * (atBoxes[i].tMax.y + atBoxes[i].tMin.y);
+        tBounds.sbfCenterZ[i] = 0.5f * (atBoxes[i].tMax.z + atBoxes[i].tMin.z);
+        tBounds.sbfExtentX[i] = 0.5f * (atBoxes[i].tMax.x - atBoxes[i].tMin.x);
+        tBounds.sbfExtentY[i] = 0.5f * (atBoxes[i].tMax.y - atBoxes[i].tMin.y);
+        tBounds.sbfExtentZ[i] = 0.5f * (atBoxes[i].tMax.z - atBoxes[i].tMin.z);
+        if(i % 17 != 0)
+            tBounds.sbuFlags[i] |= PL_CULL_BOUNDS_FLAG_RENDERABLE;
+        if(i % 29 == 0)
+            tBounds.sbuFlags[i] |= PL_CULL_BOUNDS_FLAG_ALWAYS_VISIBLE;
+    }
+
+    // perspective frustum looking down +z into the box volume
+    const plVec3 tEye = {50.0f, 50.0f, -10.0f};
+    const plVec3 tForward = {0.0f, 0.0f, 1.0f};
+    const plVec3 tRight = {1.0f, 0.0f, 0.0f};
+    const plVec3 tUp = {0.0f, 1.0f, 0.0f};
+    const float fTanY = tanf(0.5f * 0.9f);
+    const float fTanX = fTanY * 1.5f;
+    const plVec3 tInside = pl_add_vec3(tEye, pl_mul_vec3_scalarf(tForward, 10.0f));
+    const plVec3 tNearPoint = pl_add_vec3(tEye, pl_mul_vec3_scalarf(tForward, 0.1f));
+    const plVec3 tFarPoint = pl_add_vec3(tEye, pl_mul_vec3_scalarf(tForward, 80.0f));
+    plFrustum tFrustum = {
+        .atPlanes = {
+            culling_test_plane(tEye, pl_cross_vec3(pl_sub_vec3(tForward, pl_mul_vec3_scalarf(tRight, fTanX)), tUp), tInside),
+            culling_test_plane(tEye, pl_cross_vec3(pl_add_vec3(tForward, pl_mul_vec3_scalarf(tRight, fTanX)), tUp), tInside),
+            culling_test_plane(tEye, pl_cross_vec3(pl_add_vec3(tForward, pl_mul_vec3_scalarf(tUp, fTanY)), tRight), tInside),
+            culling_test_plane(tEye, pl_cross_vec3(pl_sub_vec3(tForward, pl_mul_vec3_scalarf(tUp, fTanY)), tRight), tInside),
+            culling_test_plane(tNearPoint, tForward, tInside),
+            culling_test_plane(tFarPoint, tForward, tInside)
+        }
+    };
+    culling_test_compare(&tBounds, atBoxes, 0, &tFrustum, pl_gjk_support_frustum, "frustum");
+
+    const plSphere tSphere = {.tCenter = {40.0f, 55.0f, 50.0f}, .fRadius = 20.0f};
+    culling_test_compare(&tBounds, atBoxes, 1, &tSphere, pl_gjk_support_sphere, "sphere");
+
+    const plCone tCone = {.tTipPos = {50.0f, 50.0f, 0.0f}, .tBasePos = {60.0f, 45.0f, 70.0f}, .fRadius = 25.0f};
+    culling_test_compare(&tBounds, atBoxes, 2, &tCone, pl_gjk_support_cone, "cone");
+
+    PL_FREE(tBounds.sbuFlags);
+    PL_FREE(afBounds);
+    PL_FREE(atBoxes);
+}
+
+void
+mesh_builder_tests_0(void* pAppData)
+{
+    // 4x4 quad grid, every shared corner jittered within the weld radius
+    const uint32_t uGridSize = 4;
+    const uint32_t uTriangleCount = uGridSize * uGridSize * 2;
+    plVec3* atPositions = PL_ALLOC(sizeof(plVec3) * uTriangleCount * 3);
+    plVec3d* atPositionsDouble = PL_ALLOC(sizeof(plVec3d) * uTriangleCount * 3);
+    uint32_t uCurrentPosition = 0;
+    for(uint32_t uY = 0; uY < uGridSize; uY++)
+    {
+        for(uint32_t uX = 0; uX < uGridSize; uX++)
+        {
+            const float fJitter = (uX + uY) % 2 == 0 ? 0.001f : -0.001f;
+            const plVec3 tA = {(float)uX + fJitter,       (float)uY,                 0.0f};
+            const plVec3 tB = {(float)(uX + 1),           (float)uY - fJitter,       0.0f};
+            const plVec3 tC = {(float)(uX + 1) - fJitter, (float)(uY + 1),           0.0f};
+            const plVec3 tD = {(float)uX,                 (float)(uY + 1) + fJitter, 0.0f};
+            atPositions[uCurrentPosition++] = tA;
+            atPositions[uCurrentPosition++] = tB;
+            atPositions[uCurrentPosition++] = tC;
+            atPositions[uCurrentPosition++] = tA;
+            atPositions[uCurrentPosition++] = tC;
+            atPositions[uCurrentPosition++] = tD;
+        }
+    }
+    for(uint32_t i = 0; i < uTriangleCount * 3; i++)
+        atPositionsDouble[i] = (plVec3d){atPositions[i].x, atPositions[i].y, atPositions[i].z};
+
+    const uint32_t uExpectedVertexCount = (uGridSize + 1) * (uGridSize + 1);
+    const uint32_t uExpectedIndexCount = uTriangleCount * 3;
+    const plMeshBuilderOptions tOptions = {.fWeldRadius = 0.01f};
+
+    // single triangles
+    plMeshBuilder* ptBuilder = gptMeshBuilder->create(tOptions);
+    for(uint32_t i = 0; i < uTriangleCount; i++)
+        gptMeshBuilder->add_triangle(ptBuilder, atPositions[i * 3], atPositions[i * 3 + 1], atPositions[i * 3 + 2]);
+
+    uint32_t uIndexCount = 0;
+    uint32_t uVertexCount = 0;
+    gptMeshBuilder->commit(ptBuilder, NULL, NULL, &uIndexCount, &uVertexCount);
+    pl_test_expect_uint32_equal(uVertexCount, uExpectedVertexCount, "welded vertex count");
+    pl_test_expect_uint32_equal(uIndexCount, uExpectedIndexCount, "index count");
+
+    uint32_t* auIndices = PL_ALLOC(sizeof(uint32_t) * uIndexCount);
+    plVec3* atVertices = PL_ALLOC(sizeof(plVec3) * uVertexCount);
+    gptMeshBuilder->commit(ptBuilder, auIndices, atVertices, NULL, NULL);
+    gptMeshBuilder->cleanup(ptBuilder);
+
+    uint32_t uBadIndexCount = 0;
+    for(uint32_t i = 0; i < uIndexCount; i++)
+    {
+        if(auIndices[i] >= uVertexCount)
+            uBadIndexCount++;
+        else
+        {
+            const plVec3 tDiff = pl_sub_vec3(atVertices[auIndices[i]], atPositions[i]);
+            if(pl_length_vec3(tDiff) > tOptions.fWeldRadius)
+                uBadIndexCount++;
+        }
+    }
+    pl_test_expect_uint32_equal(uBadIndexCount, 0, "indices reference welded vertices");
+
+    // bulk triangles
+    ptBuilder = gptMeshBuilder->create(tOptions);
+    gptMeshBuilder->add_triangles(ptBuilder, uTriangleCount, atPositions);
+    gptMeshBuilder->commit(ptBuilder, NULL, NULL, &uIndexCount, &uVertexCount);
+    gptMeshBuilder->cleanup(ptBuilder);
+    pl_test_expect_uint32_equal(uVertexCount, uExpectedVertexCount, "welded vertex count (add_triangles)");
+    pl_test_expect_uint32_equal(uIndexCount, uExpectedIndexCount, "index count (add_triangles)");
+
+    ptBuilder = gptMeshBuilder->create(tOptions);
+    gptMeshBuilder->add_triangles_double(ptBuilder, uTriangleCount, atPositionsDouble);
+    gptMeshBuilder->commit_double(ptBuilder, NULL, NULL, &uIndexCount, &uVertexCount);
+    gptMeshBuilder->cleanup(ptBuilder);
+    pl_test_expect_uint32_equal(uVertexCount, uExpectedVertexCount, "welded vertex count (add_triangles_double)");
+    pl_test_expect_uint32_equal(uIndexCount, uExpectedIndexCount, "index count (add_triangles_double)");
+
+    // radius smaller than jitter keeps jittered corners apart
+    ptBuilder = gptMeshBuilder->create((plMeshBuilderOptions){.fWeldRadius = 0.0001f});
+    gptMeshBuilder->add_triangles(ptBuilder, uTriangleCount, atPositions);
+    gptMeshBuilder->commit(ptBuilder, NULL, NULL, NULL, &uVertexCount);
+    gptMeshBuilder->cleanup(ptBuilder);
+    pl_test_expect_true(uVertexCount > uExpectedVertexCount, "unwelded beyond radius");
+
+    PL_FREE(atVertices);
+    PL_FREE(auIndices);
+    PL_FREE(atPositionsDouble);
+    PL_FREE(atPositions);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] unity build
 //-----------------------------------------------------------------------------
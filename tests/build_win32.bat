@@ -81,6 +81,8 @@
     @if exist "../out/pilot_light_cpp_*.pdb" del "..\out\pilot_light_cpp_*.pdb"
     @if exist "../out/tests_c.dll" del "..\out\tests_c.dll"
     @if exist "../out/tests_c_*.pdb" del "..\out\tests_c_*.pdb"
+    @if exist "../out/benchmarks.dll" del "..\out\benchmarks.dll"
+    @if exist "../out/benchmarks_*.pdb" del "..\out\benchmarks_*.pdb"
     @if exist "../out/tests_cpp.dll" del "..\out\tests_cpp.dll"
     @if exist "../out/tests_cpp_*.pdb" del "..\out\tests_cpp_*.pdb"
 
@@ -207,6 +209,43 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 
 @del "..\out\*.obj"  > nul 2> nul
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ benchmarks | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_benchmarks
+
+:Build_benchmarks
+@set PL_DEFINES=-DPL_CONFIG_DEBUG -D_DEBUG 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" 
+@set PL_COMPILER_FLAGS=-Od -MDd -Zi -Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- 
+@set PL_LINKER_FLAGS=-incremental:no -noimplib -noexp 
+@set PL_SOURCES="app_benchmarks.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: benchmarks[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/benchmarks.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/benchmarks_%random%.pdb"
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_benchmarks
+
+@del "..\out\*.obj"  > nul 2> nul
+
 ::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ tests_cpp | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 :: skip during hot reload
@@ -292,6 +331,8 @@ goto ExitLabel
     @if exist "../out/pilot_light_cpp_*.pdb" del "..\out\pilot_light_cpp_*.pdb"
     @if exist "../out/tests_c.dll" del "..\out\tests_c.dll"
     @if exist "../out/tests_c_*.pdb" del "..\out\tests_c_*.pdb"
+    @if exist "../out/benchmarks.dll" del "..\out\benchmarks.dll"
+    @if exist "../out/benchmarks_*.pdb" del "..\out\benchmarks_*.pdb"
     @if exist "../out/tests_cpp.dll" del "..\out\tests_cpp.dll"
     @if exist "../out/tests_cpp_*.pdb" del "..\out\tests_cpp_*.pdb"
 
@@ -418,6 +459,43 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 
 @del "..\out\*.obj"  > nul 2> nul
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ benchmarks | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_benchmarks
+
+:Build_benchmarks
+@set PL_DEFINES=-DPL_CONFIG_RELEASE -DNDEBUG 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../shaders" -I"../libs" -I"../extensions" -I"../out" -I"../thirdparty/stb" 
+@set PL_COMPILER_FLAGS=-O2 -MD -Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- 
+@set PL_LINKER_FLAGS=-incremental:no -noimplib -noexp 
+@set PL_SOURCES="app_benchmarks.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mTarget: benchmarks[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/benchmarks.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/benchmarks_%random%.pdb"
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_benchmarks
+
+@del "..\out\*.obj"  > nul 2> nul
+
 ::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ tests_cpp | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 :: skip during hot reload